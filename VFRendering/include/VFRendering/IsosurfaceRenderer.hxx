@@ -2,10 +2,13 @@
 #define VFRENDERING_ISOSURFACE_RENDERER_HXX
 
 #include <functional>
+#include <memory>
 
 #include <VFRendering/VectorFieldRenderer.hxx>
 
 namespace VFRendering {
+class VectorfieldIsosurfaceTopology;
+
 class IsosurfaceRenderer : public VectorFieldRenderer {
 public:
 
@@ -43,6 +46,8 @@ private:
 
     bool m_value_function_changed;
     bool m_isovalue_changed;
+    // Edges of the tetrahedra of the current geometry, which are reused while only the directions change
+    std::shared_ptr<VectorfieldIsosurfaceTopology> m_topology;
 };
 
 namespace Utilities {
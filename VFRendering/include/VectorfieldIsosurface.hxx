@@ -9,6 +9,23 @@
 #include <VFRendering/Geometry.hxx>
 
 namespace VFRendering {
+/** The edges of a tetrahedralization, on which the points of an isosurface lie.
+ *
+ *  They only depend on the tetrahedra, so they can be determined once for a
+ *  geometry and reused for any values and isovalues.
+ */
+class VectorfieldIsosurfaceTopology {
+public:
+    typedef Geometry::index_type index_type;
+
+    VectorfieldIsosurfaceTopology(const std::vector<std::array<index_type, 4>>& tetrahedra, index_type num_points);
+
+    // Unique edges, with the smaller index first
+    std::vector<std::array<index_type, 2>> edges;
+    // Indices into edges of the edges (0, 1), (0, 2), (0, 3), (1, 2), (1, 3) and (2, 3) of each tetrahedron
+    std::vector<std::array<index_type, 6>> tetrahedron_edges;
+};
+
 class VectorfieldIsosurface {
 public:
     std::vector<glm::vec3> positions;
@@ -16,6 +33,7 @@ public:
     std::vector<glm::vec3> normals;
     std::vector<int> triangle_indices;
     static VectorfieldIsosurface calculate(const std::vector<glm::vec3>&, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue, const std::vector<std::array<Geometry::index_type, 4>>& tetrahedra);
+    static VectorfieldIsosurface calculate(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue, const std::vector<std::array<Geometry::index_type, 4>>& tetrahedra, const VectorfieldIsosurfaceTopology& topology);
 };
 }
 
@@ -89,7 +89,9 @@ void IsosurfaceRenderer::update(bool keep_geometry) {
     if (!m_is_initialized) {
         return;
     }
-    (void)keep_geometry;
+    if (!keep_geometry) {
+        m_topology.reset();
+    }
     updateIsosurfaceIndices();
 }
 
@@ -168,14 +170,19 @@ void IsosurfaceRenderer::updateIsosurfaceIndices() {
         return;
     }
 
-    std::vector<float> values;
+    // The value function is not required to be thread-safe (e.g. when it is
+    // implemented in Python), so the values are calculated serially.
+    std::vector<float> values(positions().size());
     for (Geometry::index_type i = 0; i < positions().size(); i++) {
         const glm::vec3& position = positions()[i];
         const glm::vec3& direction = directions()[i];
-        values.push_back(value_function(position, direction));
+        values[i] = value_function(position, direction);
     }
 
-    VectorfieldIsosurface isosurface(VectorfieldIsosurface::calculate(positions(), directions(), values, isovalue, volume_indices));
+    if (!m_topology || m_topology->tetrahedron_edges.size() != volume_indices.size()) {
+        m_topology = std::make_shared<VectorfieldIsosurfaceTopology>(volume_indices, positions().size());
+    }
+    VectorfieldIsosurface isosurface(VectorfieldIsosurface::calculate(positions(), directions(), values, isovalue, volume_indices, *m_topology));
 
     const std::vector<GLuint> surface_indices(isosurface.triangle_indices.begin(), isosurface.triangle_indices.end());
 
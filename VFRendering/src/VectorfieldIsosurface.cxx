@@ -1,78 +1,81 @@
 #include "VectorfieldIsosurface.hxx"
 
-#include <iostream>
-#include <map>
+#include <algorithm>
 #include <limits>
 
 #include <glm/glm.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace VFRendering {
-class VectorfieldIsosurfaceCalculation {
+namespace {
+typedef Geometry::index_type index_type;
+
+// Position in VectorfieldIsosurfaceTopology::tetrahedron_edges of the edge between the vertices i and j of a tetrahedron
+const int tetrahedron_edge_index[4][4] = {
+    {-1, 0, 1, 2},
+    {0, -1, 3, 4},
+    {1, 3, -1, 5},
+    {2, 4, 5, -1}
+};
+
+int maxThreads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+int threadNum() {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+int numThreads() {
+#ifdef _OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+struct Triangle {
+    std::array<index_type, 3> indices;
+    // Normal, which is added to the normals of the points of the triangle
+    glm::vec3 normal;
+};
+
+// The triangles within the tetrahedra are independent of each other once the
+// isopoints have been calculated, so that each thread can collect its own.
+class TetrahedronTriangulation {
 public:
-    VectorfieldIsosurfaceCalculation(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue) : in_positions(positions), in_directions(directions), in_values(values), in_isovalue(isovalue) {}
+    TetrahedronTriangulation(const std::vector<glm::vec3>& positions, const std::vector<float>& values, float isovalue, const std::vector<index_type>& edge_isopoints, const std::vector<glm::vec3>& isopoint_positions, std::vector<Triangle>& triangles) : in_positions(positions), in_values(values), in_isovalue(isovalue), edge_isopoints(edge_isopoints), isopoint_positions(isopoint_positions), triangles(triangles) {}
 
-    void addTetrahedron(std::array<Geometry::index_type, 4> t);
-    VectorfieldIsosurface getResultAndReset();
+    void addTetrahedron(const std::array<index_type, 4>& t, const std::array<index_type, 6>& t_edges);
 
 private:
-    typedef Geometry::index_type index_type;
-    typedef std::pair<index_type, index_type> edge_type;
-
     template<int NUM_INSIDE_POINTS>
     void generateTriangle(index_type i1, index_type i2, index_type i3, const std::array<glm::vec3, NUM_INSIDE_POINTS>& inside_points, bool flip_normal);
 
-    index_type getIsopointIndex(const edge_type& edge);
-
-    void generateOneTetrahedronTriangle(index_type in_i1, index_type out_i1, index_type out_i2, index_type out_i3, bool flip_normal);
-    void generateTwoTetrahedronTriangles(index_type in_i1, index_type in_i2, index_type out_i1, index_type out_i2, bool flip_normal);
-
-    // input
     const std::vector<glm::vec3>& in_positions;
-    const std::vector<glm::vec3>& in_directions;
     const std::vector<float>& in_values;
     float in_isovalue;
-
-    // internal
-    std::map<edge_type, index_type> edge_indices;
-
-    // output
-    std::vector<glm::vec3> positions;
-    std::vector<glm::vec3> directions;
-    std::vector<glm::vec3> normals;
-    std::vector<int> triangle_indices;
+    const std::vector<index_type>& edge_isopoints;
+    const std::vector<glm::vec3>& isopoint_positions;
+    std::vector<Triangle>& triangles;
 };
 
-
-VectorfieldIsosurface VectorfieldIsosurfaceCalculation::getResultAndReset() {
-    for (auto& normal : normals) {
-        normal = glm::normalize(normal);
-        if (glm::any(glm::isnan(normal))) {
-            normal = glm::vec3(0, 0, 0);
-        }
-    }
-    for (auto& direction : directions) {
-        direction = glm::normalize(direction);
-    }
-
-    VectorfieldIsosurface isosurface;
-    isosurface.positions.swap(positions);
-    isosurface.directions.swap(directions);
-    isosurface.normals.swap(normals);
-    isosurface.triangle_indices.swap(triangle_indices);
-
-    edge_indices.clear();
-    positions.clear();
-    directions.clear();
-    normals.clear();
-    triangle_indices.clear();
-    return isosurface;
-}
-
 template<int NUM_INSIDE_POINTS>
-void VectorfieldIsosurfaceCalculation::generateTriangle(index_type i1, index_type i2, index_type i3, const std::array<glm::vec3, NUM_INSIDE_POINTS>& inside_points, bool flip_normal) {
-    glm::vec3 p1 = positions[i1];
-    glm::vec3 p2 = positions[i2];
-    glm::vec3 p3 = positions[i3];
+void TetrahedronTriangulation::generateTriangle(index_type i1, index_type i2, index_type i3, const std::array<glm::vec3, NUM_INSIDE_POINTS>& inside_points, bool flip_normal) {
+    glm::vec3 p1 = isopoint_positions[i1];
+    glm::vec3 p2 = isopoint_positions[i2];
+    glm::vec3 p3 = isopoint_positions[i3];
 
     glm::vec3 n = glm::normalize(glm::cross(p2 - p1, p3 - p1));
     if (glm::any(glm::isnan(n))) {
@@ -95,76 +98,13 @@ void VectorfieldIsosurfaceCalculation::generateTriangle(index_type i1, index_typ
     }
 
     if (flip_normal) {
-        n = -n;
-        triangle_indices.push_back(i2);
-        triangle_indices.push_back(i1);
-        triangle_indices.push_back(i3);
+        triangles.push_back({{{i2, i1, i3}}, -n});
     } else {
-        triangle_indices.push_back(i1);
-        triangle_indices.push_back(i2);
-        triangle_indices.push_back(i3);
+        triangles.push_back({{{i1, i2, i3}}, n});
     }
-    normals[i1] += n;
-    normals[i2] += n;
-    normals[i3] += n;
 }
 
-VectorfieldIsosurfaceCalculation::index_type VectorfieldIsosurfaceCalculation::getIsopointIndex(const VectorfieldIsosurfaceCalculation::edge_type& edge) {
-    if (edge.first > edge.second) {
-        return getIsopointIndex({edge.second, edge.first});
-    }
-    auto it = edge_indices.find(edge);
-    if (it == edge_indices.end()) {
-        float left_value = in_values[edge.first];
-        float right_value = in_values[edge.second];
-        float alpha;
-        if (std::abs(left_value - right_value) < std::numeric_limits<float>::min()) {
-            alpha = 0.5;
-        } else {
-            alpha = (in_isovalue - left_value) / (right_value - left_value);
-            if (alpha < 0) {
-                alpha = 0;
-            } else if (alpha > 1) {
-                alpha = 1;
-            }
-        }
-
-        glm::vec3 left_point = in_positions[edge.first];
-        glm::vec3 right_point = in_positions[edge.second];
-        glm::vec3 isopoint = glm::mix(left_point, right_point, alpha);
-
-        glm::vec3 left_direction = in_directions[edge.first];
-        glm::vec3 right_direction = in_directions[edge.second];
-        glm::vec3 isodirection = glm::normalize(glm::mix(left_direction, right_direction, alpha));
-
-        index_type isopoint_index = positions.size();
-        edge_indices[edge] = isopoint_index;
-        positions.push_back(isopoint);
-        directions.push_back(isodirection);
-        normals.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-        return isopoint_index;
-    } else {
-        return it->second;
-    }
-}
-
-void VectorfieldIsosurfaceCalculation::generateOneTetrahedronTriangle(index_type in_i1, index_type out_i1, index_type out_i2, index_type out_i3, bool flip_normal) {
-    index_type i1 = getIsopointIndex({in_i1, out_i1});
-    index_type i2 = getIsopointIndex({in_i1, out_i2});
-    index_type i3 = getIsopointIndex({in_i1, out_i3});
-    generateTriangle<1>(i1, i2, i3, {{in_positions[in_i1]}}, flip_normal);
-}
-
-void VectorfieldIsosurfaceCalculation::generateTwoTetrahedronTriangles(index_type in_i1, index_type in_i2, index_type out_i1, index_type out_i2, bool flip_normal) {
-    index_type i1 = getIsopointIndex({in_i1, out_i1});
-    index_type i2 = getIsopointIndex({in_i1, out_i2});
-    index_type i3 = getIsopointIndex({in_i2, out_i1});
-    index_type i4 = getIsopointIndex({in_i2, out_i2});
-    generateTriangle<2>(i1, i4, i2, {{in_positions[in_i1], in_positions[in_i2]}}, flip_normal);
-    generateTriangle<2>(i1, i4, i3, {{in_positions[in_i1], in_positions[in_i2]}}, flip_normal);
-}
-
-void VectorfieldIsosurfaceCalculation::addTetrahedron(std::array<Geometry::index_type, 4> t) {
+void TetrahedronTriangulation::addTetrahedron(const std::array<index_type, 4>& t, const std::array<index_type, 6>& t_edges) {
     int index = 0;
     for (int i = 0; i < 4; i++) {
         if (in_values[t[i]] > in_isovalue) {
@@ -175,77 +115,269 @@ void VectorfieldIsosurfaceCalculation::addTetrahedron(std::array<Geometry::index
     if (flip_normal) {
         index = 15 - index;
     }
-    index_type in_i1 = -1;
-    index_type in_i2 = -1;
-    index_type out_i1 = -1;
-    index_type out_i2 = -1;
-    index_type out_i3 = -1;
-    index_type result_tri = 1;
+    // Vertices of the tetrahedron (0 to 3) inside and outside of the isosurface
+    int in_1 = -1;
+    int in_2 = -1;
+    int out_1 = -1;
+    int out_2 = -1;
+    int out_3 = -1;
+    int result_tri = 1;
     switch (index) {
     case 0:
         return;
     case 1:
-        in_i1 = t[0];
-        out_i1 = t[1];
-        out_i2 = t[2];
-        out_i3 = t[3];
+        in_1 = 0;
+        out_1 = 1;
+        out_2 = 2;
+        out_3 = 3;
         break;
     case 2:
-        in_i1 = t[1];
-        out_i1 = t[0];
-        out_i2 = t[2];
-        out_i3 = t[3];
+        in_1 = 1;
+        out_1 = 0;
+        out_2 = 2;
+        out_3 = 3;
         break;
     case 3:
-        in_i1 = t[0];
-        in_i2 = t[1];
-        out_i1 = t[2];
-        out_i2 = t[3];
+        in_1 = 0;
+        in_2 = 1;
+        out_1 = 2;
+        out_2 = 3;
         result_tri = 2;
         break;
     case 4:
-        in_i1 = t[2];
-        out_i1 = t[0];
-        out_i2 = t[1];
-        out_i3 = t[3];
+        in_1 = 2;
+        out_1 = 0;
+        out_2 = 1;
+        out_3 = 3;
         break;
     case 5:
-        in_i1 = t[0];
-        in_i2 = t[2];
-        out_i1 = t[1];
-        out_i2 = t[3];
+        in_1 = 0;
+        in_2 = 2;
+        out_1 = 1;
+        out_2 = 3;
         result_tri = 2;
         break;
     case 6:
-        in_i1 = t[1];
-        in_i2 = t[2];
-        out_i1 = t[0];
-        out_i2 = t[3];
+        in_1 = 1;
+        in_2 = 2;
+        out_1 = 0;
+        out_2 = 3;
         result_tri = 2;
         break;
     case 7:
         flip_normal = !flip_normal;
-        in_i1 = t[3];
-        out_i1 = t[0];
-        out_i2 = t[1];
-        out_i3 = t[2];
+        in_1 = 3;
+        out_1 = 0;
+        out_2 = 1;
+        out_3 = 2;
         break;
     }
+    auto isopoint = [&](int i, int j) {
+        return edge_isopoints[t_edges[tetrahedron_edge_index[i][j]]];
+    };
     if (result_tri == 1) {
-        if (in_values[in_i1] == in_isovalue) {
+        if (in_values[t[in_1]] == in_isovalue) {
             return;
         }
-        generateOneTetrahedronTriangle(in_i1, out_i1, out_i2, out_i3, flip_normal);
+        index_type i1 = isopoint(in_1, out_1);
+        index_type i2 = isopoint(in_1, out_2);
+        index_type i3 = isopoint(in_1, out_3);
+        generateTriangle<1>(i1, i2, i3, {{in_positions[t[in_1]]}}, flip_normal);
     } else {
-        generateTwoTetrahedronTriangles(in_i1, in_i2, out_i1, out_i2, flip_normal);
+        index_type i1 = isopoint(in_1, out_1);
+        index_type i2 = isopoint(in_1, out_2);
+        index_type i3 = isopoint(in_2, out_1);
+        index_type i4 = isopoint(in_2, out_2);
+        generateTriangle<2>(i1, i4, i2, {{in_positions[t[in_1]], in_positions[t[in_2]]}}, flip_normal);
+        generateTriangle<2>(i1, i4, i3, {{in_positions[t[in_1]], in_positions[t[in_2]]}}, flip_normal);
+    }
+}
+}
+
+VectorfieldIsosurfaceTopology::VectorfieldIsosurfaceTopology(const std::vector<std::array<index_type, 4>>& tetrahedra, index_type num_points) {
+    // Neighbours of each point with a larger index, with duplicates
+    std::vector<index_type> offsets(num_points + 1, 0);
+    for (const auto& t : tetrahedra) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = i + 1; j < 4; j++) {
+                offsets[std::min(t[i], t[j]) + 1]++;
+            }
+        }
+    }
+    for (index_type i = 0; i < num_points; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<index_type> neighbours(offsets[num_points]);
+    std::vector<index_type> next(offsets.begin(), offsets.end() - 1);
+    for (const auto& t : tetrahedra) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = i + 1; j < 4; j++) {
+                neighbours[next[std::min(t[i], t[j])]++] = std::max(t[i], t[j]);
+            }
+        }
+    }
+
+    // Remove the duplicates, so that the edges of each point are sorted and unique
+    std::vector<index_type> num_unique(num_points);
+    #pragma omp parallel for
+    for (int i = 0; i < (int)num_points; i++) {
+        auto begin = neighbours.begin() + offsets[i];
+        auto end = neighbours.begin() + offsets[i + 1];
+        std::sort(begin, end);
+        num_unique[i] = std::unique(begin, end) - begin;
+    }
+    std::vector<index_type> edge_offsets(num_points + 1, 0);
+    for (index_type i = 0; i < num_points; i++) {
+        edge_offsets[i + 1] = edge_offsets[i] + num_unique[i];
+    }
+    edges.resize(edge_offsets[num_points]);
+    #pragma omp parallel for
+    for (int i = 0; i < (int)num_points; i++) {
+        for (index_type k = 0; k < num_unique[i]; k++) {
+            edges[edge_offsets[i] + k] = {{(index_type)i, neighbours[offsets[i] + k]}};
+        }
+    }
+
+    // Look up the edges of each tetrahedron among the edges of its points
+    tetrahedron_edges.resize(tetrahedra.size());
+    #pragma omp parallel for
+    for (int n = 0; n < (int)tetrahedra.size(); n++) {
+        const auto& t = tetrahedra[n];
+        for (int i = 0; i < 4; i++) {
+            for (int j = i + 1; j < 4; j++) {
+                index_type first = std::min(t[i], t[j]);
+                index_type second = std::max(t[i], t[j]);
+                auto edge = std::lower_bound(edges.begin() + edge_offsets[first], edges.begin() + edge_offsets[first + 1], second,
+                    [](const std::array<index_type, 2>& e, index_type value) { return e[1] < value; });
+                tetrahedron_edges[n][tetrahedron_edge_index[i][j]] = edge - edges.begin();
+            }
+        }
     }
 }
 
 VectorfieldIsosurface VectorfieldIsosurface::calculate(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue, const std::vector<std::array<Geometry::index_type, 4>>& tetrahedra) {
-    VectorfieldIsosurfaceCalculation calculation(positions, directions, values, isovalue);
-    for (auto& t : tetrahedra) {
-        calculation.addTetrahedron(t);
+    return calculate(positions, directions, values, isovalue, tetrahedra, VectorfieldIsosurfaceTopology(tetrahedra, positions.size()));
+}
+
+VectorfieldIsosurface VectorfieldIsosurface::calculate(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& directions, const std::vector<float>& values, float isovalue, const std::vector<std::array<Geometry::index_type, 4>>& tetrahedra, const VectorfieldIsosurfaceTopology& topology) {
+    const auto& edges = topology.edges;
+    const int num_edges = edges.size();
+    const int num_tetrahedra = tetrahedra.size();
+    const index_type no_isopoint = std::numeric_limits<index_type>::max();
+
+    // Number the edges which cross the isosurface, each of which has one isopoint.
+    // Each thread counts the crossing edges of its block of edges, the blocks are
+    // then numbered in order.
+    std::vector<index_type> edge_isopoints(num_edges);
+    std::vector<index_type> block_offsets(maxThreads() + 1, 0);
+    index_type num_isopoints = 0;
+    #pragma omp parallel
+    {
+        const int thread = threadNum();
+        const int num_blocks = numThreads();
+        const int begin = (long long)num_edges * thread / num_blocks;
+        const int end = (long long)num_edges * (thread + 1) / num_blocks;
+        index_type count = 0;
+        for (int e = begin; e < end; e++) {
+            bool crossing = (values[edges[e][0]] > isovalue) != (values[edges[e][1]] > isovalue);
+            edge_isopoints[e] = crossing ? count++ : no_isopoint;
+        }
+        block_offsets[thread + 1] = count;
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (int i = 0; i < num_blocks; i++) {
+                block_offsets[i + 1] += block_offsets[i];
+            }
+            num_isopoints = block_offsets[num_blocks];
+        }
+        for (int e = begin; e < end; e++) {
+            if (edge_isopoints[e] != no_isopoint) {
+                edge_isopoints[e] += block_offsets[thread];
+            }
+        }
+    }
+
+    std::vector<glm::vec3> isopoint_positions(num_isopoints);
+    std::vector<glm::vec3> isopoint_directions(num_isopoints);
+
+    // Interpolate the isopoints
+    #pragma omp parallel for
+    for (int e = 0; e < num_edges; e++) {
+        index_type isopoint_index = edge_isopoints[e];
+        if (isopoint_index == no_isopoint) {
+            continue;
+        }
+        index_type left = edges[e][0];
+        index_type right = edges[e][1];
+        float left_value = values[left];
+        float right_value = values[right];
+        float alpha;
+        if (std::abs(left_value - right_value) < std::numeric_limits<float>::min()) {
+            alpha = 0.5;
+        } else {
+            alpha = (isovalue - left_value) / (right_value - left_value);
+            if (alpha < 0) {
+                alpha = 0;
+            } else if (alpha > 1) {
+                alpha = 1;
+            }
+        }
+        isopoint_positions[isopoint_index] = glm::mix(positions[left], positions[right], alpha);
+        isopoint_directions[isopoint_index] = glm::normalize(glm::mix(directions[left], directions[right], alpha));
+    }
+
+    // Triangles within the tetrahedra, collected per thread. As the
+    // tetrahedra are split into contiguous blocks in the order of the threads,
+    // the merged triangles are in the order of the tetrahedra.
+    std::vector<std::vector<Triangle>> thread_triangles(maxThreads());
+    #pragma omp parallel
+    {
+        TetrahedronTriangulation triangulation(positions, values, isovalue, edge_isopoints, isopoint_positions, thread_triangles[threadNum()]);
+        #pragma omp for schedule(static)
+        for (int n = 0; n < num_tetrahedra; n++) {
+            triangulation.addTetrahedron(tetrahedra[n], topology.tetrahedron_edges[n]);
+        }
     }
-    return calculation.getResultAndReset();
+
+    // Merge the triangles and add their normals to the normals of their points.
+    // Isopoints which are not part of any triangle, where a point lies exactly
+    // on the isosurface, are dropped and the others are numbered by first use.
+    std::size_t num_triangles = 0;
+    for (const auto& triangles : thread_triangles) {
+        num_triangles += triangles.size();
+    }
+    std::vector<index_type> isopoint_indices(num_isopoints, no_isopoint);
+    std::vector<index_type> used_isopoints;
+    VectorfieldIsosurface isosurface;
+    isosurface.triangle_indices.reserve(3 * num_triangles);
+    for (const auto& triangles : thread_triangles) {
+        for (const auto& triangle : triangles) {
+            for (auto i : triangle.indices) {
+                if (isopoint_indices[i] == no_isopoint) {
+                    isopoint_indices[i] = used_isopoints.size();
+                    used_isopoints.push_back(i);
+                    isosurface.normals.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
+                }
+                isosurface.triangle_indices.push_back(isopoint_indices[i]);
+                isosurface.normals[isopoint_indices[i]] += triangle.normal;
+            }
+        }
+    }
+
+    const int num_used_isopoints = used_isopoints.size();
+    isosurface.positions.resize(num_used_isopoints);
+    isosurface.directions.resize(num_used_isopoints);
+    #pragma omp parallel for
+    for (int i = 0; i < num_used_isopoints; i++) {
+        isosurface.positions[i] = isopoint_positions[used_isopoints[i]];
+        isosurface.directions[i] = isopoint_directions[used_isopoints[i]];
+        auto& normal = isosurface.normals[i];
+        normal = glm::normalize(normal);
+        if (glm::any(glm::isnan(normal))) {
+            normal = glm::vec3(0, 0, 0);
+        }
+    }
+    return isosurface;
 }
 }
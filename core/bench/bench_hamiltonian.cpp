@@ -0,0 +1,102 @@
+#include <benchmark.hpp>
+#include <Spirit/State.h>
+#include <Spirit/Configurations.h>
+#include <Spirit/Geometry.h>
+#include <Spirit/Hamiltonian.h>
+#include <data/State.hpp>
+#include <engine/Hamiltonian.hpp>
+
+/*
+    Gradient, energy and Hessian of the Hamiltonians on an n x n x 1 system
+    The second argument selects the set of interactions:
+        0: heisenberg_neighbours with exchange and DMI   (fd_neighbours.cfg)
+        1: as 0, with the DDI summed directly within a radius of 3 lattice constants
+        2: heisenberg_pairs                              (fd_pairs.cfg)
+        3: gaussian                                      (fd_gaussian.cfg)
+*/
+
+namespace
+{
+    const std::vector<int> interaction_sets{ 0, 1, 2, 3 };
+
+    std::shared_ptr<State> Hamiltonian_State(int n, int interactions, std::string & label)
+    {
+        std::string input;
+        if (interactions == 0 || interactions == 1)
+        {
+            input = "fd_neighbours.cfg";
+            label = interactions == 0 ? "Neighbours" : "Neighbours+DDI";
+        }
+        else if (interactions == 2)
+        {
+            input = "fd_pairs.cfg";
+            label = "Pairs";
+        }
+        else
+        {
+            input = "fd_gaussian.cfg";
+            label = "Gaussian";
+        }
+
+        auto state = std::shared_ptr<State>(State_Setup(Benchmark::Input_File(input).c_str(), true), State_Delete);
+        int n_cells[3]{ n, n, 1 };
+        Geometry_Set_N_Cells(state.get(), n_cells);
+        if (interactions == 1)
+        {
+            Hamiltonian_Set_DDI_Method(state.get(), Hamiltonian_DDI_Cutoff);
+            Hamiltonian_Set_DDI(state.get(), 3);
+        }
+        Configuration_Random(state.get());
+        return state;
+    }
+}
+
+static void Hamiltonian_Gradient(Benchmark::Run & run)
+{
+    std::string label;
+    auto state = Hamiltonian_State(run.Arg(0), run.Arg(1), label);
+    auto & hamiltonian = *state->active_image->hamiltonian;
+    auto & spins = *state->active_image->spins;
+    vectorfield gradient(spins.size());
+
+    while (run.Keep_Running())
+        hamiltonian.Gradient(spins, gradient);
+
+    run.Set_Items_per_Iteration(spins.size());
+    run.Set_Label(label);
+}
+SPIRIT_BENCHMARK(Hamiltonian_Gradient)->Ranges({ {32, 128, 256}, interaction_sets });
+
+static void Hamiltonian_Energy(Benchmark::Run & run)
+{
+    std::string label;
+    auto state = Hamiltonian_State(run.Arg(0), run.Arg(1), label);
+    auto & hamiltonian = *state->active_image->hamiltonian;
+    auto & spins = *state->active_image->spins;
+    // Keeps the compiler from discarding the results
+    volatile scalar energy = 0;
+
+    while (run.Keep_Running())
+        energy = hamiltonian.Energy(spins);
+
+    run.Set_Items_per_Iteration(spins.size());
+    run.Set_Label(label);
+}
+SPIRIT_BENCHMARK(Hamiltonian_Energy)->Ranges({ {32, 128, 256}, interaction_sets });
+
+static void Hamiltonian_Hessian(Benchmark::Run & run)
+{
+    std::string label;
+    auto state = Hamiltonian_State(run.Arg(0), run.Arg(1), label);
+    auto & hamiltonian = *state->active_image->hamiltonian;
+    auto & spins = *state->active_image->spins;
+    // The Hessian is dense, so only small systems are feasible
+    MatrixX hessian(3*spins.size(), 3*spins.size());
+
+    while (run.Keep_Running())
+        hamiltonian.Hessian(spins, hessian);
+
+    run.Set_Items_per_Iteration(spins.size());
+    run.Set_Label(label);
+}
+SPIRIT_BENCHMARK(Hamiltonian_Hessian)->Ranges({ {8, 16}, interaction_sets });
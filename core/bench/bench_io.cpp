@@ -0,0 +1,95 @@
+#include <benchmark.hpp>
+#include <Spirit/State.h>
+#include <Spirit/Configurations.h>
+#include <Spirit/Geometry.h>
+#include <Spirit/IO.h>
+#include <data/State.hpp>
+
+#include <cstdio>
+
+/*
+    Setting up a State from the input files of the tests, and writing and reading
+    configurations of n x n x 1 spins in the OVF formats
+*/
+
+namespace
+{
+    const std::vector<std::string> input_files{ "api.cfg", "fd_gaussian.cfg", "fd_neighbours.cfg",
+        "fd_pairs.cfg", "physics_larmor.cfg", "solvers.cfg" };
+
+    const std::vector<int> ovf_formats{ IO_Fileformat_OVF_bin8, IO_Fileformat_OVF_bin4,
+        IO_Fileformat_OVF_text, IO_Fileformat_OVF_oct16,
+        #ifdef SPIRIT_USE_ZLIB
+        IO_Fileformat_OVF_bin4_zlib
+        #endif
+    };
+
+    std::string Format_Label(int format)
+    {
+        if (format == IO_Fileformat_OVF_bin8)
+            return "OVF bin8";
+        else if (format == IO_Fileformat_OVF_bin4)
+            return "OVF bin4";
+        else if (format == IO_Fileformat_OVF_text)
+            return "OVF text";
+        else if (format == IO_Fileformat_OVF_bin4_zlib)
+            return "OVF bin4 zlib";
+        return "OVF oct16";
+    }
+
+    std::shared_ptr<State> IO_State(int n)
+    {
+        auto state = std::shared_ptr<State>(State_Setup(Benchmark::Input_File("solvers.cfg").c_str(), true), State_Delete);
+        int n_cells[3]{ n, n, 1 };
+        Geometry_Set_N_Cells(state.get(), n_cells);
+        Configuration_Random(state.get());
+        return state;
+    }
+
+    const std::string bench_file = "spirit_bench_io.ovf";
+}
+
+// The argument is the index of the input file
+static void IO_State_Setup(Benchmark::Run & run)
+{
+    std::string input = input_files[run.Arg(0)];
+    std::string file = Benchmark::Input_File(input);
+    int nos = 0;
+    while (run.Keep_Running())
+    {
+        auto state = std::shared_ptr<State>(State_Setup(file.c_str(), true), State_Delete);
+        nos = state->active_image->nos;
+        // Deleting the State is not part of the setup
+        run.Pause_Timing();
+        state.reset();
+        run.Resume_Timing();
+    }
+    run.Set_Items_per_Iteration(nos);
+    run.Set_Label(input);
+}
+SPIRIT_BENCHMARK(IO_State_Setup)->Arg(0)->Arg(1)->Arg(2)->Arg(3)->Arg(4)->Arg(5);
+
+static void IO_Image_Write_OVF(Benchmark::Run & run)
+{
+    int format = run.Arg(1);
+    auto state = IO_State(run.Arg(0));
+    while (run.Keep_Running())
+        IO_Image_Write(state.get(), bench_file.c_str(), format);
+    std::remove(bench_file.c_str());
+    run.Set_Items_per_Iteration(state->active_image->nos);
+    run.Set_Label(Format_Label(format));
+}
+SPIRIT_BENCHMARK(IO_Image_Write_OVF)->Ranges({ {128, 512}, ovf_formats });
+
+static void IO_Image_Read_OVF(Benchmark::Run & run)
+{
+    int format = run.Arg(1);
+    auto state = IO_State(run.Arg(0));
+    IO_Image_Write(state.get(), bench_file.c_str(), format);
+    while (run.Keep_Running())
+        IO_Image_Read(state.get(), bench_file.c_str(), format);
+    std::remove(bench_file.c_str());
+    run.Set_Items_per_Iteration(state->active_image->nos);
+    run.Set_Label(Format_Label(format));
+}
+SPIRIT_BENCHMARK(IO_Image_Read_OVF)->Ranges({ {128, 512}, ovf_formats });
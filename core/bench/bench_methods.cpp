@@ -0,0 +1,175 @@
+#include <benchmark.hpp>
+#include <Spirit/State.h>
+#include <Spirit/Chain.h>
+#include <Spirit/Configurations.h>
+#include <Spirit/Geometry.h>
+#include <Spirit/Transitions.h>
+#include <data/State.hpp>
+#include <engine/Method_LLG.hpp>
+#include <engine/Method_MC.hpp>
+#include <engine/Method_GNEB.hpp>
+#include <engine/Method_MMF.hpp>
+
+/*
+    Single iterations of the Methods with each Solver (0: SIB, 1: Heun, 2: Depondt, 3: NCG, 4: VP)
+    on an n x n x 1 system (solvers.cfg). Only the iteration itself is timed: the Methods are not
+    run through `Iterate`, so that there is no setup, logging or output in the loop.
+    NCG calculates the dense Hessian in each iteration, so it is only run on small systems.
+*/
+
+using namespace Engine;
+
+namespace
+{
+    const std::vector<int> solvers{ 0, 1, 2, 4 };
+
+    // Gives access to the single steps of `Method::Iterate`. The hooks are private in the
+    //      specialized Methods, so they are called through the declarations of the base class,
+    //      which dispatch to the overrides.
+    template<typename Method_Type>
+    class Single_Iteration : public Method_Type
+    {
+    public:
+        using Method_Type::Method_Type;
+
+        void Step()
+        {
+            this->Hook_Pre_Iteration();
+            this->Iteration();
+            this->Hook_Post_Iteration();
+        }
+
+    private:
+        using Method::Hook_Pre_Iteration;
+        using Method::Iteration;
+        using Method::Hook_Post_Iteration;
+    };
+
+    template<typename Method_Type, typename... Args>
+    void Iterate(Benchmark::Run & run, Args && ... args)
+    {
+        Single_Iteration<Method_Type> method(std::forward<Args>(args)...);
+        while (run.Keep_Running())
+            method.Step();
+    }
+
+    template<template<Solver> class Method_Type, typename... Args>
+    void Iterate_with_Solver(Benchmark::Run & run, int solver, Args && ... args)
+    {
+        if (solver == 0)
+            Iterate<Method_Type<Solver::SIB>>(run, std::forward<Args>(args)...);
+        else if (solver == 1)
+            Iterate<Method_Type<Solver::Heun>>(run, std::forward<Args>(args)...);
+        else if (solver == 2)
+            Iterate<Method_Type<Solver::Depondt>>(run, std::forward<Args>(args)...);
+        else if (solver == 3)
+            Iterate<Method_Type<Solver::NCG>>(run, std::forward<Args>(args)...);
+        else
+            Iterate<Method_Type<Solver::VP>>(run, std::forward<Args>(args)...);
+    }
+
+    std::string Solver_Label(int solver)
+    {
+        const std::vector<std::string> names{ "SIB", "Heun", "Depondt", "NCG", "VP" };
+        return names[solver];
+    }
+
+    std::shared_ptr<State> Method_State(int n)
+    {
+        auto state = std::shared_ptr<State>(State_Setup(Benchmark::Input_File("solvers.cfg").c_str(), true), State_Delete);
+        int n_cells[3]{ n, n, 1 };
+        Geometry_Set_N_Cells(state.get(), n_cells);
+        Configuration_PlusZ(state.get());
+        Configuration_Skyrmion(state.get(), n/4, 1, -90, false, false, false);
+        return state;
+    }
+
+    // Chain of n_images, homogeneous transition from the skyrmion to the ferromagnet
+    std::shared_ptr<State> Transition_State(int n, int n_images)
+    {
+        auto state = Method_State(n);
+        Chain_Image_to_Clipboard(state.get());
+        for (int i = 1; i < n_images; ++i)
+            Chain_Push_Back(state.get());
+        Chain_Jump_To_Image(state.get(), n_images-1);
+        Configuration_PlusZ(state.get());
+        Transition_Homogeneous(state.get(), 0, n_images-1);
+        return state;
+    }
+}
+
+static void Method_LLG_Iteration(Benchmark::Run & run)
+{
+    int solver = run.Arg(1);
+    auto state = Method_State(run.Arg(0));
+    Iterate_with_Solver<Method_LLG>(run, solver, state->active_image, 0, 0);
+    run.Set_Items_per_Iteration(state->active_image->nos);
+    run.Set_Label(Solver_Label(solver));
+}
+SPIRIT_BENCHMARK(Method_LLG_Iteration)->Ranges({ {32, 128}, solvers })->Args({16, 3});
+
+static void Method_MC_Iteration(Benchmark::Run & run)
+{
+    auto state = Method_State(run.Arg(0));
+    state->active_image->mc_parameters->temperature = 10;
+    Iterate<Method_MC>(run, state->active_image, 0, 0);
+    run.Set_Items_per_Iteration(state->active_image->nos);
+}
+SPIRIT_BENCHMARK(Method_MC_Iteration)->Arg(16)->Arg(32);
+
+// The second argument is the number of images
+static void Method_GNEB_Iteration(Benchmark::Run & run)
+{
+    int n_images = run.Arg(1);
+    int solver = run.Arg(2);
+    auto state = Transition_State(run.Arg(0), n_images);
+    Iterate_with_Solver<Method_GNEB>(run, solver, state->active_chain, 0);
+    run.Set_Items_per_Iteration(n_images * state->active_image->nos);
+    run.Set_Label(Solver_Label(solver));
+}
+SPIRIT_BENCHMARK(Method_GNEB_Iteration)->Ranges({ {32}, {5, 20}, solvers });
+
+static void Method_MMF_Iteration(Benchmark::Run & run)
+{
+    int solver = run.Arg(1);
+    auto state = Method_State(run.Arg(0));
+    // The Hessian is dense, so only small systems are feasible
+    Iterate_with_Solver<Method_MMF>(run, solver, state->collection, 0);
+    run.Set_Items_per_Iteration(state->active_image->nos);
+    run.Set_Label(Solver_Label(solver));
+}
+SPIRIT_BENCHMARK(Method_MMF_Iteration)->Ranges({ {8, 16}, {0, 1, 2, 3, 4} });
+
+
+/*
+    Fixed workloads of the performance regression tests (ctest label "perf"), which compare
+    their throughput to a stored baseline (see the option SPIRIT_TEST_PERFORMANCE):
+        LLG with the SIB solver on 316 x 316 (~10^5) spins
+        GNEB with the SIB solver on 20 images of 100 x 100 spins
+        MC sweeps on 32 x 32 spins, as the MC iteration does not scale to larger systems
+*/
+static void Regression_LLG_SIB(Benchmark::Run & run)
+{
+    auto state = Method_State(run.Arg(0));
+    Iterate<Method_LLG<Solver::SIB>>(run, state->active_image, 0, 0);
+    run.Set_Items_per_Iteration(state->active_image->nos);
+}
+SPIRIT_BENCHMARK(Regression_LLG_SIB)->Arg(316);
+
+static void Regression_GNEB_SIB(Benchmark::Run & run)
+{
+    int n_images = run.Arg(1);
+    auto state = Transition_State(run.Arg(0), n_images);
+    Iterate<Method_GNEB<Solver::SIB>>(run, state->active_chain, 0);
+    run.Set_Items_per_Iteration(n_images * state->active_image->nos);
+}
+SPIRIT_BENCHMARK(Regression_GNEB_SIB)->Args({100, 20});
+
+static void Regression_MC(Benchmark::Run & run)
+{
+    auto state = Method_State(run.Arg(0));
+    state->active_image->mc_parameters->temperature = 10;
+    Iterate<Method_MC>(run, state->active_image, 0, 0);
+    run.Set_Items_per_Iteration(state->active_image->nos);
+}
+SPIRIT_BENCHMARK(Regression_MC)->Arg(32);
@@ -0,0 +1,87 @@
+#include <benchmark.hpp>
+#include <engine/Vectormath.hpp>
+
+/*
+    The primitives of Vectormath on fields of 2^10, 2^14 and 2^18 vectors
+*/
+
+using namespace Engine;
+
+namespace
+{
+    vectorfield Random_Field(int n, int seed)
+    {
+        std::mt19937 prng(seed);
+        vectorfield vf(n);
+        Vectormath::get_random_vectorfield_unitsphere(prng, vf);
+        return vf;
+    }
+}
+
+static void Vectormath_fill(Benchmark::Run & run)
+{
+    int n = run.Arg(0);
+    vectorfield vf(n);
+    while (run.Keep_Running())
+        Vectormath::fill(vf, Vector3{0, 0, 1});
+    run.Set_Items_per_Iteration(n);
+}
+SPIRIT_BENCHMARK(Vectormath_fill)->Arg(1<<10)->Arg(1<<14)->Arg(1<<18);
+
+static void Vectormath_normalize_vectors(Benchmark::Run & run)
+{
+    int n = run.Arg(0);
+    auto vf = Random_Field(n, 1);
+    while (run.Keep_Running())
+        Vectormath::normalize_vectors(vf);
+    run.Set_Items_per_Iteration(n);
+}
+SPIRIT_BENCHMARK(Vectormath_normalize_vectors)->Arg(1<<10)->Arg(1<<14)->Arg(1<<18);
+
+static void Vectormath_dot(Benchmark::Run & run)
+{
+    int n = run.Arg(0);
+    auto vf1 = Random_Field(n, 1);
+    auto vf2 = Random_Field(n, 2);
+    // Keeps the compiler from discarding the results
+    volatile scalar result = 0;
+    while (run.Keep_Running())
+        result = Vectormath::dot(vf1, vf2);
+    run.Set_Items_per_Iteration(n);
+}
+SPIRIT_BENCHMARK(Vectormath_dot)->Arg(1<<10)->Arg(1<<14)->Arg(1<<18);
+
+static void Vectormath_add_c_a(Benchmark::Run & run)
+{
+    int n = run.Arg(0);
+    auto vf = Random_Field(n, 1);
+    vectorfield out(n, Vector3::Zero());
+    while (run.Keep_Running())
+        Vectormath::add_c_a(0.5, vf, out);
+    run.Set_Items_per_Iteration(n);
+}
+SPIRIT_BENCHMARK(Vectormath_add_c_a)->Arg(1<<10)->Arg(1<<14)->Arg(1<<18);
+
+static void Vectormath_set_c_cross(Benchmark::Run & run)
+{
+    int n = run.Arg(0);
+    auto vf1 = Random_Field(n, 1);
+    auto vf2 = Random_Field(n, 2);
+    vectorfield out(n);
+    while (run.Keep_Running())
+        Vectormath::set_c_cross(0.5, vf1, vf2, out);
+    run.Set_Items_per_Iteration(n);
+}
+SPIRIT_BENCHMARK(Vectormath_set_c_cross)->Arg(1<<10)->Arg(1<<14)->Arg(1<<18);
+
+static void Vectormath_max_abs_component(Benchmark::Run & run)
+{
+    int n = run.Arg(0);
+    auto vf = Random_Field(n, 1);
+    // Keeps the compiler from discarding the results
+    volatile scalar result = 0;
+    while (run.Keep_Running())
+        result = Vectormath::max_abs_component(vf);
+    run.Set_Items_per_Iteration(n);
+}
+SPIRIT_BENCHMARK(Vectormath_max_abs_component)->Arg(1<<10)->Arg(1<<14)->Arg(1<<18);
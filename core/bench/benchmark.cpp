@@ -0,0 +1,159 @@
+#include <benchmark.hpp>
+
+#include <stdexcept>
+
+namespace Benchmark
+{
+    Run::Run(const std::vector<int> & args, scalar min_time) :
+        args(args), min_time(min_time), items_per_iteration(0), label(""),
+        warmed_up(false), timing(false), paused(false), iterations(0),
+        elapsed(std::chrono::steady_clock::duration::zero())
+    {
+    }
+
+    bool Run::Keep_Running()
+    {
+        auto now = std::chrono::steady_clock::now();
+
+        // The first pass is a warm-up which is not timed, so that e.g. lazily allocated buffers
+        //      do not count
+        if (!this->warmed_up)
+        {
+            this->warmed_up = true;
+            return true;
+        }
+
+        if (this->timing)
+        {
+            if (!this->paused)
+                this->elapsed += now - this->start;
+            ++this->iterations;
+            if (std::chrono::duration<scalar>(this->elapsed).count() >= this->min_time)
+            {
+                this->timing = false;
+                return false;
+            }
+        }
+
+        this->timing = true;
+        this->paused = false;
+        this->start = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    int Run::Arg(int i) const
+    {
+        if (i < 0 || i >= (int)this->args.size())
+            throw std::out_of_range("Benchmark::Run::Arg: the benchmark has no argument " + std::to_string(i));
+        return this->args[i];
+    }
+
+    void Run::Pause_Timing()
+    {
+        if (!this->timing || this->paused)
+            return;
+        this->elapsed += std::chrono::steady_clock::now() - this->start;
+        this->paused = true;
+    }
+
+    void Run::Resume_Timing()
+    {
+        if (!this->timing || !this->paused)
+            return;
+        this->paused = false;
+        this->start = std::chrono::steady_clock::now();
+    }
+
+    void Run::Set_Items_per_Iteration(scalar items)
+    {
+        this->items_per_iteration = items;
+    }
+
+    void Run::Set_Label(const std::string & label)
+    {
+        this->label = label;
+    }
+
+    long long Run::Iterations() const
+    {
+        return this->iterations;
+    }
+
+    scalar Run::Seconds_per_Iteration() const
+    {
+        if (this->iterations == 0)
+            return 0;
+        return std::chrono::duration<scalar>(this->elapsed).count() / this->iterations;
+    }
+
+    scalar Run::Items_per_Second() const
+    {
+        scalar seconds = this->Seconds_per_Iteration();
+        if (seconds <= 0)
+            return 0;
+        return this->items_per_iteration / seconds;
+    }
+
+    const std::string & Run::Label() const
+    {
+        return this->label;
+    }
+
+
+    Benchmark::Benchmark(const std::string & name, std::function<void(Run &)> function) :
+        name(name), function(function)
+    {
+    }
+
+    Benchmark * Benchmark::Arg(int arg)
+    {
+        this->variants.push_back({arg});
+        return this;
+    }
+
+    Benchmark * Benchmark::Args(const std::vector<int> & args)
+    {
+        this->variants.push_back(args);
+        return this;
+    }
+
+    Benchmark * Benchmark::Ranges(const std::vector<std::vector<int>> & ranges)
+    {
+        std::vector<std::vector<int>> combinations{ {} };
+        for (auto & range : ranges)
+        {
+            std::vector<std::vector<int>> extended;
+            for (auto & combination : combinations)
+            {
+                for (int value : range)
+                {
+                    extended.push_back(combination);
+                    extended.back().push_back(value);
+                }
+            }
+            combinations = extended;
+        }
+        for (auto & combination : combinations)
+            this->variants.push_back(combination);
+        return this;
+    }
+
+
+    std::vector<std::unique_ptr<Benchmark>> & Registered()
+    {
+        // Function-local, so that it exists before the benchmarks of any file are registered
+        static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+        return benchmarks;
+    }
+
+    Benchmark * Register(const std::string & name, std::function<void(Run &)> function)
+    {
+        Registered().push_back(std::unique_ptr<Benchmark>(new Benchmark(name, function)));
+        return Registered().back().get();
+    }
+
+    std::string Input_File(const std::string & name)
+    {
+        return std::string(SPIRIT_BENCH_INPUT_DIR) + "/" + name;
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef SPIRIT_BENCHMARK_H
+#define SPIRIT_BENCHMARK_H
+
+#include "Spirit_Defines.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+    A small benchmark harness in the style of Google Benchmark.
+    A benchmark is a function which prepares its workload and then runs it in a loop
+        while( run.Keep_Running() ) { ... }
+    The first pass of the loop is a warm-up, the following passes are timed until the minimum
+    time is reached. The function reports how many spins (or other items) one pass processes,
+    from which the throughput is calculated.
+*/
+namespace Benchmark
+{
+    class Run
+    {
+    public:
+        Run(const std::vector<int> & args, scalar min_time);
+
+        // Whether to do another pass of the benchmark loop
+        bool Keep_Running();
+
+        // Argument of the current variant of the benchmark
+        int Arg(int i) const;
+
+        // Exclude e.g. the reset of the workload inside the loop from the timing
+        void Pause_Timing();
+        void Resume_Timing();
+
+        // Number of items (usually spins) processed in one pass of the loop
+        void Set_Items_per_Iteration(scalar items);
+        // Description of the variant, e.g. the Hamiltonian or solver
+        void Set_Label(const std::string & label);
+
+        // Results
+        long long Iterations() const;
+        scalar Seconds_per_Iteration() const;
+        scalar Items_per_Second() const;
+        const std::string & Label() const;
+
+    private:
+        std::vector<int> args;
+        scalar min_time;
+        scalar items_per_iteration;
+        std::string label;
+
+        bool warmed_up;
+        bool timing;
+        bool paused;
+        long long iterations;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::duration elapsed;
+    };
+
+    class Benchmark
+    {
+    public:
+        Benchmark(const std::string & name, std::function<void(Run &)> function);
+
+        // Add a variant of the benchmark with the given arguments
+        Benchmark * Arg(int arg);
+        Benchmark * Args(const std::vector<int> & args);
+        // Add a variant for each combination of the given values of the arguments
+        Benchmark * Ranges(const std::vector<std::vector<int>> & ranges);
+
+        std::string name;
+        std::function<void(Run &)> function;
+        std::vector<std::vector<int>> variants;
+    };
+
+    // Register a benchmark, which is run by spirit_bench
+    Benchmark * Register(const std::string & name, std::function<void(Run &)> function);
+    // All registered benchmarks, in the order of registration
+    std::vector<std::unique_ptr<Benchmark>> & Registered();
+
+    // Path of an input file of the unit tests (core/test/input)
+    std::string Input_File(const std::string & name);
+}
+
+#define SPIRIT_BENCHMARK_CONCAT_(a, b) a##b
+#define SPIRIT_BENCHMARK_CONCAT(a, b) SPIRIT_BENCHMARK_CONCAT_(a, b)
+// Register a benchmark function, e.g. SPIRIT_BENCHMARK(Gradient)->Arg(32)->Arg(64);
+#define SPIRIT_BENCHMARK(function) \
+    static Benchmark::Benchmark * SPIRIT_BENCHMARK_CONCAT(spirit_benchmark_, __LINE__) = \
+        Benchmark::Register(#function, function)
+
+#endif
@@ -0,0 +1,333 @@
+#include <benchmark.hpp>
+#include <utility/Version.hpp>
+
+#include <fmt/format.h>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+
+/*
+    spirit_bench [--filter=<regex>] [--min_time=<seconds>] [--json=<file>] [--list]
+                 [--baseline=<file> [--tolerance=<fraction>]] [--update_baseline=<file>]
+
+    Runs all registered benchmarks whose name (including the arguments, e.g. "Gradient/64/1")
+    matches the filter, each for at least min_time seconds, and prints a table of the results.
+    With --json the results are also written to the given file in a machine-readable form.
+
+    With --baseline the results are compared to those of a previous --json or --update_baseline
+    run. A benchmark which is slower than its baseline by more than the tolerance (default 0.2,
+    i.e. 20%) is a regression, which makes spirit_bench return 1. If none of the benchmarks
+    has a baseline, it returns 77 (which ctest can be told to treat as a skipped test).
+    With --update_baseline the results replace those of the same benchmarks in the given file.
+*/
+
+namespace
+{
+    struct Result
+    {
+        std::string name;
+        std::string label;
+        long long iterations;
+        scalar seconds_per_iteration;
+        scalar items_per_second;
+    };
+
+    std::string Variant_Name(const Benchmark::Benchmark & benchmark, const std::vector<int> & args)
+    {
+        std::string name = benchmark.name;
+        for (int arg : args)
+            name += "/" + std::to_string(arg);
+        return name;
+    }
+
+    std::string Format_Time(scalar seconds)
+    {
+        if (seconds < 1e-6)
+            return fmt::format("{:.1f} ns", seconds * 1e9);
+        else if (seconds < 1e-3)
+            return fmt::format("{:.2f} us", seconds * 1e6);
+        else if (seconds < 1)
+            return fmt::format("{:.2f} ms", seconds * 1e3);
+        return fmt::format("{:.3f} s", seconds);
+    }
+
+    std::string Format_Rate(scalar items_per_second)
+    {
+        if (items_per_second <= 0)
+            return "";
+        else if (items_per_second >= 1e9)
+            return fmt::format("{:.2f} G/s", items_per_second * 1e-9);
+        else if (items_per_second >= 1e6)
+            return fmt::format("{:.2f} M/s", items_per_second * 1e-6);
+        else if (items_per_second >= 1e3)
+            return fmt::format("{:.2f} k/s", items_per_second * 1e-3);
+        return fmt::format("{:.2f} /s", items_per_second);
+    }
+
+    std::string Json_String(const std::string & s)
+    {
+        std::string escaped = "\"";
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\')
+                escaped += std::string("\\") + c;
+            else if (c == '\n')
+                escaped += "\\n";
+            else
+                escaped += c;
+        }
+        return escaped + "\"";
+    }
+
+    std::string Json_Unescape(const std::string & s)
+    {
+        std::string unescaped;
+        for (unsigned int i = 0; i < s.size(); ++i)
+        {
+            if (s[i] == '\\' && i + 1 < s.size())
+            {
+                ++i;
+                unescaped += s[i] == 'n' ? '\n' : s[i];
+            }
+            else
+                unescaped += s[i];
+        }
+        return unescaped;
+    }
+
+    // Value of a field of a flat JSON object, with the quotes of strings removed
+    std::string Json_Field(const std::string & object, const std::string & key)
+    {
+        std::regex field("\"" + key + "\"\\s*:\\s*(\"((?:[^\"\\\\]|\\\\.)*)\"|[^,}\\s]+)");
+        std::smatch match;
+        if (!std::regex_search(object, match, field))
+            return "";
+        if (match[2].matched)
+            return Json_Unescape(match[2].str());
+        return match[1].str();
+    }
+
+    // Read the results written by Write_Json. Returns false if the file cannot be read.
+    bool Read_Json(const std::string & file, std::vector<Result> & results)
+    {
+        std::ifstream in(file);
+        if (!in.good())
+            return false;
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string content = buffer.str();
+
+        // The benchmarks are the objects which have a name and no nested objects
+        std::regex object("\\{[^{}]*\\}");
+        for (auto it = std::sregex_iterator(content.begin(), content.end(), object); it != std::sregex_iterator(); ++it)
+        {
+            std::string text = it->str();
+            std::string name = Json_Field(text, "name");
+            if (name.empty())
+                continue;
+            results.push_back({ name, Json_Field(text, "label"), std::atoll(Json_Field(text, "iterations").c_str()),
+                std::atof(Json_Field(text, "seconds_per_iteration").c_str()),
+                std::atof(Json_Field(text, "items_per_second").c_str()) });
+        }
+        return true;
+    }
+
+    // Compare the results to the baseline and print a table. Returns the exit code.
+    int Compare(const std::vector<Result> & results, const std::vector<Result> & baseline, scalar tolerance)
+    {
+        std::cout << std::endl << fmt::format("{:<48} {:>14} {:>14} {:>9}", "Comparison to baseline", "Baseline", "Time", "Speed") << std::endl
+                  << std::string(100, '-') << std::endl;
+
+        int n_compared = 0;
+        int n_regressions = 0;
+        for (auto & result : results)
+        {
+            auto reference = std::find_if(baseline.begin(), baseline.end(),
+                [&](const Result & r) { return r.name == result.name; });
+            if (reference == baseline.end() || reference->seconds_per_iteration <= 0)
+            {
+                std::cout << fmt::format("{:<48} {:>14}", result.name, "none") << std::endl;
+                continue;
+            }
+
+            // Relative speed, i.e. 0.5 is twice as slow as the baseline
+            scalar speed = reference->seconds_per_iteration / result.seconds_per_iteration;
+            bool regression = speed < 1 - tolerance;
+            std::cout << fmt::format("{:<48} {:>14} {:>14} {:>8.1f}%  {}", result.name,
+                Format_Time(reference->seconds_per_iteration), Format_Time(result.seconds_per_iteration),
+                100 * (speed - 1), regression ? "REGRESSION" : "") << std::endl;
+            ++n_compared;
+            if (regression)
+                ++n_regressions;
+        }
+
+        std::cout << std::endl;
+        if (n_compared == 0)
+        {
+            std::cout << "None of the benchmarks has a baseline" << std::endl;
+            return 77;
+        }
+        if (n_regressions > 0)
+        {
+            std::cout << fmt::format("{} of {} benchmarks are slower than their baseline by more than {}%",
+                n_regressions, n_compared, 100 * tolerance) << std::endl;
+            return 1;
+        }
+        std::cout << fmt::format("All {} benchmarks are within {}% of their baseline", n_compared, 100 * tolerance) << std::endl;
+        return 0;
+    }
+
+    void Write_Json(const std::string & file, const std::vector<Result> & results)
+    {
+        std::time_t now = std::time(nullptr);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        int n_threads = 1;
+        #ifdef _OPENMP
+        n_threads = omp_get_max_threads();
+        #endif
+
+        std::ofstream out(file);
+        out << "{\n";
+        out << "  \"context\": {\n";
+        out << "    \"date\": " << Json_String(date) << ",\n";
+        out << "    \"version\": " << Json_String(Utility::version_full) << ",\n";
+        out << "    \"scalar\": " << Json_String(sizeof(scalar) == sizeof(float) ? "float" : "double") << ",\n";
+        out << "    \"threads\": " << n_threads << "\n";
+        out << "  },\n";
+        out << "  \"benchmarks\": [\n";
+        for (unsigned int i = 0; i < results.size(); ++i)
+        {
+            auto & result = results[i];
+            out << "    {\n";
+            out << "      \"name\": " << Json_String(result.name) << ",\n";
+            out << "      \"label\": " << Json_String(result.label) << ",\n";
+            out << "      \"iterations\": " << result.iterations << ",\n";
+            out << "      \"seconds_per_iteration\": " << fmt::format("{:.9g}", result.seconds_per_iteration) << ",\n";
+            out << "      \"items_per_second\": " << fmt::format("{:.9g}", result.items_per_second) << "\n";
+            out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n";
+        out << "}\n";
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    std::string filter = ".*";
+    scalar min_time = 0.5;
+    std::string json_file = "";
+    std::string baseline_file = "";
+    std::string update_file = "";
+    scalar tolerance = 0.2;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.find("--filter=") == 0)
+            filter = arg.substr(9);
+        else if (arg.find("--min_time=") == 0)
+            min_time = std::atof(arg.substr(11).c_str());
+        else if (arg.find("--json=") == 0)
+            json_file = arg.substr(7);
+        else if (arg == "--list")
+            list = true;
+        else if (arg.find("--baseline=") == 0)
+            baseline_file = arg.substr(11);
+        else if (arg.find("--tolerance=") == 0)
+            tolerance = std::atof(arg.substr(12).c_str());
+        else if (arg.find("--update_baseline=") == 0)
+            update_file = arg.substr(18);
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--filter=<regex>] [--min_time=<seconds>] [--json=<file>] [--list]" << std::endl
+                      << "       [--baseline=<file> [--tolerance=<fraction>]] [--update_baseline=<file>]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Without a baseline file the comparison is skipped
+    std::vector<Result> baseline;
+    if (!baseline_file.empty() && !Read_Json(baseline_file, baseline))
+        std::cerr << "Could not read the baseline " << baseline_file << std::endl;
+
+    std::regex pattern(filter);
+    std::vector<Result> results;
+
+    if (!list)
+        std::cout << fmt::format("{:<48} {:>12} {:>14} {:>14}  {}", "Benchmark", "Iterations", "Time", "Spins/s", "Label") << std::endl
+                  << std::string(100, '-') << std::endl;
+
+    for (auto & benchmark : Benchmark::Registered())
+    {
+        auto variants = benchmark->variants;
+        if (variants.empty())
+            variants.push_back({});
+
+        for (auto & args : variants)
+        {
+            std::string name = Variant_Name(*benchmark, args);
+            if (!std::regex_search(name, pattern))
+                continue;
+
+            if (list)
+            {
+                std::cout << name << std::endl;
+                continue;
+            }
+
+            Benchmark::Run run(args, min_time);
+            try
+            {
+                benchmark->function(run);
+            }
+            catch (const std::exception & ex)
+            {
+                std::cerr << name << " failed: " << ex.what() << std::endl;
+                return 1;
+            }
+
+            results.push_back({name, run.Label(), run.Iterations(), run.Seconds_per_Iteration(), run.Items_per_Second()});
+            std::cout << fmt::format("{:<48} {:>12} {:>14} {:>14}  {}", name, run.Iterations(),
+                Format_Time(run.Seconds_per_Iteration()), Format_Rate(run.Items_per_Second()), run.Label()) << std::endl;
+        }
+    }
+
+    if (!json_file.empty())
+        Write_Json(json_file, results);
+
+    // Keep the baselines of the benchmarks which were not run
+    if (!update_file.empty() && !list)
+    {
+        std::vector<Result> updated;
+        Read_Json(update_file, updated);
+        for (auto & result : results)
+        {
+            auto entry = std::find_if(updated.begin(), updated.end(),
+                [&](const Result & r) { return r.name == result.name; });
+            if (entry != updated.end())
+                *entry = result;
+            else
+                updated.push_back(result);
+        }
+        Write_Json(update_file, updated);
+        std::cout << fmt::format("Updated {} baselines in {}", results.size(), update_file) << std::endl;
+    }
+
+    if (!baseline_file.empty() && !list)
+        return Compare(results, baseline, tolerance);
+
+    return 0;
+}
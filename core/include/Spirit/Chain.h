@@ -5,6 +5,8 @@
 
 struct State;
 
+#include "Spirit_Defines.h"
+
 // Info
 DLLEXPORT int Chain_Get_Index(State * state) noexcept;
 DLLEXPORT int Chain_Get_NOI(State * state, int idx_chain=-1) noexcept;
@@ -28,9 +30,15 @@ DLLEXPORT void Chain_Get_Rx(State * state, float * Rx, int idx_chain = -1) noexc
 DLLEXPORT void Chain_Get_Rx_Interpolated(State * state, float * Rx_interpolated, int idx_chain = -1) noexcept;
 DLLEXPORT void Chain_Get_Energy(State * state, float * energy, int idx_chain = -1) noexcept;
 DLLEXPORT void Chain_Get_Energy_Interpolated(State * state, float * E_interpolated, int idx_chain = -1) noexcept;
+// Copy the spin directions of all images ([noi][nos][3]) in a single call
+DLLEXPORT void Chain_Get_Spin_Directions(State * state, scalar * spins, int idx_chain = -1) noexcept;
 // TODO: energy array getter
 // std::vector<std::vector<float>> Chain_Get_Energy_Array_Interpolated(State * state, int idx_chain=-1) noexcept;
 
+// Set the spin directions of all images ([noi][nos][3]), which are normalized and pinned.
+// The energies and reaction coordinates of the images are updated accordingly.
+DLLEXPORT void Chain_Set_Spin_Directions(State * state, const scalar * spins, int idx_chain = -1) noexcept;
+
 // Update Data (primarily for plots)
 DLLEXPORT void Chain_Update_Data(State * state, int idx_chain=-1) noexcept;
 DLLEXPORT void Chain_Setup_Data(State * state, int idx_chain=-1) noexcept;
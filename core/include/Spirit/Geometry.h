@@ -18,12 +18,21 @@ typedef enum
     Bravais_Lattice_FCC         = 6
 } Bravais_Lattice_Type;
 
+// Define how spin configurations are mapped onto a resized lattice
+typedef enum
+{
+    Geometry_Remap_Tile   = 0,  // Repeat the previous configuration periodically
+    Geometry_Remap_Centre = 1   // Place the previous configuration in the centre and extend its edges
+} Geometry_Remap_Mode;
+
 // Set the type of Bravais lattice. Can be e.g. "sc" or "bcc"
 DLLEXPORT void Geometry_Set_Bravais_Lattice(State *state, const char * bravais_lattice) noexcept;
-// Set the number of basis cells in the three translation directions
-DLLEXPORT void Geometry_Set_N_Cells(State * state, int n_cells[3]) noexcept;
-// Set the number and positions of atoms in a basis cell
-DLLEXPORT void Geometry_Set_Cell_Atoms(State *state, int n_atoms, float ** atoms) noexcept;
+// Set the number of basis cells in the three translation directions.
+//      The spin configurations of all images are mapped onto the new lattice according to remap_mode.
+DLLEXPORT void Geometry_Set_N_Cells(State * state, int n_cells[3], int remap_mode=Geometry_Remap_Tile) noexcept;
+// Set the number and positions of atoms in a basis cell.
+//      The spin configurations of all images are mapped onto the new lattice according to remap_mode.
+DLLEXPORT void Geometry_Set_Cell_Atoms(State *state, int n_atoms, float ** atoms, int remap_mode=Geometry_Remap_Tile) noexcept;
 // Set the types of the atoms in a basis cell
 DLLEXPORT void Geometry_Set_Cell_Atom_Types(State *state, float lattice_constant) noexcept;
 // Set the bravais vectors
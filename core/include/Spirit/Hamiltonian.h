@@ -4,19 +4,36 @@
 #include "DLL_Define_Export.h"
 struct State;
 
+#include "Spirit_Defines.h"
+
+// How the dipole-dipole interaction is evaluated
+typedef enum
+{
+    Hamiltonian_DDI_Cutoff = 0,  // Direct sum over all pairs within the DDI radius
+    Hamiltonian_DDI_Ewald  = 1   // Sum over all spins and all periodic images (Ewald summation)
+} Hamiltonian_DDI_Method;
+
 // Set the Hamiltonian's parameters
 DLLEXPORT void Hamiltonian_Set_Boundary_Conditions(State *state, const bool* periodical, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Set_mu_s(State *state, float mu_s, int idx_image=-1, int idx_chain=-1) noexcept;
+// Set the magnetic moment of each atom of the basis cell (n_cell_atoms values). The energy and
+// effective field are updated accordingly.
+DLLEXPORT void Hamiltonian_Set_mu_s_per_Cell_Atom(State *state, const scalar * mu_s, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Set_Field(State *state, float magnitude, const float* normal, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Set_Anisotropy(State *state, float magnitude, const float* normal, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Set_Exchange(State *state, int n_shells, const float* jij, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Set_DMI(State *state, int n_shells, const float * dij, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Set_DDI(State *state, float radius, int idx_image=-1, int idx_chain=-1) noexcept;
+// Set the summation method of the DDI. With Hamiltonian_DDI_Ewald the DDI radius is not used.
+DLLEXPORT void Hamiltonian_Set_DDI_Method(State *state, int method, int idx_image=-1, int idx_chain=-1) noexcept;
 
 // Get the Hamiltonian's parameters
 DLLEXPORT const char * Hamiltonian_Get_Name(State * state, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Get_Boundary_Conditions(State *state, bool * periodical, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Get_mu_s(State *state, float * mu_s, int idx_image=-1, int idx_chain=-1) noexcept;
+// Pointer to the magnetic moment of each atom of the basis cell (n_cell_atoms values), nullptr if
+// the Hamiltonian has none
+DLLEXPORT scalar * Hamiltonian_Get_mu_s_per_Cell_Atom(State *state, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Get_Field(State *state, float * magnitude, float * normal, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Get_Anisotropy(State *state, float * magnitude, float * normal, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Get_Exchange(State *state, int * n_shells, float * jij, int idx_image=-1, int idx_chain=-1) noexcept;
@@ -24,6 +41,7 @@ DLLEXPORT int  Hamiltonian_Get_Exchange_N_Pairs(State *state, int idx_image=-1,
 DLLEXPORT void Hamiltonian_Get_Exchange_Pairs(State *state, float * idx[2], float * translations[3], float * Jij, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Get_DMI(State *state, int * n_shells, float * dij, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void Hamiltonian_Get_DDI(State *state, float * radius, int idx_image=-1, int idx_chain=-1) noexcept;
+DLLEXPORT int  Hamiltonian_Get_DDI_Method(State *state, int idx_image=-1, int idx_chain=-1) noexcept;
 
 #include "DLL_Undefine_Export.h"
 #endif
\ No newline at end of file
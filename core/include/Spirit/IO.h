@@ -12,6 +12,13 @@ struct State;
 #define IO_Fileformat_OVF_bin8      4   // 
 #define IO_Fileformat_OVF_bin4      5   // OOMF Vector Field (OVF2.0) file format
 #define IO_Fileformat_OVF_text      6   // 
+#define IO_Fileformat_OVF_bin4_zlib 7   // OVF with zlib-compressed 4 byte binary data
+#define IO_Fileformat_OVF_oct16     8   // OVF with directions as two 2 byte integers (octahedral)
+
+// Define the encodings of the spins in binary trajectory files
+#define IO_Trajectory_Float64       0   // 8 byte floating point values
+#define IO_Trajectory_Float32       1   // 4 byte floating point values
+#define IO_Trajectory_Quantised16   2   // 2 byte integers, renormalised when read
 
 // From Config File
 DLLEXPORT int IO_System_From_Config( State * state, const char * file, int idx_image=-1,
@@ -24,6 +31,7 @@ DLLEXPORT void IO_Positions_Write( State * state, const char *file, int format=I
 ///// TODO: give bool returns for these functions to indicate success??
 
 // Images
+// Number of images in a file. Only the OVF formats are supported, otherwise -1 is returned
 DLLEXPORT int IO_N_Images_In_File( State *state, const char *file, 
                                    int format=IO_Fileformat_Regular, int idx_chain=-1 ) noexcept;
 DLLEXPORT void IO_Image_Read( State *state, const char *file, int format=IO_Fileformat_Regular, 
@@ -42,8 +50,10 @@ DLLEXPORT void IO_Chain_Write( State *state, const char *file, int format,
 DLLEXPORT void IO_Chain_Append( State *state, const char *file, int format, 
                                 const char* comment = "-", int idx_chain=-1 ) noexcept;
 
-// Save the spin-resolved energy contributions of a spin system
-DLLEXPORT void IO_Image_Write_Energy_per_Spin( State *state, const char *file, int idx_image=-1, 
+// Save the spin-resolved energy contributions of a spin system, as a text table
+// (IO_Fileformat_Regular) or as binary data in one of the OVF formats
+DLLEXPORT void IO_Image_Write_Energy_per_Spin( State *state, const char *file, 
+                                               int format=IO_Fileformat_Regular, int idx_image=-1, 
                                                int idx_chain = -1 ) noexcept;
 // Save the Energy contributions of a spin system
 DLLEXPORT void IO_Image_Write_Energy( State *state, const char *file, int idx_image=-1, 
@@ -61,5 +71,22 @@ DLLEXPORT void IO_Collection_Read( State *state, const char *file, int idx_image
 DLLEXPORT void IO_Collection_Write( State *state, const char *file, int idx_image=-1, 
                                     int idx_chain=-1 ) noexcept;
 
+// Checkpoints of the whole State, from which a simulation can be continued
+DLLEXPORT void IO_State_Checkpoint( State *state, const char *file ) noexcept;
+DLLEXPORT void IO_State_Restore( State *state, const char *file ) noexcept;
+
+// Binary trajectories, to which frames (iteration, time, energies and spins) are appended and
+// from which any frame can be read directly. The encoding and whether energies are stored are
+// chosen when the file is created.
+DLLEXPORT void IO_Image_Trajectory_Append( State *state, const char *file, int iteration=0, float time=0,
+                                           int encoding=IO_Trajectory_Float32, bool energies=true,
+                                           int idx_image=-1, int idx_chain=-1 ) noexcept;
+DLLEXPORT int IO_Trajectory_N_Frames( State *state, const char *file ) noexcept;
+// Read the spins of a frame into an image. Returns the iteration of the frame and writes its time
+// and total energy (0 if the file contains no energies).
+DLLEXPORT int IO_Image_Trajectory_Read_Frame( State *state, const char *file, int idx_frame,
+                                              float *time=nullptr, float *energy=nullptr,
+                                              int idx_image=-1, int idx_chain=-1 ) noexcept;
+
 #include "DLL_Undefine_Export.h"
 #endif
\ No newline at end of file
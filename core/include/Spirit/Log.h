@@ -35,13 +35,14 @@ struct State;
 //      General functions
 // Send a Log message
 DLLEXPORT void Log_Send(State *state, Spirit_Log_Level level, Spirit_Log_Sender sender, const char * message, int idx_image=-1, int idx_chain=-1) noexcept;
-// Get the entries from the Log and write new number of entries into given int
+// Get the entries from the Log with index in [idx_first, idx_last) (idx_last=-1: up to the newest
+// entry). Only the most recent entries are kept, older ones are skipped.
 // TODO: can this be written in a C-style way?
 namespace Utility
 {
     struct LogEntry;
 }
-std::vector<Utility::LogEntry> Log_Get_Entries(State *state) noexcept;
+std::vector<Utility::LogEntry> Log_Get_Entries(State *state, int idx_first=0, int idx_last=-1) noexcept;
 // Append the Log to it's file
 DLLEXPORT void Log_Append(State *state) noexcept;
 // Dump the Log into it's file
@@ -11,4 +11,14 @@ DLLEXPORT void Quantity_Get_Magnetization(State * state, float m[3], int idx_ima
 // Topological Charge
 DLLEXPORT float Quantity_Get_Topological_Charge(State * state, int idx_image=-1, int idx_chain=-1) noexcept;
 
+// Topological Charge of each triangle of the (periodically wrapped) triangulation of a 2D system.
+//      Returns the number of triangles. If not nullptr, charge_density is filled with one value
+//      per triangle and triangle_indices with the corresponding index 3-tuples, so they need
+//      to be allocated accordingly (call with nullptr first to get the number of triangles).
+DLLEXPORT int Quantity_Get_Topological_Charge_Density(State * state, float * charge_density, int * triangle_indices, int idx_image=-1, int idx_chain=-1) noexcept;
+
+// Topological Charge per spin of a 2D system (a third of the charge of each adjacent triangle).
+//      charge_density needs to have length NOS.
+DLLEXPORT void Quantity_Get_Topological_Charge_Density_per_Spin(State * state, float * charge_density, int idx_image=-1, int idx_chain=-1) noexcept;
+
 #endif
\ No newline at end of file
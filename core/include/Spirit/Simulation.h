@@ -5,8 +5,21 @@
 
 struct State;
 
+#include "Spirit_Defines.h"
 #include <vector>
 
+// Parameters which can be varied in a sweep
+#define Sweep_Parameter_Field        0   // Magnitude of the external field [T], along its current direction
+#define Sweep_Parameter_Temperature  1   // Temperature [K]
+#define Sweep_Parameter_Exchange     2   // Factor by which the exchange magnitudes of all shells are scaled
+#define Sweep_Parameter_DMI          3   // Factor by which the DMI magnitudes of all shells are scaled
+
+// Number of observables of each point of a sweep: E, M_x, M_y, M_z, Q, max. torque component
+#define Sweep_N_Observables          6
+
+// Length of the names of the timers of Simulation_Get_Timings, including the terminating null
+#define Simulation_Timing_Name_Length  64
+
 // Single Solver iteration with a Method
 DLLEXPORT void Simulation_SingleShot(State *state, const char * c_method_type, const char * c_solver_type, 
 	int n_iterations = -1, int n_iterations_log = -1, int idx_image=-1, int idx_chain=-1) noexcept;
@@ -18,6 +31,41 @@ DLLEXPORT void Simulation_PlayPause(State *state, const char * c_method_type, co
 // Stop all simulations
 DLLEXPORT void Simulation_Stop_All(State *state) noexcept;
 
+// Start a simulation in the background
+//		The method is iterated by a worker thread, using n_threads OpenMP threads (default: all).
+//		Returns a handle to the simulation, or -1 if it could not be started (e.g. because a
+//		simulation is already running on the image or chain).
+//		The handle is released once Simulation_Wait_Async or Simulation_Finished_Async has found
+//		the simulation to be finished.
+DLLEXPORT int Simulation_Start_Async(State *state, const char * c_method_type, const char * c_solver_type, 
+	int n_iterations = -1, int n_iterations_log = -1, int n_threads = -1, int idx_image=-1, int idx_chain=-1) noexcept;
+// Wait for a background simulation to finish, at most timeout seconds (negative: no limit)
+//		Returns whether the simulation has finished.
+DLLEXPORT bool Simulation_Wait_Async(State *state, int handle, float timeout = -1) noexcept;
+// Stop a background simulation after its current iteration
+DLLEXPORT void Simulation_Cancel_Async(State *state, int handle) noexcept;
+// Check whether a background simulation has finished
+DLLEXPORT bool Simulation_Finished_Async(State *state, int handle) noexcept;
+// Get the number of iterations a background simulation has done so far
+DLLEXPORT int Simulation_Get_Iteration_Async(State *state, int handle) noexcept;
+
+// Run a sweep over n_points parameter points with an LLG or MC method
+//		Every point is a simulation of a copy of the image, with the values of the n_parameters
+//		parameters (Sweep_Parameter_...) given in points [n_points][n_parameters]. The points are
+//		split into contiguous blocks, which run in parallel on n_workers threads (default: all).
+//		With warm_start, a point starts from the final configuration of the previous point of
+//		its block, otherwise from the configuration of the image, which is not modified.
+//		If not nullptr, results [n_points][Sweep_N_Observables] is filled with the observables of
+//		the final configurations (NaN for points which did not run). If filename is not empty,
+//		a line is appended to it as soon as a point has finished. n_iterations > 0 replaces the
+//		number of iterations of the method for the points, without changing the image.
+//		Simulation_Stop_All stops the sweep after the points which are currently running.
+//		Returns the number of points which have finished.
+DLLEXPORT int Simulation_Sweep(State *state, const char * c_method_type, const char * c_solver_type,
+	int n_parameters, const int * parameters, int n_points, const scalar * points, scalar * results = nullptr,
+	bool warm_start = true, int n_workers = -1, const char * filename = "", int n_iterations = -1,
+	int idx_image=-1, int idx_chain=-1) noexcept;
+
 
 // Get maximum torque component
 //		If an LLG simulation is running this returns the max. torque on the current image.
@@ -38,6 +86,16 @@ DLLEXPORT float Simulation_Get_IterationsPerSecond(State *state, int idx_image=-
 // Get number of done iterations
 DLLEXPORT int Simulation_Get_Iteration(State *state, int idx_image=-1, int idx_chain=-1) noexcept;
 
+// Get the timings of the Hamiltonian terms and solver phases (e.g. "Gradient Exchange", "Update")
+//		of the running or last simulation on the image or, if there is none, on the chain.
+//		The time of a timer does not include the timers inside of it, e.g. the "Force" does not
+//		include the Hamiltonian gradients. The timers are sorted by the time spent.
+//		The first n_max timers are written into those of names [n_max][Simulation_Timing_Name_Length],
+//		counts [n_max] (numbers of calls) and seconds [n_max] (times spent) which are not nullptr.
+//		Returns the number of timers, which is 0 if the library was built without SPIRIT_ENABLE_TIMINGS.
+DLLEXPORT int Simulation_Get_Timings(State *state, int n_max = 0, char * names = nullptr, int * counts = nullptr,
+	scalar * seconds = nullptr, int idx_image=-1, int idx_chain=-1) noexcept;
+
 // Get name of the currently used solver
 //		If an LLG simulation is running this returns the Solver name on the current image.
 //		If a GNEB simulation is running this returns the Solver name on the current chain.
@@ -5,6 +5,9 @@
 
 struct State;
 
+// Length of the names of the entries of State_Get_Memory_Report, including the terminating null
+#define State_Memory_Name_Length  64
+
 /*
 	State_Setup
 	  Create the State and fill it with initial data
@@ -36,5 +39,18 @@ DLLEXPORT void State_To_Config(State * state, const char * config_file, const ch
 */
 DLLEXPORT const char * State_DateTime(State * state) noexcept;
 
+/*
+	State_Get_Memory_Report
+	  Get a report of the memory held by the State: the chains with their images (spins,
+	  geometry, hamiltonian, ...), the clipboard and the workspaces of the methods.
+	  The entries are listed as a tree in pre-order, where the depth of the State is 0
+	  and the bytes of an entry include those of its children.
+	  The first n_max entries are written into those of names [n_max][State_Memory_Name_Length],
+	  depths [n_max] and bytes [n_max] which are not nullptr.
+	  Returns the number of entries.
+*/
+DLLEXPORT int State_Get_Memory_Report(State * state, int n_max = 0, char * names = nullptr,
+	int * depths = nullptr, long long * bytes = nullptr) noexcept;
+
 #include "DLL_Undefine_Export.h"
 #endif
\ No newline at end of file
@@ -14,10 +14,23 @@ DLLEXPORT int System_Get_NOS(State * state, int idx_image=-1, int idx_chain=-1)
 // Data
 DLLEXPORT scalar * System_Get_Spin_Directions(State * state, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT scalar * System_Get_Effective_Field(State * state, int idx_image=-1, int idx_chain=-1) noexcept;
+// Copy a consistent snapshot of the spin directions (3*nos) and, if not nullptr, of the effective
+// field (3*nos) and the total energy, and return the iteration at which it was taken.
+// While a simulation is running, this does not wait for it and returns the most recent snapshot
+// it has published (see n_iterations_snapshot). Otherwise the current data is returned, with
+// iteration -1.
+DLLEXPORT int System_Get_Spin_Snapshot(State * state, scalar * spins, scalar * effective_field=nullptr, 
+                                       float * energy=nullptr, int idx_image=-1, int idx_chain=-1) noexcept;
+// Update the energy of each spin and return a pointer to it (nos values)
+DLLEXPORT scalar * System_Get_Energy_per_Spin(State * state, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT float System_Get_Rx(State * state, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT float System_Get_Energy(State * state, int idx_image=-1, int idx_chain=-1) noexcept;
 DLLEXPORT void System_Get_Energy_Array(State * state, float * energies, int idx_image=-1, int idx_chain=-1) noexcept;
 
+// Set the spin directions (3*nos), which are normalized and pinned. The energy and effective
+// field of the system are updated accordingly.
+DLLEXPORT void System_Set_Spin_Directions(State * state, const scalar * spins, int idx_image=-1, int idx_chain=-1) noexcept;
+
 // Console Output
 DLLEXPORT void System_Print_Energy_Array(State * state, int idx_image=-1, int idx_chain=-1) noexcept;
 
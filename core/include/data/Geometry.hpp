@@ -5,7 +5,11 @@
 #include "Spirit_Defines.h"
 #include <engine/Vectormath_Defines.hpp>
 #include <Spirit/Geometry.h>
+#include <utility/Memory.hpp>
 
+#include <array>
+#include <map>
+#include <mutex>
 #include <vector>
 
 namespace Data
@@ -45,9 +49,17 @@ namespace Data
 
         // ---------- Convenience functions
         // Retrieve triangulation, if 2D
-        const std::vector<triangle_t>&    triangulation(int n_cell_step=1);
+        //      For Bravais lattices the triangles are generated from the cell indices. If the
+        //      boundary conditions are periodic in a direction, triangles wrapping around the
+        //      system in that direction are added.
+        //      All triangles are oriented counter-clockwise with respect to the normal of the
+        //      lattice plane, which is chosen to point along +z (or +y, +x if it lies in the plane).
+        //      The result is cached per n_cell_step and boundary conditions, and the returned
+        //      reference stays valid until the Geometry is assigned. It is safe to call from
+        //      several threads. The boundary conditions have to be given for all 3 directions.
+        const std::vector<triangle_t>&    triangulation(int n_cell_step=1, const intfield & boundary_conditions=intfield{0,0,0});
         // Retrieve tetrahedra, if 3D
-        const std::vector<tetrahedron_t>& tetrahedra(int n_cell_step=1);
+        const std::vector<tetrahedron_t>& tetrahedra(int n_cell_step=1, const intfield & boundary_conditions=intfield{0,0,0});
         // Introduce disorder into the atom types
         // void disorder(scalar mixing);
         static std::vector<Vector3> BravaisVectorsSC();
@@ -55,6 +67,8 @@ namespace Data
         static std::vector<Vector3> BravaisVectorsBCC();
         static std::vector<Vector3> BravaisVectorsHex2D60();
         static std::vector<Vector3> BravaisVectorsHex2D120();
+        // Add the memory held by the positions, atom types and cached triangulations to a report
+        void Memory_Usage(Utility::Memory::Report & report) const;
 
 
         // ---------- Basic information set, which (in theory) defines everything
@@ -106,14 +120,22 @@ namespace Data
 		// Calculate and update the type lattice
 		void calculateGeometryType();
 
-        // 
-        std::vector<triangle_t>    _triangulation;
-        std::vector<tetrahedron_t> _tetrahedra;
-        
-        // Temporaries to tell wether the triangulation or tetrahedra
-        // need to be updated when the corresponding function is called
-        int last_update_n_cell_step;
-        intfield last_update_n_cells;
+        // Triangulations and tetrahedra, by n_cell_step and boundary conditions
+        //      A copy of the Geometry starts with an empty cache, an assignment clears it.
+        struct Simplex_Cache
+        {
+            typedef std::array<int, 4> Key;
+            static Key Make_Key(int n_cell_step, const intfield & boundary_conditions);
+
+            Simplex_Cache() {}
+            Simplex_Cache(const Simplex_Cache &) {}
+            Simplex_Cache & operator=(const Simplex_Cache &);
+
+            std::mutex mutex;
+            std::map<Key, std::vector<triangle_t>>    triangulations;
+            std::map<Key, std::vector<tetrahedron_t>> tetrahedra;
+        };
+        mutable Simplex_Cache simplex_cache;
     };
 }
 #endif
@@ -3,6 +3,7 @@
 #define DATA_PARAMETERS_METHOD_H
 
 #include "Spirit_Defines.h"
+#include <engine/Vectormath_Defines.hpp>
 #include <data/Pinning.hpp>
 
 #include <string>
@@ -11,6 +12,39 @@
 
 namespace Data
 {
+	// Selection of the spins written to spin configuration output
+	struct Output_Filter
+	{
+		// Write only every n-th basis cell along each bravais vector
+		std::array<int,3> cell_stride{ {1, 1, 1} };
+		// Write only the spins in a region around position, as for the configurations: the
+		// half-widths of a box, the radii of a cylinder along z and of a sphere, where negative
+		// values mean no cut, and whether the region is inverted
+		Vector3 position{ 0, 0, 0 };
+		Vector3 r_cut_rectangular{ -1, -1, -1 };
+		scalar r_cut_cylindrical = -1;
+		scalar r_cut_spherical = -1;
+		bool inverted = false;
+
+		// Whether the filter restricts the output to a region
+		bool Region() const
+		{
+			return inverted || r_cut_rectangular[0] >= 0 || r_cut_rectangular[1] >= 0 ||
+				r_cut_rectangular[2] >= 0 || r_cut_cylindrical >= 0 || r_cut_spherical >= 0;
+		}
+		// Whether all spins are written
+		bool All() const
+		{
+			return cell_stride[0] == 1 && cell_stride[1] == 1 && cell_stride[2] == 1 && !Region();
+		}
+		bool operator==(const Output_Filter & other) const
+		{
+			return cell_stride == other.cell_stride && position == other.position &&
+				r_cut_rectangular == other.r_cut_rectangular && r_cut_cylindrical == other.r_cut_cylindrical &&
+				r_cut_spherical == other.r_cut_spherical && inverted == other.inverted;
+		}
+	};
+
 	// Solver Parameters Base Class
 	class Parameters_Method
 	{
@@ -31,6 +65,10 @@ namespace Data
 		bool output_initial;
 		// Save output at final state
 		bool output_final;
+		// File format of the spin configuration output (IO_Fileformat_...)
+		int output_configuration_filetype;
+		// Spins written to the spin configuration output
+		Output_Filter output_filter;
 
 		// Maximum walltime for Iterate in seconds
 		long int max_walltime_sec;
@@ -39,6 +77,8 @@ namespace Data
 		long int n_iterations;
 		// Number of iterations after which the Method should save data
 		long int n_iterations_log;
+		// Number of iterations after which the Method publishes a snapshot of the systems
+		long int n_iterations_snapshot;
 
 		// Info on pinned spins
 		std::shared_ptr<Pinning> pinning;
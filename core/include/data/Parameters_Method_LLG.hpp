@@ -55,10 +55,15 @@ namespace Data
         bool output_energy_step;
         bool output_energy_archive;
         bool output_energy_spin_resolved;
+        // File format of the spin-resolved energies (IO_Fileformat_Regular or one of the OVF formats)
+        int output_energy_spin_resolved_filetype;
         bool output_energy_divide_by_nspins;
         // Spin configurations output settings
         bool output_configuration_step;
         bool output_configuration_archive;
+        // Binary trajectory output, with the encoding of the spins (IO_Trajectory_...)
+        bool output_configuration_trajectory;
+        int output_trajectory_encoding;
     };
 }
 #endif
\ No newline at end of file
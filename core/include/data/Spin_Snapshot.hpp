@@ -0,0 +1,64 @@
+#pragma once
+#ifndef DATA_SPIN_SNAPSHOT_H
+#define DATA_SPIN_SNAPSHOT_H
+
+#include "Spirit_Defines.h"
+#include <engine/Vectormath_Defines.hpp>
+#include <utility/Memory.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Data
+{
+	class Spin_System;
+
+	// A consistent copy of the spins, effective field and energies of a spin system
+	struct Spin_Snapshot
+	{
+		// Iteration at which the snapshot was taken, -1 if it was not taken during a simulation
+		int iteration = -1;
+		vectorfield spins;
+		vectorfield effective_field;
+		scalar E = 0;
+		std::vector<std::pair<std::string, scalar>> E_array;
+	};
+
+	/*
+		Publishes snapshots of a spin system, so that it can be read (e.g. by a GUI or the API)
+		while a simulation is iterating on it, without waiting for the iteration.
+		The iterating thread publishes a snapshot every few iterations and readers get the most
+		recently published one, which is never modified afterwards. The snapshots are recycled
+		once no reader holds them anymore, so that usually only three exist: the one being
+		written, the published one and one still being read.
+	*/
+	class Spin_Snapshot_Buffer
+	{
+	public:
+		Spin_Snapshot_Buffer();
+
+		// Take a snapshot of the system and publish it. The caller has to make sure that the
+		// system is not modified meanwhile, i.e. hold its lock or be the thread iterating on it.
+		void Publish(const Spin_System & system, int iteration);
+		// The most recently published snapshot, nullptr if none has been published yet
+		std::shared_ptr<const Spin_Snapshot> Get() const;
+
+		// Add the memory held by the snapshots to a report
+		void Memory_Usage(Utility::Memory::Report & report) const;
+
+		// Whether a simulation is running on the system and publishing snapshots
+		std::atomic<bool> live;
+
+	private:
+		std::shared_ptr<const Spin_Snapshot> published;
+		// The snapshots, which are reused once only the pool holds them
+		std::vector<std::shared_ptr<Spin_Snapshot>> pool;
+		// Only guards the pool against concurrent publishers and memory reports
+		mutable std::mutex mutex;
+	};
+}
+#endif
@@ -10,6 +10,7 @@
 #include <engine/Vectormath_Defines.hpp>
 #include <engine/Hamiltonian.hpp>
 #include <data/Geometry.hpp>
+#include <data/Spin_Snapshot.hpp>
 #include <data/Parameters_Method_LLG.hpp>
 #include <data/Parameters_Method_MC.hpp>
 #include <data/Parameters_Method_GNEB.hpp>
@@ -33,11 +34,16 @@ namespace Data
 		// Update
 		void UpdateEnergy();
 		void UpdateEffectiveField();
+		// Update E_per_spin and return the contributions, which are kept in the buffers of the Hamiltonian
+		const std::vector<std::pair<std::string, scalarfield>> & UpdateEnergy_per_Spin();
 
 		// For multithreading
 		void Lock() const;
 		void Unlock() const;
 
+		// Add the memory held by the spins, fields, geometry and Hamiltonian to a report
+		void Memory_Usage(Utility::Memory::Report & report) const;
+
 		// Number of spins
 		int nos;
 		// Orientations of the Spins: spins[dim][nos]
@@ -56,10 +62,15 @@ namespace Data
 		// Total Energy of the spin system (to be updated from outside, i.e. SIB, GNEB, ...)
 		scalar E;
 		std::vector<std::pair<std::string, scalar>> E_array;
+		// Total energy of each spin (only updated on request)
+		scalarfield E_per_spin;
 		// Mean of magnetization
 		Vector3 M;
 		// Total effective field of the spins [3][nos]
 		vectorfield effective_field;
+		// Snapshots of the spins, effective field and energies, which can be read while a
+		// simulation is running
+		Spin_Snapshot_Buffer snapshots;
 
 	private:
 		// Mutex for thread-safety
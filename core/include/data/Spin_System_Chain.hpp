@@ -26,6 +26,9 @@ namespace Data
 		void Lock() const;
 		void Unlock() const;
 
+		// Add the memory held by the images and the interpolated energies to a report
+		void Memory_Usage(Utility::Memory::Report & report) const;
+
 		int noi;	// Number of Images
 		std::vector<std::shared_ptr<Spin_System>> images;
 		int idx_active_image;
@@ -1,7 +1,12 @@
 #include <data/Spin_System_Chain_Collection.hpp>
 #include <engine/Method.hpp>
+#include <engine/Simulation_Worker.hpp>
+#include <io/Checkpoint.hpp>
 #include <utility/Timing.hpp>
 
+#include <map>
+#include <mutex>
+
 /*
 	State
       The State struct is passed around in an application to make the
@@ -34,6 +39,13 @@ struct State
 	std::vector<std::shared_ptr<Engine::Method>> method_chain;
 	//    max. 1 MMF method
 	std::shared_ptr<Engine::Method> method_collection;
+	//    data of methods read from a checkpoint, applied when the methods are created
+	std::vector<IO::Method_Checkpoint> method_checkpoints;
+	//    simulations running in the background, by handle, guarded by mutex_simulations_async
+	//    as they may be started, polled and released from different threads
+	std::map<int, std::shared_ptr<Engine::Simulation_Task>> simulations_async;
+	int idx_next_simulation_async = 0;
+	std::mutex mutex_simulations_async;
 
 	// Timepoint of creation
 	system_clock::time_point datetime_creation;
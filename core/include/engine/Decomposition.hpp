@@ -0,0 +1,72 @@
+#pragma once
+#ifndef DECOMPOSITION_H
+#define DECOMPOSITION_H
+
+#include "Spirit_Defines.h"
+#include <engine/Vectormath_Defines.hpp>
+#include <data/Geometry.hpp>
+
+#include <array>
+
+#ifdef SPIRIT_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace Engine
+{
+	/*
+		Domain decomposition of a single system across MPI ranks.
+		The lattice is split into slabs along its slowest non-trivial translation direction, so that
+		each rank owns a contiguous range of spin indices. The Hamiltonians evaluate the gradient
+		and energy only for the owned spins and the results are then gathered on all ranks, so that
+		every rank holds the same, complete configuration and all reductions are global.
+		This distributes the work, but not the memory: the spins and all per-spin fields are
+		stored in full on every rank, so that no halo exchange is needed. The DDI, triplet and
+		quadruplet terms are evaluated on the full lattice by every rank.
+		Without SPIRIT_USE_MPI there is a single rank owning the whole lattice and all
+		communication functions do nothing.
+	*/
+	namespace Decomposition
+	{
+		// The part of the lattice owned by this rank
+		struct Slab
+		{
+			// The decomposed translation direction (0, 1 or 2)
+			int direction;
+			// Owned cells in each direction [cell_min, cell_max)
+			std::array<int, 3> cell_min, cell_max;
+			// Owned cells [icell_begin, icell_end) and spins [idx_begin, idx_end) in the global ordering
+			int icell_begin, icell_end;
+			int idx_begin, idx_end;
+		};
+
+		// Set up the decomposition, initialising MPI if the application has not done so, and pass
+		// the rank of this process to the Log. Called by State_Setup.
+		void Setup();
+
+		// Rank of this process and total number of ranks (0 and 1 without MPI)
+		int Rank();
+		int N_Ranks();
+
+		// The slab owned by a given rank
+		Slab Get_Slab(const Data::Geometry & geometry, int rank);
+		// The slab owned by this rank
+		Slab Get_Slab(const Data::Geometry & geometry);
+
+		// Gather the owned parts of a per-spin field of nos values, so that all ranks hold the
+		// complete field (an empty field is left unchanged)
+		void Gather(vectorfield & vf, const Data::Geometry & geometry);
+		void Gather(scalarfield & sf, const Data::Geometry & geometry);
+		// Copy a per-spin field from rank 0 to all other ranks
+		void Broadcast(vectorfield & vf);
+		// Returns true on all ranks if the condition is true on any rank
+		bool Any(bool condition);
+
+		#ifdef SPIRIT_USE_MPI
+		// Set the communicator used for the decomposition (default is MPI_COMM_WORLD)
+		void Set_Communicator(MPI_Comm comm);
+		#endif
+	}
+}
+
+#endif
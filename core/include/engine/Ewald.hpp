@@ -0,0 +1,67 @@
+#pragma once
+#ifndef EWALD_H
+#define EWALD_H
+
+#include "Spirit_Defines.h"
+#include <engine/Vectormath_Defines.hpp>
+#include <data/Geometry.hpp>
+#include <Spirit/Hamiltonian.h>
+
+#include <array>
+#include <vector>
+
+namespace Engine
+{
+	// How the dipole-dipole interaction is evaluated
+	enum class DDI_Method
+	{
+		Cutoff = Hamiltonian_DDI_Cutoff, // Direct sum over all pairs within the DDI radius
+		Ewald  = Hamiltonian_DDI_Ewald   // Sum over all spins and all their periodic images
+	};
+
+	/*
+		Summation of the dipole-dipole interaction over all periodic images of the lattice.
+		The interaction of two spins only depends on their basis atoms and on the difference of their
+		cells, so the lattice sums are performed once for each such combination and tabulated as
+		3x3 interaction tensors W, with
+			E = 1/2 sum_ij mu_i mu_j s_i^T W_ij s_j.
+		Depending on the number of periodic directions the sums are calculated as follows:
+			3 - Ewald summation (conducting boundary at infinity)
+			2 - Two-dimensional Ewald summation, open in the third direction (films)
+			1 - Direct sum along the periodic direction with an analytic tail correction (wires)
+			0 - Direct sum over all pairs
+		The splitting parameter and the cutoffs are chosen automatically from the lattice, such that the
+		truncation error is below sqrt(epsilon) of the scalar type.
+	*/
+	namespace Ewald
+	{
+		struct DDI_Tensors
+		{
+			// Geometry and boundary conditions the tensors were calculated for
+			intfield n_cells;
+			int n_cell_atoms;
+			intfield boundary_conditions;
+			// Number of tabulated cell differences in each direction:
+			//      n_cells for periodic directions (wrapped), 2*n_cells-1 for open directions
+			std::array<int, 3> n_translations;
+			// Splitting parameter [1/Angstrom] and real and reciprocal space cutoffs
+			scalar alpha, r_cut, k_cut;
+			// Interaction tensors [1/Angstrom^3], indexed by (ibasis, jbasis, cell difference)
+			std::vector<Matrix3> tensors;
+		};
+
+		// Calculate the interaction tensors for a geometry and its boundary conditions
+		DDI_Tensors Get_DDI_Tensors(const Data::Geometry & geometry, const intfield & boundary_conditions);
+		// Check if the tensors were calculated for the given geometry and boundary conditions
+		bool Is_Valid(const DDI_Tensors & tensors, const Data::Geometry & geometry, const intfield & boundary_conditions);
+
+		// Add the dipolar gradient of the spins owned by this rank
+		void Gradient(const DDI_Tensors & tensors, const Data::Geometry & geometry, const scalarfield & mu_s,
+			const vectorfield & spins, vectorfield & gradient);
+		// Add the dipolar energy of the spins owned by this rank
+		void Energy_per_Spin(const DDI_Tensors & tensors, const Data::Geometry & geometry, const scalarfield & mu_s,
+			const vectorfield & spins, scalarfield & energy);
+	}
+}
+
+#endif
@@ -7,6 +7,7 @@
 
 #include "Spirit_Defines.h"
 #include <engine/Vectormath_Defines.hpp>
+#include <utility/Memory.hpp>
 
 namespace Engine
 {
@@ -26,6 +27,13 @@ namespace Engine
 		*/
 		virtual void Update_Energy_Contributions();
 
+		/*
+			Update the interactions after the geometry has changed, e.g. after the number of
+			basis cells has been changed. Interactions which do not depend on the geometry
+			are kept, so that this is cheaper than re-creating the Hamiltonian.
+		*/
+		virtual void Update_Interactions();
+
 		/*
 			Calculate the Hessian matrix of a spin configuration.
 			This function uses finite differences and may thus be quite inefficient. You should
@@ -57,6 +65,10 @@ namespace Engine
 		// Calculate the Energy contributions for the spins of a configuration
 		virtual void Energy_Contributions_per_Spin(const vectorfield & spins, std::vector<std::pair<std::string, scalarfield>> & contributions);
 
+		// Calculate the Energy contributions for the spins of a configuration into the buffers of
+		// the Hamiltonian, which are reused between calls, and return them
+		const std::vector<std::pair<std::string, scalarfield>> & Update_Energy_Contributions_per_Spin(const vectorfield & spins);
+
 		// Calculate the Energy contributions for a spin configuration
 		virtual std::vector<std::pair<std::string, scalar>> Energy_Contributions(const vectorfield & spins);
 
@@ -66,6 +78,10 @@ namespace Engine
 		// Hamiltonian name as string
 		virtual const std::string& Name();
 
+		// Add the memory held by the interactions and the energy buffers to a report
+		//      Override to add the interactions of a specialized Hamiltonian
+		virtual void Memory_Usage(Utility::Memory::Report & report) const;
+
 		// Boundary conditions
 		intfield boundary_conditions; // [3] (a, b, c)
 	
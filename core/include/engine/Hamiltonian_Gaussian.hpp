@@ -35,6 +35,9 @@ namespace Engine
 		// Hamiltonian name as string
 		const std::string& Name() override;
 
+		// Add the memory held by the interactions to a report
+		void Memory_Usage(Utility::Memory::Report & report) const override;
+
 		// Parameters of the energy landscape
 		int n_gaussians;
 		std::vector<scalar> amplitude;
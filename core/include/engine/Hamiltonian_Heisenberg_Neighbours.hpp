@@ -8,6 +8,7 @@
 #include "Spirit_Defines.h"
 #include <engine/Vectormath_Defines.hpp>
 #include <engine/Hamiltonian.hpp>
+#include <engine/Ewald.hpp>
 #include <data/Geometry.hpp>
 
 namespace Engine
@@ -27,12 +28,13 @@ namespace Engine
 			intfield anisotropy_indices, scalarfield anisotropy_magnitudes, vectorfield anisotropy_normals,
 			scalarfield exchange_magnitudes,
 			scalarfield dmi_magnitudes, int dm_chirality,
-			scalar ddi_radius,
+			scalar ddi_radius, DDI_Method ddi_method,
 			std::shared_ptr<Data::Geometry> geometry,
 			intfield boundary_conditions
 		);
 
 		void Update_Energy_Contributions() override;
+		void Update_Interactions() override;
 
 		void Hessian(const vectorfield & spins, MatrixX & hessian) override;
 		void Gradient(const vectorfield & spins, vectorfield & gradient) override;
@@ -42,6 +44,9 @@ namespace Engine
 
 		// Hamiltonian name as string
 		const std::string& Name() override;
+
+		// Add the memory held by the interactions to a report
+		void Memory_Usage(Utility::Memory::Report & report) const override;
 		
 		// ------------ Single Spin Interactions ------------
 		// Spin moment
@@ -62,14 +67,26 @@ namespace Engine
 		neighbourfield dmi_neighbours;
 		scalarfield dmi_magnitudes;
 		vectorfield dmi_normals;
+		int dm_chirality;
 		// Dipole Dipole interaction
 		scalar ddi_radius;
+		DDI_Method ddi_method;
 		neighbourfield ddi_neighbours;
 		scalarfield ddi_magnitudes;
 		vectorfield ddi_normals;
 
 	private:
 		std::shared_ptr<Data::Geometry> geometry;
+		// Lattice sums of the DDI, calculated when first needed
+		Ewald::DDI_Tensors ddi_tensors;
+		// Bravais vectors, basis cell, numbers of shells and searched translations the neighbour
+		//      shells were generated for
+		std::vector<Vector3> shell_bravais_vectors;
+		std::vector<Vector3> shell_cell_atoms;
+		int n_exchange_shells = -1, n_dmi_shells = -1;
+		intfield exchange_shell_translations, dmi_shell_translations;
+		// Stores the lattice the neighbour shells depend on and returns whether it changed
+		bool Update_Shell_Lattice();
 		
 		// ------------ Effective Field Functions ------------
 		// Calculate the Zeeman effective field of a single Spin
@@ -8,6 +8,7 @@
 #include "Spirit_Defines.h"
 #include <engine/Vectormath_Defines.hpp>
 #include <engine/Hamiltonian.hpp>
+#include <engine/Ewald.hpp>
 #include <data/Geometry.hpp>
 
 namespace Engine
@@ -26,7 +27,7 @@ namespace Engine
             intfield anisotropy_indices, scalarfield anisotropy_magnitudes, vectorfield anisotropy_normals,
             pairfield exchange_pairs, scalarfield exchange_magnitudes,
             pairfield dmi_pairs, scalarfield dmi_magnitudes, vectorfield dmi_normals,
-            scalar ddi_radius,
+            scalar ddi_radius, DDI_Method ddi_method,
 			tripletfield triplets, scalarfield triplet_magnitudes1, scalarfield triplet_magnitudes2,
             quadrupletfield quadruplets, scalarfield quadruplet_magnitudes,
             std::shared_ptr<Data::Geometry> geometry,
@@ -34,6 +35,7 @@ namespace Engine
         );
 
 		void Update_Energy_Contributions() override;
+		void Update_Interactions() override;
 
 		void Hessian(const vectorfield & spins, MatrixX & hessian) override;
 		void Gradient(const vectorfield & spins, vectorfield & gradient) override;
@@ -41,6 +43,9 @@ namespace Engine
 
 		// Hamiltonian name as string
 		const std::string& Name() override;
+
+		// Add the memory held by the interactions to a report
+		void Memory_Usage(Utility::Memory::Report & report) const override;
 		
 		// ------------ Single Spin Interactions ------------
 		// Spin moments of basis cell atoms
@@ -67,6 +72,8 @@ namespace Engine
 		scalarfield dmi_magnitudes;
         vectorfield dmi_normals;
 		// Dipole Dipole interaction
+		scalar      ddi_radius;
+		DDI_Method  ddi_method;
 		pairfield   ddi_pairs;
 		scalarfield ddi_magnitudes;
 		vectorfield ddi_normals;
@@ -81,6 +88,8 @@ namespace Engine
 
 	private:
 		std::shared_ptr<Data::Geometry> geometry;
+		// Lattice sums of the DDI, calculated when first needed
+		Ewald::DDI_Tensors ddi_tensors;
 
 		// ------------ Effective Field Functions ------------
 		// Calculate the Zeeman effective field of a single Spin
@@ -7,8 +7,13 @@
 #include <data/Spin_System_Chain.hpp>
 #include <data/Parameters_Method.hpp>
 #include <utility/Timing.hpp>
+#include <utility/Profiling.hpp>
+#include <utility/Memory.hpp>
 #include <utility/Logging.hpp>
+#include <io/Checkpoint.hpp>
+#include <io/Output_Selection.hpp>
 
+#include <atomic>
 #include <deque>
 #include <fstream>
 #include <map>
@@ -34,9 +39,13 @@ namespace Engine
         // Calculate a smooth but current IPS value
         virtual scalar getIterationsPerSecond() final;
 
-        // Get the number of iterations passed
+        // Get the number of iterations passed (may be called from any thread)
         virtual int getNIterations() final;
 
+        // Timings of the Hamiltonian terms and solver phases of all calls to `Iterate` so far
+        //      (may be called from any thread; empty if SPIRIT_ENABLE_TIMINGS is not defined)
+        virtual std::vector<Utility::Profiling::Timer_Entry> getTimings() final;
+
         // Maximum of the absolutes of all components of the force - needs to be updated at each calculation
         virtual scalar getForceMaxAbsComponent() final;
 
@@ -44,6 +53,24 @@ namespace Engine
         // The default is that this returns simply {getForceMaxAbsComponent()}
         virtual std::vector<scalar> getForceMaxAbsComponent_All();
 
+        // Stop `Iterate` after the current iteration (may be called from any thread)
+        virtual void Cancel() final;
+
+        // Whether the last call to `Iterate` was stopped because the maximum walltime was reached
+        virtual bool getWalltimeExpired() final;
+
+        // Add the memory held by the workspace of the Method to a report
+        //      Override to add the buffers of a specialized Method or Solver
+        virtual void Memory_Usage(Utility::Memory::Report & report) const;
+
+        // File into which a checkpoint is written when the walltime is reached
+        virtual std::string getCheckpointFile() final;
+
+        // Write and read the internal data needed to continue the iterations from a checkpoint
+        //      Override to add the data of a specialized Method or Solver
+        virtual void Checkpoint_Write(IO::Binary_Writer & writer);
+        virtual void Checkpoint_Read(IO::Binary_Reader & reader);
+
         // Method name as string
         virtual std::string Name();
 
@@ -66,6 +93,8 @@ namespace Engine
         virtual void Message_Start();
         virtual void Message_Step();
         virtual void Message_End();
+        // Lines of a log block listing the memory held by the workspace and the systems
+        std::vector<std::string> Memory_Summary() const;
 
         // A hook into `Iterate` before an Iteration.
         //      Override this function if special actions are needed
@@ -81,6 +110,11 @@ namespace Engine
         //      Override to specialize what a Method should save
         virtual void Save_Current(std::string starttime, int iteration, bool initial=false, bool final=false);
 
+        // Selection of the spins of a system which are written to the configuration output,
+        //      following parameters->output_filter. It is rebuilt if the geometry or the filter
+        //      changed since the last output.
+        std::shared_ptr<const IO::Output_Selection> Get_Output_Selection(int idx_system, std::shared_ptr<const Data::Geometry> geometry);
+
 
         // Lock systems in order to prevent otherwise access
         //      This function should be overridden by specialized methods to ensure systems are
@@ -119,8 +153,14 @@ namespace Engine
 
         // Number of iterations that have been executed
         int iteration;
+        // The number of iterations, published after every iteration for readers on other threads
+        std::atomic<int> iteration_published;
         // Number of steps (set of iterations between logs) that have been executed
         int step;
+        // Whether the last call to `Iterate` reached the maximum walltime
+        bool walltime_expired;
+        // Whether `Cancel` was called
+        std::atomic<bool> cancelled;
 
         // Method name as enum
         Utility::Log_Sender SenderName;
@@ -137,6 +177,8 @@ namespace Engine
         std::deque<std::chrono::time_point<std::chrono::system_clock>> t_iterations;
         
         std::chrono::time_point<std::chrono::system_clock> t_start, t_last;
+        // Timings of the scopes timed while `Iterate` runs
+        Utility::Profiling::Timings timings;
 
 
         //////////// Parameters //////////////////////////////////////////////////////
@@ -175,6 +217,9 @@ namespace Engine
 
         // Precision for the conversion of scalar to string
         int print_precision;
+
+        // Selections of the spins written to the configuration output, per system
+        std::vector<std::shared_ptr<const IO::Output_Selection>> output_selections;
 	};
 }
 
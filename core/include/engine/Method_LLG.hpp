@@ -24,6 +24,9 @@ namespace Engine
         // Method name as string
         std::string Name() override;
 
+        // Add the memory held by the Method, its Solver and its own buffers to a report
+        void Memory_Usage(Utility::Memory::Report & report) const override;
+
     private:
         // Calculate Forces onto Systems
         void Calculate_Force(const std::vector<std::shared_ptr<vectorfield>> & configurations, std::vector<vectorfield> & forces) override;
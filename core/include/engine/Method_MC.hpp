@@ -22,6 +22,13 @@ namespace Engine
 
         // Method name as string
         std::string Name() override;
+        // MC does not use a Solver
+        std::string SolverName() override;
+        std::string SolverFullName() override;
+
+        // Checkpoint data, including the adaptive cone angle
+        void Checkpoint_Write(IO::Binary_Writer & writer) override;
+        void Checkpoint_Read(IO::Binary_Reader & reader) override;
         
     private:
         // Solver_Iteration represents one iteration of a certain Solver
@@ -21,6 +21,9 @@ namespace Engine
 
         // Method name as string
         std::string Name() override;
+
+        // Add the memory held by the Method, its Solver and its own buffers to a report
+        void Memory_Usage(Utility::Memory::Report & report) const override;
         
     private:
         // Calculate Forces onto Systems
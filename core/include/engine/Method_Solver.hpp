@@ -59,6 +59,17 @@ namespace Engine
         virtual std::string SolverName() override;
         virtual std::string SolverFullName() override;
 
+        // Checkpoint data of the Method and the Solver
+        virtual void Checkpoint_Write(IO::Binary_Writer & writer) override;
+        virtual void Checkpoint_Read(IO::Binary_Reader & reader) override;
+
+        // Add the memory held by the Method and the buffers of the Solver to a report
+        virtual void Memory_Usage(Utility::Memory::Report & report) const override;
+
+        // Projected memory of the buffers the Solver allocates in `Initialize` [bytes]
+        //      This is used to check whether a calculation fits into memory before allocating.
+        static std::size_t Workspace_Bytes(int noi, int nos);
+
     protected:
 
         // Calculate Forces onto Systems
@@ -78,6 +89,7 @@ namespace Engine
         virtual void Calculate_Force_Virtual(const std::vector<std::shared_ptr<vectorfield>> & configurations, const std::vector<vectorfield> & forces, std::vector<vectorfield> & forces_virtual)
         {
             using namespace Utility;
+            SPIRIT_TIMER("Virtual force");
 
             // Calculate the cross product with the spin configuration to get direct minimization
             for (unsigned int i=0; i<configurations.size(); ++i)
@@ -212,6 +224,40 @@ namespace Engine
     {
     };
 
+    // Default implementation: the Solver keeps no data between iterations
+    template<Solver solver>
+    void Method_Solver<solver>::Checkpoint_Write(IO::Binary_Writer & writer)
+    {
+        Method::Checkpoint_Write(writer);
+    };
+
+    template<Solver solver>
+    void Method_Solver<solver>::Checkpoint_Read(IO::Binary_Reader & reader)
+    {
+        Method::Checkpoint_Read(reader);
+    };
+
+    template<Solver solver>
+    void Method_Solver<solver>::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        using Utility::Memory::Bytes;
+        Method::Memory_Usage(report);
+        // Buffers which are only allocated by some of the Solvers
+        report.Add("Depondt rotations", Bytes(this->rotationaxis) + Bytes(this->forces_virtual_norm) + Bytes(this->angle));
+        report.Add("NCG fields", Bytes(this->alpha) + Bytes(this->beta)
+            + Bytes(this->delta_0) + Bytes(this->delta_new) + Bytes(this->delta_old) + Bytes(this->delta_d)
+            + Bytes(this->residual) + Bytes(this->direction) + Bytes(this->r_dot_d) + Bytes(this->dda2));
+        report.Add("VP velocities", Bytes(this->velocities) + Bytes(this->velocities_previous)
+            + Bytes(this->forces_previous) + Bytes(this->projection) + Bytes(this->force_norm2));
+    };
+
+    // Default implementation: the Solver allocates nothing
+    template<Solver solver>
+    std::size_t Method_Solver<solver>::Workspace_Bytes(int noi, int nos)
+    {
+        return 0;
+    };
+
 
 
     template<Solver solver>
@@ -220,16 +266,19 @@ namespace Engine
         using namespace Utility;
 
         //---- Log messages
-        Log.SendBlock(Log_Level::All, this->SenderName,
-            {
-                "------------  Started  " + this->Name() + " Calculation  ------------",
-                "    Going to iterate " + fmt::format("{}", this->n_log) + " steps",
-                "                with " + fmt::format("{}", this->n_iterations_log) + " iterations per step",
-                "    Force convergence parameter: " + fmt::format("{:." + fmt::format("{}", this->print_precision) + "f}", this->parameters->force_convergence),
-                "    Maximum force component:     " + fmt::format("{:." + fmt::format("{}", this->print_precision) + "f}", this->force_max_abs_component),
-                "    Solver: " + this->SolverFullName(),
-                "-----------------------------------------------------"
-            }, this->idx_image, this->idx_chain);
+        std::vector<std::string> block
+        {
+            "------------  Started  " + this->Name() + " Calculation  ------------",
+            "    Going to iterate " + fmt::format("{}", this->n_log) + " steps",
+            "                with " + fmt::format("{}", this->n_iterations_log) + " iterations per step",
+            "    Force convergence parameter: " + fmt::format("{:." + fmt::format("{}", this->print_precision) + "f}", this->parameters->force_convergence),
+            "    Maximum force component:     " + fmt::format("{:." + fmt::format("{}", this->print_precision) + "f}", this->force_max_abs_component),
+            "    Solver: " + this->SolverFullName()
+        };
+        for (auto & line : this->Memory_Summary())
+            block.push_back(line);
+        block.push_back("-----------------------------------------------------");
+        Log.SendBlock(Log_Level::All, this->SenderName, block, this->idx_image, this->idx_chain);
     }
 
     template<Solver solver>
@@ -240,17 +289,18 @@ namespace Engine
         // Update time of current step
         auto t_current = system_clock::now();
 
-        // Send log message
-        Log.SendBlock(Log_Level::All, this->SenderName,
-            {
-                "----- " + this->Name() + " Calculation (" + this->SolverName() + " Solver): " + Timing::DateTimePassed(t_current - this->t_start),
-                "    Step                         " + fmt::format("{} / {}", step, n_log),
-                "    Iteration                    " + fmt::format("{} / {}", this->iteration, n_iterations),
-                "    Time since last step:        " + Timing::DateTimePassed(t_current - this->t_last),
-                "    Iterations / sec:            " + fmt::format("{}", this->n_iterations_log / Timing::SecondsPassed(t_current - this->t_last)),
-                "    Force convergence parameter: " + fmt::format("{:." + fmt::format("{}", this->print_precision) + "f}", this->parameters->force_convergence),
-                "    Maximum force component:     " + fmt::format("{:." + fmt::format("{}", this->print_precision) + "f}", this->force_max_abs_component)
-            }, this->idx_image, this->idx_chain);
+        // Send log message, which is only created if it is printed or saved
+        if (Log.Accepts(Log_Level::All))
+            Log.SendBlock(Log_Level::All, this->SenderName,
+                {
+                    "----- " + this->Name() + " Calculation (" + this->SolverName() + " Solver): " + Timing::DateTimePassed(t_current - this->t_start),
+                    "    Step                         " + fmt::format("{} / {}", step, n_log),
+                    "    Iteration                    " + fmt::format("{} / {}", this->iteration, n_iterations),
+                    "    Time since last step:        " + Timing::DateTimePassed(t_current - this->t_last),
+                    "    Iterations / sec:            " + fmt::format("{}", this->n_iterations_log / Timing::SecondsPassed(t_current - this->t_last)),
+                    "    Force convergence parameter: " + fmt::format("{:.{}f}", this->parameters->force_convergence, this->print_precision),
+                    "    Maximum force component:     " + fmt::format("{:.{}f}", this->force_max_abs_component, this->print_precision)
+                }, this->idx_image, this->idx_chain);
 
         // Update time of last step
         this->t_last = t_current;
@@ -285,6 +335,8 @@ namespace Engine
         block.push_back("    Force convergence parameter: " + fmt::format("{:."+fmt::format("{}",this->print_precision)+"f}", this->parameters->force_convergence));
         block.push_back("    Maximum force component:     " + fmt::format("{:."+fmt::format("{}",this->print_precision)+"f}", this->force_max_abs_component));
         block.push_back("    Solver: " + this->SolverFullName());
+        for (auto & line : this->timings.Summary())
+            block.push_back(line);
         block.push_back("-----------------------------------------------------");
         Log.SendBlock(Log_Level::All, this->SenderName, block, this->idx_image, this->idx_chain);
     }
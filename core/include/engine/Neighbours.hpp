@@ -18,6 +18,8 @@ namespace Engine
 		pairfield Get_Pairs_in_Shells(const Data::Geometry & geometry, int nShells);
 		pairfield Get_Pairs_in_Radius(const Data::Geometry & geometry, scalar radius);
 
+		// Numbers of translations along the Bravais vectors searched for the neighbours in nShells shells
+		intfield Get_Shell_Translations(const Data::Geometry & geometry, int nShells);
 		neighbourfield Get_Neighbours_in_Shells(const Data::Geometry & geometry, int nShells);
 		// this function may be redundant (the only difference to Get_Pairs_in_Radius is that it
 		//		returns a neighbourfield instead of a pairfield...
@@ -0,0 +1,68 @@
+#pragma once
+#ifndef SIMULATION_WORKER_H
+#define SIMULATION_WORKER_H
+
+#include "Spirit_Defines.h"
+#include <engine/Method.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace Engine
+{
+    /*
+        Simulations running in the background.
+        A started simulation is iterated by a worker thread owned by the engine, so that the caller
+        does not block and can poll its progress, wait for it or cancel it. Workers are reused once
+        their simulation has finished.
+        Each simulation can be given a budget of threads, which are used by the OpenMP-parallel
+        parts of its iterations. Several images or chains can thereby run concurrently, each on its
+        own share of the cores.
+        Without SPIRIT_USE_THREADS, a simulation is iterated completely when it is started.
+    */
+    class Simulation_Task
+    {
+    public:
+        // The task runs `work`, which is expected to call method->Iterate(), with n_threads
+        //      OpenMP threads (n_threads <= 0 keeps the default number of threads)
+        Simulation_Task(std::shared_ptr<Method> method, std::function<void()> work, int n_threads);
+
+        // Stop the iterations, which takes effect after the current iteration
+        void Cancel();
+        // Wait until the simulation has finished, at most timeout seconds (negative: no limit)
+        //      Returns whether the simulation has finished
+        bool Wait(scalar timeout = -1);
+        // Whether the simulation has finished
+        bool Finished();
+        // Number of iterations done so far
+        int Iteration();
+        // Number of threads the simulation uses
+        int N_Threads() const { return this->n_threads; }
+
+        // Execute the task on the calling thread
+        void Run();
+
+    private:
+        std::shared_ptr<Method> method;
+        std::function<void()> work;
+        int n_threads;
+        // Number of iterations when the simulation finished
+        int iteration_final;
+        bool finished;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    namespace Simulation_Worker
+    {
+        // Hand a task to a worker thread. If no worker is idle, a new one is started.
+        void Start(std::shared_ptr<Simulation_Task> task);
+        // Sum of the thread budgets of the simulations which are currently running
+        int N_Threads_Running();
+    }
+}
+
+#endif
@@ -18,6 +18,13 @@ void Method_Solver<Solver::Depondt>::Initialize ()
     this->temp1 = vectorfield( this->nos, {0, 0, 0} );
 };
 
+// as for SIB, the rotation axes, angles and a temporary field
+template <> inline
+std::size_t Method_Solver<Solver::Depondt>::Workspace_Bytes(int noi, int nos)
+{
+    return (std::size_t(noi) * 6 + 1) * nos * sizeof(Vector3) + (std::size_t(noi) + 1) * nos * sizeof(scalar);
+};
+
 
 /*
     Template instantiation of the Simulation class for use with the Depondt Solver.
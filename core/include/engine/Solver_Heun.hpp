@@ -18,6 +18,13 @@ void Method_Solver<Solver::Heun>::Initialize ()
     this->temp1 = vectorfield( this->nos, {0, 0, 0} );
 };
 
+// forces, virtual forces and configurations, each also for the predictor, temporary configurations and a field
+template <> inline
+std::size_t Method_Solver<Solver::Heun>::Workspace_Bytes(int noi, int nos)
+{
+    return (std::size_t(noi) * 6 + 1) * nos * sizeof(Vector3);
+};
+
 
 /*
     Template instantiation of the Simulation class for use with the Heun Solver.
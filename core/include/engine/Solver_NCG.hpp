@@ -46,6 +46,35 @@ void Method_Solver<Solver::NCG>::Initialize ()
     }
 };
 
+// eight scalar and two vector fields per image, and the dense Hessian of one image
+template <> inline
+std::size_t Method_Solver<Solver::NCG>::Workspace_Bytes(int noi, int nos)
+{
+    return std::size_t(noi) * nos * (8 * sizeof(scalar) + 2 * sizeof(Vector3))
+        + 9 * std::size_t(nos) * std::size_t(nos) * sizeof(scalar);
+};
+
+// The conjugate directions and residuals are needed to continue
+template <> inline
+void Method_Solver<Solver::NCG>::Checkpoint_Write (IO::Binary_Writer & writer)
+{
+    Method::Checkpoint_Write(writer);
+    writer.Write(this->residual);
+    writer.Write(this->direction);
+    writer.Write(this->delta_0);
+    writer.Write(this->delta_new);
+};
+
+template <> inline
+void Method_Solver<Solver::NCG>::Checkpoint_Read (IO::Binary_Reader & reader)
+{
+    Method::Checkpoint_Read(reader);
+    reader.Read(this->residual);
+    reader.Read(this->direction);
+    reader.Read(this->delta_0);
+    reader.Read(this->delta_new);
+};
+
 
 /*
     Template instantiation of the Simulation class for use with the NCG Solver
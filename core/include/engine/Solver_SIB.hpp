@@ -12,6 +12,13 @@ void Method_Solver<Solver::SIB>::Initialize ()
       configurations_predictor[i] = std::shared_ptr<vectorfield>(new vectorfield(this->nos));  
 };
 
+// forces, virtual forces and configurations, each also for the predictor
+template <> inline
+std::size_t Method_Solver<Solver::SIB>::Workspace_Bytes(int noi, int nos)
+{
+    return std::size_t(noi) * 5 * nos * sizeof(Vector3);
+};
+
 
 /*
     Template instantiation of the Simulation class for use with the SIB Solver.
@@ -15,6 +15,30 @@ void Method_Solver<Solver::VP>::Initialize ()
     this->force_norm2         = std::vector<scalar>(this->noi, 0);	// [noi]
 };
 
+// forces, virtual forces, temporary configurations, velocities and previous velocities and forces
+template <> inline
+std::size_t Method_Solver<Solver::VP>::Workspace_Bytes(int noi, int nos)
+{
+    return std::size_t(noi) * (6 * nos * sizeof(Vector3) + 2 * sizeof(scalar));
+};
+
+// The velocities and the forces of the last iteration are needed to continue
+template <> inline
+void Method_Solver<Solver::VP>::Checkpoint_Write (IO::Binary_Writer & writer)
+{
+    Method::Checkpoint_Write(writer);
+    writer.Write(this->velocities);
+    writer.Write(this->forces);
+};
+
+template <> inline
+void Method_Solver<Solver::VP>::Checkpoint_Read (IO::Binary_Reader & reader)
+{
+    Method::Checkpoint_Read(reader);
+    reader.Read(this->velocities);
+    reader.Read(this->forces);
+};
+
 
 /*
     Template instantiation of the Simulation class for use with the VP Solver.
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "Spirit_Defines.h"
+#include <engine/Method.hpp>
+#include <engine/Method_Solver.hpp>
+#include <data/Spin_System.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+    // Parameters which can be varied in a sweep
+    enum class Sweep_Parameter
+    {
+        // Magnitude of the external field [T], along the current direction of the field
+        Field,
+        // Temperature [K] of the LLG and MC methods
+        Temperature,
+        // Factor by which the current exchange magnitudes of all shells or pairs are scaled
+        Exchange,
+        // Factor by which the current DMI magnitudes of all shells or pairs are scaled
+        DMI
+    };
+
+    /*
+        Sweep over a list of parameter points, e.g. a hysteresis loop or a temperature scan.
+        Every point is an independent LLG or MC simulation of a copy of the system. The points
+        are split into contiguous blocks, which are run in parallel by n_workers workers (threads
+        with SPIRIT_USE_THREADS, otherwise OpenMP threads). Each worker owns one copy of the
+        system, which shares the geometry with the original, and runs the points of its block
+        one after the other. With warm_start, a point starts from the final configuration of the
+        previous point of the block, otherwise every point starts from the configuration of the
+        original system. A strictly sequential sweep (e.g. a hysteresis loop) thus needs a
+        single worker. With several MPI ranks, there is always a single worker, as the methods
+        use collective operations.
+        The original system is not modified. The sweep stops after the points which are
+        currently running if its iteration_allowed is set to false.
+    */
+    class Sweep
+    {
+    public:
+        // Observables recorded for each point: E, M_x, M_y, M_z, Q, max. torque component
+        static const int n_observables = 6;
+
+        // points contains parameters.size() values for each point
+        //      n_workers <= 0 uses as many workers as there are threads
+        //      n_iterations > 0 replaces the number of iterations of the method on the copies
+        //      Throws if a parameter cannot be varied for the Hamiltonian of the system
+        Sweep(std::shared_ptr<Data::Spin_System> system, std::string method_type, Solver solver,
+              std::vector<Sweep_Parameter> parameters, std::vector<scalar> points,
+              bool warm_start, int n_workers, int n_iterations, int idx_image, int idx_chain);
+
+        // Run the points, returning when all have finished or the sweep was stopped.
+        //      If filename is not empty, a line with the point index, parameters and observables
+        //      is appended to the file as soon as a point has finished.
+        void Run(const std::string & filename = "");
+
+        // Number of points
+        int N_Points() const;
+        // Number of points which have finished
+        int N_Points_Done() const;
+        // Observables of all points [n_points][n_observables], NaN for the points which did not run
+        const std::vector<scalar> & Results() const;
+
+    private:
+        // Run the points [idx_begin, idx_end) on the copy of the system of a worker
+        void Run_Block(int idx_worker, int idx_begin, int idx_end);
+        // Set the parameters of a point on a copy of the system
+        void Apply_Point(Data::Spin_System & system, int idx_point);
+        // Set a Field, Exchange or DMI parameter on a Heisenberg Hamiltonian of a copy
+        template<typename Heisenberg>
+        void Apply_Heisenberg(Heisenberg & hamiltonian, Sweep_Parameter parameter, scalar value);
+        // Create a copy of the system for a worker, sharing the geometry
+        std::shared_ptr<Data::Spin_System> Copy_System(int n_iterations);
+        // Create the method which iterates a copy of the system
+        std::shared_ptr<Method> Create_Method(std::shared_ptr<Data::Spin_System> system);
+        // Store the observables of a finished point and append them to the output file
+        void Record(int idx_point, Data::Spin_System & system, Method & method);
+
+        std::shared_ptr<Data::Spin_System> system;
+        std::string method_type;
+        Solver solver;
+        std::vector<Sweep_Parameter> parameters;
+        std::vector<scalar> points;
+        bool warm_start;
+        int n_workers;
+        int idx_image;
+        int idx_chain;
+
+        // One copy of the system per worker
+        std::vector<std::shared_ptr<Data::Spin_System>> systems;
+        // Configuration of the original system, from which the points start
+        vectorfield spins_initial;
+        // Magnitudes of the original system, which are scaled by the Exchange and DMI parameters
+        scalarfield exchange_magnitudes;
+        scalarfield dmi_magnitudes;
+        // Triangulation of a 2D geometry for the topological charge, empty otherwise
+        std::vector<Data::triangle_t> triangulation;
+
+        std::string filename;
+        std::vector<scalar> results;
+        int n_points_done;
+        std::mutex mutex;
+    };
+}
+
+#endif
@@ -369,6 +369,19 @@ namespace Engine
             return jspin;
         }
 
+        // Removes the entries of a field for which keep is false in a single pass, preserving the order of the others
+        template<typename Field>
+        inline void filter(Field & field, const std::vector<bool> & keep)
+        {
+            std::size_t n_kept = 0;
+            for (std::size_t i = 0; i < field.size(); ++i)
+            {
+                if (keep[i])
+                    field[n_kept++] = field[i];
+            }
+            field.erase(field.begin() + n_kept, field.end());
+        }
+
 
         /////////////////////////////////////////////////////////////////
         //////// Vectorfield Math - special stuff
@@ -380,7 +393,12 @@ namespace Engine
         // Calculate the mean of a vectorfield
         std::array<scalar, 3> Magnetization(const vectorfield & vf);
         // Calculate the topological charge inside a vectorfield
-        scalar TopologicalCharge(const vectorfield & vf, const vectorfield & vf_pos, const std::vector<std::array<int, 3>> & triangulation);
+        //      The triangles need to be oriented counter-clockwise w.r.t. the lattice plane normal
+        scalar TopologicalCharge(const vectorfield & vf, const std::vector<std::array<int, 3>> & triangulation);
+        // Calculate the topological charge of each triangle
+        void TopologicalChargeDensity(const vectorfield & vf, const std::vector<std::array<int, 3>> & triangulation, scalarfield & charge_density);
+        // Calculate the topological charge per spin, distributing the charge of each triangle evenly onto its corners
+        void TopologicalChargeDensity_per_Spin(const vectorfield & vf, const std::vector<std::array<int, 3>> & triangulation, scalarfield & charge_density);
 
         // Utility function for the SIB Solver - maybe create a MathUtil namespace?
         void transform(const vectorfield & spins, const vectorfield & force, vectorfield & out);
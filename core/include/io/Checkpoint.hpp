@@ -0,0 +1,141 @@
+#pragma once
+#ifndef IO_CHECKPOINT_H
+#define IO_CHECKPOINT_H
+
+#include "Spirit_Defines.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct State;
+namespace Engine
+{
+    class Method;
+}
+
+namespace IO
+{
+    /*
+        Binary checkpoints of a whole State, from which a simulation can be continued.
+        A checkpoint contains, for all chains and images, the spins, the states of the random
+        number generators and the chain data (reaction coordinates, image types), as well as the
+        internal data of the methods in the State (iteration counters, solver velocities, ...).
+        Checkpoints are written to a temporary file which is then renamed, so that an existing
+        checkpoint is never left incomplete. They can only be read with the same scalar type and
+        for the same geometry they were written with.
+        The data of the methods is kept in the State after reading a checkpoint and applied to the
+        next method of the same kind which is created for the same image or chain.
+    */
+
+    // Binary serialisation into a buffer
+    class Binary_Writer
+    {
+    public:
+        template<typename T>
+        void Write(const T & value)
+        {
+            this->buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        void Write(const std::string & value)
+        {
+            this->Write<std::uint64_t>(value.size());
+            this->buffer.append(value);
+        }
+
+        template<typename T, typename A>
+        void Write(const std::vector<T, A> & values)
+        {
+            this->Write<std::uint64_t>(values.size());
+            this->buffer.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+        }
+
+        template<typename T, typename A, typename B>
+        void Write(const std::vector<std::vector<T, A>, B> & values)
+        {
+            this->Write<std::uint64_t>(values.size());
+            for (auto& v : values)
+                this->Write(v);
+        }
+
+        const std::string & Data() const { return this->buffer; }
+
+    private:
+        std::string buffer;
+    };
+
+    // Binary deserialisation from a buffer, throws if the data ends prematurely
+    class Binary_Reader
+    {
+    public:
+        Binary_Reader(const char * data, std::size_t size) : data(data), size(size), offset(0) {}
+
+        template<typename T>
+        void Read(T & value)
+        {
+            this->Require(sizeof(T));
+            std::memcpy(&value, this->data + this->offset, sizeof(T));
+            this->offset += sizeof(T);
+        }
+
+        void Read(std::string & value)
+        {
+            std::uint64_t n;
+            this->Read(n);
+            this->Require(n);
+            value.assign(this->data + this->offset, n);
+            this->offset += n;
+        }
+
+        template<typename T, typename A>
+        void Read(std::vector<T, A> & values)
+        {
+            std::uint64_t n;
+            this->Read(n);
+            this->Require(n * sizeof(T));
+            values.resize(n);
+            std::memcpy(values.data(), this->data + this->offset, n * sizeof(T));
+            this->offset += n * sizeof(T);
+        }
+
+        template<typename T, typename A, typename B>
+        void Read(std::vector<std::vector<T, A>, B> & values)
+        {
+            std::uint64_t n;
+            this->Read(n);
+            values.resize(n);
+            for (auto& v : values)
+                this->Read(v);
+        }
+
+        bool At_End() const { return this->offset == this->size; }
+
+    private:
+        void Require(std::size_t n_bytes);
+
+        const char * data;
+        std::size_t size;
+        std::size_t offset;
+    };
+
+    // Internal data of a method, read from a checkpoint
+    struct Method_Checkpoint
+    {
+        std::string method_name;
+        std::string solver_name;
+        int idx_image, idx_chain;
+        std::string data;
+    };
+
+    // Write a checkpoint of the State
+    void Write_Checkpoint(State & state, const std::string & filename);
+    // Restore the State from a checkpoint
+    void Read_Checkpoint(State & state, const std::string & filename);
+    // If the State holds checkpoint data for this method, apply and remove it
+    void Apply_Method_Checkpoint(State & state, Engine::Method & method, int idx_image, int idx_chain);
+}
+
+#endif
@@ -22,38 +22,40 @@ namespace IO
                                           const int stride, vectorfield& vf,
                                           const Data::Geometry& geometry );
     void Read_Spin_Configuration_CSV( std::shared_ptr<Data::Spin_System> s, const std::string file );
+    // Read a spin configuration, for OVF files from the given segment
     void Read_Spin_Configuration( std::shared_ptr<Data::Spin_System> s, const std::string file, 
-                                  VF_FileFormat format = VF_FileFormat::SPIRIT_CSV_POS_SPIN );
+                                  VF_FileFormat format = VF_FileFormat::SPIRIT_CSV_POS_SPIN,
+                                  int idx_image_infile = 0 );
     void Read_SpinChain_Configuration( std::shared_ptr<Data::Spin_System_Chain> c, 
                                        const std::string file );
     void Anisotropy_from_File( const std::string anisotropyFile, 
                                const std::shared_ptr<Data::Geometry> geometry, int& n_indices,
                                intfield& anisotropy_index, scalarfield& anisotropy_magnitude, 
                                vectorfield& anisotropy_normal );
+    // Interaction tables (pairs, triplets, quadruplets) are parsed in parallel. With a cache
+    // folder, the result is also stored there in a binary file named after a hash of the input
+    // file, which is read instead of parsing the file again as long as the file does not change.
     void Pairs_from_File( const std::string pairsFile, 
                           const std::shared_ptr<Data::Geometry> geometry, int& nop,
                           pairfield& exchange_pairs, scalarfield& exchange_magnitudes,
                           pairfield& dmi_pairs, scalarfield& dmi_magnitudes, 
-                          vectorfield& dmi_normals );
+                          vectorfield& dmi_normals, const std::string cache_folder = "" );
     void Triplets_from_File( const std::string tripletsFile, 
                                 const std::shared_ptr<Data::Geometry> geometry, int& noq,
-                                tripletfield& triplets, scalarfield& triplet_magnitudes, scalarfield& triplet_magnitudes2 );
+                                tripletfield& triplets, scalarfield& triplet_magnitudes, scalarfield& triplet_magnitudes2,
+                                const std::string cache_folder = "" );
     void Quadruplets_from_File( const std::string quadrupletsFile, 
                                 const std::shared_ptr<Data::Geometry> geometry, int& noq,
-                                quadrupletfield& quadruplets, scalarfield& quadruplet_magnitudes );
+                                quadrupletfield& quadruplets, scalarfield& quadruplet_magnitudes,
+                                const std::string cache_folder = "" );
     void Defects_from_File( const std::string defectsFile, int& n_defects,
                             intfield& defect_indices, intfield & defect_types );
     void Pinned_from_File( const std::string pinnedFile, int& n_pinned,
                            intfield& pinned_indices, vectorfield& pinned_spins );
-    // Read data from OVF file format
+    // Read data from a segment of a file in OVF file format
     void Read_From_OVF( vectorfield& vf, const Data::Geometry& geometry, std::string inputfilename, 
-                        VF_FileFormat format );
-    // Reads the OVF binary data to the vectorfield vf
-    void OVF_Read_Binary( Filter_File_Handle& myfile, const int ovf_binary_length, 
-                          const std::array<int, 3>& ovf_xyz_nodes, vectorfield& vf );
-    // Checking the initial check values of OVF binary data
-    bool OVF_Check_Binary_Initial_Values( Filter_File_Handle& myfile, const int ovf_binary_length );
-    // Read the OVF text data to the vectorfield vf 
-    void OVF_Read_Text( Filter_File_Handle& myfile, const Data::Geometry& geometry, vectorfield& vf );
+                        VF_FileFormat format, int idx_segment = 0 );
+    // Read the segments of a file in OVF file format into the images of a chain
+    void Read_SpinChain_From_OVF( std::shared_ptr<Data::Spin_System_Chain> c, const std::string file );
 };// end namespace IO
 #endif
\ No newline at end of file
@@ -25,20 +25,19 @@ namespace IO
     void Write_Chain_Spin_Configuration( const std::shared_ptr<Data::Spin_System_Chain>& c, 
                                          const std::string filename, VF_FileFormat format,
                                          const std::string comment, bool append = false );
+    // Write/Append a list of spin configurations to file, e.g. a snapshot of a chain
+    void Write_Chain_Spin_Configuration( const std::vector<std::shared_ptr<vectorfield>>& images, 
+                                         const std::vector<std::shared_ptr<const Data::Geometry>>& geometries, 
+                                         const std::string filename, VF_FileFormat format,
+                                         const std::string comment, bool append = false );
     
     // Saves any SPIRIT format
     void Save_To_SPIRIT( const vectorfield & vf, const Data::Geometry & geometry, 
                          const std::string filename, VF_FileFormat format, 
                          const std::string comment );
-    // Saves any OVF format 
+    // Saves any OVF format, appending adds a segment to the file
     void Save_To_OVF( const vectorfield& vf, const Data::Geometry& geometry, std::string filename, 
-                      VF_FileFormat format, const std::string comment );
-    // Writes the OVF bin data
-    void Write_OVF_bin_data( const vectorfield& vf, const Data::Geometry& geometry, 
-                             const std::string filename, VF_FileFormat format );
-    // Writes the OVF text data
-    void Write_OVF_text_data( const vectorfield& vf, const Data::Geometry& geometry,
-                              std::string& output_to_file );
+                      VF_FileFormat format, const std::string comment, bool append = false );
 
     // =========================== Saving Energies ===========================
     void Write_Energy_Header( const Data::Spin_System& s, const std::string filename, 
@@ -50,9 +49,12 @@ namespace IO
     // Save energy contributions of a spin system
     void Write_Image_Energy( const Data::Spin_System& system, const std::string filename, 
                               bool normalize_by_nos=true );
-    // Save energy contributions of a spin system per spin
-    void Write_Image_Energy_per_Spin( const Data::Spin_System & s, const std::string filename, 
-                                       bool normalize_nos=true );
+    // Save energy contributions of a spin system per spin, as a text table or, for the OVF
+    // formats, as binary data with one value dimension per contribution. The energies are
+    // calculated into the buffers of the system (see Spin_System::UpdateEnergy_per_Spin).
+    void Write_Image_Energy_per_Spin( Data::Spin_System & s, const std::string filename, 
+                                       bool normalize_nos=true, 
+                                       VF_FileFormat format=VF_FileFormat::SPIRIT_WHITESPACE_SPIN );
 
     // Saves Energies of all images with header and contributions
     void Write_Chain_Energies( const Data::Spin_System_Chain& c, const int iteration, 
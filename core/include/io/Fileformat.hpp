@@ -21,9 +21,28 @@ namespace IO
         OVF_BIN8                   = IO_Fileformat_OVF_bin8,
         OVF_BIN4                   = IO_Fileformat_OVF_bin4,
         OVF_TEXT                   = IO_Fileformat_OVF_text,
+        // OVF with zlib-compressed binary data (requires SPIRIT_USE_ZLIB)
+        OVF_BIN4_ZLIB              = IO_Fileformat_OVF_bin4_zlib,
+        // OVF with unit vectors encoded octahedrally in two 2 byte integers, lossy with an
+        // error of at most ~1e-4 per component (compressed if SPIRIT_USE_ZLIB is set)
+        OVF_OCT16                  = IO_Fileformat_OVF_oct16,
         // General Spirit file
         SPIRIT_GENERAL
     };
+
+    // Whether the format is one of the OVF formats
+    inline bool Is_OVF_Format( VF_FileFormat format )
+    {
+        return format == VF_FileFormat::OVF_BIN8 || format == VF_FileFormat::OVF_BIN4 ||
+               format == VF_FileFormat::OVF_TEXT || format == VF_FileFormat::OVF_BIN4_ZLIB ||
+               format == VF_FileFormat::OVF_OCT16;
+    }
+
+    // Extension of the files written in the format
+    inline const char * Fileformat_Extension( VF_FileFormat format )
+    {
+        return Is_OVF_Format( format ) ? ".ovf" : ".txt";
+    }
 };
 
 #endif
\ No newline at end of file
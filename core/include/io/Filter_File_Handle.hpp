@@ -2,8 +2,10 @@
 #ifndef IO_FILTERFILEHANDLE_H
 #define IO_FILTERFILEHANDLE_H
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include <istream>
 #include <fstream>
 #include <sstream>
@@ -20,6 +22,52 @@
 
 namespace IO
 {
+    // Fast sequential reading of whitespace-separated fields from a line, for large tables.
+    // Like a stream, it fails on the first field that cannot be read and stays failed.
+    class Line_Tokenizer
+    {
+    public:
+        Line_Tokenizer() : pos(""), failed(false) {}
+
+        // Start reading from a null-terminated line, which has to outlive the tokenizer
+        void Set( const char * line )
+        {
+            this->pos = line;
+            this->failed = false;
+        }
+
+        Line_Tokenizer & operator>>( int & value );
+        Line_Tokenizer & operator>>( long & value );
+        Line_Tokenizer & operator>>( float & value );
+        Line_Tokenizer & operator>>( double & value );
+        Line_Tokenizer & operator>>( std::string & value );
+
+        explicit operator bool() const { return !this->failed; }
+        bool operator!() const { return this->failed; }
+
+    private:
+        // Skips whitespace, returns false if the end of the line is reached
+        bool Skip_Whitespace();
+
+        const char * pos;
+        bool failed;
+    };
+
+    // Contents of a file without comments and separator characters, in lower case.
+    // Lines starting with a word are indexed by that word, so that keywords are found
+    // without scanning the file.
+    struct Filtered_File
+    {
+        std::vector<std::string> lines;
+        std::map<std::string, std::vector<std::size_t>> index;
+    };
+
+    /*
+        Line-based reading of input files with keywords.
+        The file is read and indexed once and the result is shared by all handles on the same
+        file as long as it does not change, so that e.g. the many parsers reading from a single
+        config file do not scan it again for every keyword.
+    */
     class Filter_File_Handle
     {
     private:
@@ -27,27 +75,35 @@ namespace IO
         std::string line;
         std::string comment_tag;
         std::string dump;
+        // Shared contents of the file and the position of the next line to read
+        std::shared_ptr<const Filtered_File> file;
+        std::size_t next_line;
     public:
         IO::VF_FileFormat ff;
         std::string filename;
-        std::unique_ptr<std::ifstream> myfile;
         std::istringstream iss;
+        // Fields of the current line (after the keyword), faster than iss for large tables
+        Line_Tokenizer tokens;
         
         // Constructs a Filter_File_Handle with string filename
         Filter_File_Handle( const std::string& s, 
                             IO::VF_FileFormat format = VF_FileFormat::SPIRIT_GENERAL );
         // Destructor
         ~Filter_File_Handle();
-        // Reads next line of file into the handle (false -> end-of-file)
+        // Reads next line of file into the handle without setting up iss (false -> end-of-file)
         bool GetLine_Handle();
-        // Reads the next line of file into the handle and into the iss
+        // Reads the next line of file into the handle and into the iss and tokens
         bool GetLine();
         // Reset the file stream to the start of the file
         void ResetStream();
         // Tries to find s in the current file and if found outputs the line into internal iss
+        // and tokens. The search starts from the beginning of the file.
         bool Find(const std::string& s);
-        // Tries to find s in the current line and if found outputs into internal iss
+        // Tries to find s in the current line and if found outputs into internal iss and tokens
         bool Find_in_Line(const std::string & s);
+        // All lines of the file and the position of the next line to read, for bulk reading
+        const std::vector<std::string> & Lines() const { return this->file->lines; }
+        std::size_t Next_Line() const { return this->next_line; }
         // Removes a set of chars from a string
         void Remove_Chars_From_String(std::string &str, char* charsToRemove);
         // Removes comments from a string
@@ -6,15 +6,16 @@
 #include <vector>
 
 #include <io/Fileformat.hpp>
+#include <io/Output_Queue.hpp>
 #include "Spirit_Defines.h"
 
 namespace IO
 {
     // ------ Saving Helpers --------------------------------------------
-	// Creates a new thread with String_to_File, which is immediately detached
-	void Dump_to_File(const std::string text, const std::string name);
+	// Queues String_to_File in the asynchronous output (see Output_Queue.hpp)
+	void Dump_to_File(std::string text, const std::string name);
 	// Takes a vector of strings of size "no" and dumps those into a file asynchronously
-	void Dump_to_File(const std::vector<std::string> text, const std::string name, const int no);
+	void Dump_to_File(std::vector<std::string> text, const std::string name, const int no);
 
 	// Dumps the contents of the strings in text vector into file "name"
 	void Strings_to_File(const std::vector<std::string> text, const std::string name, const int no);
@@ -0,0 +1,38 @@
+#pragma once
+#ifndef IO_MAPPED_FILE_H
+#define IO_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace IO
+{
+    /*
+        Read-only view of the contents of a file.
+        The file is memory-mapped where the platform supports it, so that only the parts which
+        are actually accessed are read from disk. Otherwise it is read into memory as a whole.
+        Throws if the file cannot be opened.
+    */
+    class Mapped_File
+    {
+    public:
+        Mapped_File(const std::string & filename);
+        ~Mapped_File();
+
+        Mapped_File(const Mapped_File &) = delete;
+        Mapped_File & operator=(const Mapped_File &) = delete;
+
+        const char * data() const { return this->begin; }
+        std::size_t size() const { return this->length; }
+
+    private:
+        const char * begin;
+        std::size_t length;
+        // Used if the file could not be mapped
+        std::vector<char> buffer;
+        bool mapped;
+    };
+}
+
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef IO_OVF_FILE_H
+#define IO_OVF_FILE_H
+
+#include "Spirit_Defines.h"
+#include <engine/Vectormath_Defines.hpp>
+#include <data/Geometry.hpp>
+#include <io/Fileformat.hpp>
+#include <io/Mapped_File.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace IO
+{
+    /*
+        Reading of OOMMF OVF 2.0 files with one or more segments (e.g. the images of a chain).
+        The file is memory-mapped and indexed in a single pass over the segment headers, so that
+        any segment can be read without scanning the file again. The data of a segment is
+        converted in parallel, for binary data directly from the mapped file and for text data
+        in chunks of lines.
+        Besides the standard "text" and "binary" representations, Spirit writes two extensions:
+        "Binary 4 Zlib", i.e. binary data compressed with zlib, and "Octahedral 2 [Zlib]", in
+        which unit vectors are encoded as two 2 byte integers on the unfolded octahedron. A
+        compressed data block starts with its uncompressed and compressed sizes (8 byte each).
+    */
+    class OVF_File
+    {
+    public:
+        // Opens and indexes the file, throws if it is not a valid OVF 2.0 file
+        OVF_File(const std::string & filename);
+
+        // Number of segments found in the file
+        int n_segments() const;
+        // Number of vectors in a segment
+        int n_values(int idx_segment) const;
+        // Reads the data of a segment into vf
+        void Read_Segment(vectorfield & vf, const Data::Geometry & geometry, int idx_segment = 0) const;
+
+    private:
+        struct Segment
+        {
+            std::string title;
+            std::string meshtype;
+            int valuedim = 0;
+            std::array<int, 3> nodes{ {0, 0, 0} };
+            int pointcount = 0;
+            // "text", "binary" (4 or 8 bytes per value) or "octahedral" (2 bytes per value)
+            std::string representation;
+            int binary_length = 0;
+            // Whether the binary data is compressed with zlib
+            bool compressed = false;
+            // Number of vectors and location of the data block in the file
+            int n_values = 0;
+            std::size_t data_begin = 0;
+            std::size_t data_end = 0;
+        };
+
+        std::size_t Index_Segment(std::size_t pos, Segment & segment);
+        void Read_Binary(const Segment & segment, vectorfield & vf, int n) const;
+        void Read_Text(const Segment & segment, vectorfield & vf, int n) const;
+
+        std::string filename;
+        std::unique_ptr<Mapped_File> file;
+        std::vector<Segment> segments;
+    };
+
+    // Writes one OVF 2.0 segment per vectorfield. With append, the segments are added to the
+    // segments already in the file.
+    void Write_OVF( const std::vector<const vectorfield *> & vfs,
+                    const std::vector<const Data::Geometry *> & geometries,
+                    const std::string & filename, VF_FileFormat format,
+                    const std::string & comment, bool append = false );
+
+    // Writes a single OVF 2.0 segment with the scaled values of several scalar fields (e.g. the
+    // energy contributions per spin), i.e. with one value dimension per field
+    void Write_OVF_Scalars( const std::vector<const scalarfield *> & fields,
+                            const std::vector<std::string> & labels,
+                            const Data::Geometry & geometry, const std::string & filename,
+                            VF_FileFormat format, const std::string & comment, scalar scale = 1 );
+}
+
+#endif
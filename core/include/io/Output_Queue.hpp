@@ -0,0 +1,58 @@
+#pragma once
+#ifndef IO_OUTPUT_QUEUE_H
+#define IO_OUTPUT_QUEUE_H
+
+#include "Spirit_Defines.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace IO
+{
+    /*
+        Asynchronous output.
+        Tasks writing to files are handed to a small pool of writer threads, so that a simulation
+        does not wait for the formatting and writing of its output. A task should only use data it
+        owns, i.e. a snapshot of the spins rather than a reference to them.
+        Each file is always served by the same writer, so the tasks writing to one file are executed
+        in the order in which they were queued. The memory held by the queued tasks is bounded:
+        if the limit is reached, Enqueue blocks until enough output has been written.
+        Without SPIRIT_USE_THREADS the tasks are executed immediately.
+    */
+    namespace Output_Queue
+    {
+        // Queue a task which writes to the file "filename", holding n_bytes of data
+        void Enqueue(const std::string & filename, std::function<void()> task, std::size_t n_bytes = 0);
+        // Block until all queued tasks have been executed
+        void Drain();
+
+        // While it exists, the tasks queued by the calling thread belong to the group, so that
+        //      e.g. a Method can wait for its own output only. Groups can be nested, in which
+        //      case a task belongs to the innermost one.
+        class Group
+        {
+        public:
+            Group();
+            ~Group();
+            Group(const Group &) = delete;
+            Group & operator=(const Group &) = delete;
+
+            // Block until all tasks of the group have been executed
+            void Drain();
+
+        private:
+            friend void Enqueue(const std::string & filename, std::function<void()> task, std::size_t n_bytes);
+            Group * previous;
+            // Number of tasks of the group which have not yet been executed
+            std::shared_ptr<std::size_t> n_pending;
+        };
+
+        // Maximum amount of memory held by queued tasks [bytes]
+        void Set_Max_Bytes(std::size_t max_bytes);
+        std::size_t Get_Max_Bytes();
+    }
+}
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+#ifndef IO_OUTPUT_SELECTION_H
+#define IO_OUTPUT_SELECTION_H
+
+#include "Spirit_Defines.h"
+#include <engine/Vectormath_Defines.hpp>
+#include <data/Geometry.hpp>
+#include <data/Parameters_Method.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace IO
+{
+    /*
+        The spins of a system which are written to the spin configuration output according to a
+        Data::Output_Filter, together with the geometry of these spins.
+        With a cell stride, the written spins form a lattice with correspondingly longer bravais
+        vectors, which is used as their geometry (e.g. for the OVF header). A region further
+        reduces the positions of this geometry to the spins inside the region and its bounds to
+        theirs, so that it is written as an irregular mesh.
+        The selection is built once for a geometry and filter and then shared by the snapshots
+        of all outputs, so that taking a snapshot and writing it scale with the number of
+        selected spins rather than with nos. Without a filter, the geometry itself is shared,
+        so it must not be changed while output using it is queued.
+    */
+    class Output_Selection
+    {
+    public:
+        Output_Selection(std::shared_ptr<const Data::Geometry> geometry, const Data::Output_Filter & filter);
+
+        // Whether the selection is still valid for the geometry and filter
+        bool Matches(const Data::Geometry & geometry, const Data::Output_Filter & filter) const;
+        // Number of selected spins
+        int n_selected() const;
+        // Indices of the selected spins (empty if all spins are selected)
+        const intfield & indices() const;
+        // Geometry of the selected spins, to be passed to the writers
+        std::shared_ptr<const Data::Geometry> geometry() const;
+        // Copies the selected spins of vf into a new vectorfield
+        std::shared_ptr<vectorfield> Gather(const vectorfield & vf) const;
+
+    private:
+        Data::Output_Filter filter;
+        // Lattice of the geometry the selection was built for
+        std::vector<Vector3> bravais_vectors;
+        intfield n_cells;
+        std::vector<Vector3> cell_atoms;
+        scalar lattice_constant;
+
+        bool all;
+        intfield selected;
+        std::shared_ptr<const Data::Geometry> selected_geometry;
+    };
+}
+
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef IO_TRAJECTORY_H
+#define IO_TRAJECTORY_H
+
+#include "Spirit_Defines.h"
+#include <Spirit/IO.h>
+#include <engine/Vectormath_Defines.hpp>
+#include <data/Geometry.hpp>
+#include <io/Mapped_File.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace IO
+{
+    /*
+        Binary trajectory files, to which the frames of a simulation are appended.
+        The file starts with a header containing the geometry (numbers of cells and atoms and the
+        positions) and the names of the energy contributions. It is followed by the frames, which
+        all have the same size: iteration, time, optionally the total energy and its contributions,
+        and the spins in the encoding chosen when the file was created. Frame k is therefore
+        located at header_size + k*frame_size, so that any frame can be accessed directly and the
+        number of frames follows from the file size. An incomplete frame at the end of the file,
+        e.g. from an aborted simulation, is ignored and overwritten by the next appended frame.
+    */
+
+    enum class Trajectory_Encoding
+    {
+        // 8 bytes per spin component
+        Float64     = IO_Trajectory_Float64,
+        // 4 bytes per spin component
+        Float32     = IO_Trajectory_Float32,
+        // Spin components as 2 byte integers, renormalised when read (precision ~1e-4)
+        Quantised16 = IO_Trajectory_Quantised16
+    };
+
+    struct Trajectory_Frame
+    {
+        std::int64_t iteration = 0;
+        scalar time = 0;
+        // Total energy and its contributions, only present if the file contains energies
+        scalar energy = 0;
+        std::vector<scalar> energy_contributions;
+        vectorfield spins;
+    };
+
+    // Appends a frame to a trajectory file. If the file does not exist, it is created with the
+    // given encoding and energy contributions (energy_names), and with energies only if
+    // with_energies is set. Otherwise the frame has to match the file.
+    void Append_Trajectory_Frame( const std::string & filename, const Data::Geometry & geometry,
+                                  const Trajectory_Frame & frame, Trajectory_Encoding encoding,
+                                  bool with_energies, const std::vector<std::string> & energy_names );
+
+    class Trajectory_File
+    {
+    public:
+        // Opens the file and reads the header, throws if it is not a valid trajectory file
+        Trajectory_File(const std::string & filename);
+
+        int n_frames() const { return this->frames; }
+        int nos() const { return this->n_spins; }
+        Trajectory_Encoding encoding() const { return this->spin_encoding; }
+        bool with_energies() const { return this->energies; }
+        const std::vector<std::string> & energy_names() const { return this->contributions; }
+        // Numbers of basis cells and of atoms per cell of the geometry the file was written with
+        const std::vector<int> & n_cells() const { return this->cells; }
+        int n_cell_atoms() const { return this->cell_atoms; }
+        const vectorfield & positions() const { return this->atom_positions; }
+        // Bytes of the header and of each frame, as stored in the file
+        std::size_t header_size() const { return this->header_bytes; }
+        std::size_t frame_size() const { return this->frame_bytes; }
+
+        // Reads a frame (0 <= idx_frame < n_frames)
+        void Read_Frame(int idx_frame, Trajectory_Frame & frame) const;
+
+    private:
+        std::string filename;
+        std::unique_ptr<Mapped_File> file;
+        Trajectory_Encoding spin_encoding;
+        bool energies;
+        std::vector<std::string> contributions;
+        int n_spins;
+        int cell_atoms;
+        std::vector<int> cells;
+        vectorfield atom_positions;
+        std::size_t header_bytes;
+        std::size_t frame_bytes;
+        int frames;
+    };
+}
+
+#endif
@@ -17,11 +17,26 @@ namespace Utility
 		typedef std::function< bool(const Vector3&, const Vector3&) > filterfunction;
 		filterfunction const defaultfilter = [](const Vector3& spin, const Vector3& pos)->bool { return true; };
 		void filter_to_mask(const vectorfield & spins, const vectorfield & positions, filterfunction filter, intfield & mask);
+		// Filter for the positions within a region around position: a box of the given half-widths,
+		// a cylinder along z and a sphere, where negative values mean no cut. If inverted, the
+		// filter selects the positions outside of the region.
+		filterfunction Filter_Region(Vector3 position, Vector3 r_cut_rectangular, scalar r_cut_cylindrical, scalar r_cut_spherical, bool inverted);
 
 		// TODO: replace the Spin_System references with smart pointers??
 
 		void Move(vectorfield& configuration, const Data::Geometry & geometry, int da, int db, int dc);
 
+		// How a configuration is mapped onto a resized lattice
+		enum class Remap_Mode
+		{
+			Tile   = Geometry_Remap_Tile,   // Repeat the previous configuration periodically
+			Centre = Geometry_Remap_Centre  // Place the previous configuration in the centre and extend its edges
+		};
+		// Calculate for every spin of a new geometry the index of the corresponding spin of the previous geometry
+		intfield Remap_Indices(const Data::Geometry & geometry_old, const Data::Geometry & geometry_new, Remap_Mode mode);
+		// Map a configuration onto a new geometry, using the indices calculated by Remap_Indices
+		void Remap(vectorfield & configuration, const intfield & indices_old);
+
 		// Insert data in certain region
 		void Insert(Data::Spin_System &s, const vectorfield& configuration, int shift = 0, filterfunction filter = defaultfilter);
 
@@ -18,6 +18,7 @@ namespace Utility
         Non_existing_Chain,
         Input_parse_failed,
         Bad_File_Content,
+        Insufficient_Memory,
 		Standard_Exception,
 		CUDA_Error,
 		Unknown_Exception
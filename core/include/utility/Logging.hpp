@@ -9,6 +9,9 @@
 #include <vector>
 #include <chrono>
 #include <string>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
 
 // Define Log as the singleton instance, so that messages can be sent with Log(..., message, ...)
@@ -70,8 +73,19 @@ namespace Utility
 	std::string LogBlockToString(std::vector<LogEntry> entries, bool braces_separators = true);
 
 	/*
-		The Logging Handler keeps all Log Entries and provides methods to dump or append
-		the entire Log to a file.
+		The Logging Handler keeps the Log Entries and provides methods to dump or append
+		the Log to a file.
+		The entries are kept in a ring buffer of fixed size, so that the memory used by the Log
+		is bounded and only the most recent entries can be retrieved. Each slot of the buffer
+		is guarded by its own spin lock, so that threads sending messages at the same time
+		only wait for each other if they store into the same slot. A slot records which entry
+		it holds once the entry has been stored, so that the Log file is only written up to
+		the first entry which is still being stored.
+		Messages which are neither printed to the console nor saved to file are counted but
+		discarded, and Accepts can be used to skip creating them in the first place.
+		The entries are formatted for the Log file when they are written, which is done by
+		the asynchronous output (see IO::Output_Queue). With MPI, only rank 0 prints to the
+		console and writes the Log file.
 		The Handler is a singleton.
 	*/
 	class LoggingHandler
@@ -83,8 +97,13 @@ namespace Utility
 		void SendBlock(Log_Level level, Log_Sender sender, std::vector<std::string> messages, int idx_image=-1, int idx_chain=-1);
 		void operator() (Log_Level level, Log_Sender sender, std::vector<std::string> messages, int idx_image=-1, int idx_chain=-1);
 
-		// Get the Log's entries
-		std::vector<LogEntry> GetEntries();
+		// Whether a message of the given level is printed to the console or saved to file,
+		// i.e. whether it is kept in the Log
+		bool Accepts(Log_Level level) const;
+
+		// Get the Log's entries with index in [idx_first, idx_last) which are still in the
+		// buffer (idx_last=-1: up to the newest entry)
+		std::vector<LogEntry> GetEntries(int idx_first=0, int idx_last=-1);
 		
 		// Dumps the log to File fileName
 		void Append_to_File();
@@ -114,12 +133,16 @@ namespace Utility
 		bool save_neighbours_final;
 		// Name of the Log file
 		std::string fileName;
-		// Number of Log entries
-		int n_entries;
+		// Rank of this process with MPI (0 without), set by Engine::Decomposition
+		std::atomic<int> rank;
+		// Number of Log entries, including discarded messages
+		std::atomic<int> n_entries;
 		// Number of errors in the Log
-		int n_errors;
+		std::atomic<int> n_errors;
 		// Number of warnings in the Log
-		int n_warnings;
+		std::atomic<int> n_warnings;
+		// Number of entries kept in the ring buffer
+		static const int buffer_size = 1 << 14;
 		// Length of the tags before each message in spaces
 		const std::string tags_space = "                                                 ";
 
@@ -138,12 +161,54 @@ namespace Utility
 
 		// Get the Log's entries, filtered for level, sender and indices
 		std::vector<LogEntry> Filter(Log_Level level=Log_Level::All, Log_Sender sender=Log_Sender::All, int idx_image=-1, int idx_chain=-1);
-		
-		int no_dumped;
-		std::vector<LogEntry> log_entries;
 
-		// Mutex for thread-safety
-		std::mutex mutex;
+		// Store an entry in the ring buffer and print it to the console if requested
+		void Store(LogEntry entry);
+		// Count a discarded message
+		void Skip();
+
+		// Collect the kept entries with index in [idx_first, idx_last) for the Log file. Returns
+		// the index of the first entry which is still being stored (or idx_last)
+		int Collect(int idx_first, int idx_last, std::vector<LogEntry> & entries, int & n_lost);
+
+		// A slot of the ring buffer, holding the entry with the given index
+		struct Slot
+		{
+			std::atomic<bool> busy;
+			int idx_entry;
+			bool kept;
+			LogEntry entry;
+		};
+		std::unique_ptr<Slot[]> log_entries;
+
+		// Number of entries which have been written to file
+		std::atomic<int> no_dumped;
+		// Mutex for collecting the entries for the Log file, so that entries are written once and in order
+		std::mutex mutex_file;
+
+		// Entries collected for the Log file which have not yet been written. They are queued
+		// while mutex_file is held and taken in order by the writing tasks, so that the
+		// asynchronous output can be waited for without holding mutex_file.
+		struct File_Batch
+		{
+			std::string filename;
+			bool append;
+			Log_Level level_file;
+			int n_lost;
+			std::vector<LogEntry> entries;
+		};
+		struct Pending_Batches
+		{
+			std::mutex mutex;
+			std::deque<File_Batch> batches;
+		};
+		std::shared_ptr<Pending_Batches> pending;
+		// Collect the entries for the Log file (all or, if append, the ones not yet written) and
+		// queue writing them
+		void Write_to_File(bool append);
+
+		// Mutex for the console output, so that lines are not interleaved
+		std::mutex mutex_console;
 	
 	public:
 		// C++ 11
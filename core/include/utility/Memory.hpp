@@ -0,0 +1,90 @@
+#pragma once
+#ifndef UTILITY_MEMORY_H
+#define UTILITY_MEMORY_H
+
+#include "Spirit_Defines.h"
+
+#include <Eigen/Core>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Utility
+{
+    namespace Memory
+    {
+        // Bytes held by the heap buffer of a container (counted by capacity)
+        template<typename T, typename Allocator>
+        std::size_t Bytes(const std::vector<T, Allocator> & v)
+        {
+            return v.capacity() * sizeof(T);
+        }
+
+        // Bytes held by a container of containers, including the inner buffers
+        template<typename T, typename Allocator_Inner, typename Allocator>
+        std::size_t Bytes(const std::vector<std::vector<T, Allocator_Inner>, Allocator> & v)
+        {
+            std::size_t bytes = v.capacity() * sizeof(std::vector<T, Allocator_Inner>);
+            for (auto & inner : v)
+                bytes += Bytes(inner);
+            return bytes;
+        }
+
+        // Bytes held by a dynamically sized Eigen matrix or vector
+        template<typename Derived>
+        std::size_t Bytes(const Eigen::PlainObjectBase<Derived> & m)
+        {
+            return m.size() * sizeof(typename Derived::Scalar);
+        }
+
+        // A node of a hierarchical report of the memory held by a component and its parts
+        class Report
+        {
+        public:
+            Report(const std::string & name = "");
+
+            // Add the bytes of a buffer of this component
+            void Add(const std::string & name, std::size_t bytes);
+            // The report of a part of this component, which is created if it does not exist yet
+            Report & Child(const std::string & name);
+
+            // Bytes held by this component, including its parts
+            std::size_t Bytes() const;
+
+            // Lines of a log block listing the components as a tree, down to the given depth
+            //      (all if negative). Buffers below the minimum size are not listed separately.
+            std::vector<std::string> Lines(int max_depth = -1, std::size_t min_bytes = 0) const;
+
+            // Visit the components in pre-order with their depth (this component has depth 0)
+            template<typename Function>
+            void Visit(Function function, int depth = 0) const
+            {
+                function(*this, depth);
+                for (auto & child : this->children)
+                    child->Visit(function, depth + 1);
+            }
+
+            std::string name;
+            // Bytes of this component which are not attributed to a part
+            std::size_t bytes;
+            std::vector<std::unique_ptr<Report>> children;
+
+        private:
+            void Lines(std::vector<std::string> & lines, int depth, int max_depth, std::size_t min_bytes) const;
+        };
+
+        // Human-readable size, e.g. "12.3 MiB"
+        std::string Format_Bytes(std::size_t bytes);
+
+        // Physical memory currently available to the process [bytes], 0 if it cannot be determined
+        std::size_t Available();
+
+        // Throw if a projected allocation exceeds the available memory
+        //      The allocation is described by what, e.g. "GNEB workspace".
+        void Require(const std::string & what, std::size_t bytes);
+    }
+}
+
+#endif
@@ -0,0 +1,90 @@
+#pragma once
+#ifndef UTILITY_PROFILING_H
+#define UTILITY_PROFILING_H
+
+#include "Spirit_Defines.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Time the enclosing scope under the given name (a string literal), if the calling thread is
+//      collecting timings. Compiles to nothing if SPIRIT_ENABLE_TIMINGS is not defined.
+#ifdef SPIRIT_ENABLE_TIMINGS
+    #define SPIRIT_TIMER(name) Utility::Profiling::Scoped_Timer spirit_scoped_timer(name)
+#else
+    #define SPIRIT_TIMER(name)
+#endif
+
+namespace Utility
+{
+    namespace Profiling
+    {
+        // Number of calls and time spent in a timed scope
+        struct Timer_Entry
+        {
+            std::string name;
+            long long count;
+            // Time spent in the scope, excluding the time spent in timed scopes inside of it [s]
+            scalar seconds;
+        };
+
+        // Timings collected by the timed scopes of the threads which collect into it
+        //      Entries may be read while other threads add to them.
+        class Timings
+        {
+        public:
+            void Add(const char * name, std::chrono::steady_clock::duration duration);
+            void Reset();
+
+            // Entries merged by name, sorted by time spent (descending)
+            std::vector<Timer_Entry> Entries() const;
+            // Lines of a log block listing the entries and their share of the total time
+            std::vector<std::string> Summary() const;
+
+        private:
+            struct Entry
+            {
+                const char * name;
+                long long count;
+                std::chrono::steady_clock::duration duration;
+            };
+            std::vector<Entry> entries;
+            mutable std::mutex mutex;
+        };
+
+        class Scoped_Timer;
+
+        // While it exists, the timed scopes of the calling thread add to the given timings
+        class Collector
+        {
+        public:
+            Collector(Timings & timings);
+            ~Collector();
+
+        private:
+            Timings * previous_timings;
+            Scoped_Timer * previous_timer;
+        };
+
+        // Times its lifetime, if the calling thread is collecting timings. The time spent in
+        //      timed scopes inside of it is not counted, so that the entries add up to the
+        //      total time spent in timed scopes.
+        class Scoped_Timer
+        {
+        public:
+            Scoped_Timer(const char * name);
+            ~Scoped_Timer();
+
+        private:
+            const char * name;
+            Timings * timings;
+            Scoped_Timer * parent;
+            std::chrono::steady_clock::time_point start;
+            std::chrono::steady_clock::duration children;
+        };
+    }
+}
+
+#endif
@@ -2,6 +2,10 @@ import spirit.spiritlib as spiritlib
 import spirit.parameters as parameters
 import ctypes
 
+from spirit.scalar import scalar
+from spirit import system
+from numpy import zeros, float32, ascontiguousarray
+
 ### Load Library
 _spirit = spiritlib.LoadSpiritLibrary()
 
@@ -119,12 +123,9 @@ _Get_Rx.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_float), ctypes.c_in
 _Get_Rx.restype  = None
 def Get_Rx(p_state, idx_chain=-1):
     noi = Get_NOI(p_state, idx_chain)
-    arrayX = ctypes.c_float * noi
-    Rx = [0]*noi
-    _Rx = arrayX(*Rx)
-    _Get_Rx(ctypes.c_void_p(p_state), _Rx, ctypes.c_int(idx_chain))
-    for i in range(noi):
-        Rx[i] = _Rx[i]
+    Rx = zeros(noi, dtype=float32)
+    _Get_Rx(ctypes.c_void_p(p_state), Rx.ctypes.data_as(ctypes.POINTER(ctypes.c_float)), 
+            ctypes.c_int(idx_chain))
     return Rx
 
 ### Get Rx interpolated
@@ -135,8 +136,9 @@ def Get_Rx_Interpolated(p_state, idx_chain=-1):
     noi = Get_NOI(p_state, idx_chain)
     n_interp = parameters.gneb.getEnergyInterpolations(p_state, idx_chain)
     len_Rx = noi + (noi-1)*n_interp
-    Rx = (len_Rx*ctypes.c_float)()
-    _Get_Rx_Interpolated(ctypes.c_void_p(p_state), Rx, ctypes.c_int(idx_chain))
+    Rx = zeros(len_Rx, dtype=float32)
+    _Get_Rx_Interpolated(ctypes.c_void_p(p_state), Rx.ctypes.data_as(ctypes.POINTER(ctypes.c_float)), 
+                         ctypes.c_int(idx_chain))
     return Rx
 
 ### Get Energy
@@ -145,8 +147,9 @@ _Get_Energy.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_float), ctypes.
 _Get_Energy.restype  = None
 def Get_Energy(p_state, idx_chain=-1):
     noi = Get_NOI(p_state, idx_chain)
-    Energy = (noi*ctypes.c_float)()
-    _Get_Energy(ctypes.c_void_p(p_state), Energy, ctypes.c_int(idx_chain))
+    Energy = zeros(noi, dtype=float32)
+    _Get_Energy(ctypes.c_void_p(p_state), Energy.ctypes.data_as(ctypes.POINTER(ctypes.c_float)), 
+                ctypes.c_int(idx_chain))
     return Energy
 
 ### Get Energy Interpolated
@@ -157,6 +160,31 @@ def Get_Energy_Interpolated(p_state, idx_chain=-1):
     noi = Get_NOI(p_state, idx_chain)
     n_interp = parameters.gneb.getEnergyInterpolations(p_state, idx_chain)
     len_Energy = noi + (noi-1)*n_interp
-    Energy_interp = (len_Energy*ctypes.c_float)()
-    _Get_Energy_Interpolated(ctypes.c_void_p(p_state), Energy_interp, ctypes.c_int(idx_chain))
-    return Energy_interp
\ No newline at end of file
+    Energy_interp = zeros(len_Energy, dtype=float32)
+    _Get_Energy_Interpolated(ctypes.c_void_p(p_state), 
+                             Energy_interp.ctypes.data_as(ctypes.POINTER(ctypes.c_float)), 
+                             ctypes.c_int(idx_chain))
+    return Energy_interp
+
+### Get the Spin Directions of all images (noi, nos, 3) in a single call
+_Get_Spin_Directions          = _spirit.Chain_Get_Spin_Directions
+_Get_Spin_Directions.argtypes = [ctypes.c_void_p, ctypes.POINTER(scalar), ctypes.c_int]
+_Get_Spin_Directions.restype  = None
+def Get_Spin_Directions(p_state, idx_chain=-1):
+    noi = Get_NOI(p_state, idx_chain)
+    nos = system.Get_NOS(p_state, -1, idx_chain)
+    spins = zeros((noi, nos, 3), dtype=scalar)
+    _Get_Spin_Directions(ctypes.c_void_p(p_state), spins.ctypes.data_as(ctypes.POINTER(scalar)), 
+                         ctypes.c_int(idx_chain))
+    return spins
+
+### Set the Spin Directions of all images (noi, nos, 3), updating their energies and Rx
+_Set_Spin_Directions          = _spirit.Chain_Set_Spin_Directions
+_Set_Spin_Directions.argtypes = [ctypes.c_void_p, ctypes.POINTER(scalar), ctypes.c_int]
+_Set_Spin_Directions.restype  = None
+def Set_Spin_Directions(p_state, spins, idx_chain=-1):
+    noi = Get_NOI(p_state, idx_chain)
+    nos = system.Get_NOS(p_state, -1, idx_chain)
+    spins = ascontiguousarray(spins, dtype=scalar).reshape(noi, nos, 3)
+    _Set_Spin_Directions(ctypes.c_void_p(p_state), spins.ctypes.data_as(ctypes.POINTER(scalar)), 
+                         ctypes.c_int(idx_chain))
\ No newline at end of file
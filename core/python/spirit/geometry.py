@@ -11,6 +11,20 @@ from spirit import system
 
 import numpy as np
 
+### Remap modes for resized lattices
+Remap_Tile   = 0
+Remap_Centre = 1
+
+### Set number of basis cells
+_Set_N_Cells          = _spirit.Geometry_Set_N_Cells
+_Set_N_Cells.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_int), ctypes.c_int]
+_Set_N_Cells.restype  = None
+def Set_N_Cells(p_state, n_cells=None, remap_mode=Remap_Tile):
+    if n_cells is None:
+        n_cells = [1, 1, 1]
+    n_cells = (3*ctypes.c_int)(*n_cells)
+    _Set_N_Cells(ctypes.c_void_p(p_state), n_cells, ctypes.c_int(remap_mode))
+
 ### Get Bounds
 _Get_Bounds          = _spirit.Geometry_Get_Bounds
 _Get_Bounds.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_float), 
@@ -85,6 +99,14 @@ def Get_Dimensionality(p_state, idx_image=-1, idx_chain=-1):
     return int(_Get_Dimensionality(ctypes.c_void_p(p_state), ctypes.c_int(idx_image), 
                                    ctypes.c_int(idx_chain)))
 
+### Get number of atoms in the basis cell
+_Get_N_Cell_Atoms            = _spirit.Geometry_Get_N_Cell_Atoms
+_Get_N_Cell_Atoms.argtypes   = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Get_N_Cell_Atoms.restype    = ctypes.c_int
+def Get_N_Cell_Atoms(p_state, idx_image=-1, idx_chain=-1):
+    return int(_Get_N_Cell_Atoms(ctypes.c_void_p(p_state), ctypes.c_int(idx_image), 
+                                 ctypes.c_int(idx_chain)))
+
 ### Get Pointer to Spin Positions
 # NOTE: Changing the values of the array_view one can alter the value of the data of the state
 _Get_Positions            = _spirit.Geometry_Get_Positions
@@ -92,14 +114,9 @@ _Get_Positions.argtypes   = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
 _Get_Positions.restype    = ctypes.POINTER(scalar)
 def Get_Positions(p_state, idx_image=-1, idx_chain=-1):
     nos = system.Get_NOS(p_state, idx_image, idx_chain)
-    ArrayType = scalar*3*nos
     Data = _Get_Positions(ctypes.c_void_p(p_state), 
                                ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
-    array_pointer = ctypes.cast(Data, ctypes.POINTER(ArrayType))
-    array = np.frombuffer(array_pointer.contents, dtype=scalar)
-    array_view = array.view()
-    array_view.shape = (nos, 3)
-    return array_view
+    return spiritlib.ArrayView(Data, scalar, (nos, 3))
 
 ### Get Pointer to atom types
 # NOTE: Changing the values of the array_view one can alter the value of the data of the state
@@ -108,10 +125,6 @@ _Get_Atom_Types.argtypes   = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
 _Get_Atom_Types.restype    = ctypes.POINTER(ctypes.c_int)
 def Get_Atom_Types(p_state, idx_image=-1, idx_chain=-1):
     nos = system.Get_NOS(p_state, idx_image, idx_chain)
-    ArrayType = ctypes.c_int*nos
     Data = _Get_Atom_Types(ctypes.c_void_p(p_state), 
                            ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
-    array_pointer = ctypes.cast(Data, ctypes.POINTER(ArrayType))
-    array = np.frombuffer(array_pointer.contents, dtype=ctypes.c_int)
-    array_view = array.view()
-    return array_view
\ No newline at end of file
+    return spiritlib.ArrayView(Data, ctypes.c_int, (nos,))
\ No newline at end of file
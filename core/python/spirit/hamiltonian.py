@@ -1,6 +1,10 @@
 import spirit.spiritlib as spiritlib
 import ctypes
 
+from spirit.scalar import scalar
+from spirit import geometry
+from numpy import ascontiguousarray
+
 ### Load Library
 _spirit = spiritlib.LoadSpiritLibrary()
 
@@ -30,3 +34,27 @@ def Set_Anisotropy(p_state, magnitude, direction, idx_image=-1, idx_chain=-1):
     vec3 = ctypes.c_float * 3
     _Set_Anisotropy(ctypes.c_void_p(p_state), ctypes.c_float(magnitude), vec3(*direction), 
                     ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+
+### Get Pointer to the magnetic moments of the atoms of the basis cell
+# NOTE: Changing the values of the array_view one can alter the value of the data of the state,
+#       but the energy and effective field are only updated by Set_mu_s_per_Cell_Atom
+_Get_mu_s_per_Cell_Atom             = _spirit.Hamiltonian_Get_mu_s_per_Cell_Atom
+_Get_mu_s_per_Cell_Atom.argtypes    = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Get_mu_s_per_Cell_Atom.restype     = ctypes.POINTER(scalar)
+def Get_mu_s_per_Cell_Atom(p_state, idx_image=-1, idx_chain=-1):
+    n_cell_atoms = geometry.Get_N_Cell_Atoms(p_state, idx_image, idx_chain)
+    Data = _Get_mu_s_per_Cell_Atom(ctypes.c_void_p(p_state), ctypes.c_int(idx_image), 
+                                   ctypes.c_int(idx_chain))
+    if not Data:
+        return None
+    return spiritlib.ArrayView(Data, scalar, (n_cell_atoms,))
+
+### Set the magnetic moments of the atoms of the basis cell
+_Set_mu_s_per_Cell_Atom             = _spirit.Hamiltonian_Set_mu_s_per_Cell_Atom
+_Set_mu_s_per_Cell_Atom.argtypes    = [ctypes.c_void_p, ctypes.POINTER(scalar), ctypes.c_int, ctypes.c_int]
+_Set_mu_s_per_Cell_Atom.restype     = None
+def Set_mu_s_per_Cell_Atom(p_state, mu_s, idx_image=-1, idx_chain=-1):
+    n_cell_atoms = geometry.Get_N_Cell_Atoms(p_state, idx_image, idx_chain)
+    mu_s = ascontiguousarray(mu_s, dtype=scalar).reshape(n_cell_atoms)
+    _Set_mu_s_per_Cell_Atom(ctypes.c_void_p(p_state), mu_s.ctypes.data_as(ctypes.POINTER(scalar)), 
+                            ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
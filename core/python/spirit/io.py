@@ -4,6 +4,17 @@ import ctypes
 ### Load Library
 _spirit = spiritlib.LoadSpiritLibrary()
 
+### File formats for vector fields
+FILEFORMAT_REGULAR       = 0
+FILEFORMAT_REGULAR_POS   = 1
+FILEFORMAT_CSV           = 2
+FILEFORMAT_CSV_POS       = 3
+FILEFORMAT_OVF_BIN8      = 4
+FILEFORMAT_OVF_BIN4      = 5
+FILEFORMAT_OVF_TEXT      = 6
+FILEFORMAT_OVF_BIN4_ZLIB = 7 # Compressed with zlib
+FILEFORMAT_OVF_OCT16     = 8 # Directions in 2x2 bytes, deviation ~1e-4
+
 ### Read an image from disk
 _Image_Read             = _spirit.IO_Image_Read
 _Image_Read.argtypes    = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_int, 
@@ -66,3 +77,54 @@ def Chain_Append(p_state, filename, fileformat=0, comment=" ", idx_chain=-1):
                  ctypes.c_int(fileformat), ctypes.c_char_p(comment.encode('utf-8')), 
                  ctypes.c_int(idx_chain))
 
+### Write a checkpoint of the whole state, from which a simulation can be continued
+_State_Checkpoint             = _spirit.IO_State_Checkpoint
+_State_Checkpoint.argtypes    = [ctypes.c_void_p, ctypes.c_char_p]
+_State_Checkpoint.restype     = None
+def State_Checkpoint(p_state, filename):
+    _State_Checkpoint(ctypes.c_void_p(p_state), ctypes.c_char_p(filename.encode('utf-8')))
+
+### Restore the state from a checkpoint
+_State_Restore             = _spirit.IO_State_Restore
+_State_Restore.argtypes    = [ctypes.c_void_p, ctypes.c_char_p]
+_State_Restore.restype     = None
+def State_Restore(p_state, filename):
+    _State_Restore(ctypes.c_void_p(p_state), ctypes.c_char_p(filename.encode('utf-8')))
+
+### Encodings of the spins in binary trajectory files
+TRAJECTORY_FLOAT64     = 0
+TRAJECTORY_FLOAT32     = 1
+TRAJECTORY_QUANTISED16 = 2
+
+### Append a frame (iteration, time, energies and spins of an image) to a binary trajectory file
+_Image_Trajectory_Append             = _spirit.IO_Image_Trajectory_Append
+_Image_Trajectory_Append.argtypes    = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, 
+                                        ctypes.c_float, ctypes.c_int, ctypes.c_bool, 
+                                        ctypes.c_int, ctypes.c_int]
+_Image_Trajectory_Append.restype     = None
+def Image_Trajectory_Append(p_state, filename, iteration=0, time=0, encoding=TRAJECTORY_FLOAT32, 
+                            energies=True, idx_image=-1, idx_chain=-1):
+    _Image_Trajectory_Append(ctypes.c_void_p(p_state), ctypes.c_char_p(filename.encode('utf-8')), 
+                             ctypes.c_int(iteration), ctypes.c_float(time), ctypes.c_int(encoding), 
+                             ctypes.c_bool(energies), ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+
+### Get the number of complete frames in a binary trajectory file
+_Trajectory_N_Frames             = _spirit.IO_Trajectory_N_Frames
+_Trajectory_N_Frames.argtypes    = [ctypes.c_void_p, ctypes.c_char_p]
+_Trajectory_N_Frames.restype     = ctypes.c_int
+def Trajectory_N_Frames(p_state, filename):
+    return int(_Trajectory_N_Frames(ctypes.c_void_p(p_state), ctypes.c_char_p(filename.encode('utf-8'))))
+
+### Read a frame of a binary trajectory file into an image, returns (iteration, time, energy)
+_Image_Trajectory_Read_Frame             = _spirit.IO_Image_Trajectory_Read_Frame
+_Image_Trajectory_Read_Frame.argtypes    = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, 
+                                            ctypes.POINTER(ctypes.c_float), ctypes.POINTER(ctypes.c_float), 
+                                            ctypes.c_int, ctypes.c_int]
+_Image_Trajectory_Read_Frame.restype     = ctypes.c_int
+def Image_Trajectory_Read_Frame(p_state, filename, idx_frame, idx_image=-1, idx_chain=-1):
+    time   = ctypes.c_float()
+    energy = ctypes.c_float()
+    iteration = _Image_Trajectory_Read_Frame(ctypes.c_void_p(p_state), ctypes.c_char_p(filename.encode('utf-8')), 
+                                             ctypes.c_int(idx_frame), ctypes.byref(time), ctypes.byref(energy), 
+                                             ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+    return int(iteration), float(time.value), float(energy.value)
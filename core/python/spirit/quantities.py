@@ -1,6 +1,8 @@
 import spirit.spiritlib as spiritlib
 import ctypes
 
+from spirit import system
+
 ### Load Library
 _spirit = spiritlib.LoadSpiritLibrary()
 
@@ -14,3 +16,37 @@ def Get_Magnetization(p_state, idx_image=-1, idx_chain=-1):
     _Get_Magnetization(ctypes.c_void_p(p_state), magnetization,
                        ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
     return [float(i) for i in magnetization]
+
+### Get Topological Charge
+_Get_Topological_Charge          = _spirit.Quantity_Get_Topological_Charge
+_Get_Topological_Charge.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Get_Topological_Charge.restype  = ctypes.c_float
+def Get_Topological_Charge(p_state, idx_image=-1, idx_chain=-1):
+    return float(_Get_Topological_Charge(ctypes.c_void_p(p_state),
+                                         ctypes.c_int(idx_image), ctypes.c_int(idx_chain)))
+
+### Get Topological Charge per triangle
+_Get_Topological_Charge_Density          = _spirit.Quantity_Get_Topological_Charge_Density
+_Get_Topological_Charge_Density.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_float),
+                                            ctypes.POINTER(ctypes.c_int), ctypes.c_int, ctypes.c_int]
+_Get_Topological_Charge_Density.restype  = ctypes.c_int
+def Get_Topological_Charge_Density(p_state, idx_image=-1, idx_chain=-1):
+    n_triangles = _Get_Topological_Charge_Density(ctypes.c_void_p(p_state), None, None,
+                                                  ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+    charge_density   = (n_triangles*ctypes.c_float)()
+    triangle_indices = (3*n_triangles*ctypes.c_int)()
+    _Get_Topological_Charge_Density(ctypes.c_void_p(p_state), charge_density, triangle_indices,
+                                    ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+    return [float(i) for i in charge_density], [[int(triangle_indices[3*i+k]) for k in range(3)] for i in range(n_triangles)]
+
+### Get Topological Charge per spin
+_Get_Topological_Charge_Density_per_Spin          = _spirit.Quantity_Get_Topological_Charge_Density_per_Spin
+_Get_Topological_Charge_Density_per_Spin.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_float),
+                                                     ctypes.c_int, ctypes.c_int]
+_Get_Topological_Charge_Density_per_Spin.restype  = None
+def Get_Topological_Charge_Density_per_Spin(p_state, idx_image=-1, idx_chain=-1):
+    nos = system.Get_NOS(p_state, idx_image, idx_chain)
+    charge_density = (nos*ctypes.c_float)()
+    _Get_Topological_Charge_Density_per_Spin(ctypes.c_void_p(p_state), charge_density,
+                                             ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+    return [float(i) for i in charge_density]
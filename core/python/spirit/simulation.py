@@ -4,6 +4,9 @@ import ctypes
 ### Load Library
 _spirit = spiritlib.LoadSpiritLibrary()
 
+from spirit.scalar import scalar
+from numpy import zeros, ascontiguousarray
+
 import threading
 
 ###     We use a thread for PlayPause, so that KeyboardInterrupt can be forwarded to the CDLL call
@@ -49,6 +52,107 @@ _Stop_All.restype   = None
 def Stop_All(p_state):
     _Stop_All(ctypes.c_void_p(p_state))
 
+### Start a simulation in the background, returns a handle (-1 if it could not be started)
+###     The handle is released once Wait_Async or Finished_Async has found the simulation to be finished
+_Start_Async            = _spirit.Simulation_Start_Async
+_Start_Async.argtypes   = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int, 
+                           ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.c_int]
+_Start_Async.restype    = ctypes.c_int
+def Start_Async(p_state, method_type, solver_type, n_iterations=-1, n_iterations_log=-1, 
+                n_threads=-1, idx_image=-1, idx_chain=-1):
+    return int(_Start_Async(ctypes.c_void_p(p_state), 
+                            ctypes.c_char_p(method_type.encode('utf-8')), 
+                            ctypes.c_char_p(solver_type.encode('utf-8')), 
+                            ctypes.c_int(n_iterations), ctypes.c_int(n_iterations_log), 
+                            ctypes.c_int(n_threads), ctypes.c_int(idx_image), ctypes.c_int(idx_chain)))
+
+### Wait for a background simulation, at most timeout seconds (negative: no limit)
+###     Returns whether the simulation has finished
+_Wait_Async             = _spirit.Simulation_Wait_Async
+_Wait_Async.argtypes    = [ctypes.c_void_p, ctypes.c_int, ctypes.c_float]
+_Wait_Async.restype     = ctypes.c_bool
+def Wait_Async(p_state, handle, timeout=-1):
+    return bool(_Wait_Async(ctypes.c_void_p(p_state), ctypes.c_int(handle), ctypes.c_float(timeout)))
+
+### Stop a background simulation after its current iteration
+_Cancel_Async           = _spirit.Simulation_Cancel_Async
+_Cancel_Async.argtypes  = [ctypes.c_void_p, ctypes.c_int]
+_Cancel_Async.restype   = None
+def Cancel_Async(p_state, handle):
+    _Cancel_Async(ctypes.c_void_p(p_state), ctypes.c_int(handle))
+
+### Check if a background simulation has finished
+_Finished_Async            = _spirit.Simulation_Finished_Async
+_Finished_Async.argtypes   = [ctypes.c_void_p, ctypes.c_int]
+_Finished_Async.restype    = ctypes.c_bool
+def Finished_Async(p_state, handle):
+    return bool(_Finished_Async(ctypes.c_void_p(p_state), ctypes.c_int(handle)))
+
+### Get the number of iterations done by a background simulation
+_Get_Iteration_Async            = _spirit.Simulation_Get_Iteration_Async
+_Get_Iteration_Async.argtypes   = [ctypes.c_void_p, ctypes.c_int]
+_Get_Iteration_Async.restype    = ctypes.c_int
+def Get_Iteration_Async(p_state, handle):
+    return int(_Get_Iteration_Async(ctypes.c_void_p(p_state), ctypes.c_int(handle)))
+
+### Parameters which can be varied in a sweep
+SWEEP_FIELD       = 0 # Magnitude of the external field [T], along its current direction
+SWEEP_TEMPERATURE = 1 # Temperature [K]
+SWEEP_EXCHANGE    = 2 # Factor by which the exchange magnitudes of all shells are scaled
+SWEEP_DMI         = 3 # Factor by which the DMI magnitudes of all shells are scaled
+
+### Run a sweep over parameter points (n_points, n_parameters) with copies of the image
+###     Returns the observables of the final configurations (n_points, 6), i.e. E, M_x, M_y, M_z,
+###     Q and the max. torque component. The rows of points which did not run are NaN.
+_Sweep            = _spirit.Simulation_Sweep
+_Sweep.argtypes   = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int, 
+                     ctypes.POINTER(ctypes.c_int), ctypes.c_int, ctypes.POINTER(scalar), 
+                     ctypes.POINTER(scalar), ctypes.c_bool, ctypes.c_int, ctypes.c_char_p, 
+                     ctypes.c_int, ctypes.c_int, ctypes.c_int]
+_Sweep.restype    = ctypes.c_int
+def Sweep(p_state, method_type, solver_type, parameters, points, warm_start=True, n_workers=-1, 
+          filename="", n_iterations=-1, idx_image=-1, idx_chain=-1):
+    n_parameters = len(parameters)
+    points = ascontiguousarray(points, dtype=scalar).reshape(-1, n_parameters)
+    n_points = points.shape[0]
+    vec_parameters = (ctypes.c_int * n_parameters)(*parameters)
+    results = zeros((n_points, 6), dtype=scalar)
+    spiritlib.WrapFunction(_Sweep, [ctypes.c_void_p(p_state), 
+                                    ctypes.c_char_p(method_type.encode('utf-8')), 
+                                    ctypes.c_char_p(solver_type.encode('utf-8')), 
+                                    ctypes.c_int(n_parameters), vec_parameters, ctypes.c_int(n_points), 
+                                    points.ctypes.data_as(ctypes.POINTER(scalar)), 
+                                    results.ctypes.data_as(ctypes.POINTER(scalar)), 
+                                    ctypes.c_bool(warm_start), ctypes.c_int(n_workers), 
+                                    ctypes.c_char_p(filename.encode('utf-8')), ctypes.c_int(n_iterations), 
+                                    ctypes.c_int(idx_image), ctypes.c_int(idx_chain)])
+    return results
+
+### Get the timings of the Hamiltonian terms and solver phases of the running or last simulation
+###     Returns a list of (name, number of calls, seconds) tuples, sorted by the time spent, which
+###     is empty if the library was built without timings
+TIMING_NAME_LENGTH = 64
+_Get_Timings          = _spirit.Simulation_Get_Timings
+_Get_Timings.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_char_p, 
+                         ctypes.POINTER(ctypes.c_int), ctypes.POINTER(scalar), ctypes.c_int, 
+                         ctypes.c_int]
+_Get_Timings.restype  = ctypes.c_int
+def Get_Timings(p_state, idx_image=-1, idx_chain=-1):
+    n_max = _Get_Timings(ctypes.c_void_p(p_state), ctypes.c_int(0), None, None, None, 
+                         ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+    names   = ctypes.create_string_buffer(max(n_max, 1) * TIMING_NAME_LENGTH)
+    counts  = (ctypes.c_int * max(n_max, 1))()
+    seconds = (scalar * max(n_max, 1))()
+    # A running simulation may have added timers in the meantime
+    n_timings = min(n_max, _Get_Timings(ctypes.c_void_p(p_state), ctypes.c_int(n_max), names, 
+                                        counts, seconds, ctypes.c_int(idx_image), 
+                                        ctypes.c_int(idx_chain)))
+    timings = []
+    for i in range(n_timings):
+        name = names.raw[i*TIMING_NAME_LENGTH:(i+1)*TIMING_NAME_LENGTH].split(b'\0', 1)[0]
+        timings.append((name.decode('utf-8'), counts[i], seconds[i]))
+    return timings
+
 ### Check if a simulation is running on a specific image
 _Running_Image            = _spirit.Simulation_Running_Image
 _Running_Image.argtypes   = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
@@ -36,4 +36,16 @@ def WrapFunction(function, arguments):
     t.daemon = True
     t.start()
     while t.is_alive(): # wait for the thread to exit
-        t.join(.1)
\ No newline at end of file
+        t.join(.1)
+
+### Wrap memory of the library in a numpy array of the given ctypes type and shape, without copying
+###     Changing the values of the array changes the data of the state. The array is only valid as
+###     long as the memory is, e.g. until the geometry of the system is changed.
+def ArrayView(pointer, ctype, shape):
+    import ctypes
+    from numpy import frombuffer, prod
+    n = int(prod(shape))
+    array_pointer = ctypes.cast(pointer, ctypes.POINTER(ctype*n))
+    array = frombuffer(array_pointer.contents, dtype=ctype)
+    array.shape = shape
+    return array
@@ -30,4 +30,24 @@ _State_Delete = _spirit.State_Delete
 _State_Delete.argtypes = [ctypes.c_void_p]
 _State_Delete.restype = None
 def delete(p_state):
-    return _State_Delete(ctypes.c_void_p(p_state))
\ No newline at end of file
+    return _State_Delete(ctypes.c_void_p(p_state))
+
+### Memory report
+_Memory_Name_Length = 64
+_Get_Memory_Report = _spirit.State_Get_Memory_Report
+_Get_Memory_Report.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_char_p,
+                               ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_longlong)]
+_Get_Memory_Report.restype = ctypes.c_int
+def get_memory_report(p_state):
+    """Returns the memory held by the State as a list of (name, depth, bytes) in pre-order,
+    where the bytes of an entry include those of the entries below it."""
+    n = _Get_Memory_Report(ctypes.c_void_p(p_state), 0, None, None, None)
+    names  = ctypes.create_string_buffer(n * _Memory_Name_Length)
+    depths = (n * ctypes.c_int)()
+    nbytes = (n * ctypes.c_longlong)()
+    n = _Get_Memory_Report(ctypes.c_void_p(p_state), n, names, depths, nbytes)
+    report = []
+    for i in range(n):
+        name = names.raw[i * _Memory_Name_Length:(i + 1) * _Memory_Name_Length]
+        report.append((name.split(b'\0', 1)[0].decode('utf-8'), depths[i], nbytes[i]))
+    return report
@@ -5,7 +5,7 @@ import ctypes
 _spirit = spiritlib.LoadSpiritLibrary()
 
 from spirit.scalar import scalar
-from numpy import frombuffer, ndarray as np
+from numpy import zeros, ascontiguousarray
 
 ### Get Chain index
 _Get_Index          = _spirit.System_Get_Index
@@ -28,14 +28,58 @@ _Get_Spin_Directions.argtypes   = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
 _Get_Spin_Directions.restype    = ctypes.POINTER(scalar)
 def Get_Spin_Directions(p_state, idx_image=-1, idx_chain=-1):
     nos = Get_NOS(p_state, idx_image, idx_chain)
-    ArrayType = scalar*3*nos
     Data = _Get_Spin_Directions(ctypes.c_void_p(p_state), ctypes.c_int(idx_image), 
                                 ctypes.c_int(idx_chain))
-    array_pointer = ctypes.cast(Data, ctypes.POINTER(ArrayType))
-    array = frombuffer(array_pointer.contents, dtype=scalar)
-    array_view = array.view()
-    array_view.shape = (nos, 3)
-    return array_view
+    return spiritlib.ArrayView(Data, scalar, (nos, 3))
+
+### Get Pointer to the Effective Field
+# NOTE: Changing the values of the array_view one can alter the value of the data of the state
+_Get_Effective_Field            = _spirit.System_Get_Effective_Field
+_Get_Effective_Field.argtypes   = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Get_Effective_Field.restype    = ctypes.POINTER(scalar)
+def Get_Effective_Field(p_state, idx_image=-1, idx_chain=-1):
+    nos = Get_NOS(p_state, idx_image, idx_chain)
+    Data = _Get_Effective_Field(ctypes.c_void_p(p_state), ctypes.c_int(idx_image), 
+                                ctypes.c_int(idx_chain))
+    return spiritlib.ArrayView(Data, scalar, (nos, 3))
+
+### Update the energy of each spin and get a pointer to it
+_Get_Energy_per_Spin            = _spirit.System_Get_Energy_per_Spin
+_Get_Energy_per_Spin.argtypes   = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_Get_Energy_per_Spin.restype    = ctypes.POINTER(scalar)
+def Get_Energy_per_Spin(p_state, idx_image=-1, idx_chain=-1):
+    nos = Get_NOS(p_state, idx_image, idx_chain)
+    Data = _Get_Energy_per_Spin(ctypes.c_void_p(p_state), ctypes.c_int(idx_image), 
+                                ctypes.c_int(idx_chain))
+    return spiritlib.ArrayView(Data, scalar, (nos,))
+
+### Set the Spin Directions (nos, 3), updating the energy and effective field
+_Set_Spin_Directions            = _spirit.System_Set_Spin_Directions
+_Set_Spin_Directions.argtypes   = [ctypes.c_void_p, ctypes.POINTER(scalar), ctypes.c_int, ctypes.c_int]
+_Set_Spin_Directions.restype    = None
+def Set_Spin_Directions(p_state, spins, idx_image=-1, idx_chain=-1):
+    nos = Get_NOS(p_state, idx_image, idx_chain)
+    spins = ascontiguousarray(spins, dtype=scalar).reshape(nos, 3)
+    _Set_Spin_Directions(ctypes.c_void_p(p_state), spins.ctypes.data_as(ctypes.POINTER(scalar)), 
+                         ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+
+### Get a consistent snapshot of the spin directions, effective field and energy
+# NOTE: In contrast to Get_Spin_Directions, these are copies, which do not change while a simulation
+#       is running. The iteration at which the snapshot was taken is -1 if no simulation is running.
+_Get_Spin_Snapshot            = _spirit.System_Get_Spin_Snapshot
+_Get_Spin_Snapshot.argtypes   = [ctypes.c_void_p, ctypes.POINTER(scalar), ctypes.POINTER(scalar), 
+                                 ctypes.POINTER(ctypes.c_float), ctypes.c_int, ctypes.c_int]
+_Get_Spin_Snapshot.restype    = ctypes.c_int
+def Get_Spin_Snapshot(p_state, idx_image=-1, idx_chain=-1):
+    nos = Get_NOS(p_state, idx_image, idx_chain)
+    spins = zeros((nos, 3), dtype=scalar)
+    effective_field = zeros((nos, 3), dtype=scalar)
+    energy = ctypes.c_float()
+    iteration = _Get_Spin_Snapshot(ctypes.c_void_p(p_state), 
+                                   spins.ctypes.data_as(ctypes.POINTER(scalar)), 
+                                   effective_field.ctypes.data_as(ctypes.POINTER(scalar)), 
+                                   ctypes.byref(energy), ctypes.c_int(idx_image), ctypes.c_int(idx_chain))
+    return int(iteration), spins, effective_field, float(energy.value)
 
 ### Get total Energy
 _Get_Energy          = _spirit.System_Get_Energy
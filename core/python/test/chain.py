@@ -9,6 +9,8 @@ from spirit import state
 from spirit import chain
 from spirit import system
 
+from numpy import zeros, sqrt, pi
+
 import unittest
 
 ##########
@@ -213,6 +215,23 @@ class data_TestChain(TestChain):
     def test_setup(self):
         chain.Setup_Data( self.p_state )
 
+class spins_TestChain(TestChain):
+    
+    def test_set_get_spin_directions(self):
+        chain.Insert_Image_After( self.p_state )
+        noi = chain.Get_NOI( self.p_state )
+        nos = system.Get_NOS( self.p_state )
+        spins = zeros( (noi, nos, 3) )
+        spins[0,:,2] = 1.                                       # first image +z
+        spins[1,:,0] = 2.                                       # second image +x
+        chain.Set_Spin_Directions( self.p_state, spins )
+        arr = chain.Get_Spin_Directions( self.p_state )
+        self.assertEqual( arr.shape, (noi, nos, 3) )
+        self.assertAlmostEqual( arr[0,:,2].min(), 1. )
+        self.assertAlmostEqual( arr[1,:,0].min(), 1. )          # normalized
+        Rx = chain.Get_Rx( self.p_state )
+        self.assertAlmostEqual( (Rx[1] - Rx[0]) / (sqrt(nos)*pi/2), 1., places=4 )
+
 #########
 
 def suite():
@@ -226,6 +245,7 @@ def suite():
     suite.addTest( unittest.makeSuite( remove_TestChain ) )
     #suite.addTest( unittest.makeSuite( getters_TestChain ) )
     #suite.addTest( unittest.makeSuite( data_TestChain ) )
+    suite.addTest( unittest.makeSuite( spins_TestChain ) )
     return suite
 
 if __name__ == '__main__':
@@ -7,6 +7,7 @@ sys.path.insert(0, spirit_py_dir)
 
 from spirit import state
 from spirit import hamiltonian
+from spirit import system
 
 import unittest
 
@@ -35,6 +36,14 @@ class Hamiltonian_set_get(TestParameters):
         dir_set = [1., 1., 0.]
         hamiltonian.Set_Anisotropy(self.p_state, mag_set, dir_set)
         # TODO: test the functionality of that function when the corresponding get will be available
+    
+    def test_mu_s_per_cell_atom(self):
+        mu_s = hamiltonian.Get_mu_s_per_Cell_Atom(self.p_state)
+        mu_s_set = mu_s + 1
+        hamiltonian.Set_mu_s_per_Cell_Atom(self.p_state, mu_s_set)
+        # The array is a view of the data of the state
+        for i in range(len(mu_s)):
+            self.assertAlmostEqual(mu_s[i], mu_s_set[i])
         
     
 #########
@@ -5,7 +5,7 @@ import sys
 spirit_py_dir = os.path.abspath(os.path.join(os.path.dirname( __file__ ), ".."))
 sys.path.insert(0, spirit_py_dir)
 
-from spirit import state, quantities, configuration
+from spirit import state, system, quantities, configuration
 
 import unittest
 
@@ -29,6 +29,16 @@ class Quantities_Get(TestParameters):
         self.assertAlmostEqual(M[0], 0)
         self.assertAlmostEqual(M[1], 0)
         self.assertAlmostEqual(M[2], 1)
+
+    def test_topological_charge(self):
+        configuration.PlusZ(self.p_state)
+        Q = quantities.Get_Topological_Charge(self.p_state)
+        self.assertAlmostEqual(Q, 0)
+        density, triangles = quantities.Get_Topological_Charge_Density(self.p_state)
+        self.assertEqual(len(density), len(triangles))
+        self.assertAlmostEqual(sum(density), 0)
+        density_per_spin = quantities.Get_Topological_Charge_Density_per_Spin(self.p_state)
+        self.assertEqual(len(density_per_spin), system.Get_NOS(self.p_state))
     
 #########
 
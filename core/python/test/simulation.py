@@ -35,6 +35,37 @@ class Simulation_StartStop(TestParameters):
     def test_stopall(self):
         simulation.Stop_All(self.p_state)
 
+    def test_async(self):
+        configuration.Random(self.p_state)
+        handle = simulation.Start_Async(self.p_state, "LLG", "SIB", n_iterations=10, n_threads=1)
+        self.assertTrue(handle >= 0)
+        while not simulation.Finished_Async(self.p_state, handle):
+            self.assertTrue(simulation.Get_Iteration_Async(self.p_state, handle) <= 10)
+        self.assertFalse(simulation.Running_Image(self.p_state))
+        # The handle is released once the simulation has been found to be finished
+        self.assertFalse(simulation.Wait_Async(self.p_state, handle))
+
+    def test_sweep(self):
+        configuration.Random(self.p_state)
+        points = [[1], [1], [1]]
+        results = simulation.Sweep(self.p_state, "LLG", "SIB", [simulation.SWEEP_FIELD], points, 
+                                   warm_start=False, n_workers=2, n_iterations=10)
+        self.assertEqual(results.shape, (3, 6))
+        # Independent points with the same parameters end in the same state
+        self.assertTrue((results[1:] == results[0]).all())
+        self.assertFalse(simulation.Running_Image(self.p_state))
+
+    def test_timings(self):
+        configuration.Random(self.p_state)
+        simulation.PlayPause(self.p_state, "LLG", "SIB", n_iterations=10)
+        timings = simulation.Get_Timings(self.p_state)
+        for name, count, seconds in timings:
+            self.assertTrue(len(name) > 0)
+            self.assertTrue(count > 0)
+            self.assertTrue(seconds >= 0)
+        # The timers are sorted by the time spent
+        self.assertEqual([t[2] for t in timings], sorted([t[2] for t in timings], reverse=True))
+
 class Simulation_Running(TestParameters):
     
     def test_running_image(self):
@@ -18,6 +18,17 @@ class TestState(unittest.TestCase):
         with state.State(cfgfile) as p_state:
             pass
 
+    def test_memory_report(self):
+        with state.State(cfgfile) as p_state:
+            report = state.get_memory_report(p_state)
+            name, depth, total = report[0]
+            self.assertEqual(name, "State")
+            self.assertEqual(depth, 0)
+            self.assertGreater(total, 0)
+            names = [entry[0] for entry in report]
+            self.assertIn("Geometry", names)
+            self.assertIn("Hamiltonian", names)
+
 #########
 
 def suite():
@@ -7,6 +7,8 @@ sys.path.insert(0, spirit_py_dir)
 
 from spirit import state, system, configuration
 
+from numpy import zeros
+
 import unittest
 
 ##########
@@ -39,10 +41,49 @@ class SystemGetters(TestSystem):
             self.assertAlmostEqual( arr[i][1], 0. )
             self.assertAlmostEqual( arr[i][2], 1. )
     
+    def test_get_spin_snapshot(self):
+        configuration.PlusZ(self.p_state)
+        nos = system.Get_NOS(self.p_state)
+        iteration, spins, effective_field, energy = system.Get_Spin_Snapshot(self.p_state)
+        self.assertEqual(iteration, -1)
+        self.assertEqual(spins.shape, (nos, 3))
+        for i in range(nos):
+            self.assertAlmostEqual( spins[i][2], 1. )
+    
     def test_get_energy(self):
         # NOTE: that test is trivial
         E = system.Get_Energy(self.p_state)
     
+    def test_get_energy_per_spin(self):
+        configuration.PlusZ(self.p_state)
+        system.Update_Data(self.p_state)
+        energy_per_spin = system.Get_Energy_per_Spin(self.p_state)
+        self.assertEqual(energy_per_spin.shape, (system.Get_NOS(self.p_state),))
+        self.assertAlmostEqual(energy_per_spin.sum(), system.Get_Energy(self.p_state), places=4)
+
+class SystemSetters(TestSystem):
+    
+    def test_views(self):
+        # The arrays are views of the data of the state
+        configuration.PlusZ(self.p_state)
+        spins = system.Get_Spin_Directions(self.p_state)
+        spins[0] = [1., 0., 0.]
+        self.assertAlmostEqual(system.Get_Spin_Directions(self.p_state)[0][0], 1.)
+        self.assertEqual(system.Get_Effective_Field(self.p_state).shape, spins.shape)
+    
+    def test_set_spin_directions(self):
+        nos = system.Get_NOS(self.p_state)
+        spins = zeros((nos, 3))
+        spins[:,0] = 2.
+        system.Set_Spin_Directions(self.p_state, spins)
+        # The spins are normalized and the energy is updated
+        arr = system.Get_Spin_Directions(self.p_state)
+        for i in range(nos):
+            self.assertAlmostEqual( arr[i][0], 1. )
+        E = system.Get_Energy(self.p_state)
+        system.Update_Data(self.p_state)
+        self.assertAlmostEqual( E, system.Get_Energy(self.p_state), places=5 )
+    
     
     # NOTE: there is no way to test the system.Update_Data() and system.Print_Energy_Array()
 
@@ -51,6 +92,7 @@ class SystemGetters(TestSystem):
 def suite():
     suite = unittest.TestSuite()
     suite.addTest(unittest.makeSuite(SystemGetters))
+    suite.addTest(unittest.makeSuite(SystemSetters))
     return suite
 
 if __name__ == '__main__':
@@ -9,6 +9,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 int Chain_Get_Index(State * state) noexcept
 {
     try
@@ -705,6 +707,79 @@ std::vector<std::vector<float>> Chain_Get_Energy_Array_Interpolated( State * sta
     }
 }
 
+void Chain_Get_Spin_Directions( State * state, scalar * spins, int idx_chain ) noexcept
+{
+    int idx_image = -1;
+
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        for (int i = 0; i < chain->noi; ++i)
+        {
+            auto& image_spins = *chain->images[i]->spins;
+            int nos = chain->images[i]->nos;
+            if (nos > 0)
+                std::copy( image_spins[0].data(), image_spins[0].data() + 3*nos, spins + 3*nos*i );
+        }
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+}
+
+void Chain_Set_Spin_Directions( State * state, const scalar * spins, int idx_chain ) noexcept
+{
+    int idx_image = -1;
+
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        for (int i = 0; i < chain->noi; ++i)
+        {
+            chain->images[i]->Lock();
+            try
+            {
+                auto& image_spins = *chain->images[i]->spins;
+                int nos = chain->images[i]->nos;
+                for (int ispin = 0; ispin < nos; ++ispin)
+                {
+                    int idx = 3*(nos*i + ispin);
+                    image_spins[ispin] = { spins[idx], spins[idx+1], spins[idx+2] };
+                }
+                Engine::Vectormath::normalize_vectors(image_spins);
+                chain->images[i]->llg_parameters->pinning->Apply(image_spins);
+
+                // Observables derived from the spins
+                chain->images[i]->UpdateEnergy();
+                chain->images[i]->UpdateEffectiveField();
+                if (i > 0) 
+                    chain->Rx[i] = chain->Rx[i-1] + 
+                        Engine::Manifoldmath::dist_geodesic( *chain->images[i-1]->spins, image_spins );
+            }
+            catch( ... )
+            {
+                spirit_handle_exception_api(idx_image, idx_chain);
+            }
+            chain->images[i]->Unlock();
+        }
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+}
+
 void Chain_Update_Data( State * state, int idx_chain ) noexcept
 {
     int idx_image = -1;
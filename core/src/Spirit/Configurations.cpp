@@ -14,55 +14,9 @@ std::function<bool(const Vector3&, const Vector3&)>
 get_filter( Vector3 position, const float r_cut_rectangular[3], float r_cut_cylindrical, 
             float r_cut_spherical, bool inverted )
 {
-    bool no_cut_rectangular_x = r_cut_rectangular[0] < 0;
-    bool no_cut_rectangular_y = r_cut_rectangular[1] < 0;
-    bool no_cut_rectangular_z = r_cut_rectangular[2] < 0;
-    bool no_cut_cylindrical   = r_cut_cylindrical    < 0;
-    bool no_cut_spherical     = r_cut_spherical      < 0;
-
-    std::function< bool(const Vector3&, const Vector3&) > filter;
-    if (!inverted)
-    {
-        filter =
-            [ position, r_cut_rectangular, r_cut_cylindrical, r_cut_spherical, no_cut_rectangular_x,
-                no_cut_rectangular_y, no_cut_rectangular_z, no_cut_cylindrical, no_cut_spherical ]
-            (const Vector3& spin, const Vector3& positions)
-        {
-            Vector3 r_rectangular = positions - position;
-            scalar r_cylindrical = std::sqrt(std::pow(positions[0] - position[0], 2) + 
-                                    std::pow(positions[1] - position[1], 2));
-            scalar r_spherical   = (positions-position).norm();
-            if (   ( no_cut_rectangular_x || std::abs(r_rectangular[0]) < r_cut_rectangular[0] )
-                && ( no_cut_rectangular_y || std::abs(r_rectangular[1]) < r_cut_rectangular[1] )
-                && ( no_cut_rectangular_z || std::abs(r_rectangular[2]) < r_cut_rectangular[2] )
-                && ( no_cut_cylindrical   || r_cylindrical    < r_cut_cylindrical )
-                && ( no_cut_spherical     || r_spherical      < r_cut_spherical )
-                ) return true;
-            return false;
-        };
-    }
-    else
-    {
-        filter =
-            [ position, r_cut_rectangular, r_cut_cylindrical, r_cut_spherical, no_cut_rectangular_x, 
-                no_cut_rectangular_y, no_cut_rectangular_z, no_cut_cylindrical, no_cut_spherical]
-            (const Vector3& spin, const Vector3& positions)
-        {
-            Vector3 r_rectangular = positions - position;
-            scalar r_cylindrical = std::sqrt(std::pow(positions[0] - position[0], 2) +
-                                    std::pow(positions[1] - position[1], 2));
-            scalar r_spherical   = (positions-position).norm();
-            if (!( ( no_cut_rectangular_x || std::abs(r_rectangular[0]) < r_cut_rectangular[0] )
-                && ( no_cut_rectangular_y || std::abs(r_rectangular[1]) < r_cut_rectangular[1] )
-                && ( no_cut_rectangular_z || std::abs(r_rectangular[2]) < r_cut_rectangular[2] )
-                && ( no_cut_cylindrical   || r_cylindrical    < r_cut_cylindrical )
-                && ( no_cut_spherical     || r_spherical      < r_cut_spherical )
-                )) return true;
-            return false;
-        };
-    }
-
-    return filter;
+    Vector3 r_cut{ r_cut_rectangular[0], r_cut_rectangular[1], r_cut_rectangular[2] };
+    return Utility::Configurations::Filter_Region( position, r_cut, r_cut_cylindrical, 
+                                                   r_cut_spherical, inverted );
 }
 
 std::string filter_to_string( const float position[3], const float r_cut_rectangular[3], 
@@ -1,6 +1,7 @@
 #include <Spirit/Geometry.h>
 #include <data/State.hpp>
 #include <engine/Vectormath.hpp>
+#include <utility/Configurations.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Exception.hpp>
 
@@ -8,32 +9,29 @@
 #include <fmt/ostream.h>
 
 
-void Helper_System_Set_Geometry(std::shared_ptr<Data::Spin_System> system, const Data::Geometry & new_geometry)
+void Helper_System_Set_Geometry(std::shared_ptr<Data::Spin_System> system, const Data::Geometry & new_geometry, const intfield & indices_old)
 {
     *system->geometry = new_geometry;
     auto ge = system->geometry;
 
     // Spins
-    int nos_old = system->nos;
     int nos = ge->nos;
     system->nos = nos;
-    // TODO: ordering of spins should be considered and date potentially extrapolated -> write a function for this
-    system->spins->resize(nos);
-    system->effective_field.resize(nos);
-    for (int i = nos_old; i<nos; ++i) (*system->spins)[i] = Vector3{ 0, 0, 1 };
-    for (int i = nos_old; i<nos; ++i) system->effective_field[i] = Vector3{ 0, 0, 1 };
+    Utility::Configurations::Remap(*system->spins, indices_old);
+    system->effective_field = vectorfield(nos, Vector3{ 0, 0, 1 });
 
     // Parameters
     // TODO: properly re-generate pinning
     system->llg_parameters->pinning->mask_unpinned = intfield(nos, 1);
-
-    // Hamiltonian
-    // TODO: the Hamiltonian update is still incomplete! DDI is not yet updated.
-    //system->hamiltonian->Update_From_Geometry();
 }
 
-void Helper_State_Set_Geometry(State * state, const Data::Geometry & new_geometry)
+void Helper_State_Set_Geometry(State * state, const Data::Geometry & new_geometry, Utility::Configurations::Remap_Mode remap_mode = Utility::Configurations::Remap_Mode::Tile)
 {
+    // The spins of the new geometry are mapped onto those of the previous one
+    auto& old_geometry = *state->active_image->geometry;
+    int nos_old = old_geometry.nos;
+    auto indices_old = Utility::Configurations::Remap_Indices(old_geometry, new_geometry, remap_mode);
+
     // Deal with all systems in all chains
     for (auto& chain : state->collection->chains)
     {
@@ -44,7 +42,7 @@ void Helper_State_Set_Geometry(State * state, const Data::Geometry & new_geometr
             // Modify all systems in the chain
             for (auto& system : chain->images)
             {
-                Helper_System_Set_Geometry(system, new_geometry);
+                Helper_System_Set_Geometry(system, new_geometry, indices_old);
             }
         }
         catch( ... )
@@ -70,7 +68,7 @@ void Helper_State_Set_Geometry(State * state, const Data::Geometry & new_geometr
         try
         {
             // Modify
-            Helper_System_Set_Geometry(system, new_geometry);
+            Helper_System_Set_Geometry(system, new_geometry, indices_old);
         }
         catch( ... )
         {
@@ -83,8 +81,40 @@ void Helper_State_Set_Geometry(State * state, const Data::Geometry & new_geometr
     // Deal with clipboard configuration of State
     if (state->clipboard_spins)
     {
-        // TODO: the previous configuration should be extended, not overwritten
-        state->clipboard_spins = std::shared_ptr<vectorfield>(new vectorfield(nos, { 0, 0, 1 }));
+        if ((int)state->clipboard_spins->size() == nos_old)
+            Utility::Configurations::Remap(*state->clipboard_spins, indices_old);
+        else
+            state->clipboard_spins = std::shared_ptr<vectorfield>(new vectorfield(nos, { 0, 0, 1 }));
+    }
+
+    // Update the Hamiltonians. This is done after all geometries have been updated, as
+    //      copied Hamiltonians may refer to the geometry of another image.
+    for (auto& chain : state->collection->chains)
+    {
+        chain->Lock();
+        try
+        {
+            for (auto& system : chain->images)
+                system->hamiltonian->Update_Interactions();
+        }
+        catch( ... )
+        {
+            spirit_handle_exception_api(-1, -1);
+        }
+        chain->Unlock();
+    }
+    if (system)
+    {
+        system->Lock();
+        try
+        {
+            system->hamiltonian->Update_Interactions();
+        }
+        catch( ... )
+        {
+            spirit_handle_exception_api(-1, -1);
+        }
+        system->Unlock();
     }
 }
 
@@ -126,7 +156,7 @@ void Geometry_Set_Bravais_Lattice(State *state, const char * c_bravais_lattice)
     }
 }
 
-void Geometry_Set_N_Cells(State * state, int n_cells_i[3]) noexcept
+void Geometry_Set_N_Cells(State * state, int n_cells_i[3], int remap_mode) noexcept
 {
     try
     {
@@ -139,7 +169,7 @@ void Geometry_Set_N_Cells(State * state, int n_cells_i[3]) noexcept
             n_cells, ge->cell_atoms, ge->cell_atom_types, ge->lattice_constant);
 
         // Update the State
-        Helper_State_Set_Geometry(state, new_geometry);
+        Helper_State_Set_Geometry(state, new_geometry, Utility::Configurations::Remap_Mode(remap_mode));
 
         Log(Utility::Log_Level::Warning, Utility::Log_Sender::API, fmt::format("Set number of cells for all Systems: ({}, {}, {})", n_cells[0], n_cells[1], n_cells[2]), -1, -1);
     }
@@ -149,7 +179,7 @@ void Geometry_Set_N_Cells(State * state, int n_cells_i[3]) noexcept
     }
 }
 
-void Geometry_Set_Cell_Atoms(State *state, int n_atoms, float ** atoms) noexcept
+void Geometry_Set_Cell_Atoms(State *state, int n_atoms, float ** atoms, int remap_mode) noexcept
 {
     try
     {
@@ -160,13 +190,17 @@ void Geometry_Set_Cell_Atoms(State *state, int n_atoms, float ** atoms) noexcept
             cell_atoms.push_back({atoms[i][0], atoms[i][1], atoms[i][2]});
         }
 
-        // The new geometry
+        // The atom types of additional cell atoms default to 0
         auto ge = state->active_image->geometry;
+        intfield cell_atom_types = ge->cell_atom_types;
+        cell_atom_types.resize(n_atoms, 0);
+
+        // The new geometry
         auto new_geometry = Data::Geometry(ge->bravais_vectors,
-            ge->n_cells, cell_atoms, ge->cell_atom_types, ge->lattice_constant);
+            ge->n_cells, cell_atoms, cell_atom_types, ge->lattice_constant);
 
         // Update the State
-        Helper_State_Set_Geometry(state, new_geometry);
+        Helper_State_Set_Geometry(state, new_geometry, Utility::Configurations::Remap_Mode(remap_mode));
 
         Log(Utility::Log_Level::Warning, Utility::Log_Sender::API, fmt::format("Set {} cell atoms for all Systems. cell_atom[0]={}", n_atoms, cell_atoms[0]), -1, -1);
     }
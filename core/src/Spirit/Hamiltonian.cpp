@@ -14,6 +14,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 using namespace Utility;
 
 /*------------------------------------------------------------------------------------------------------ */
@@ -98,6 +100,52 @@ void Hamiltonian_Set_mu_s(State *state, float mu_s, int idx_image, int idx_chain
     }
 }
 
+void Hamiltonian_Set_mu_s_per_Cell_Atom(State *state, const scalar * mu_s, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+        
+        image->Lock();
+        
+        try
+        {
+            scalarfield * ham_mu_s = nullptr;
+            if (image->hamiltonian->Name() == "Heisenberg (Neighbours)")
+                ham_mu_s = &((Engine::Hamiltonian_Heisenberg_Neighbours*)image->hamiltonian.get())->mu_s;
+            else if (image->hamiltonian->Name() == "Heisenberg (Pairs)")
+                ham_mu_s = &((Engine::Hamiltonian_Heisenberg_Pairs*)image->hamiltonian.get())->mu_s;
+
+            if (ham_mu_s)
+            {
+                std::copy(mu_s, mu_s + image->geometry->n_cell_atoms, ham_mu_s->begin());
+                // Observables which depend on mu_s
+                image->UpdateEnergy();
+                image->UpdateEffectiveField();
+                Log(Utility::Log_Level::Info, Utility::Log_Sender::API,
+                    "Set mu_s of each basis cell atom", idx_image, idx_chain);
+            }
+            else
+                Log( Utility::Log_Level::Warning, Utility::Log_Sender::API,
+                    "mu_s cannot be set on " + image->hamiltonian->Name(), idx_image, idx_chain );
+        }
+        catch( ... )
+        {
+            spirit_handle_exception_api(idx_image, idx_chain);
+        }
+        
+        image->Unlock();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+}
+
 void Hamiltonian_Set_Field(State *state, float magnitude, const float * normal, int idx_image, int idx_chain) noexcept
 {
     try
@@ -471,6 +519,7 @@ void Hamiltonian_Set_DDI(State *state, float radius, int idx_image, int idx_chai
                     magnitudes.push_back(magnitude);
                     normals.push_back(normal);
                 }
+                ham->ddi_radius = radius;
                 ham->ddi_pairs = pairs;
                 ham->ddi_magnitudes = magnitudes;
                 ham->ddi_normals = normals;
@@ -497,6 +546,52 @@ void Hamiltonian_Set_DDI(State *state, float radius, int idx_image, int idx_chai
     }
 }
 
+void Hamiltonian_Set_DDI_Method(State *state, int method, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+        image->Lock();
+
+        try
+        {
+            auto ddi_method = Engine::DDI_Method(method);
+            if (image->hamiltonian->Name() == "Heisenberg (Neighbours)")
+            {
+                auto ham = (Engine::Hamiltonian_Heisenberg_Neighbours*)image->hamiltonian.get();
+                ham->ddi_method = ddi_method;
+                ham->Update_Energy_Contributions();
+            }
+            else if (image->hamiltonian->Name() == "Heisenberg (Pairs)")
+            {
+                auto ham = (Engine::Hamiltonian_Heisenberg_Pairs*)image->hamiltonian.get();
+                ham->ddi_method = ddi_method;
+                ham->Update_Energy_Contributions();
+            }
+            else
+                Log( Utility::Log_Level::Warning, Utility::Log_Sender::API, "DDI cannot be set on " + 
+                        image->hamiltonian->Name(), idx_image, idx_chain );
+
+            Log( Utility::Log_Level::Info, Utility::Log_Sender::API, fmt::format("Set ddi method to {}",
+                ddi_method == Engine::DDI_Method::Ewald ? "ewald" : "cutoff"), idx_image, idx_chain );
+        }
+        catch( ... )
+        {
+            spirit_handle_exception_api(idx_image, idx_chain);
+        }
+
+        image->Unlock();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+}
+
 /*------------------------------------------------------------------------------------------------------ */
 /*---------------------------------- Get Parameters ---------------------------------------------------- */
 /*------------------------------------------------------------------------------------------------------ */
@@ -569,6 +664,29 @@ void Hamiltonian_Get_mu_s(State *state, float * mu_s, int idx_image, int idx_cha
     }
 }
 
+scalar * Hamiltonian_Get_mu_s_per_Cell_Atom(State *state, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+        
+        if (image->hamiltonian->Name() == "Heisenberg (Neighbours)")
+            return ((Engine::Hamiltonian_Heisenberg_Neighbours*)image->hamiltonian.get())->mu_s.data();
+        else if (image->hamiltonian->Name() == "Heisenberg (Pairs)")
+            return ((Engine::Hamiltonian_Heisenberg_Pairs*)image->hamiltonian.get())->mu_s.data();
+        return nullptr;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+        return nullptr;
+    }
+}
+
 void Hamiltonian_Get_Field(State *state, float * magnitude, float * normal, int idx_image, int idx_chain) noexcept
 {
     try
@@ -774,7 +892,7 @@ void Hamiltonian_Get_DDI(State *state, float * radius, int idx_image, int idx_ch
         }
         else if (image->hamiltonian->Name() == "Heisenberg (Pairs)")
         {
-            auto ham = (Engine::Hamiltonian_Heisenberg_Neighbours*)image->hamiltonian.get();
+            auto ham = (Engine::Hamiltonian_Heisenberg_Pairs*)image->hamiltonian.get();
 
             *radius = (float)ham->ddi_radius;
         }
@@ -783,4 +901,26 @@ void Hamiltonian_Get_DDI(State *state, float * radius, int idx_image, int idx_ch
     {
         spirit_handle_exception_api(idx_image, idx_chain);
     }
+}
+
+int Hamiltonian_Get_DDI_Method(State *state, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+        
+        if (image->hamiltonian->Name() == "Heisenberg (Neighbours)")
+            return (int)((Engine::Hamiltonian_Heisenberg_Neighbours*)image->hamiltonian.get())->ddi_method;
+        else if (image->hamiltonian->Name() == "Heisenberg (Pairs)")
+            return (int)((Engine::Hamiltonian_Heisenberg_Pairs*)image->hamiltonian.get())->ddi_method;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+    return Hamiltonian_DDI_Cutoff;
 }
\ No newline at end of file
@@ -7,11 +7,15 @@
 #include <data/Spin_System.hpp>
 #include <data/Spin_System_Chain.hpp>
 #include <io/IO.hpp>
+#include <io/Checkpoint.hpp>
+#include <io/OVF_File.hpp>
+#include <io/Trajectory.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Exception.hpp>
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -116,9 +120,23 @@ void IO_Positions_Write( State * state, const char *file, int format,
 
 int IO_N_Images_In_File( State *state, const char *file, int format, int idx_chain ) noexcept
 {
-    // TODO: implementation
-    
-    return 0;
+    try
+    {
+        // OVF files contain one segment per image
+        if ( IO::Is_OVF_Format( IO::VF_FileFormat(format) ) )
+            return IO::OVF_File( std::string(file) ).n_segments();
+
+        // The other formats contain a single configuration without a separator between images
+        Log( Utility::Log_Level::Error, Utility::Log_Sender::API,
+             fmt::format("Cannot count the images in file \"{}\": not supported for file format {}", file, format),
+             -1, idx_chain );
+        return -1;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(-1, idx_chain);
+        return -1;
+    }
 }
 
 void IO_Image_Read( State *state, const char *file, int format, int idx_image_infile, 
@@ -136,7 +154,8 @@ void IO_Image_Read( State *state, const char *file, int format, int idx_image_in
         image->Lock();
         try
         {
-            IO::Read_Spin_Configuration(image, std::string(file), IO::VF_FileFormat(format));
+            IO::Read_Spin_Configuration(image, std::string(file), IO::VF_FileFormat(format), 
+                                        std::max(0, idx_image_infile));
         }
         catch( ... )
         {
@@ -366,7 +385,7 @@ void IO_Collection_Write(State * state, const char * file, int idx_image, int id
 /*----------------------------------------------------------------------------------------------- */
 
 //IO_Energies_Spins_Save
-void IO_Image_Write_Energy_per_Spin(State * state, const char * file, int idx_image, int idx_chain) noexcept
+void IO_Image_Write_Energy_per_Spin(State * state, const char * file, int format, int idx_image, int idx_chain) noexcept
 {
     try
     {
@@ -377,7 +396,7 @@ void IO_Image_Write_Energy_per_Spin(State * state, const char * file, int idx_im
         from_indices( state, idx_image, idx_chain, image, chain );
         
         // Write the data
-        IO::Write_Image_Energy_per_Spin(*image, std::string(file));
+        IO::Write_Image_Energy_per_Spin(*image, std::string(file), true, IO::VF_FileFormat(format));
     }
     catch( ... )
     {
@@ -447,4 +466,142 @@ void IO_Chain_Write_Energies_Interpolated(State * state, const char * file, int
     {
         spirit_handle_exception_api(idx_image, idx_chain);
     }
-}
\ No newline at end of file
+}
+
+/*----------------------------------------------------------------------------------------------- */
+/*-------------------------------------- Checkpoints -------------------------------------------- */
+/*----------------------------------------------------------------------------------------------- */
+
+void IO_State_Checkpoint(State * state, const char * file) noexcept
+{
+    try
+    {
+        IO::Write_Checkpoint(*state, std::string(file));
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(-1, -1);
+    }
+}
+
+void IO_State_Restore(State * state, const char * file) noexcept
+{
+    try
+    {
+        IO::Read_Checkpoint(*state, std::string(file));
+        State_Update(state);
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(-1, -1);
+    }
+}
+
+
+/*----------------------------------------------------------------------------------------------- */
+/*-------------------------------------- Trajectories ------------------------------------------- */
+/*----------------------------------------------------------------------------------------------- */
+
+void IO_Image_Trajectory_Append( State *state, const char *file, int iteration, float time, 
+                                 int encoding, bool energies, int idx_image, int idx_chain ) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+        
+        // Write the data
+        image->Lock();
+        try
+        {
+            IO::Trajectory_Frame frame;
+            frame.iteration = iteration;
+            frame.time = time;
+            std::vector<std::string> energy_names;
+            if (energies)
+            {
+                image->UpdateEnergy();
+                frame.energy = image->E;
+                for (auto& contribution : image->E_array)
+                {
+                    energy_names.push_back(contribution.first);
+                    frame.energy_contributions.push_back(contribution.second);
+                }
+            }
+            frame.spins = *image->spins;
+            IO::Append_Trajectory_Frame( std::string(file), *image->geometry, frame, 
+                                         IO::Trajectory_Encoding(encoding), energies, energy_names );
+        }
+        catch( ... )
+        {
+            image->Unlock();
+            spirit_handle_exception_api(idx_image, idx_chain);
+            return;
+        }
+        image->Unlock();
+        
+        Log( Utility::Log_Level::Info, Utility::Log_Sender::API, fmt::format( "Appended frame to "
+                "trajectory file {}", file ), idx_image, idx_chain );
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+}
+
+int IO_Trajectory_N_Frames( State *state, const char *file ) noexcept
+{
+    try
+    {
+        return IO::Trajectory_File( std::string(file) ).n_frames();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(-1, -1);
+        return 0;
+    }
+}
+
+int IO_Image_Trajectory_Read_Frame( State *state, const char *file, int idx_frame, float *time, 
+                                    float *energy, int idx_image, int idx_chain ) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        // Read the frame before touching the image
+        IO::Trajectory_File trajectory{ std::string(file) };
+        if (trajectory.nos() != image->nos)
+            spirit_throw( Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
+                fmt::format("Trajectory file {} has {} spins, but the image has {}", 
+                    file, trajectory.nos(), image->nos) );
+        IO::Trajectory_Frame frame;
+        trajectory.Read_Frame(idx_frame, frame);
+
+        image->Lock();
+        *image->spins = frame.spins;
+        image->Unlock();
+
+        if (time != nullptr)
+            *time = (float)frame.time;
+        if (energy != nullptr)
+            *energy = (float)frame.energy;
+
+        Log( Utility::Log_Level::Info, Utility::Log_Sender::API,
+            fmt::format("Read frame {} from trajectory file {}", idx_frame, file),
+            idx_image, idx_chain );
+        return (int)frame.iteration;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+        return -1;
+    }
+}
@@ -18,12 +18,12 @@ void Log_Send( State *state, Spirit_Log_Level level, Spirit_Log_Sender sender, c
     }
 }
 
-std::vector<Utility::LogEntry> Log_Get_Entries(State *state) noexcept
+std::vector<Utility::LogEntry> Log_Get_Entries(State *state, int idx_first, int idx_last) noexcept
 {
     try
     {
-        // Get all entries
-        return Log.GetEntries();
+        // Get the entries which are still in the Log
+        return Log.GetEntries(idx_first, idx_last);
     }
     catch( ... )
     {
@@ -131,6 +131,28 @@ void Parameters_Set_LLG_Output_Configuration( State *state, bool configuration_s
     }
 }
 
+void Parameters_Set_LLG_Output_Trajectory( State *state, bool trajectory, int encoding, 
+                                           int idx_image, int idx_chain ) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        image->Lock();
+        image->llg_parameters->output_configuration_trajectory = trajectory;
+        image->llg_parameters->output_trajectory_encoding = encoding;
+        image->Unlock();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+}
+
 void Parameters_Set_LLG_N_Iterations( State *state, int n_iterations, int n_iterations_log, 
                                       int idx_image, int idx_chain ) noexcept
 {
@@ -905,6 +927,26 @@ void Parameters_Get_LLG_Output_Configuration( State *state, bool * configuration
     }
 }
 
+void Parameters_Get_LLG_Output_Trajectory( State *state, bool * trajectory, int * encoding, 
+                                           int idx_image, int idx_chain ) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        *trajectory = image->llg_parameters->output_configuration_trajectory;
+        *encoding = image->llg_parameters->output_trajectory_encoding;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+}
+
 void Parameters_Get_LLG_N_Iterations( State *state, int * iterations, int * iterations_log, 
                                       int idx_image, int idx_chain ) noexcept
 {
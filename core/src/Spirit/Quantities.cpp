@@ -46,8 +46,8 @@ float Quantity_Get_Topological_Charge(State * state, int idx_image, int idx_chai
         scalar charge = 0;
         int dimensionality = Geometry_Get_Dimensionality(state, idx_image, idx_chain);
         if (dimensionality == 2)
-            charge = Engine::Vectormath::TopologicalCharge(*image->spins, 
-                        image->geometry->positions, image->geometry->triangulation());
+            charge = Engine::Vectormath::TopologicalCharge(*image->spins,
+                        image->geometry->triangulation(1, image->hamiltonian->boundary_conditions));
 
         // image->Unlock();
         
@@ -58,4 +58,69 @@ float Quantity_Get_Topological_Charge(State * state, int idx_image, int idx_chai
         spirit_handle_exception_api(idx_image, idx_chain);
         return 0;
     }
-}
\ No newline at end of file
+}
+
+int Quantity_Get_Topological_Charge_Density(State * state, float * charge_density, int * triangle_indices, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        int dimensionality = Geometry_Get_Dimensionality(state, idx_image, idx_chain);
+        if (dimensionality != 2)
+            return 0;
+
+        auto& triangles = image->geometry->triangulation(1, image->hamiltonian->boundary_conditions);
+
+        if (charge_density != nullptr)
+        {
+            scalarfield density;
+            Engine::Vectormath::TopologicalChargeDensity(*image->spins, triangles, density);
+            for (unsigned int i=0; i<density.size(); ++i)
+                charge_density[i] = (float)density[i];
+        }
+
+        if (triangle_indices != nullptr)
+        {
+            for (unsigned int i=0; i<triangles.size(); ++i)
+                for (int k=0; k<3; ++k)
+                    triangle_indices[3*i+k] = triangles[i][k];
+        }
+
+        return triangles.size();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+        return 0;
+    }
+}
+
+void Quantity_Get_Topological_Charge_Density_per_Spin(State * state, float * charge_density, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        scalarfield density(image->nos, 0);
+        int dimensionality = Geometry_Get_Dimensionality(state, idx_image, idx_chain);
+        if (dimensionality == 2)
+            Engine::Vectormath::TopologicalChargeDensity_per_Spin(*image->spins,
+                image->geometry->triangulation(1, image->hamiltonian->boundary_conditions), density);
+
+        for (int i=0; i<image->nos; ++i)
+            charge_density[i] = (float)density[i];
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+}
@@ -7,9 +7,43 @@
 #include <engine/Method_MC.hpp>
 #include <engine/Method_GNEB.hpp>
 #include <engine/Method_MMF.hpp>
+#include <engine/Sweep.hpp>
+#include <io/Checkpoint.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Exception.hpp>
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#ifdef SPIRIT_USE_THREADS
+#include <thread>
+#endif
+
+
+// Determine the Solver kind from its name, false if it is invalid
+bool Get_Solver( const std::string & solver_type, Engine::Solver & solver )
+{
+    if (solver_type == "SIB")
+        solver = Engine::Solver::SIB;
+    else if (solver_type == "Heun")
+        solver = Engine::Solver::Heun;
+    else if (solver_type == "Depondt")
+        solver = Engine::Solver::Depondt;
+    else if (solver_type == "NCG")
+        solver = Engine::Solver::NCG;
+    else if (solver_type == "VP")
+        solver = Engine::Solver::VP;
+    else
+    {
+        Log( Utility::Log_Level::Error, Utility::Log_Sender::API, "Invalid Solver selected: " + 
+                solver_type);
+        return false;
+    }
+    return true;
+}
 
 bool Get_Method( State *state, const char * c_method_type, const char * c_solver_type, 
                  int n_iterations, int n_iterations_log, int idx_image, int idx_chain, 
@@ -23,22 +57,8 @@ bool Get_Method( State *state, const char * c_method_type, const char * c_solver
 
         // Determine the Solver kind
         Engine::Solver solver;
-        if (solver_type == "SIB")
-            solver = Engine::Solver::SIB;
-        else if (solver_type == "Heun")
-            solver = Engine::Solver::Heun;
-        else if (solver_type == "Depondt")
-            solver = Engine::Solver::Depondt;
-        else if (solver_type == "NCG")
-            solver = Engine::Solver::NCG;
-        else if (solver_type == "VP")
-            solver = Engine::Solver::VP;
-        else
-        {
-            Log( Utility::Log_Level::Error, Utility::Log_Sender::API, "Invalid Solver selected: " + 
-                    solver_type);
+        if (!Get_Solver(solver_type, solver))
             return false;
-        }
 
         // Fetch correct indices and pointers for image and chain
         std::shared_ptr<Data::Spin_System> image;
@@ -203,6 +223,14 @@ bool Get_Method( State *state, const char * c_method_type, const char * c_solver
         // Create Simulation Information
         auto info = std::shared_ptr<Engine::Method>(method);
 
+        // Continue from a restored checkpoint, if there is one for this method
+        if (method_type == "LLG" || method_type == "MC")
+            IO::Apply_Method_Checkpoint(*state, *method, idx_image, idx_chain);
+        else if (method_type == "GNEB")
+            IO::Apply_Method_Checkpoint(*state, *method, -1, idx_chain);
+        else if (method_type == "MMF")
+            IO::Apply_Method_Checkpoint(*state, *method, -1, -1);
+
         // Add to correct list
         if (method_type == "LLG")
             state->method_image[idx_chain][idx_image] = info;
@@ -254,7 +282,12 @@ void Simulation_PlayPause(State *state, const char * c_method_type, const char *
         std::shared_ptr<Engine::Method> method;
         if ( Get_Method( state, c_method_type, c_solver_type, n_iterations, n_iterations_log, 
                             idx_image, idx_chain, method ) )
+        {
             method->Iterate();
+            // If the walltime ran out, write a checkpoint from which the simulation can be continued
+            if (method->getWalltimeExpired())
+                IO::Write_Checkpoint(*state, method->getCheckpointFile());
+        }
     }
     catch( ... )
     {
@@ -303,6 +336,221 @@ void Simulation_Stop_All(State *state) noexcept
 }
 
 
+int Simulation_Start_Async(State *state, const char * c_method_type, const char * c_solver_type,
+    int n_iterations, int n_iterations_log, int n_threads, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        // Get_Method would stop a running simulation instead of starting one
+        if (image->iteration_allowed || chain->iteration_allowed || state->collection->iteration_allowed)
+        {
+            Log( Utility::Log_Level::Error, Utility::Log_Sender::API,
+                    "Cannot start a simulation in the background, as a simulation is already running", 
+                    idx_image, idx_chain );
+            return -1;
+        }
+
+        std::shared_ptr<Engine::Method> method;
+        if ( !Get_Method( state, c_method_type, c_solver_type, n_iterations, n_iterations_log, 
+                          idx_image, idx_chain, method ) )
+            return -1;
+
+        // Executed by a worker, with the same behaviour as Simulation_PlayPause
+        auto work = [state, method, idx_image, idx_chain]()
+        {
+            try
+            {
+                method->Iterate();
+                if (method->getWalltimeExpired())
+                    IO::Write_Checkpoint(*state, method->getCheckpointFile());
+            }
+            catch( ... )
+            {
+                Utility::Handle_Exception_API("Simulation_Start_Async", idx_image, idx_chain);
+            }
+        };
+        auto simulation = std::shared_ptr<Engine::Simulation_Task>(
+            new Engine::Simulation_Task( method, work, n_threads ) );
+
+        #ifdef SPIRIT_USE_THREADS
+        int n_cores = std::thread::hardware_concurrency();
+        if (n_cores > 0 && Engine::Simulation_Worker::N_Threads_Running() + simulation->N_Threads() > n_cores)
+            Log( Utility::Log_Level::Warning, Utility::Log_Sender::API, fmt::format(
+                    "The simulations running in the background use more threads than there are cores ({})", 
+                    n_cores), idx_image, idx_chain );
+        #endif
+
+        int handle;
+        {
+            std::lock_guard<std::mutex> guard(state->mutex_simulations_async);
+            handle = state->idx_next_simulation_async++;
+            state->simulations_async[handle] = simulation;
+        }
+        Engine::Simulation_Worker::Start(simulation);
+
+        return handle;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+        return -1;
+    }
+}
+
+// Fetch a background simulation by handle, nullptr if it does not exist
+std::shared_ptr<Engine::Simulation_Task> Get_Simulation_Async(State *state, int handle)
+{
+    {
+        std::lock_guard<std::mutex> guard(state->mutex_simulations_async);
+        auto simulation = state->simulations_async.find(handle);
+        if (simulation != state->simulations_async.end())
+            return simulation->second;
+    }
+    Log( Utility::Log_Level::Error, Utility::Log_Sender::API, 
+            fmt::format("Non-existing background simulation {}", handle) );
+    return nullptr;
+}
+
+bool Simulation_Wait_Async(State *state, int handle, float timeout) noexcept
+{
+    try
+    {
+        auto simulation = Get_Simulation_Async(state, handle);
+        if (!simulation)
+            return false;
+        // A simulation which has been joined is released
+        bool finished = simulation->Wait(timeout);
+        if (finished)
+        {
+            std::lock_guard<std::mutex> guard(state->mutex_simulations_async);
+            state->simulations_async.erase(handle);
+        }
+        return finished;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(-1, -1);
+        return false;
+    }
+}
+
+void Simulation_Cancel_Async(State *state, int handle) noexcept
+{
+    try
+    {
+        auto simulation = Get_Simulation_Async(state, handle);
+        if (simulation)
+            simulation->Cancel();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(-1, -1);
+    }
+}
+
+bool Simulation_Finished_Async(State *state, int handle) noexcept
+{
+    try
+    {
+        auto simulation = Get_Simulation_Async(state, handle);
+        if (!simulation)
+            return false;
+        // A simulation which has been found to be finished is released
+        bool finished = simulation->Finished();
+        if (finished)
+        {
+            std::lock_guard<std::mutex> guard(state->mutex_simulations_async);
+            state->simulations_async.erase(handle);
+        }
+        return finished;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(-1, -1);
+        return false;
+    }
+}
+
+int Simulation_Get_Iteration_Async(State *state, int handle) noexcept
+{
+    try
+    {
+        auto simulation = Get_Simulation_Async(state, handle);
+        if (simulation)
+            return simulation->Iteration();
+        return 0;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(-1, -1);
+        return 0;
+    }
+}
+
+
+int Simulation_Sweep(State *state, const char * c_method_type, const char * c_solver_type,
+    int n_parameters, const int * parameters, int n_points, const scalar * points, scalar * results,
+    bool warm_start, int n_workers, const char * filename, int n_iterations, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        if (image->iteration_allowed || chain->iteration_allowed || state->collection->iteration_allowed)
+        {
+            Log( Utility::Log_Level::Error, Utility::Log_Sender::API,
+                    "Cannot start a sweep, as a simulation is already running", idx_image, idx_chain );
+            return 0;
+        }
+
+        Engine::Solver solver;
+        if (!Get_Solver(c_solver_type, solver))
+            return 0;
+
+        std::vector<Engine::Sweep_Parameter> sweep_parameters(n_parameters);
+        for (int i = 0; i < n_parameters; ++i)
+        {
+            if (parameters[i] < Sweep_Parameter_Field || parameters[i] > Sweep_Parameter_DMI)
+            {
+                Log( Utility::Log_Level::Error, Utility::Log_Sender::API,
+                        fmt::format("Invalid sweep parameter {}", parameters[i]), idx_image, idx_chain );
+                return 0;
+            }
+            sweep_parameters[i] = Engine::Sweep_Parameter(parameters[i]);
+        }
+
+        Engine::Sweep sweep( image, c_method_type, solver, sweep_parameters,
+                             std::vector<scalar>(points, points + n_points * n_parameters),
+                             warm_start, n_workers, n_iterations, idx_image, idx_chain );
+
+        // The image counts as running during the sweep, so that it can be stopped
+        image->iteration_allowed = true;
+        sweep.Run(filename);
+        image->iteration_allowed = false;
+
+        if (results)
+            std::copy(sweep.Results().begin(), sweep.Results().end(), results);
+
+        return sweep.N_Points_Done();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+        return 0;
+    }
+}
+
+
 float Simulation_Get_MaxTorqueComponent(State * state, int idx_image, int idx_chain) noexcept
 {
     try
@@ -445,6 +693,50 @@ int Simulation_Get_Iteration(State *state, int idx_image, int idx_chain) noexcep
 }
 
 
+int Simulation_Get_Timings(State *state, int n_max, char * names, int * counts, scalar * seconds, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        // Fetch correct indices and pointers for image and chain
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        // The method of the image is kept after it has finished, otherwise that of the chain
+        std::shared_ptr<Engine::Method> method = state->method_image[idx_chain][idx_image];
+        if (!method)
+            method = state->method_chain[idx_chain];
+        if (!method)
+            method = state->method_collection;
+        if (!method)
+            return 0;
+
+        auto timings = method->getTimings();
+        for (int i = 0; i < std::min(n_max, (int)timings.size()); ++i)
+        {
+            if (names)
+            {
+                char * name = names + i * Simulation_Timing_Name_Length;
+                std::strncpy(name, timings[i].name.c_str(), Simulation_Timing_Name_Length - 1);
+                name[Simulation_Timing_Name_Length - 1] = '\0';
+            }
+            if (counts)
+                counts[i] = (int)timings[i].count;
+            if (seconds)
+                seconds[i] = timings[i].seconds;
+        }
+        return timings.size();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+        return 0;
+    }
+}
+
+
 const char * Simulation_Get_Solver_Name(State *state, int idx_image, int idx_chain) noexcept
 {
     try
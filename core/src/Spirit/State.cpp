@@ -1,15 +1,19 @@
 #include <Spirit/State.h>
 #include "Spirit_Defines.h"
 #include <data/State.hpp>
+#include <engine/Decomposition.hpp>
 #include <io/IO.hpp>
 #include <utility/Version.hpp>
 #include <utility/Configurations.hpp>
 #include <utility/Configuration_Chain.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Exception.hpp>
+#include <utility/Memory.hpp>
 
 #include <fmt/format.h>
 
+#include <cstring>
+
 using namespace Utility;
 
 
@@ -30,6 +34,9 @@ State * State_Setup(const char * config_file, bool quiet) noexcept
         state->config_file = config_file;
         state->quiet = quiet;
 
+        // With MPI, the Log needs to know the rank before the first message
+        Engine::Decomposition::Setup();
+
         // Log version info
         Log(Log_Level::All,  Log_Sender::All, "=====================================================");
         Log(Log_Level::All,  Log_Sender::All, "========== Spirit State: Initialising... ============");
@@ -254,9 +261,23 @@ void State_Delete(State * state) noexcept
         Log(Log_Level::All, Log_Sender::All,  "=====================================================");
         Log(Log_Level::All, Log_Sender::All,  "============ Spirit State: Deleting... ==============");
         
+        // Stop the simulations running in the background
+        std::map<int, std::shared_ptr<Engine::Simulation_Task>> simulations_async;
+        {
+            std::lock_guard<std::mutex> guard(state->mutex_simulations_async);
+            simulations_async.swap(state->simulations_async);
+        }
+        for (auto& simulation : simulations_async)
+            simulation.second->Cancel();
+        for (auto& simulation : simulations_async)
+            simulation.second->Wait();
+
         // Final file writing (input, positions, neighbours)
         Save_Initial_Final( state, false );
 
+        // Wait for the asynchronous output to be written
+        IO::Output_Queue::Drain();
+
         // Timing
         auto now = system_clock::now();
         auto diff = Timing::DateTimePassed(now - state->datetime_creation);
@@ -366,6 +387,68 @@ const char * State_DateTime(State * state) noexcept
     }
 }
 
+int State_Get_Memory_Report(State * state, int n_max, char * names, int * depths, long long * bytes) noexcept
+{
+    try
+    {
+        Memory::Report report("State");
+
+        for (int ichain = 0; ichain < state->collection->noc; ++ichain)
+            state->collection->chains[ichain]->Memory_Usage(report.Child(fmt::format("Chain {}", ichain)));
+
+        auto & clipboard = report.Child("Clipboard");
+        if (state->clipboard_image)
+            state->clipboard_image->Memory_Usage(clipboard.Child("image"));
+        if (state->clipboard_spins)
+            clipboard.Add("spins", Memory::Bytes(*state->clipboard_spins));
+
+        // The methods which are kept after a calculation, each with its workspace
+        auto & methods = report.Child("Methods");
+        for (unsigned int ichain = 0; ichain < state->method_image.size(); ++ichain)
+        {
+            for (unsigned int iimage = 0; iimage < state->method_image[ichain].size(); ++iimage)
+            {
+                auto & method = state->method_image[ichain][iimage];
+                if (method)
+                    method->Memory_Usage(methods.Child(fmt::format("{} on image {} of chain {}", method->Name(), iimage, ichain)));
+            }
+        }
+        for (unsigned int ichain = 0; ichain < state->method_chain.size(); ++ichain)
+        {
+            auto & method = state->method_chain[ichain];
+            if (method)
+                method->Memory_Usage(methods.Child(fmt::format("{} on chain {}", method->Name(), ichain)));
+        }
+        if (state->method_collection)
+            state->method_collection->Memory_Usage(methods.Child(state->method_collection->Name() + " on collection"));
+
+        int n_entries = 0;
+        report.Visit([&](const Memory::Report & entry, int depth)
+        {
+            if (n_entries < n_max)
+            {
+                if (names)
+                {
+                    char * name = names + n_entries * State_Memory_Name_Length;
+                    std::strncpy(name, entry.name.c_str(), State_Memory_Name_Length - 1);
+                    name[State_Memory_Name_Length - 1] = '\0';
+                }
+                if (depths)
+                    depths[n_entries] = depth;
+                if (bytes)
+                    bytes[n_entries] = (long long)entry.Bytes();
+            }
+            ++n_entries;
+        });
+        return n_entries;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(-1, -1);
+        return 0;
+    }
+}
+
 
 // Helper function for file writing at setup and delete of State.
 //    Input, positions, neighbours.
@@ -1,9 +1,12 @@
 #include <Spirit/System.h>
 #include <Spirit/State.h>
 #include <data/State.hpp>
+#include <engine/Vectormath.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Exception.hpp>
 
+#include <algorithm>
+
 int System_Get_Index(State * state) noexcept
 {
     try
@@ -73,6 +76,74 @@ scalar * System_Get_Effective_Field(State * state, int idx_image, int idx_chain)
     }
 }
 
+int System_Get_Spin_Snapshot(State * state, scalar * spins, scalar * effective_field, float * energy, 
+                             int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        // Without a running simulation, a snapshot of the current data is taken
+        auto snapshot = image->snapshots.Get();
+        if (!snapshot || !image->snapshots.live)
+        {
+            image->Lock();
+            image->snapshots.Publish(*image, -1);
+            image->Unlock();
+            snapshot = image->snapshots.Get();
+        }
+
+        int nos = snapshot->spins.size();
+        if (spins && nos > 0)
+            std::copy(snapshot->spins[0].data(), snapshot->spins[0].data() + 3*nos, spins);
+        if (effective_field && nos > 0 && (int)snapshot->effective_field.size() == nos)
+            std::copy(snapshot->effective_field[0].data(), snapshot->effective_field[0].data() + 3*nos, effective_field);
+        if (energy)
+            *energy = (float)snapshot->E;
+
+        return snapshot->iteration;
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+        return -1;
+    }
+}
+
+scalar * System_Get_Energy_per_Spin(State * state, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        image->Lock();
+        try
+        {
+            image->UpdateEnergy_per_Spin();
+        }
+        catch( ... )
+        {
+            spirit_handle_exception_api(idx_image, idx_chain);
+        }
+        image->Unlock();
+
+        return image->E_per_spin.data();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+        return nullptr;
+    }
+}
+
 float System_Get_Rx(State * state, int idx_image, int idx_chain) noexcept
 {
     try
@@ -159,6 +230,41 @@ void System_Print_Energy_Array(State * state, int idx_image, int idx_chain) noex
     }
 }
 
+void System_Set_Spin_Directions(State * state, const scalar * spins, int idx_image, int idx_chain) noexcept
+{
+    try
+    {
+        std::shared_ptr<Data::Spin_System> image;
+        std::shared_ptr<Data::Spin_System_Chain> chain;
+        
+        // Fetch correct indices and pointers
+        from_indices( state, idx_image, idx_chain, image, chain );
+
+        image->Lock();
+        try
+        {
+            auto& image_spins = *image->spins;
+            for (int ispin = 0; ispin < image->nos; ++ispin)
+                image_spins[ispin] = { spins[3*ispin], spins[3*ispin+1], spins[3*ispin+2] };
+            Engine::Vectormath::normalize_vectors(image_spins);
+            image->llg_parameters->pinning->Apply(image_spins);
+
+            // Observables derived from the spins
+            image->UpdateEnergy();
+            image->UpdateEffectiveField();
+        }
+        catch( ... )
+        {
+            spirit_handle_exception_api(idx_image, idx_chain);
+        }
+        image->Unlock();
+    }
+    catch( ... )
+    {
+        spirit_handle_exception_api(idx_image, idx_chain);
+    }
+}
+
 void System_Update_Data(State * state, int idx_image, int idx_chain) noexcept
 {
     try
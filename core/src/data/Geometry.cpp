@@ -11,6 +11,9 @@
 #include "QhullVertexSet.h"
 
 #include <array>
+#include <algorithm>
+
+#include <fmt/format.h>
 
 namespace Data
 {
@@ -43,10 +46,23 @@ namespace Data
 
         // Calculate the type of geometry
         this->calculateGeometryType();
+    }
 
-        // For updates of triangulation and tetrahedra
-        this->last_update_n_cell_step = -1;
-        this->last_update_n_cells = intfield(3, -1);
+    Geometry::Simplex_Cache::Key Geometry::Simplex_Cache::Make_Key(int n_cell_step, const intfield & boundary_conditions)
+    {
+        if (boundary_conditions.size() != 3)
+            spirit_throw(Utility::Exception_Classifier::Unknown_Exception, Utility::Log_Level::Error,
+                fmt::format("Expected boundary conditions for 3 directions, but got {}", boundary_conditions.size()));
+        return Key{ n_cell_step, boundary_conditions[0] != 0, boundary_conditions[1] != 0, boundary_conditions[2] != 0 };
+    }
+
+    Geometry::Simplex_Cache & Geometry::Simplex_Cache::operator=(const Simplex_Cache &)
+    {
+        // The simplices of the previous geometry are not valid for the new one
+        std::lock_guard<std::mutex> guard(this->mutex);
+        this->triangulations.clear();
+        this->tetrahedra.clear();
+        return *this;
     }
 
 
@@ -100,8 +116,267 @@ namespace Data
         return triangles;
     }
 
-    const std::vector<triangle_t>& Geometry::triangulation(int n_cell_step)
+    // Number of cells in each direction, if only every n_cell_step'th cell is used
+    std::array<int, 3> stepped_n_cells(const intfield & n_cells, int n_cell_step)
+    {
+        return { std::max(1, n_cells[0]/n_cell_step),
+                 std::max(1, n_cells[1]/n_cell_step),
+                 std::max(1, n_cells[2]/n_cell_step) };
+    }
+
+    // Calculate an orthonormal basis {e1, e2} of the plane of a 2D set of points. The normal e1 x e2
+    //      is chosen to point along +z (or +y or +x for planes containing the z-axis), so that
+    //      counter-clockwise triangles in the xy-plane keep their orientation.
+    void lattice_plane_basis(const vectorfield & positions, Vector3 & e1, Vector3 & e2)
+    {
+        e1 = {1,0,0};
+        e2 = {0,1,0};
+
+        // First non-vanishing in-plane vector
+        Vector3 v1{0,0,0};
+        unsigned int i = 1;
+        for (; i < positions.size(); ++i)
+        {
+            v1 = positions[i] - positions[0];
+            if (v1.norm() > 1e-8) break;
+        }
+        // First in-plane vector which is not parallel to v1
+        Vector3 normal{0,0,0};
+        for (++i; i < positions.size(); ++i)
+        {
+            normal = v1.cross(positions[i] - positions[0]);
+            if (normal.norm() > 1e-8 * v1.squaredNorm()) break;
+        }
+        if (normal.norm() <= 1e-8 * v1.squaredNorm())
+            return;
+
+        normal.normalize();
+        for (int dim = 2; dim >= 0; --dim)
+        {
+            if (std::abs(normal[dim]) > 1e-8)
+            {
+                if (normal[dim] < 0) normal = -normal;
+                break;
+            }
+        }
+        e1 = v1.normalized();
+        e2 = normal.cross(e1);
+    }
+
+    // Orient a triangle counter-clockwise in the plane
+    void orient_triangle(const vector2_t & p1, const vector2_t & p2, const vector2_t & p3, int & i2, int & i3)
+    {
+        scalar cross = (p2.x - p1.x)*(p3.y - p1.y) - (p2.y - p1.y)*(p3.x - p1.x);
+        if (cross < 0)
+            std::swap(i2, i3);
+    }
+
+    // A vertex of a lattice simplex: {basis atom index, da, db, dc}, where the d's are the
+    //      translations of the vertex' cell relative to the cell the simplex belongs to
+    typedef std::array<int, 4> lattice_vertex_t;
+
+    // Calculate the Delaunay simplices (triangles for ndim=2, tetrahedra for ndim=3) belonging to a
+    //      single basis cell of the lattice of every n_cell_step'th cell.
+    //      Only a small patch of cells is triangulated with qhull. A simplex belongs to the central
+    //      cell if that is the componentwise minimum of the cells of its vertices, so that the
+    //      translations of these simplices tile the lattice exactly once.
+    //      Returns false if the lattice does not span ndim dimensions or if the simplices do not
+    //      fill the cell (e.g. for degenerate point sets), in which case the full Delaunay
+    //      triangulation needs to be used.
+    bool compute_lattice_cell_simplices(const Geometry & geometry, int n_cell_step, int ndim,
+        std::vector<std::vector<lattice_vertex_t>> & cell_simplices)
+    {
+        cell_simplices.clear();
+
+        auto& n_cells = geometry.n_cells;
+        int n_cell_atoms = geometry.n_cell_atoms;
+
+        // The lattice needs to have ndim translation directions
+        std::vector<int> directions(0);
+        for (int dim = 0; dim < 3; ++dim)
+            if (n_cells[dim] > 1) directions.push_back(dim);
+        if (int(directions.size()) != ndim)
+            return false;
+
+        // Translation vectors of the lattice of every n_cell_step'th cell, taken from the positions
+        std::array<Vector3, 3> translations{ Vector3{0,0,0}, Vector3{0,0,0}, Vector3{0,0,0} };
+        for (int dim : directions)
+        {
+            std::array<int, 3> cell{ 0, 0, 0 };
+            cell[dim] = 1;
+            int idx = Engine::Vectormath::idx_from_translations(n_cells, n_cell_atoms, cell);
+            translations[dim] = n_cell_step * (geometry.positions[idx] - geometry.positions[0]);
+        }
+
+        // Orthonormal basis of the lattice plane, onto which 2D points are projected
+        Vector3 e1{1,0,0}, e2{0,1,0};
+        if (ndim == 2)
+            lattice_plane_basis(geometry.positions, e1, e2);
+
+        // Points of a patch of cells around the central cell (0,0,0)
+        const int margin = 2;
+        std::array<int, 3> cell_min{ 0, 0, 0 }, cell_max{ 0, 0, 0 };
+        for (int dim : directions)
+        {
+            cell_min[dim] = -margin;
+            cell_max[dim] = margin + 1;
+        }
+        std::vector<lattice_vertex_t> patch_vertices(0);
+        std::vector<Vector3> patch_points(0);
+        for (int dc = cell_min[2]; dc <= cell_max[2]; ++dc)
+        {
+            for (int db = cell_min[1]; db <= cell_max[1]; ++db)
+            {
+                for (int da = cell_min[0]; da <= cell_max[0]; ++da)
+                {
+                    for (int ibasis = 0; ibasis < n_cell_atoms; ++ibasis)
+                    {
+                        patch_vertices.push_back({ ibasis, da, db, dc });
+                        patch_points.push_back( geometry.positions[ibasis]
+                            + da * translations[0] + db * translations[1] + dc * translations[2] );
+                    }
+                }
+            }
+        }
+
+        // Triangulate the patch
+        std::vector<std::vector<int>> patch_simplices(0);
+        if (ndim == 2)
+        {
+            std::vector<vector2_t> points(patch_points.size());
+            for (unsigned int i = 0; i < patch_points.size(); ++i)
+            {
+                points[i].x = patch_points[i].dot(e1);
+                points[i].y = patch_points[i].dot(e2);
+            }
+            for (auto& triangle : compute_delaunay_triangulation_2D(points))
+            {
+                orient_triangle(points[triangle[0]], points[triangle[1]], points[triangle[2]], triangle[1], triangle[2]);
+                patch_simplices.push_back({ triangle[0], triangle[1], triangle[2] });
+            }
+        }
+        else
+        {
+            std::vector<vector3_t> points(patch_points.size());
+            for (unsigned int i = 0; i < patch_points.size(); ++i)
+            {
+                points[i].x = patch_points[i][0];
+                points[i].y = patch_points[i][1];
+                points[i].z = patch_points[i][2];
+            }
+            for (auto& tetrahedron : compute_delaunay_triangulation_3D(points))
+                patch_simplices.push_back({ tetrahedron[0], tetrahedron[1], tetrahedron[2], tetrahedron[3] });
+        }
+
+        // Area or volume of the cell
+        scalar cell_measure;
+        if (ndim == 2)
+            cell_measure = translations[directions[0]].cross(translations[directions[1]]).norm();
+        else
+            cell_measure = std::abs(translations[0].dot(translations[1].cross(translations[2])));
+
+        // Keep the simplices belonging to the central cell and sum up their area or volume
+        scalar measure = 0;
+        for (auto& simplex : patch_simplices)
+        {
+            std::array<int, 3> owner{ patch_vertices[simplex[0]][1], patch_vertices[simplex[0]][2], patch_vertices[simplex[0]][3] };
+            for (int idx : simplex)
+                for (int dim = 0; dim < 3; ++dim)
+                    owner[dim] = std::min(owner[dim], patch_vertices[idx][dim+1]);
+            if (owner[0] != 0 || owner[1] != 0 || owner[2] != 0)
+                continue;
+
+            Vector3 v1 = patch_points[simplex[1]] - patch_points[simplex[0]];
+            Vector3 v2 = patch_points[simplex[2]] - patch_points[simplex[0]];
+            scalar simplex_measure;
+            if (ndim == 2)
+                simplex_measure = 0.5 * v1.cross(v2).norm();
+            else
+                simplex_measure = std::abs(v1.dot(v2.cross(patch_points[simplex[3]] - patch_points[simplex[0]]))) / 6.0;
+
+            // Qhull's triangulation of cospherical points (e.g. cubic lattices) may contain flat simplices
+            if (simplex_measure < 1e-8 * cell_measure)
+                continue;
+
+            std::vector<lattice_vertex_t> cell_simplex(0);
+            for (int idx : simplex)
+                cell_simplex.push_back(patch_vertices[idx]);
+            cell_simplices.push_back(cell_simplex);
+            measure += simplex_measure;
+        }
+
+        // The simplices of one cell need to exactly fill the area or volume of the cell
+        if (cell_simplices.size() == 0 || std::abs(measure - cell_measure) > 1e-6 * cell_measure)
+        {
+            cell_simplices.clear();
+            return false;
+        }
+        return true;
+    }
+
+    // Translate the simplices of a single cell across the lattice of every n_cell_step'th cell.
+    //      The resulting indices refer to the spins of that lattice. Simplices which reach over the
+    //      boundary are wrapped around in periodic directions and dropped otherwise.
+    template<std::size_t N>
+    void generate_lattice_simplices(const std::vector<std::vector<lattice_vertex_t>> & cell_simplices,
+        int n_cell_atoms, const std::array<int, 3> & n_cells, const std::array<bool, 3> & periodic,
+        std::vector<std::array<int, N>> & simplices)
     {
+        simplices.clear();
+        simplices.reserve(cell_simplices.size() * n_cells[0] * n_cells[1] * n_cells[2]);
+
+        std::array<int, N> simplex;
+        std::array<int, 3> cell;
+        for (int cell_c = 0; cell_c < n_cells[2]; ++cell_c)
+        {
+            for (int cell_b = 0; cell_b < n_cells[1]; ++cell_b)
+            {
+                for (int cell_a = 0; cell_a < n_cells[0]; ++cell_a)
+                {
+                    for (auto& cell_simplex : cell_simplices)
+                    {
+                        bool valid = true;
+                        for (unsigned int k = 0; k < N && valid; ++k)
+                        {
+                            auto& vertex = cell_simplex[k];
+                            cell = { cell_a + vertex[1], cell_b + vertex[2], cell_c + vertex[3] };
+                            for (int dim = 0; dim < 3; ++dim)
+                            {
+                                if (cell[dim] < 0 || cell[dim] >= n_cells[dim])
+                                {
+                                    if (periodic[dim])
+                                        cell[dim] = (cell[dim] % n_cells[dim] + n_cells[dim]) % n_cells[dim];
+                                    else
+                                        valid = false;
+                                }
+                            }
+                            simplex[k] = vertex[0] + n_cell_atoms*(cell[0] + n_cells[0]*(cell[1] + n_cells[1]*cell[2]));
+                        }
+
+                        // Wrapping around a small lattice may collapse vertices onto each other
+                        for (unsigned int k = 0; k < N && valid; ++k)
+                            for (unsigned int l = k+1; l < N && valid; ++l)
+                                if (simplex[k] == simplex[l]) valid = false;
+
+                        if (valid)
+                            simplices.push_back(simplex);
+                    }
+                }
+            }
+        }
+    }
+
+    const std::vector<triangle_t>& Geometry::triangulation(int n_cell_step, const intfield & boundary_conditions)
+    {
+        std::lock_guard<std::mutex> guard(this->simplex_cache.mutex);
+
+        // Check if the triangulation for this combination of n_cell_step and boundary conditions has already been calculated
+        auto key = Simplex_Cache::Make_Key(n_cell_step, boundary_conditions);
+        auto cached = this->simplex_cache.triangulations.find(key);
+        if (cached != this->simplex_cache.triangulations.end())
+            return cached->second;
+        auto & _triangulation = this->simplex_cache.triangulations[key];
+
         // Only every n_cell_step'th cell is used. So we check if there is still enough cells in all
         //      directions. Note: when visualising, 'n_cell_step' can be used to e.g. olny visualise
         //      every 2nd spin.
@@ -109,159 +384,113 @@ namespace Data
              (n_cells[1]/n_cell_step < 2 && n_cells[1] > 1) ||
              (n_cells[2]/n_cell_step < 2 && n_cells[2] > 1) )
         {
-            _triangulation.clear();
             return _triangulation;
         }
 
         // 2D: triangulation
         if (dimensionality == 2)
         {
-            // Check if the tetrahedra for this combination of n_cells and n_cell_step has already been calculated
-            if (this->last_update_n_cell_step != n_cell_step ||
-                this->last_update_n_cells[0]  != n_cells[0]  ||
-                this->last_update_n_cells[1]  != n_cells[1]  ||
-                this->last_update_n_cells[2]  != n_cells[2]  )
+            auto n_cells_step = stepped_n_cells(n_cells, n_cell_step);
+
+            // For a Bravais lattice the triangles can be generated from those of a single cell
+            std::vector<std::vector<lattice_vertex_t>> cell_simplices;
+            if (compute_lattice_cell_simplices(*this, n_cell_step, 2, cell_simplices))
+            {
+                generate_lattice_simplices(cell_simplices, n_cell_atoms, n_cells_step, { key[1] != 0, key[2] != 0, key[3] != 0 }, _triangulation);
+            }
+            // Otherwise we calculate the Delaunay triangulation of all points
+            else
             {
-                this->last_update_n_cell_step = n_cell_step;
-                this->last_update_n_cells[0]  = n_cells[0];
-                this->last_update_n_cells[1]  = n_cells[1];
-                this->last_update_n_cells[2]  = n_cells[2];
-                
-                _triangulation.clear();
+                Vector3 e1, e2;
+                lattice_plane_basis(positions, e1, e2);
 
                 std::vector<vector2_t> points;
-                points.resize(positions.size());
+                points.resize(n_cell_atoms * n_cells_step[0] * n_cells_step[1] * n_cells_step[2]);
 
                 int icell = 0, idx;
-                for (int cell_c=0; cell_c<n_cells[2]; cell_c+=n_cell_step)
+                for (int cell_c=0; cell_c<n_cells_step[2]; ++cell_c)
                 {
-                    for (int cell_b=0; cell_b<n_cells[1]; cell_b+=n_cell_step)
+                    for (int cell_b=0; cell_b<n_cells_step[1]; ++cell_b)
                     {
-                        for (int cell_a=0; cell_a<n_cells[0]; cell_a+=n_cell_step)
+                        for (int cell_a=0; cell_a<n_cells_step[0]; ++cell_a)
                         {
                             for (int ibasis=0; ibasis < n_cell_atoms; ++ibasis)
                             {
-                                idx = ibasis + n_cell_atoms*cell_a + n_cell_atoms*n_cells[0]*cell_b + n_cell_atoms*n_cells[0]*n_cells[1]*cell_c;
-                                points[icell].x = positions[idx][0];
-                                points[icell].y = positions[idx][1];
+                                idx = ibasis + n_cell_atoms*cell_a*n_cell_step + n_cell_atoms*n_cells[0]*cell_b*n_cell_step + n_cell_atoms*n_cells[0]*n_cells[1]*cell_c*n_cell_step;
+                                points[icell].x = positions[idx].dot(e1);
+                                points[icell].y = positions[idx].dot(e2);
                                 ++icell;
                             }
                         }
                     }
                 }
                 _triangulation = compute_delaunay_triangulation_2D(points);
+                for (auto& triangle : _triangulation)
+                    orient_triangle(points[triangle[0]], points[triangle[1]], points[triangle[2]], triangle[1], triangle[2]);
             }
         }// endif 2D
         // 0D, 1D and 3D give no triangulation
-        else
-        {
-            _triangulation.clear();
-        }
         return _triangulation;
     }
 
-    const std::vector<tetrahedron_t>& Geometry::tetrahedra(int n_cell_step)
+    const std::vector<tetrahedron_t>& Geometry::tetrahedra(int n_cell_step, const intfield & boundary_conditions)
     {
+        std::lock_guard<std::mutex> guard(this->simplex_cache.mutex);
+
+        // Check if the tetrahedra for this combination of n_cell_step and boundary conditions have already been calculated
+        auto key = Simplex_Cache::Make_Key(n_cell_step, boundary_conditions);
+        auto cached = this->simplex_cache.tetrahedra.find(key);
+        if (cached != this->simplex_cache.tetrahedra.end())
+            return cached->second;
+        auto & _tetrahedra = this->simplex_cache.tetrahedra[key];
+
         // Only every n_cell_step'th cell is used. So we check if there is still enough cells in all
         //      directions. Note: when visualising, 'n_cell_step' can be used to e.g. olny visualise
         //      every 2nd spin.
         if (n_cells[0]/n_cell_step < 2 || n_cells[1]/n_cell_step < 2 || n_cells[2]/n_cell_step < 2)
         {
-            _tetrahedra.clear();
             return _tetrahedra;
         }
 
         // 3D: Tetrahedra
         if (dimensionality == 3)
         {
-            // Check if the tetrahedra for this combination of n_cells and n_cell_step has already been calculated
-            if (this->last_update_n_cell_step != n_cell_step ||
-                this->last_update_n_cells[0]  != n_cells[0]  ||
-                this->last_update_n_cells[1]  != n_cells[1]  ||
-                this->last_update_n_cells[2]  != n_cells[2]  )
-            {
-                this->last_update_n_cell_step = n_cell_step;
-                this->last_update_n_cells[0]  = n_cells[0];
-                this->last_update_n_cells[1]  = n_cells[1];
-                this->last_update_n_cells[2]  = n_cells[2];
+            auto n_cells_step = stepped_n_cells(n_cells, n_cell_step);
 
-                // If we have only one spin in the basis our lattice is a simple regular geometry
-                bool is_simple_regular_geometry = n_cell_atoms == 1;
+            // For a Bravais lattice the tetrahedra can be generated from those of a single cell
+            std::vector<std::vector<lattice_vertex_t>> cell_simplices;
+            if (compute_lattice_cell_simplices(*this, n_cell_step, 3, cell_simplices))
+            {
+                generate_lattice_simplices(cell_simplices, n_cell_atoms, n_cells_step, { key[1] != 0, key[2] != 0, key[3] != 0 }, _tetrahedra);
+            }
+            // Otherwise we calculate the Delaunay tetrahedra of all points
+            else
+            {
+                std::vector<vector3_t> points;
+                points.resize(n_cell_atoms * n_cells_step[0] * n_cells_step[1] * n_cells_step[2]);
 
-                // If we have a simple regular geometry everything can be calculated by hand
-                if (is_simple_regular_geometry)
-                {
-                    _tetrahedra.clear();
-                    int cell_indices[] = {
-                        0, 1, 5, 3,
-                        1, 3, 2, 5,
-                        3, 2, 5, 6,
-                        7, 6, 5, 3,
-                        4, 7, 5, 3,
-                        0, 4, 3, 5
-                        };
-                    int x_offset = 1;
-                    int y_offset = n_cells[0]/n_cell_step;
-                    int z_offset = n_cells[0]/n_cell_step*n_cells[1]/n_cell_step;
-                    int offsets[] = {
-                        0, x_offset, x_offset+y_offset, y_offset,
-                        z_offset, x_offset+z_offset, x_offset+y_offset+z_offset, y_offset+z_offset
-                        };
-                
-                    for (int ix = 0; ix < (n_cells[0]-1)/n_cell_step; ix++)
-                    {
-                        for (int iy = 0; iy < (n_cells[1]-1)/n_cell_step; iy++)
-                        {
-                            for (int iz = 0; iz < (n_cells[2]-1)/n_cell_step; iz++)
-                            {
-                                int base_index = ix*x_offset+iy*y_offset+iz*z_offset;
-                                for (int j = 0; j < 6; j++)
-                                {
-                                    tetrahedron_t tetrahedron;
-                                    for (int k = 0; k < 4; k++)
-                                    {
-                                        int index = base_index + offsets[cell_indices[j*4+k]];
-                                        tetrahedron[k] = index;
-                                    }
-                                    _tetrahedra.push_back(tetrahedron);
-                                }
-                            }
-                        }
-                    }
-                }
-                // For general basis cells we calculate the Delaunay tetrahedra
-                else 
+                int icell = 0, idx;
+                for (int cell_c=0; cell_c<n_cells_step[2]; ++cell_c)
                 {
-                    std::vector<vector3_t> points;
-                    points.resize(positions.size());
-
-                    int icell = 0, idx;
-                    for (int cell_c=0; cell_c<n_cells[2]; cell_c+=n_cell_step)
+                    for (int cell_b=0; cell_b<n_cells_step[1]; ++cell_b)
                     {
-                        for (int cell_b=0; cell_b<n_cells[1]; cell_b+=n_cell_step)
+                        for (int cell_a=0; cell_a<n_cells_step[0]; ++cell_a)
                         {
-                            for (int cell_a=0; cell_a<n_cells[0]; cell_a+=n_cell_step)
+                            for (int ibasis=0; ibasis < n_cell_atoms; ++ibasis)
                             {
-                                for (int ibasis=0; ibasis < n_cell_atoms; ++ibasis)
-                                {
-                                    idx = ibasis + n_cell_atoms*cell_a + n_cell_atoms*n_cells[0]*cell_b + n_cell_atoms*n_cells[0]*n_cells[1]*cell_c;
-                                    points[icell].x = positions[idx][0];
-                                    points[icell].y = positions[idx][1];
-                                    points[icell].z = positions[idx][2];
-                                    ++icell;
-                                }
+                                idx = ibasis + n_cell_atoms*cell_a*n_cell_step + n_cell_atoms*n_cells[0]*cell_b*n_cell_step + n_cell_atoms*n_cells[0]*n_cells[1]*cell_c*n_cell_step;
+                                points[icell].x = positions[idx][0];
+                                points[icell].y = positions[idx][1];
+                                points[icell].z = positions[idx][2];
+                                ++icell;
                             }
                         }
                     }
-                    _tetrahedra = compute_delaunay_triangulation_3D(points);
                 }
+                _tetrahedra = compute_delaunay_triangulation_3D(points);
             }
         } // endif 3D
         // 0-2 D gives no tetrahedra
-        else
-        {
-            _tetrahedra.clear();
-        }
         return _tetrahedra;
     }
 
@@ -515,5 +744,22 @@ namespace Data
             this->classifier = BravaisLatticeType::Irregular;
         }
     }
+
+    void Geometry::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        using Utility::Memory::Bytes;
+        report.Add("positions", Bytes(this->positions));
+        report.Add("atom types", Bytes(this->atom_types));
+        report.Add("basis", Bytes(this->bravais_vectors) + Bytes(this->n_cells) + Bytes(this->cell_atoms) + Bytes(this->cell_atom_types));
+        std::lock_guard<std::mutex> guard(this->simplex_cache.mutex);
+        std::size_t bytes = 0;
+        for (auto & entry : this->simplex_cache.triangulations)
+            bytes += Bytes(entry.second);
+        report.Add("triangulation", bytes);
+        bytes = 0;
+        for (auto & entry : this->simplex_cache.tetrahedra)
+            bytes += Bytes(entry.second);
+        report.Add("tetrahedra", bytes);
+    }
 }
 
@@ -1,4 +1,5 @@
 #include <data/Parameters_Method_LLG.hpp>
+#include <Spirit/IO.h>
 
 namespace Data
 {
@@ -19,7 +20,9 @@ namespace Data
         temperature_gradient_inclination(temperature_gradient_inclination),
         rng_seed(rng_seed), prng(std::mt19937(rng_seed)), stt_use_gradient(stt_use_gradient), 
         stt_magnitude(stt_magnitude_i), stt_polarisation_normal(stt_polarisation_normal_i),
-        direct_minimization(false)
+        direct_minimization(false), output_configuration_trajectory(false),
+        output_trajectory_encoding(IO_Trajectory_Float32),
+        output_energy_spin_resolved_filetype(IO_Fileformat_Regular)
     {
     }
 }
\ No newline at end of file
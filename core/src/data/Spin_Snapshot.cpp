@@ -0,0 +1,57 @@
+#include <data/Spin_Snapshot.hpp>
+#include <data/Spin_System.hpp>
+
+#include <atomic>
+
+namespace Data
+{
+	Spin_Snapshot_Buffer::Spin_Snapshot_Buffer() : live(false)
+	{
+	}
+
+	void Spin_Snapshot_Buffer::Publish(const Spin_System & system, int iteration)
+	{
+		std::lock_guard<std::mutex> guard(this->mutex);
+
+		// Reuse a snapshot which is neither published nor held by a reader
+		std::shared_ptr<Spin_Snapshot> snapshot;
+		for (auto& s : this->pool)
+		{
+			if (s.use_count() == 1)
+			{
+				snapshot = s;
+				break;
+			}
+		}
+		if (!snapshot)
+		{
+			snapshot = std::make_shared<Spin_Snapshot>();
+			this->pool.push_back(snapshot);
+		}
+		// Make sure the last reader has finished before the snapshot is overwritten
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		snapshot->iteration       = iteration;
+		snapshot->spins           = *system.spins;
+		snapshot->effective_field = system.effective_field;
+		snapshot->E               = system.E;
+		snapshot->E_array         = system.E_array;
+
+		std::atomic_store(&this->published, std::shared_ptr<const Spin_Snapshot>(snapshot));
+	}
+
+	std::shared_ptr<const Spin_Snapshot> Spin_Snapshot_Buffer::Get() const
+	{
+		return std::atomic_load(&this->published);
+	}
+
+	void Spin_Snapshot_Buffer::Memory_Usage(Utility::Memory::Report & report) const
+	{
+		using Utility::Memory::Bytes;
+		std::lock_guard<std::mutex> guard(this->mutex);
+		std::size_t bytes = 0;
+		for (auto& snapshot : this->pool)
+			bytes += sizeof(Spin_Snapshot) + Bytes(snapshot->spins) + Bytes(snapshot->effective_field) + Bytes(snapshot->E_array);
+		report.Add("snapshots", bytes);
+	}
+}
@@ -113,6 +113,21 @@ namespace Data
 		Engine::Vectormath::scale(this->effective_field, -1);
 	}
 
+	const std::vector<std::pair<std::string, scalarfield>> & Spin_System::UpdateEnergy_per_Spin()
+	{
+		auto& contributions = this->hamiltonian->Update_Energy_Contributions_per_Spin(*this->spins);
+		int n_contributions = contributions.size();
+		this->E_per_spin.resize(this->nos);
+		#pragma omp parallel for
+		for (int ispin = 0; ispin < this->nos; ++ispin)
+		{
+			this->E_per_spin[ispin] = 0;
+			for (int i = 0; i < n_contributions; ++i)
+				this->E_per_spin[ispin] += contributions[i].second[ispin];
+		}
+		return contributions;
+	}
+
 	void Spin_System::Lock() const
 	{
 		try
@@ -136,4 +151,15 @@ namespace Data
 			spirit_handle_exception_core("Unlocking the Spin_System failed!");
 		}
 	}
+
+	void Spin_System::Memory_Usage(Utility::Memory::Report & report) const
+	{
+		using Utility::Memory::Bytes;
+		report.Add("spins", Bytes(*this->spins));
+		report.Add("effective field", Bytes(this->effective_field));
+		report.Add("energy per spin", Bytes(this->E_per_spin));
+		this->snapshots.Memory_Usage(report);
+		this->geometry->Memory_Usage(report.Child("Geometry"));
+		this->hamiltonian->Memory_Usage(report.Child("Hamiltonian"));
+	}
 }
\ No newline at end of file
@@ -48,4 +48,12 @@ namespace Data
 			spirit_handle_exception_core("Unlocking the Spin_System failed!");
 		}
 	}
+
+	void Spin_System_Chain::Memory_Usage(Utility::Memory::Report & report) const
+	{
+		using Utility::Memory::Bytes;
+		for (int i = 0; i < this->noi; ++i)
+			this->images[i]->Memory_Usage(report.Child("Image " + std::to_string(i)));
+		report.Add("interpolated energies", Bytes(this->Rx) + Bytes(this->Rx_interpolated) + Bytes(this->E_interpolated) + Bytes(this->E_array_interpolated));
+	}
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include <engine/Decomposition.hpp>
+#include <utility/Logging.hpp>
+
+#include <vector>
+#include <cstdlib>
+
+namespace Engine
+{
+	namespace Decomposition
+	{
+		#ifdef SPIRIT_USE_MPI
+
+		MPI_Comm communicator = MPI_COMM_NULL;
+		int rank = 0, n_ranks = 1;
+
+		void Finalize()
+		{
+			int finalized = 0;
+			MPI_Finalized(&finalized);
+			if (!finalized)
+				MPI_Finalize();
+		}
+
+		// MPI is initialised on first use, if the application has not done so itself
+		void Initialize()
+		{
+			int initialized = 0;
+			MPI_Initialized(&initialized);
+			if (!initialized)
+			{
+				MPI_Init(nullptr, nullptr);
+				std::atexit(Finalize);
+			}
+		}
+
+		void Set_Communicator(MPI_Comm comm)
+		{
+			Initialize();
+			communicator = comm;
+			// Rank and size are cached, so that they can still be queried after MPI_Finalize
+			MPI_Comm_rank(communicator, &rank);
+			MPI_Comm_size(communicator, &n_ranks);
+			Log.rank = rank;
+		}
+
+		MPI_Comm Communicator()
+		{
+			if (communicator == MPI_COMM_NULL)
+				Set_Communicator(MPI_COMM_WORLD);
+			return communicator;
+		}
+
+		MPI_Datatype Scalar_Type()
+		{
+			return sizeof(scalar) == sizeof(float) ? MPI_FLOAT : MPI_DOUBLE;
+		}
+
+		// Gather the owned ranges of a field with n_components scalars per spin
+		void Gather_Scalars(scalar * data, const Data::Geometry & geometry, int n_components)
+		{
+			int n_ranks = N_Ranks();
+			if (n_ranks == 1) return;
+
+			std::vector<int> counts(n_ranks), displacements(n_ranks);
+			for (int rank = 0; rank < n_ranks; ++rank)
+			{
+				auto slab = Get_Slab(geometry, rank);
+				counts[rank]        = n_components * (slab.idx_end - slab.idx_begin);
+				displacements[rank] = n_components * slab.idx_begin;
+			}
+			MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+				data, counts.data(), displacements.data(), Scalar_Type(), Communicator());
+		}
+
+		#endif
+
+		void Setup()
+		{
+			#ifdef SPIRIT_USE_MPI
+			Communicator();
+			#endif
+		}
+
+		int Rank()
+		{
+			#ifdef SPIRIT_USE_MPI
+			Communicator();
+			return rank;
+			#else
+			return 0;
+			#endif
+		}
+
+		int N_Ranks()
+		{
+			#ifdef SPIRIT_USE_MPI
+			Communicator();
+			return n_ranks;
+			#else
+			return 1;
+			#endif
+		}
+
+		Slab Get_Slab(const Data::Geometry & geometry, int rank)
+		{
+			auto& n_cells = geometry.n_cells;
+			int N = geometry.n_cell_atoms;
+			int n_ranks = N_Ranks();
+
+			Slab slab;
+			slab.cell_min = { 0, 0, 0 };
+			slab.cell_max = { n_cells[0], n_cells[1], n_cells[2] };
+
+			// The slowest direction with more than one cell, so that the slab is contiguous in memory
+			slab.direction = 2;
+			while (slab.direction > 0 && n_cells[slab.direction] < 2)
+				--slab.direction;
+
+			int n = n_cells[slab.direction];
+			slab.cell_min[slab.direction] = (rank * n) / n_ranks;
+			slab.cell_max[slab.direction] = ((rank + 1) * n) / n_ranks;
+
+			// Number of cells in one layer of the decomposed direction
+			int n_cells_layer = 1;
+			for (int dim = 0; dim < slab.direction; ++dim)
+				n_cells_layer *= n_cells[dim];
+
+			slab.icell_begin = n_cells_layer * slab.cell_min[slab.direction];
+			slab.icell_end   = n_cells_layer * slab.cell_max[slab.direction];
+			slab.idx_begin   = N * slab.icell_begin;
+			slab.idx_end     = N * slab.icell_end;
+			return slab;
+		}
+
+		Slab Get_Slab(const Data::Geometry & geometry)
+		{
+			return Get_Slab(geometry, Rank());
+		}
+
+		void Gather(vectorfield & vf, const Data::Geometry & geometry)
+		{
+			#ifdef SPIRIT_USE_MPI
+			if (!vf.empty())
+				Gather_Scalars(vf[0].data(), geometry, 3);
+			#endif
+		}
+
+		void Gather(scalarfield & sf, const Data::Geometry & geometry)
+		{
+			#ifdef SPIRIT_USE_MPI
+			if (!sf.empty())
+				Gather_Scalars(sf.data(), geometry, 1);
+			#endif
+		}
+
+		void Broadcast(vectorfield & vf)
+		{
+			#ifdef SPIRIT_USE_MPI
+			if (N_Ranks() > 1 && !vf.empty())
+				MPI_Bcast(vf[0].data(), 3*vf.size(), Scalar_Type(), 0, Communicator());
+			#endif
+		}
+
+		bool Any(bool condition)
+		{
+			#ifdef SPIRIT_USE_MPI
+			if (N_Ranks() > 1)
+			{
+				int local = condition, global = 0;
+				MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_LOR, Communicator());
+				return global != 0;
+			}
+			#endif
+			return condition;
+		}
+	}
+}
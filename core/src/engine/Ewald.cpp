@@ -0,0 +1,360 @@
+#include <engine/Ewald.hpp>
+#include <engine/Decomposition.hpp>
+#include <engine/Vectormath.hpp>
+#include <utility/Constants.hpp>
+#include <utility/Logging.hpp>
+
+#include <Eigen/Dense>
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <fmt/format.h>
+
+using namespace Utility;
+using Utility::Constants::mu_B;
+using Utility::Constants::mu_0;
+using Utility::Constants::Pi;
+using Engine::Vectormath::check_atom_type;
+
+namespace Engine
+{
+	namespace Ewald
+	{
+		// Relative accuracy of the lattice sums
+		const scalar tolerance = std::sqrt(std::numeric_limits<scalar>::epsilon());
+
+		// exp(a)*erfc(u) for a <= u^2, which stays finite where exp(a) alone would overflow
+		scalar exp_erfc(scalar a, scalar u)
+		{
+			if (u < 26)
+				return std::exp(a) * std::erfc(u);
+			// Asymptotic expansion of erfc
+			scalar u2 = u*u;
+			return std::exp(a - u2) / (u * std::sqrt(Pi)) * (1 - 1/(2*u2) + 3/(4*u2*u2));
+		}
+
+		// Real space part of the Ewald sum, which is the bare dipolar tensor for alpha = 0
+		Matrix3 Real_Space_Tensor(const Vector3 & r, scalar alpha)
+		{
+			scalar d  = r.norm();
+			scalar d2 = d*d;
+			scalar B, C;
+			if (alpha > 0)
+			{
+				scalar gauss = 2*alpha/std::sqrt(Pi) * std::exp(-alpha*alpha*d2);
+				B = (std::erfc(alpha*d)/d + gauss) / d2;
+				C = (3*B + 2*alpha*alpha*gauss) / d2;
+			}
+			else
+			{
+				B = 1 / (d2*d);
+				C = 3*B / d2;
+			}
+			return B * Matrix3::Identity() - C * r * r.transpose();
+		}
+
+		// Reciprocal space vectors of the lattice spanned by the (periodic) translations L
+		std::vector<Vector3> Reciprocal_Vectors(const std::vector<Vector3> & L, const Vector3 & normal, scalar k_cut)
+		{
+			std::vector<Vector3> G;
+			if (L.size() == 3)
+			{
+				for (int d = 0; d < 3; ++d)
+				{
+					Vector3 cross = L[(d+1)%3].cross(L[(d+2)%3]);
+					G.push_back(2*Pi * cross / L[d].dot(cross));
+				}
+			}
+			else
+			{
+				Vector3 cross_0 = L[1].cross(normal);
+				Vector3 cross_1 = normal.cross(L[0]);
+				G.push_back(2*Pi * cross_0 / L[0].dot(cross_0));
+				G.push_back(2*Pi * cross_1 / L[1].dot(cross_1));
+			}
+
+			// All vectors within k_cut in one half space, as all terms are even in k
+			std::vector<int> m_max;
+			for (auto& l : L)
+				m_max.push_back(std::ceil(k_cut * l.norm() / (2*Pi)));
+			int m2_max = L.size() == 3 ? m_max[2] : 0;
+
+			std::vector<Vector3> k_vectors;
+			for (int m0 = -m_max[0]; m0 <= m_max[0]; ++m0)
+			{
+				for (int m1 = -m_max[1]; m1 <= m_max[1]; ++m1)
+				{
+					for (int m2 = -m2_max; m2 <= m2_max; ++m2)
+					{
+						bool upper = m2 > 0 || (m2 == 0 && (m1 > 0 || (m1 == 0 && m0 > 0)));
+						if (!upper) continue;
+						Vector3 k = m0*G[0] + m1*G[1];
+						if (L.size() == 3) k += m2*G[2];
+						if (k.norm() < k_cut)
+							k_vectors.push_back(k);
+					}
+				}
+			}
+			return k_vectors;
+		}
+
+		// Periodic images n*L of the lattice, with |n_d| <= n_max[d]
+		std::vector<Vector3> Images(const std::vector<Vector3> & L, const std::vector<int> & n_max)
+		{
+			std::vector<Vector3> images{ {0,0,0} };
+			for (unsigned int d = 0; d < L.size(); ++d)
+			{
+				std::vector<Vector3> shifted;
+				for (auto& image : images)
+				{
+					for (int n = -n_max[d]; n <= n_max[d]; ++n)
+						shifted.push_back(image + n*L[d]);
+				}
+				images = shifted;
+			}
+			return images;
+		}
+
+		DDI_Tensors Get_DDI_Tensors(const Data::Geometry & geometry, const intfield & boundary_conditions)
+		{
+			const int N = geometry.n_cell_atoms;
+			auto& n_cells = geometry.n_cells;
+
+			DDI_Tensors result;
+			result.n_cells = n_cells;
+			result.n_cell_atoms = N;
+			result.boundary_conditions = boundary_conditions;
+			for (int d = 0; d < 3; ++d)
+				result.n_translations[d] = boundary_conditions[d] ? n_cells[d] : 2*n_cells[d] - 1;
+			int n_translations_total = result.n_translations[0] * result.n_translations[1] * result.n_translations[2];
+
+			// Translations of the whole lattice in the periodic directions
+			std::vector<Vector3> L;
+			for (int d = 0; d < 3; ++d)
+			{
+				if (boundary_conditions[d])
+					L.push_back(n_cells[d] * geometry.bravais_vectors[d]);
+			}
+			const int n_periodic = L.size();
+
+			// Largest distance between two spins of the lattice
+			scalar extent = (geometry.bounds_max - geometry.bounds_min).norm();
+
+			const scalar s = std::sqrt(-std::log(tolerance));
+			scalar alpha = 0, r_cut = 0, k_cut = 0;
+			Vector3 normal{0,0,1};
+			scalar volume = 1;
+			std::vector<Vector3> images{ {0,0,0} };
+			std::vector<Vector3> k_vectors;
+			Matrix3 tail = Matrix3::Zero();
+
+			if (n_periodic == 3)
+			{
+				// Balance the number of real space images and reciprocal vectors
+				volume = std::abs(L[0].dot(L[1].cross(L[2])));
+				alpha  = std::sqrt(Pi) / std::cbrt(volume);
+			}
+			else if (n_periodic == 2)
+			{
+				normal = L[0].cross(L[1]);
+				volume = normal.norm();
+				normal.normalize();
+				alpha  = std::sqrt(Pi / volume);
+			}
+
+			if (n_periodic >= 2)
+			{
+				r_cut = s / alpha;
+				k_cut = 2 * s * alpha;
+				k_vectors = Reciprocal_Vectors(L, normal, k_cut);
+				// The spins are at most one lattice translation apart in each periodic direction
+				std::vector<int> n_max;
+				for (int d = 0; d < n_periodic; ++d)
+				{
+					Vector3 cross = n_periodic == 3 ? L[(d+1)%3].cross(L[(d+2)%3]) : (d == 0 ? L[1].cross(normal) : normal.cross(L[0]));
+					scalar height = std::abs(L[d].dot(cross.normalized()));
+					n_max.push_back(std::ceil(r_cut / height) + 2);
+				}
+				images = Images(L, n_max);
+			}
+			else if (n_periodic == 1)
+			{
+				// The direct sum converges absolutely. Images beyond n_max are approximated by
+				// dipoles on the axis, with an error of order (extent/(n_max*|L|))^2 / n_max^2
+				scalar length = L[0].norm();
+				int n_max = std::ceil(std::pow(tolerance, -0.25) * std::max(scalar(1), extent/length));
+				r_cut = n_max * length;
+				images = Images(L, { n_max });
+				scalar zeta_tail = 1/(2.0*n_max*n_max) - 1/(2.0*n_max*n_max*n_max) + 1/(4.0*n_max*n_max*n_max*n_max);
+				Vector3 axis = L[0] / length;
+				tail = 2 * zeta_tail / std::pow(length, 3) * (Matrix3::Identity() - 3 * axis * axis.transpose());
+			}
+
+			result.alpha = alpha;
+			result.r_cut = r_cut;
+			result.k_cut = k_cut;
+			result.tensors = std::vector<Matrix3>(N*N*n_translations_total, Matrix3::Zero());
+
+			const scalar sqrt_pi = std::sqrt(Pi);
+			auto& a = geometry.bravais_vectors;
+
+			#pragma omp parallel for collapse(3)
+			for (int ibasis = 0; ibasis < N; ++ibasis)
+			{
+				for (int jbasis = 0; jbasis < N; ++jbasis)
+				{
+					for (int t = 0; t < n_translations_total; ++t)
+					{
+						// Cell difference of this entry
+						std::array<int, 3> diff;
+						int rest = t;
+						for (int d = 0; d < 3; ++d)
+						{
+							diff[d] = rest % result.n_translations[d];
+							rest /= result.n_translations[d];
+							if (!boundary_conditions[d])
+								diff[d] -= n_cells[d] - 1;
+						}
+						Vector3 r = geometry.positions[jbasis] - geometry.positions[ibasis]
+							+ diff[0]*a[0] + diff[1]*a[1] + diff[2]*a[2];
+
+						Matrix3 W = tail;
+
+						// Real space
+						for (auto& image : images)
+						{
+							Vector3 r_image = r + image;
+							scalar d = r_image.norm();
+							if (d < 1e-10) continue;
+							if (alpha > 0 && d > r_cut) continue;
+							W += Real_Space_Tensor(r_image, alpha);
+						}
+
+						// Reciprocal space (k vectors of one half space are counted twice)
+						if (n_periodic == 3)
+						{
+							for (auto& k : k_vectors)
+							{
+								scalar k2 = k.squaredNorm();
+								W += 2 * 4*Pi/volume * std::exp(-k2/(4*alpha*alpha)) / k2 * std::cos(k.dot(r)) * k * k.transpose();
+							}
+						}
+						else if (n_periodic == 2)
+						{
+							scalar z = r.dot(normal);
+							Vector3 rho = r - z*normal;
+							for (auto& k_vec : k_vectors)
+							{
+								scalar k = k_vec.norm();
+								scalar e_plus  = exp_erfc( k*z, k/(2*alpha) + alpha*z);
+								scalar e_minus = exp_erfc(-k*z, k/(2*alpha) - alpha*z);
+								scalar f = e_plus + e_minus;
+								scalar h = e_plus - e_minus;
+								scalar g = std::exp(-k*k/(4*alpha*alpha) - alpha*alpha*z*z);
+								scalar cosine = std::cos(k_vec.dot(rho));
+								scalar sine   = std::sin(k_vec.dot(rho));
+								W += 2 * Pi/volume * ( cosine * f / k * k_vec * k_vec.transpose()
+									+ sine * h * (k_vec * normal.transpose() + normal * k_vec.transpose())
+									- cosine * (k*f - 4*alpha*g/sqrt_pi) * normal * normal.transpose() );
+							}
+							// k = 0
+							W += 4*sqrt_pi*alpha/volume * std::exp(-alpha*alpha*z*z) * normal * normal.transpose();
+						}
+
+						// Self interaction of the screening charge distribution
+						if (alpha > 0 && ibasis == jbasis && diff[0] == 0 && diff[1] == 0 && diff[2] == 0)
+							W -= 4*std::pow(alpha, 3)/(3*sqrt_pi) * Matrix3::Identity();
+
+						result.tensors[(ibasis*N + jbasis)*n_translations_total + t] = W;
+					}
+				}
+			}
+
+			Log(Log_Level::Info, Log_Sender::All, fmt::format("Calculated DDI tensors for {} periodic directions: "
+				"alpha = {}, {} real space images, {} reciprocal vectors", n_periodic, alpha, images.size(), k_vectors.size()));
+
+			return result;
+		}
+
+		bool Is_Valid(const DDI_Tensors & tensors, const Data::Geometry & geometry, const intfield & boundary_conditions)
+		{
+			return tensors.n_cells == geometry.n_cells && tensors.n_cell_atoms == geometry.n_cell_atoms
+				&& tensors.boundary_conditions == boundary_conditions
+				&& tensors.tensors.size() > 0;
+		}
+
+		// Sum of mu_j W_ij s_j over all spins j
+		Vector3 Field(const DDI_Tensors & tensors, const Data::Geometry & geometry, const scalarfield & mu_s,
+			const vectorfield & spins, int ispin)
+		{
+			const int N = geometry.n_cell_atoms;
+			auto& n_cells = geometry.n_cells;
+			auto& n_translations = tensors.n_translations;
+			const int n_translations_total = n_translations[0] * n_translations[1] * n_translations[2];
+
+			int ibasis = ispin % N;
+			auto cell_i = Vectormath::translations_from_idx(n_cells, N, ispin);
+
+			// Index of a cell difference in the table
+			auto translation = [&](int diff, int d)
+			{
+				return tensors.boundary_conditions[d] ? (diff + n_cells[d]) % n_cells[d] : diff + n_cells[d] - 1;
+			};
+
+			Vector3 field{0, 0, 0};
+			int jspin = 0;
+			for (int c = 0; c < n_cells[2]; ++c)
+			{
+				int tc = translation(c - cell_i[2], 2);
+				for (int b = 0; b < n_cells[1]; ++b)
+				{
+					int tb = translation(b - cell_i[1], 1);
+					for (int a = 0; a < n_cells[0]; ++a)
+					{
+						int t = translation(a - cell_i[0], 0) + n_translations[0]*(tb + n_translations[1]*tc);
+						for (int jbasis = 0; jbasis < N; ++jbasis, ++jspin)
+						{
+							if (check_atom_type(geometry.atom_types[jspin]))
+								field += mu_s[jbasis] * (tensors.tensors[(ibasis*N + jbasis)*n_translations_total + t] * spins[jspin]);
+						}
+					}
+				}
+			}
+			return field;
+		}
+
+		void Gradient(const DDI_Tensors & tensors, const Data::Geometry & geometry, const scalarfield & mu_s,
+			const vectorfield & spins, vectorfield & gradient)
+		{
+			// The translations are in angstrom, so the |r|[m] becomes |r|[m]*10^-10
+			const scalar mult = mu_0 * std::pow(mu_B, 2) / ( 4*Pi * 1e-30 );
+			const int N = geometry.n_cell_atoms;
+			auto slab = Decomposition::Get_Slab(geometry);
+
+			#pragma omp parallel for
+			for (int ispin = slab.idx_begin; ispin < slab.idx_end; ++ispin)
+			{
+				if (check_atom_type(geometry.atom_types[ispin]))
+					gradient[ispin] += mult * mu_s[ispin % N] * Field(tensors, geometry, mu_s, spins, ispin);
+			}
+		}
+
+		void Energy_per_Spin(const DDI_Tensors & tensors, const Data::Geometry & geometry, const scalarfield & mu_s,
+			const vectorfield & spins, scalarfield & energy)
+		{
+			// The translations are in angstrom, so the |r|[m] becomes |r|[m]*10^-10
+			const scalar mult = mu_0 * std::pow(mu_B, 2) / ( 4*Pi * 1e-30 );
+			const int N = geometry.n_cell_atoms;
+			auto slab = Decomposition::Get_Slab(geometry);
+
+			#pragma omp parallel for
+			for (int ispin = slab.idx_begin; ispin < slab.idx_end; ++ispin)
+			{
+				if (check_atom_type(geometry.atom_types[ispin]))
+					energy[ispin] += 0.5 * mult * mu_s[ispin % N] * spins[ispin].dot(Field(tensors, geometry, mu_s, spins, ispin));
+			}
+		}
+	}
+}
@@ -26,6 +26,12 @@ namespace Engine
     }
 
 
+    void Hamiltonian::Update_Interactions()
+    {
+        // The base class has no geometry-dependent interactions
+    }
+
+
     void Hamiltonian::Hessian(const vectorfield & spins, MatrixX & hessian)
     {
         this->Hessian_FD(spins, hessian);
@@ -153,6 +159,20 @@ namespace Engine
             "Tried to use  Hamiltonian::Energy_Contributions_per_Spin() of the Hamiltonian base class!");
     }
 
+    const std::vector<std::pair<std::string, scalarfield>> & Hamiltonian::Update_Energy_Contributions_per_Spin(const vectorfield & spins)
+    {
+        Energy_Contributions_per_Spin(spins, this->energy_contributions_per_spin);
+        return this->energy_contributions_per_spin;
+    }
+
+    void Hamiltonian::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        std::size_t bytes = Memory::Bytes(this->energy_contributions_per_spin);
+        for (auto & contribution : this->energy_contributions_per_spin)
+            bytes += Memory::Bytes(contribution.second);
+        report.Add("energy contributions", bytes);
+    }
+
     static const std::string name = "--";
     const std::string& Hamiltonian::Name()
     {
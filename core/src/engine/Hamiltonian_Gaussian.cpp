@@ -1,5 +1,6 @@
 #include <engine/Hamiltonian_Gaussian.hpp>
 #include <engine/Vectormath.hpp>
+#include <utility/Profiling.hpp>
 
 using namespace Data;
 
@@ -52,6 +53,7 @@ namespace Engine
 
 	void Hamiltonian_Gaussian::Gradient(const vectorfield & spins, vectorfield & gradient)
 	{
+		SPIRIT_TIMER("Gradient Gaussian");
 		int nos = spins.size();
 
 		for (int ispin = 0; ispin < nos; ++ispin)
@@ -76,13 +78,14 @@ namespace Engine
 
 	void Hamiltonian_Gaussian::Energy_Contributions_per_Spin(const vectorfield & spins, std::vector<std::pair<std::string, scalarfield>> & contributions)
 	{
+		SPIRIT_TIMER("Energy Gaussian");
 		int nos = spins.size();
 
 		// Allocate if not already allocated
-		if (this->energy_contributions_per_spin[0].second.size() != nos) this->energy_contributions_per_spin = { { "Gaussian", scalarfield(nos,0) } };
+		if (contributions.size() != 1 || contributions[0].second.size() != nos) contributions = { { "Gaussian", scalarfield(nos,0) } };
 
 		// Set to zero
-		for (auto& pair : energy_contributions_per_spin) Vectormath::fill(pair.second, 0);
+		for (auto& pair : contributions) Vectormath::fill(pair.second, 0);
 
 		for (int i = 0; i < this->n_gaussians; ++i)
 		{
@@ -91,11 +94,18 @@ namespace Engine
 				// Distance between spin and gaussian center
 				scalar l = 1 - this->center[i].dot(spins[ispin]); //Utility::Manifoldmath::Dist_Greatcircle(this->center[i], n);
 																  // Energy contribution
-				this->energy_contributions_per_spin[0].second[ispin] += this->amplitude[i] * std::exp(-std::pow(l, 2) / (2.0*std::pow(this->width[i], 2)));
+				contributions[0].second[ispin] += this->amplitude[i] * std::exp(-std::pow(l, 2) / (2.0*std::pow(this->width[i], 2)));
 			}
 		}
 	}
 
+	void Hamiltonian_Gaussian::Memory_Usage(Utility::Memory::Report & report) const
+	{
+		using Utility::Memory::Bytes;
+		Hamiltonian::Memory_Usage(report);
+		report.Add("gaussians", Bytes(this->amplitude) + Bytes(this->width) + Bytes(this->center));
+	}
+
 	// Hamiltonian name as string
 	static const std::string name = "Gaussian";
 	const std::string& Hamiltonian_Gaussian::Name() { return name; }
@@ -4,8 +4,10 @@
 #include <engine/Hamiltonian_Heisenberg_Neighbours.hpp>
 #include <engine/Vectormath.hpp>
 #include <engine/Neighbours.hpp>
+#include <engine/Decomposition.hpp>
 #include <data/Spin_System.hpp>
 #include <utility/Constants.hpp>
+#include <utility/Profiling.hpp>
 
 #include <Eigen/Dense>
 
@@ -25,7 +27,7 @@ namespace Engine
         intfield anisotropy_indices, scalarfield anisotropy_magnitudes, vectorfield anisotropy_normals,
         scalarfield exchange_magnitudes,
         scalarfield dmi_magnitudes, int dm_chirality,
-        scalar ddi_radius,
+        scalar ddi_radius, DDI_Method ddi_method,
         std::shared_ptr<Data::Geometry> geometry,
         intfield boundary_conditions
     ) :
@@ -35,8 +37,8 @@ namespace Engine
         external_field_magnitude(external_field_magnitude * mu_B), external_field_normal(external_field_normal),
         anisotropy_indices(anisotropy_indices), anisotropy_magnitudes(anisotropy_magnitudes), anisotropy_normals(anisotropy_normals),
         exchange_magnitudes(exchange_magnitudes),
-        dmi_magnitudes(dmi_magnitudes),
-        ddi_radius(ddi_radius)
+        dmi_magnitudes(dmi_magnitudes), dm_chirality(dm_chirality),
+        ddi_radius(ddi_radius), ddi_method(ddi_method)
     {
         // Generate Exchange neighbours
         exchange_neighbours = Neighbours::Get_Neighbours_in_Shells(*geometry, exchange_magnitudes.size());
@@ -47,6 +49,7 @@ namespace Engine
         {
             dmi_normals.push_back(Neighbours::DMI_Normal_from_Pair(*geometry, dmi_neighbours[ineigh], dm_chirality));
         }
+        this->Update_Shell_Lattice();
 
         // Generate DDI neighbours, magnitudes and normals
         this->ddi_neighbours = Engine::Neighbours::Get_Neighbours_in_Radius(*this->geometry, ddi_radius);
@@ -76,6 +79,74 @@ namespace Engine
         }
     }
 
+    void Hamiltonian_Heisenberg_Neighbours::Update_Interactions()
+    {
+        int n_cell_atoms = geometry->n_cell_atoms;
+
+        if (this->mu_s.size() > 0)
+            this->mu_s.resize(n_cell_atoms, this->mu_s[0]);
+
+        // Anisotropies of basis atoms which no longer exist are removed
+        std::vector<bool> keep(anisotropy_indices.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = anisotropy_indices[i] >= 0 && anisotropy_indices[i] < n_cell_atoms;
+        Vectormath::filter(anisotropy_indices, keep);
+        Vectormath::filter(anisotropy_magnitudes, keep);
+        Vectormath::filter(anisotropy_normals, keep);
+
+        // The neighbour shells depend on the basis cell and the Bravais vectors, so they are only
+        //      re-generated when these, or the translations searched on small lattices, changed
+        if (this->Update_Shell_Lattice())
+        {
+            exchange_neighbours = Neighbours::Get_Neighbours_in_Shells(*geometry, exchange_magnitudes.size());
+            dmi_neighbours = Neighbours::Get_Neighbours_in_Shells(*geometry, dmi_magnitudes.size());
+            dmi_normals = vectorfield(0);
+            for (unsigned int ineigh = 0; ineigh < dmi_neighbours.size(); ++ineigh)
+            {
+                dmi_normals.push_back(Neighbours::DMI_Normal_from_Pair(*geometry, dmi_neighbours[ineigh], dm_chirality));
+            }
+        }
+
+        // The range of the DDI neighbours is limited by the extent of the lattice, so they are re-generated
+        this->ddi_neighbours = Engine::Neighbours::Get_Neighbours_in_Radius(*this->geometry, this->ddi_radius);
+        this->ddi_magnitudes = scalarfield(0);
+        this->ddi_normals = vectorfield(0);
+        scalar magnitude;
+        Vector3 normal;
+        for (unsigned int i=0; i<ddi_neighbours.size(); ++i)
+        {
+            Engine::Neighbours::DDI_from_Pair(*this->geometry, ddi_neighbours[i], magnitude, normal);
+            this->ddi_magnitudes.push_back(magnitude);
+            this->ddi_normals.push_back(normal);
+        }
+
+        // The lattice sums are re-calculated when next needed
+        this->ddi_tensors = Ewald::DDI_Tensors();
+
+        this->Update_Energy_Contributions();
+    }
+
+    bool Hamiltonian_Heisenberg_Neighbours::Update_Shell_Lattice()
+    {
+        auto exchange_translations = Neighbours::Get_Shell_Translations(*geometry, exchange_magnitudes.size());
+        auto dmi_translations = Neighbours::Get_Shell_Translations(*geometry, dmi_magnitudes.size());
+        if ( geometry->bravais_vectors == this->shell_bravais_vectors &&
+             geometry->cell_atoms == this->shell_cell_atoms &&
+             int(exchange_magnitudes.size()) == this->n_exchange_shells &&
+             int(dmi_magnitudes.size()) == this->n_dmi_shells &&
+             exchange_translations == this->exchange_shell_translations &&
+             dmi_translations == this->dmi_shell_translations )
+            return false;
+
+        this->shell_bravais_vectors = geometry->bravais_vectors;
+        this->shell_cell_atoms = geometry->cell_atoms;
+        this->n_exchange_shells = exchange_magnitudes.size();
+        this->n_dmi_shells = dmi_magnitudes.size();
+        this->exchange_shell_translations = exchange_translations;
+        this->dmi_shell_translations = dmi_translations;
+        return true;
+    }
+
     void Hamiltonian_Heisenberg_Neighbours::Update_Energy_Contributions()
     {
         this->energy_contributions_per_spin = std::vector<std::pair<std::string, scalarfield>>(0);
@@ -109,7 +180,7 @@ namespace Engine
         }
         else this->idx_dmi = -1;
         // Dipole-Dipole
-        if (this->ddi_neighbours.size() > 0)
+        if (this->ddi_neighbours.size() > 0 || this->ddi_method == DDI_Method::Ewald)
         {
             this->energy_contributions_per_spin.push_back({"DD", scalarfield(0) });
             this->idx_ddi = this->energy_contributions_per_spin.size()-1;
@@ -144,14 +215,20 @@ namespace Engine
         if (this->idx_dmi >=0 )        E_DMI(spins, energy_contributions_per_spin[idx_dmi].second);
         // DDI
         if (this->idx_ddi >=0 )        E_DDI(spins, energy_contributions_per_spin[idx_ddi].second);
+
+        // Collect the contributions of all ranks
+        for (auto& pair : energy_contributions_per_spin)
+            Decomposition::Gather(pair.second, *geometry);
     }
 
     void Hamiltonian_Heisenberg_Neighbours::E_Zeeman(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy Zeeman");
         const int N = geometry->n_cell_atoms;
 
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (int icell = 0; icell < geometry->n_cells_total; ++icell)
+        for (int icell = slab.icell_begin; icell < slab.icell_end; ++icell)
         {
             for (int ibasis = 0; ibasis < N; ++ibasis)
             {
@@ -164,10 +241,12 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::E_Anisotropy(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy Anisotropy");
         const int N = geometry->n_cell_atoms;
 
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (int icell = 0; icell < geometry->n_cells_total; ++icell)
+        for (int icell = slab.icell_begin; icell < slab.icell_end; ++icell)
         {
             for (int iani = 0; iani < anisotropy_indices.size(); ++iani)
             {
@@ -180,8 +259,10 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::E_Exchange(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy Exchange");
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (unsigned int ispin = 0; ispin < spins.size(); ++ispin)
+        for (int ispin = slab.idx_begin; ispin < slab.idx_end; ++ispin)
         {
             // auto translations = Vectormath::translations_from_idx(geometry->n_cells, geometry->n_cell_atoms, ispin);
             for (unsigned int ineigh = 0; ineigh < exchange_neighbours.size(); ++ineigh)
@@ -198,8 +279,10 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::E_DMI(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy DMI");
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (unsigned int ispin = 0; ispin < spins.size(); ++ispin)
+        for (int ispin = slab.idx_begin; ispin < slab.idx_end; ++ispin)
         {
             for (unsigned int ineigh = 0; ineigh < dmi_neighbours.size(); ++ineigh)
             {
@@ -215,6 +298,15 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::E_DDI(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy DDI");
+        if (this->ddi_method == DDI_Method::Ewald)
+        {
+            if (!Ewald::Is_Valid(this->ddi_tensors, *geometry, boundary_conditions))
+                this->ddi_tensors = Ewald::Get_DDI_Tensors(*geometry, boundary_conditions);
+            Ewald::Energy_per_Spin(this->ddi_tensors, *geometry, this->mu_s, spins, Energy);
+            return;
+        }
+
         // The translations are in angstr�m, so the |r|[m] becomes |r|[m]*10^-10
         const scalar mult = mu_0 * std::pow(mu_B, 2) / ( 4*Pi * 1e-30 );
 
@@ -265,14 +357,19 @@ namespace Engine
         this->Gradient_DMI(spins, gradient);
         // DD
         this->Gradient_DDI(spins, gradient);
+
+        // Collect the gradient of all ranks
+        Decomposition::Gather(gradient, *geometry);
     }
 
     void Hamiltonian_Heisenberg_Neighbours::Gradient_Zeeman(vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient Zeeman");
         const int N = geometry->n_cell_atoms;
 
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (int icell = 0; icell < geometry->n_cells_total; ++icell)
+        for (int icell = slab.icell_begin; icell < slab.icell_end; ++icell)
         {
             for (int ibasis = 0; ibasis < N; ++ibasis)
             {
@@ -285,10 +382,12 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::Gradient_Anisotropy(const vectorfield & spins, vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient Anisotropy");
         const int N = geometry->n_cell_atoms;
 
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (int icell = 0; icell < geometry->n_cells_total; ++icell)
+        for (int icell = slab.icell_begin; icell < slab.icell_end; ++icell)
         {
             for (int iani = 0; iani < anisotropy_indices.size(); ++iani)
             {
@@ -301,8 +400,10 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::Gradient_Exchange(const vectorfield & spins, vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient Exchange");
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (unsigned int ispin = 0; ispin < spins.size(); ++ispin)
+        for (int ispin = slab.idx_begin; ispin < slab.idx_end; ++ispin)
         {
             for (unsigned int ineigh = 0; ineigh < exchange_neighbours.size(); ++ineigh)
             {
@@ -318,8 +419,10 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::Gradient_DMI(const vectorfield & spins, vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient DMI");
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (unsigned int ispin = 0; ispin < spins.size(); ++ispin)
+        for (int ispin = slab.idx_begin; ispin < slab.idx_end; ++ispin)
         {
             auto translations = Vectormath::translations_from_idx(geometry->n_cells, geometry->n_cell_atoms, ispin);
             for (unsigned int ineigh = 0; ineigh < dmi_neighbours.size(); ++ineigh)
@@ -336,6 +439,15 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::Gradient_DDI(const vectorfield & spins, vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient DDI");
+        if (this->ddi_method == DDI_Method::Ewald)
+        {
+            if (!Ewald::Is_Valid(this->ddi_tensors, *geometry, boundary_conditions))
+                this->ddi_tensors = Ewald::Get_DDI_Tensors(*geometry, boundary_conditions);
+            Ewald::Gradient(this->ddi_tensors, *geometry, this->mu_s, spins, gradient);
+            return;
+        }
+
         // The translations are in angstr�m, so the |r|[m] becomes |r|[m]*10^-10
         const scalar mult = mu_0 * std::pow(mu_B, 2) / ( 4*Pi * 1e-30 );
 
@@ -487,6 +599,18 @@ namespace Engine
         //}
     }
 
+    void Hamiltonian_Heisenberg_Neighbours::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        using Utility::Memory::Bytes;
+        Hamiltonian::Memory_Usage(report);
+        report.Add("mu_s", Bytes(this->mu_s));
+        report.Add("anisotropy", Bytes(this->anisotropy_indices) + Bytes(this->anisotropy_magnitudes) + Bytes(this->anisotropy_normals));
+        report.Add("exchange neighbours", Bytes(this->exchange_neighbours) + Bytes(this->exchange_magnitudes));
+        report.Add("DMI neighbours", Bytes(this->dmi_neighbours) + Bytes(this->dmi_magnitudes) + Bytes(this->dmi_normals));
+        report.Add("DDI neighbours", Bytes(this->ddi_neighbours) + Bytes(this->ddi_magnitudes) + Bytes(this->ddi_normals));
+        report.Add("DDI tensors", Bytes(this->ddi_tensors.tensors));
+    }
+
     // Hamiltonian name as string
     static const std::string name = "Heisenberg (Neighbours)";
     const std::string& Hamiltonian_Heisenberg_Neighbours::Name() { return name; }
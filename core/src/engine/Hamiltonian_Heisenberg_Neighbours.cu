@@ -24,7 +24,7 @@ namespace Engine
         intfield anisotropy_indices, scalarfield anisotropy_magnitudes, vectorfield anisotropy_normals,
         scalarfield exchange_magnitudes,
         scalarfield dmi_magnitudes, int dm_chirality,
-        scalar ddi_radius,
+        scalar ddi_radius, DDI_Method ddi_method,
         std::shared_ptr<Data::Geometry> geometry,
         intfield boundary_conditions
     ) :
@@ -34,8 +34,8 @@ namespace Engine
         external_field_magnitude(external_field_magnitude * Constants::mu_B), external_field_normal(external_field_normal),
         anisotropy_indices(anisotropy_indices), anisotropy_magnitudes(anisotropy_magnitudes), anisotropy_normals(anisotropy_normals),
         exchange_magnitudes(exchange_magnitudes),
-        dmi_magnitudes(dmi_magnitudes),
-        ddi_radius(ddi_radius)
+        dmi_magnitudes(dmi_magnitudes), dm_chirality(dm_chirality),
+        ddi_radius(ddi_radius), ddi_method(ddi_method)
     {
         // Generate Exchange neighbours
         exchange_neighbours = Neighbours::Get_Neighbours_in_Shells(*geometry, exchange_magnitudes.size());
@@ -46,6 +46,7 @@ namespace Engine
         {
             dmi_normals.push_back(Neighbours::DMI_Normal_from_Pair(*geometry, { dmi_neighbours[ineigh].i, dmi_neighbours[ineigh].j, {dmi_neighbours[ineigh].translations[0], dmi_neighbours[ineigh].translations[1], dmi_neighbours[ineigh].translations[2]} }, dm_chirality));
         }
+        this->Update_Shell_Lattice();
 
         // Generate DDI neighbours, magnitudes and normals
         this->ddi_neighbours = Engine::Neighbours::Get_Neighbours_in_Radius(*this->geometry, ddi_radius);
@@ -77,6 +78,74 @@ namespace Engine
     }
 
 
+    void Hamiltonian_Heisenberg_Neighbours::Update_Interactions()
+    {
+        int n_cell_atoms = geometry->n_cell_atoms;
+
+        if (this->mu_s.size() > 0)
+            this->mu_s.resize(n_cell_atoms, this->mu_s[0]);
+
+        // Anisotropies of basis atoms which no longer exist are removed
+        std::vector<bool> keep(anisotropy_indices.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = anisotropy_indices[i] >= 0 && anisotropy_indices[i] < n_cell_atoms;
+        Vectormath::filter(anisotropy_indices, keep);
+        Vectormath::filter(anisotropy_magnitudes, keep);
+        Vectormath::filter(anisotropy_normals, keep);
+
+        // The neighbour shells depend on the basis cell and the Bravais vectors, so they are only
+        //      re-generated when these, or the translations searched on small lattices, changed
+        if (this->Update_Shell_Lattice())
+        {
+            exchange_neighbours = Neighbours::Get_Neighbours_in_Shells(*geometry, exchange_magnitudes.size());
+            dmi_neighbours = Neighbours::Get_Neighbours_in_Shells(*geometry, dmi_magnitudes.size());
+            dmi_normals = vectorfield(0);
+            for (unsigned int ineigh = 0; ineigh < dmi_neighbours.size(); ++ineigh)
+            {
+                dmi_normals.push_back(Neighbours::DMI_Normal_from_Pair(*geometry, { dmi_neighbours[ineigh].i, dmi_neighbours[ineigh].j, {dmi_neighbours[ineigh].translations[0], dmi_neighbours[ineigh].translations[1], dmi_neighbours[ineigh].translations[2]} }, dm_chirality));
+            }
+        }
+
+        // The range of the DDI neighbours is limited by the extent of the lattice, so they are re-generated
+        this->ddi_neighbours = Engine::Neighbours::Get_Neighbours_in_Radius(*this->geometry, this->ddi_radius);
+        this->ddi_magnitudes = scalarfield(0);
+        this->ddi_normals = vectorfield(0);
+        scalar magnitude;
+        Vector3 normal;
+        for (unsigned int i=0; i<ddi_neighbours.size(); ++i)
+        {
+            Engine::Neighbours::DDI_from_Pair(*this->geometry, {ddi_neighbours[i].i, ddi_neighbours[i].j, {ddi_neighbours[i].translations[0], ddi_neighbours[i].translations[1], ddi_neighbours[i].translations[2]}}, magnitude, normal);
+            this->ddi_magnitudes.push_back(magnitude);
+            this->ddi_normals.push_back(normal);
+        }
+
+        // The lattice sums are re-calculated when next needed
+        this->ddi_tensors = Ewald::DDI_Tensors();
+
+        this->Update_Energy_Contributions();
+    }
+
+    bool Hamiltonian_Heisenberg_Neighbours::Update_Shell_Lattice()
+    {
+        auto exchange_translations = Neighbours::Get_Shell_Translations(*geometry, exchange_magnitudes.size());
+        auto dmi_translations = Neighbours::Get_Shell_Translations(*geometry, dmi_magnitudes.size());
+        if ( geometry->bravais_vectors == this->shell_bravais_vectors &&
+             geometry->cell_atoms == this->shell_cell_atoms &&
+             int(exchange_magnitudes.size()) == this->n_exchange_shells &&
+             int(dmi_magnitudes.size()) == this->n_dmi_shells &&
+             exchange_translations == this->exchange_shell_translations &&
+             dmi_translations == this->dmi_shell_translations )
+            return false;
+
+        this->shell_bravais_vectors = geometry->bravais_vectors;
+        this->shell_cell_atoms = geometry->cell_atoms;
+        this->n_exchange_shells = exchange_magnitudes.size();
+        this->n_dmi_shells = dmi_magnitudes.size();
+        this->exchange_shell_translations = exchange_translations;
+        this->dmi_shell_translations = dmi_translations;
+        return true;
+    }
+
     void Hamiltonian_Heisenberg_Neighbours::Update_Energy_Contributions()
     {
         this->energy_contributions_per_spin = std::vector<std::pair<std::string, scalarfield>>(0);
@@ -110,7 +179,7 @@ namespace Engine
         }
         else this->idx_dmi = -1;
         // Dipole-Dipole
-        if (this->ddi_neighbours.size() > 0)
+        if (this->ddi_neighbours.size() > 0 || this->ddi_method == DDI_Method::Ewald)
         {
             this->energy_contributions_per_spin.push_back({"DD", scalarfield(0) });
             this->idx_ddi = this->energy_contributions_per_spin.size()-1;
@@ -251,6 +320,16 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::E_DDI(const vectorfield & spins, scalarfield & Energy)
     {
+        if (this->ddi_method == DDI_Method::Ewald)
+        {
+            if (!Ewald::Is_Valid(this->ddi_tensors, *geometry, boundary_conditions))
+                this->ddi_tensors = Ewald::Get_DDI_Tensors(*geometry, boundary_conditions);
+            // The lattice sums are applied on the host, using the managed memory
+            cudaDeviceSynchronize();
+            Ewald::Energy_per_Spin(this->ddi_tensors, *geometry, this->mu_s, spins, Energy);
+            return;
+        }
+
         // //scalar mult = -mu_B*mu_B*1.0 / 4.0 / Pi; // multiply with mu_B^2
         // scalar mult = 0.5*0.0536814951168; // mu_0*mu_B**2/(4pi*10**-30) -- the translations are in angstr�m, so the |r|[m] becomes |r|[m]*10^-10
         // scalar result = 0.0;
@@ -411,6 +490,16 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Neighbours::Gradient_DDI(const vectorfield & spins, vectorfield & gradient)
     {
+        if (this->ddi_method == DDI_Method::Ewald)
+        {
+            if (!Ewald::Is_Valid(this->ddi_tensors, *geometry, boundary_conditions))
+                this->ddi_tensors = Ewald::Get_DDI_Tensors(*geometry, boundary_conditions);
+            // The lattice sums are applied on the host, using the managed memory
+            cudaDeviceSynchronize();
+            Ewald::Gradient(this->ddi_tensors, *geometry, this->mu_s, spins, gradient);
+            return;
+        }
+
         // //scalar mult = mu_B*mu_B*1.0 / 4.0 / Pi; // multiply with mu_B^2
         // scalar mult = 0.0536814951168; // mu_0*mu_B**2/(4pi*10**-30) -- the translations are in angstr�m, so the |r|[m] becomes |r|[m]*10^-10
         
@@ -560,6 +649,18 @@ namespace Engine
         //}
     }
 
+    void Hamiltonian_Heisenberg_Neighbours::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        using Utility::Memory::Bytes;
+        Hamiltonian::Memory_Usage(report);
+        report.Add("mu_s", Bytes(this->mu_s));
+        report.Add("anisotropy", Bytes(this->anisotropy_indices) + Bytes(this->anisotropy_magnitudes) + Bytes(this->anisotropy_normals));
+        report.Add("exchange neighbours", Bytes(this->exchange_neighbours) + Bytes(this->exchange_magnitudes));
+        report.Add("DMI neighbours", Bytes(this->dmi_neighbours) + Bytes(this->dmi_magnitudes) + Bytes(this->dmi_normals));
+        report.Add("DDI neighbours", Bytes(this->ddi_neighbours) + Bytes(this->ddi_magnitudes) + Bytes(this->ddi_normals));
+        report.Add("DDI tensors", Bytes(this->ddi_tensors.tensors));
+    }
+
     // Hamiltonian name as string
     static const std::string name = "Heisenberg (Neighbours)";
     const std::string& Hamiltonian_Heisenberg_Neighbours::Name() { return name; }
@@ -4,8 +4,10 @@
 #include <engine/Hamiltonian_Heisenberg_Pairs.hpp>
 #include <engine/Vectormath.hpp>
 #include <engine/Neighbours.hpp>
+#include <engine/Decomposition.hpp>
 #include <data/Spin_System.hpp>
 #include <utility/Constants.hpp>
+#include <utility/Profiling.hpp>
 
 #include<iostream>
 
@@ -30,7 +32,7 @@ namespace Engine
         intfield anisotropy_indices, scalarfield anisotropy_magnitudes, vectorfield anisotropy_normals,
         pairfield exchange_pairs, scalarfield exchange_magnitudes,
         pairfield dmi_pairs, scalarfield dmi_magnitudes, vectorfield dmi_normals,
-        scalar ddi_radius,
+        scalar ddi_radius, DDI_Method ddi_method,
         tripletfield triplets, scalarfield triplet_magnitudes1, scalarfield triplet_magnitudes2,
         quadrupletfield quadruplets, scalarfield quadruplet_magnitudes,
         std::shared_ptr<Data::Geometry> geometry,
@@ -42,6 +44,7 @@ namespace Engine
         anisotropy_indices(anisotropy_indices), anisotropy_magnitudes(anisotropy_magnitudes), anisotropy_normals(anisotropy_normals),
         exchange_pairs(exchange_pairs), exchange_magnitudes(exchange_magnitudes),
         dmi_pairs(dmi_pairs), dmi_magnitudes(dmi_magnitudes), dmi_normals(dmi_normals),
+        ddi_radius(ddi_radius), ddi_method(ddi_method),
         triplets(triplets), triplet_magnitudes1(triplet_magnitudes1), triplet_magnitudes2(triplet_magnitudes2),
         quadruplets(quadruplets), quadruplet_magnitudes(quadruplet_magnitudes)
     {
@@ -60,6 +63,70 @@ namespace Engine
     }
 
 
+    void Hamiltonian_Heisenberg_Pairs::Update_Interactions()
+    {
+        // The pair, triplet and quadruplet interactions are defined relative to the basis cell,
+        //      so they stay valid when the number of cells changes. Only interactions of basis
+        //      atoms which no longer exist need to be removed.
+        int n_cell_atoms = geometry->n_cell_atoms;
+        auto in_cell = [n_cell_atoms](int ibasis) { return ibasis < n_cell_atoms; };
+
+        if (this->mu_s.size() > 0)
+            this->mu_s.resize(n_cell_atoms, this->mu_s[0]);
+
+        // The interactions of basis atoms which no longer exist are removed in a single pass
+        std::vector<bool> keep(anisotropy_indices.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(anisotropy_indices[i]);
+        Vectormath::filter(anisotropy_indices, keep);
+        Vectormath::filter(anisotropy_magnitudes, keep);
+        Vectormath::filter(anisotropy_normals, keep);
+
+        keep = std::vector<bool>(exchange_pairs.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(exchange_pairs[i].i) && in_cell(exchange_pairs[i].j);
+        Vectormath::filter(exchange_pairs, keep);
+        Vectormath::filter(exchange_magnitudes, keep);
+
+        keep = std::vector<bool>(dmi_pairs.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(dmi_pairs[i].i) && in_cell(dmi_pairs[i].j);
+        Vectormath::filter(dmi_pairs, keep);
+        Vectormath::filter(dmi_magnitudes, keep);
+        Vectormath::filter(dmi_normals, keep);
+
+        keep = std::vector<bool>(triplets.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(triplets[i].i) && in_cell(triplets[i].j) && in_cell(triplets[i].k);
+        Vectormath::filter(triplets, keep);
+        Vectormath::filter(triplet_magnitudes1, keep);
+        Vectormath::filter(triplet_magnitudes2, keep);
+
+        keep = std::vector<bool>(quadruplets.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(quadruplets[i].i) && in_cell(quadruplets[i].j) && in_cell(quadruplets[i].k) && in_cell(quadruplets[i].l);
+        Vectormath::filter(quadruplets, keep);
+        Vectormath::filter(quadruplet_magnitudes, keep);
+
+        // The range of the DDI pairs is limited by the extent of the lattice, so they are re-generated
+        this->ddi_pairs = Engine::Neighbours::Get_Pairs_in_Radius(*this->geometry, this->ddi_radius);
+        this->ddi_magnitudes = scalarfield(0);
+        this->ddi_normals = vectorfield(0);
+        scalar magnitude;
+        Vector3 normal;
+        for (unsigned int i = 0; i<ddi_pairs.size(); ++i)
+        {
+            Engine::Neighbours::DDI_from_Pair(*this->geometry, { ddi_pairs[i].i, ddi_pairs[i].j, ddi_pairs[i].translations }, magnitude, normal);
+            this->ddi_magnitudes.push_back(magnitude);
+            this->ddi_normals.push_back(normal);
+        }
+
+        // The lattice sums are re-calculated when next needed
+        this->ddi_tensors = Ewald::DDI_Tensors();
+
+        this->Update_Energy_Contributions();
+    }
+
     void Hamiltonian_Heisenberg_Pairs::Update_Energy_Contributions()
     {
         this->energy_contributions_per_spin = std::vector<std::pair<std::string, scalarfield>>(0);
@@ -93,7 +160,7 @@ namespace Engine
         }
         else this->idx_dmi = -1;
         // Dipole-Dipole
-        if (this->ddi_pairs.size() > 0)
+        if (this->ddi_pairs.size() > 0 || this->ddi_method == DDI_Method::Ewald)
         {
             this->energy_contributions_per_spin.push_back({"DD", scalarfield(0) });
             this->idx_ddi = this->energy_contributions_per_spin.size()-1;
@@ -147,14 +214,20 @@ namespace Engine
         if (this->idx_triplet >=0 ) E_Triplet(spins, contributions[idx_triplet].second);
         // Quadruplets
         if (this->idx_quadruplet >=0 ) E_Quadruplet(spins, contributions[idx_quadruplet].second);
+
+        // Collect the contributions of all ranks
+        for (auto& contrib : contributions)
+            Decomposition::Gather(contrib.second, *geometry);
     }
 
     void Hamiltonian_Heisenberg_Pairs::E_Zeeman(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy Zeeman");
         const int N = geometry->n_cell_atoms;
 
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (int icell = 0; icell < geometry->n_cells_total; ++icell)
+        for (int icell = slab.icell_begin; icell < slab.icell_end; ++icell)
         {
             for (int ibasis = 0; ibasis < N; ++ibasis)
             {
@@ -167,10 +240,12 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::E_Anisotropy(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy Anisotropy");
         const int N = geometry->n_cell_atoms;
 
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (int icell = 0; icell < geometry->n_cells_total; ++icell)
+        for (int icell = slab.icell_begin; icell < slab.icell_end; ++icell)
         {
             for (int iani = 0; iani < anisotropy_indices.size(); ++iani)
             {
@@ -183,16 +258,15 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::E_Exchange(const vectorfield & spins, scalarfield & Energy)
     {
-        const int Na = geometry->n_cells[0];
-        const int Nb = geometry->n_cells[1];
-        const int Nc = geometry->n_cells[2];
+        SPIRIT_TIMER("Energy Exchange");
+        auto slab = Decomposition::Get_Slab(*geometry);
 
         #pragma omp parallel for collapse(3)
-        for (int da = 0; da < Na; ++da)
+        for (int da = slab.cell_min[0]; da < slab.cell_max[0]; ++da)
         {
-            for (int db = 0; db < Nb; ++db)
+            for (int db = slab.cell_min[1]; db < slab.cell_max[1]; ++db)
             {
-                for (int dc = 0; dc < Nc; ++dc)
+                for (int dc = slab.cell_min[2]; dc < slab.cell_max[2]; ++dc)
                 {
                     for (unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair)
                     {
@@ -202,7 +276,7 @@ namespace Engine
                         if (jspin >= 0)
                         {
                             Energy[ispin] -= 0.5 * exchange_magnitudes[i_pair] * spins[ispin].dot(spins[jspin]);
-                            #ifndef _OPENMP
+                            #if !defined(_OPENMP) && !defined(SPIRIT_USE_MPI)
                             Energy[jspin] -= 0.5 * exchange_magnitudes[i_pair] * spins[ispin].dot(spins[jspin]);
                             #endif
                         }
@@ -210,7 +284,8 @@ namespace Engine
                         // To parallelize with OpenMP we avoid atomics by not adding to two different spins in one thread.
                         //		instead, we need to also add the inverse pair to each spin, which makes it similar to the
                         //		neighbours implementation (in terms of the number of pairs)
-                        #ifdef _OPENMP
+                        //		The same is needed with MPI, where each rank only updates the spins it owns
+                        #if defined(_OPENMP) || defined(SPIRIT_USE_MPI)
                         int jspin2 = idx_from_pair(ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types, exchange_pairs[i_pair], true);
                         if (jspin2 >= 0)
                         {
@@ -225,16 +300,15 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::E_DMI(const vectorfield & spins, scalarfield & Energy)
     {
-        const int Na = geometry->n_cells[0];
-        const int Nb = geometry->n_cells[1];
-        const int Nc = geometry->n_cells[2];
+        SPIRIT_TIMER("Energy DMI");
+        auto slab = Decomposition::Get_Slab(*geometry);
 
         #pragma omp parallel for collapse(3)
-        for (int da = 0; da < Na; ++da)
+        for (int da = slab.cell_min[0]; da < slab.cell_max[0]; ++da)
         {
-            for (int db = 0; db < Nb; ++db)
+            for (int db = slab.cell_min[1]; db < slab.cell_max[1]; ++db)
             {
-                for (int dc = 0; dc < Nc; ++dc)
+                for (int dc = slab.cell_min[2]; dc < slab.cell_max[2]; ++dc)
                 {
                     for (unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair)
                     {
@@ -244,7 +318,7 @@ namespace Engine
                         if (jspin >= 0)
                         {
                             Energy[ispin] -= 0.5 * dmi_magnitudes[i_pair] * dmi_normals[i_pair].dot(spins[ispin].cross(spins[jspin]));
-                            #ifndef _OPENMP
+                            #if !defined(_OPENMP) && !defined(SPIRIT_USE_MPI)
                             Energy[jspin] -= 0.5 * dmi_magnitudes[i_pair] * dmi_normals[i_pair].dot(spins[ispin].cross(spins[jspin]));
                             #endif
                         }
@@ -252,7 +326,8 @@ namespace Engine
                         // To parallelize with OpenMP we avoid atomics by not adding to two different spins in one thread.
                         //		instead, we need to also add the inverse pair to each spin, which makes it similar to the
                         //		neighbours implementation (in terms of the number of pairs)
-                        #ifdef _OPENMP
+                        //		The same is needed with MPI, where each rank only updates the spins it owns
+                        #if defined(_OPENMP) || defined(SPIRIT_USE_MPI)
                         int jspin2 = idx_from_pair(ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types, dmi_pairs[i_pair], true);
                         if (jspin2 >= 0)
                         {
@@ -267,6 +342,15 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::E_DDI(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy DDI");
+        if (this->ddi_method == DDI_Method::Ewald)
+        {
+            if (!Ewald::Is_Valid(this->ddi_tensors, *geometry, boundary_conditions))
+                this->ddi_tensors = Ewald::Get_DDI_Tensors(*geometry, boundary_conditions);
+            Ewald::Energy_per_Spin(this->ddi_tensors, *geometry, this->mu_s, spins, Energy);
+            return;
+        }
+
         // The translations are in angstr�m, so the |r|[m] becomes |r|[m]*10^-10
         const scalar mult = mu_0 * std::pow(mu_B, 2) / ( 4*Pi * 1e-30 );
 
@@ -303,6 +387,7 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::E_Triplet(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy Triplet");
         for (unsigned int itrip = 0; itrip < triplets.size(); ++itrip)
         {
             for (int da = 0; da < geometry->n_cells[0]; ++da)
@@ -341,6 +426,7 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::E_Quadruplet(const vectorfield & spins, scalarfield & Energy)
     {
+        SPIRIT_TIMER("Energy Quadruplet");
         for (unsigned int iquad = 0; iquad < quadruplets.size(); ++iquad)
         {
             for (int da = 0; da < geometry->n_cells[0]; ++da)
@@ -394,14 +480,19 @@ namespace Engine
 
         // Quadruplets
         this->Gradient_Quadruplet(spins, gradient);
+
+        // Collect the gradient of all ranks
+        Decomposition::Gather(gradient, *geometry);
     }
 
     void Hamiltonian_Heisenberg_Pairs::Gradient_Zeeman(vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient Zeeman");
         const int N = geometry->n_cell_atoms;
 
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (int icell = 0; icell < geometry->n_cells_total; ++icell)
+        for (int icell = slab.icell_begin; icell < slab.icell_end; ++icell)
         {
             for (int ibasis = 0; ibasis < N; ++ibasis)
             {
@@ -414,10 +505,12 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::Gradient_Anisotropy(const vectorfield & spins, vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient Anisotropy");
         const int N = geometry->n_cell_atoms;
 
+        auto slab = Decomposition::Get_Slab(*geometry);
         #pragma omp parallel for
-        for (int icell = 0; icell < geometry->n_cells_total; ++icell)
+        for (int icell = slab.icell_begin; icell < slab.icell_end; ++icell)
         {
             for (int iani = 0; iani < anisotropy_indices.size(); ++iani)
             {
@@ -430,16 +523,15 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::Gradient_Exchange(const vectorfield & spins, vectorfield & gradient)
     {
-        const int Na = geometry->n_cells[0];
-        const int Nb = geometry->n_cells[1];
-        const int Nc = geometry->n_cells[2];
+        SPIRIT_TIMER("Gradient Exchange");
+        auto slab = Decomposition::Get_Slab(*geometry);
 
         #pragma omp parallel for collapse(3)
-        for (int da = 0; da < Na; ++da)
+        for (int da = slab.cell_min[0]; da < slab.cell_max[0]; ++da)
         {
-            for (int db = 0; db < Nb; ++db)
+            for (int db = slab.cell_min[1]; db < slab.cell_max[1]; ++db)
             {
-                for (int dc = 0; dc < Nc; ++dc)
+                for (int dc = slab.cell_min[2]; dc < slab.cell_max[2]; ++dc)
                 {
                     std::array<int, 3> translations = { da, db, dc };
                     for (unsigned int i_pair = 0; i_pair < exchange_pairs.size(); ++i_pair)
@@ -449,7 +541,7 @@ namespace Engine
                         if (jspin >= 0)
                         {
                             gradient[ispin] -= exchange_magnitudes[i_pair] * spins[jspin];
-                            #ifndef _OPENMP
+                            #if !defined(_OPENMP) && !defined(SPIRIT_USE_MPI)
                             gradient[jspin] -= exchange_magnitudes[i_pair] * spins[ispin];
                             #endif
                         }
@@ -457,7 +549,8 @@ namespace Engine
                         // To parallelize with OpenMP we avoid atomics by not adding to two different spins in one thread.
                         //		instead, we need to also add the inverse pair to each spin, which makes it similar to the
                         //		neighbours implementation (in terms of the number of pairs)
-                        #ifdef _OPENMP
+                        //		The same is needed with MPI, where each rank only updates the spins it owns
+                        #if defined(_OPENMP) || defined(SPIRIT_USE_MPI)
                         int jspin2 = idx_from_pair(ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types, exchange_pairs[i_pair], true);
                         if (jspin2 >= 0)
                         {
@@ -472,16 +565,15 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::Gradient_DMI(const vectorfield & spins, vectorfield & gradient)
     {
-        const int Na = geometry->n_cells[0];
-        const int Nb = geometry->n_cells[1];
-        const int Nc = geometry->n_cells[2];
+        SPIRIT_TIMER("Gradient DMI");
+        auto slab = Decomposition::Get_Slab(*geometry);
 
         #pragma omp parallel for collapse(3)
-        for (int da = 0; da < Na; ++da)
+        for (int da = slab.cell_min[0]; da < slab.cell_max[0]; ++da)
         {
-            for (int db = 0; db < Nb; ++db)
+            for (int db = slab.cell_min[1]; db < slab.cell_max[1]; ++db)
             {
-                for (int dc = 0; dc < Nc; ++dc)
+                for (int dc = slab.cell_min[2]; dc < slab.cell_max[2]; ++dc)
                 {
                     std::array<int, 3 > translations = { da, db, dc };
                     for (unsigned int i_pair = 0; i_pair < dmi_pairs.size(); ++i_pair)
@@ -491,7 +583,7 @@ namespace Engine
                         if (jspin >= 0)
                         {
                             gradient[ispin] -= dmi_magnitudes[i_pair] * spins[jspin].cross(dmi_normals[i_pair]);
-                            #ifndef _OPENMP
+                            #if !defined(_OPENMP) && !defined(SPIRIT_USE_MPI)
                             gradient[jspin] += dmi_magnitudes[i_pair] * spins[ispin].cross(dmi_normals[i_pair]);
                             #endif
                         }
@@ -499,7 +591,8 @@ namespace Engine
                         // To parallelize with OpenMP we avoid atomics by not adding to two different spins in one thread.
                         //		instead, we need to also add the inverse pair to each spin, which makes it similar to the
                         //		neighbours implementation (in terms of the number of pairs)
-                        #ifdef _OPENMP
+                        //		The same is needed with MPI, where each rank only updates the spins it owns
+                        #if defined(_OPENMP) || defined(SPIRIT_USE_MPI)
                         int jspin2 = idx_from_pair(ispin, boundary_conditions, geometry->n_cells, geometry->n_cell_atoms, geometry->atom_types, dmi_pairs[i_pair], true);
                         if (jspin2 >= 0)
                         {
@@ -514,6 +607,15 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::Gradient_DDI(const vectorfield & spins, vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient DDI");
+        if (this->ddi_method == DDI_Method::Ewald)
+        {
+            if (!Ewald::Is_Valid(this->ddi_tensors, *geometry, boundary_conditions))
+                this->ddi_tensors = Ewald::Get_DDI_Tensors(*geometry, boundary_conditions);
+            Ewald::Gradient(this->ddi_tensors, *geometry, this->mu_s, spins, gradient);
+            return;
+        }
+
         // The translations are in angstr�m, so the |r|[m] becomes |r|[m]*10^-10
         const scalar mult = mu_0 * std::pow(mu_B, 2) / ( 4*Pi * 1e-30 );
         
@@ -548,6 +650,7 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::Gradient_Triplet(const vectorfield & spins, vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient Triplet");
        for (unsigned int itrip = 0; itrip < triplets.size(); ++itrip)
         {
             int i = triplets[itrip].i;
@@ -593,6 +696,7 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::Gradient_Quadruplet(const vectorfield & spins, vectorfield & gradient)
     {
+        SPIRIT_TIMER("Gradient Quadruplet");
         for (unsigned int iquad = 0; iquad < quadruplets.size(); ++iquad)
         {
             int i = quadruplets[iquad].i;
@@ -767,6 +871,20 @@ namespace Engine
         // Quadruplets
     }
 
+    void Hamiltonian_Heisenberg_Pairs::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        using Utility::Memory::Bytes;
+        Hamiltonian::Memory_Usage(report);
+        report.Add("mu_s", Bytes(this->mu_s));
+        report.Add("anisotropy", Bytes(this->anisotropy_indices) + Bytes(this->anisotropy_magnitudes) + Bytes(this->anisotropy_normals));
+        report.Add("exchange pairs", Bytes(this->exchange_pairs) + Bytes(this->exchange_magnitudes));
+        report.Add("DMI pairs", Bytes(this->dmi_pairs) + Bytes(this->dmi_magnitudes) + Bytes(this->dmi_normals));
+        report.Add("DDI pairs", Bytes(this->ddi_pairs) + Bytes(this->ddi_magnitudes) + Bytes(this->ddi_normals));
+        report.Add("DDI tensors", Bytes(this->ddi_tensors.tensors));
+        report.Add("triplets", Bytes(this->triplets) + Bytes(this->triplet_magnitudes1) + Bytes(this->triplet_magnitudes2));
+        report.Add("quadruplets", Bytes(this->quadruplets) + Bytes(this->quadruplet_magnitudes));
+    }
+
     // Hamiltonian name as string
     static const std::string name = "Heisenberg (Pairs)";
     const std::string& Hamiltonian_Heisenberg_Pairs::Name() { return name; }
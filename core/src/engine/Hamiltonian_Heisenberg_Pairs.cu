@@ -27,7 +27,7 @@ namespace Engine
         intfield anisotropy_indices, scalarfield anisotropy_magnitudes, vectorfield anisotropy_normals,
         pairfield exchange_pairs, scalarfield exchange_magnitudes,
         pairfield dmi_pairs, scalarfield dmi_magnitudes, vectorfield dmi_normals,
-        scalar ddi_radius,
+        scalar ddi_radius, DDI_Method ddi_method,
         quadrupletfield quadruplets, scalarfield quadruplet_magnitudes,
         std::shared_ptr<Data::Geometry> geometry,
         intfield boundary_conditions
@@ -38,6 +38,7 @@ namespace Engine
         anisotropy_indices(anisotropy_indices), anisotropy_magnitudes(anisotropy_magnitudes), anisotropy_normals(anisotropy_normals),
         exchange_pairs(exchange_pairs), exchange_magnitudes(exchange_magnitudes),
         dmi_pairs(dmi_pairs), dmi_magnitudes(dmi_magnitudes), dmi_normals(dmi_normals),
+        ddi_radius(ddi_radius), ddi_method(ddi_method),
         quadruplets(quadruplets), quadruplet_magnitudes(quadruplet_magnitudes)
     {
         // Generate DDI pairs, magnitudes, normals
@@ -54,6 +55,70 @@ namespace Engine
         this->Update_Energy_Contributions();
     }
 
+    void Hamiltonian_Heisenberg_Pairs::Update_Interactions()
+    {
+        // The pair, triplet and quadruplet interactions are defined relative to the basis cell,
+        //      so they stay valid when the number of cells changes. Only interactions of basis
+        //      atoms which no longer exist need to be removed.
+        int n_cell_atoms = geometry->n_cell_atoms;
+        auto in_cell = [n_cell_atoms](int ibasis) { return ibasis < n_cell_atoms; };
+
+        if (this->mu_s.size() > 0)
+            this->mu_s.resize(n_cell_atoms, this->mu_s[0]);
+
+        // The interactions of basis atoms which no longer exist are removed in a single pass
+        std::vector<bool> keep(anisotropy_indices.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(anisotropy_indices[i]);
+        Vectormath::filter(anisotropy_indices, keep);
+        Vectormath::filter(anisotropy_magnitudes, keep);
+        Vectormath::filter(anisotropy_normals, keep);
+
+        keep = std::vector<bool>(exchange_pairs.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(exchange_pairs[i].i) && in_cell(exchange_pairs[i].j);
+        Vectormath::filter(exchange_pairs, keep);
+        Vectormath::filter(exchange_magnitudes, keep);
+
+        keep = std::vector<bool>(dmi_pairs.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(dmi_pairs[i].i) && in_cell(dmi_pairs[i].j);
+        Vectormath::filter(dmi_pairs, keep);
+        Vectormath::filter(dmi_magnitudes, keep);
+        Vectormath::filter(dmi_normals, keep);
+
+        keep = std::vector<bool>(triplets.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(triplets[i].i) && in_cell(triplets[i].j) && in_cell(triplets[i].k);
+        Vectormath::filter(triplets, keep);
+        Vectormath::filter(triplet_magnitudes1, keep);
+        Vectormath::filter(triplet_magnitudes2, keep);
+
+        keep = std::vector<bool>(quadruplets.size());
+        for (std::size_t i = 0; i < keep.size(); ++i)
+            keep[i] = in_cell(quadruplets[i].i) && in_cell(quadruplets[i].j) && in_cell(quadruplets[i].k) && in_cell(quadruplets[i].l);
+        Vectormath::filter(quadruplets, keep);
+        Vectormath::filter(quadruplet_magnitudes, keep);
+
+        // The range of the DDI pairs is limited by the extent of the lattice, so they are re-generated
+        this->ddi_pairs = Engine::Neighbours::Get_Pairs_in_Radius(*this->geometry, this->ddi_radius);
+        this->ddi_magnitudes = scalarfield(0);
+        this->ddi_normals = vectorfield(0);
+        scalar magnitude;
+        Vector3 normal;
+        for (unsigned int i = 0; i<ddi_pairs.size(); ++i)
+        {
+            Engine::Neighbours::DDI_from_Pair(*this->geometry, { ddi_pairs[i].i, ddi_pairs[i].j, {ddi_pairs[i].translations[0], ddi_pairs[i].translations[1], ddi_pairs[i].translations[2]} }, magnitude, normal);
+            this->ddi_magnitudes.push_back(magnitude);
+            this->ddi_normals.push_back(normal);
+        }
+
+        // The lattice sums are re-calculated when next needed
+        this->ddi_tensors = Ewald::DDI_Tensors();
+
+        this->Update_Energy_Contributions();
+    }
+
     void Hamiltonian_Heisenberg_Pairs::Update_Energy_Contributions()
     {
         this->energy_contributions_per_spin = std::vector<std::pair<std::string, scalarfield>>(0);
@@ -87,7 +152,7 @@ namespace Engine
         }
         else this->idx_dmi = -1;
         // Dipole-Dipole
-        if (this->ddi_pairs.size() > 0)
+        if (this->ddi_pairs.size() > 0 || this->ddi_method == DDI_Method::Ewald)
         {
             this->energy_contributions_per_spin.push_back({"DD", scalarfield(0) });
             this->idx_ddi = this->energy_contributions_per_spin.size()-1;
@@ -247,6 +312,16 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::E_DDI(const vectorfield & spins, scalarfield & Energy)
     {
+        if (this->ddi_method == DDI_Method::Ewald)
+        {
+            if (!Ewald::Is_Valid(this->ddi_tensors, *geometry, boundary_conditions))
+                this->ddi_tensors = Ewald::Get_DDI_Tensors(*geometry, boundary_conditions);
+            // The lattice sums are applied on the host, using the managed memory
+            cudaDeviceSynchronize();
+            Ewald::Energy_per_Spin(this->ddi_tensors, *geometry, this->mu_s, spins, Energy);
+            return;
+        }
+
         // //scalar mult = -mu_B*mu_B*1.0 / 4.0 / Pi; // multiply with mu_B^2
         // scalar mult = 0.5*0.0536814951168; // mu_0*mu_B**2/(4pi*10**-30) -- the translations are in angstr�m, so the |r|[m] becomes |r|[m]*10^-10
         // // scalar result = 0.0;
@@ -451,6 +526,16 @@ namespace Engine
 
     void Hamiltonian_Heisenberg_Pairs::Gradient_DDI(const vectorfield & spins, vectorfield & gradient)
     {
+        if (this->ddi_method == DDI_Method::Ewald)
+        {
+            if (!Ewald::Is_Valid(this->ddi_tensors, *geometry, boundary_conditions))
+                this->ddi_tensors = Ewald::Get_DDI_Tensors(*geometry, boundary_conditions);
+            // The lattice sums are applied on the host, using the managed memory
+            cudaDeviceSynchronize();
+            Ewald::Gradient(this->ddi_tensors, *geometry, this->mu_s, spins, gradient);
+            return;
+        }
+
         // //scalar mult = mu_B*mu_B*1.0 / 4.0 / Pi; // multiply with mu_B^2
         // scalar mult = 0.0536814951168; // mu_0*mu_B**2/(4pi*10**-30) -- the translations are in angstr�m, so the |r|[m] becomes |r|[m]*10^-10
         
@@ -652,6 +737,20 @@ namespace Engine
         // Quadruplets
     }
 
+    void Hamiltonian_Heisenberg_Pairs::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        using Utility::Memory::Bytes;
+        Hamiltonian::Memory_Usage(report);
+        report.Add("mu_s", Bytes(this->mu_s));
+        report.Add("anisotropy", Bytes(this->anisotropy_indices) + Bytes(this->anisotropy_magnitudes) + Bytes(this->anisotropy_normals));
+        report.Add("exchange pairs", Bytes(this->exchange_pairs) + Bytes(this->exchange_magnitudes));
+        report.Add("DMI pairs", Bytes(this->dmi_pairs) + Bytes(this->dmi_magnitudes) + Bytes(this->dmi_normals));
+        report.Add("DDI pairs", Bytes(this->ddi_pairs) + Bytes(this->ddi_magnitudes) + Bytes(this->ddi_normals));
+        report.Add("DDI tensors", Bytes(this->ddi_tensors.tensors));
+        report.Add("triplets", Bytes(this->triplets) + Bytes(this->triplet_magnitudes1) + Bytes(this->triplet_magnitudes2));
+        report.Add("quadruplets", Bytes(this->quadruplets) + Bytes(this->quadruplet_magnitudes));
+    }
+
     // Hamiltonian name as string
     static const std::string name = "Heisenberg (Pairs)";
     const std::string& Hamiltonian_Heisenberg_Pairs::Name() { return name; }
@@ -1,6 +1,8 @@
 #include <engine/Method.hpp>
 #include <engine/Vectormath.hpp>
 #include <engine/Manifoldmath.hpp>
+#include <engine/Decomposition.hpp>
+#include <io/Output_Queue.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Timing.hpp>
 #include <utility/Exception.hpp>
@@ -14,7 +16,8 @@ using namespace Utility;
 namespace Engine
 {
     Method::Method(std::shared_ptr<Data::Parameters_Method> parameters, int idx_img, int idx_chain) :
-        parameters(parameters), idx_image(idx_img), idx_chain(idx_chain), iteration(0), step(0)
+        parameters(parameters), idx_image(idx_img), idx_chain(idx_chain), iteration(0), iteration_published(0), step(0),
+        walltime_expired(false), cancelled(false)
     {
         // Sender name for log messages
         this->SenderName = Log_Sender::All;
@@ -54,17 +57,49 @@ namespace Engine
         auto t_current = system_clock::now();
         this->t_last = system_clock::now();
 
+        //---- Timed scopes of this thread add to the timings of the Method
+        #ifdef SPIRIT_ENABLE_TIMINGS
+        Profiling::Collector collector(this->timings);
+        #endif
+
+        //---- The asynchronous output of this Method, which is waited for at the end
+        IO::Output_Queue::Group output;
+
         //---- Log messages
         this->Message_Start();
 
+        //---- All ranks start from the configurations of rank 0
+        for (auto& system : this->systems)
+            Decomposition::Broadcast(*system->spins);
+
+        //---- Readers get snapshots from now on
+        this->Lock();
+        for (auto& system : this->systems)
+        {
+            system->snapshots.Publish(*system, this->iteration);
+            system->snapshots.live = true;
+        }
+        this->Unlock();
+
         //---- Initial save
-        this->Save_Current(this->starttime, this->iteration, true, false);
+        {
+            SPIRIT_TIMER("Save");
+            this->Save_Current(this->starttime, this->iteration, true, false);
+        }
+
+        //---- Check the stopping criteria (all ranks stop together)
+        auto continue_iterating = [&]()
+        {
+            SPIRIT_TIMER("Convergence check");
+            return !Decomposition::Any( !this->ContinueIterating() ||
+                                        this->Walltime_Expired(t_current - t_start) );
+        };
 
         //---- Iteration loop
-        for ( this->iteration = 0; 
-              this->ContinueIterating() &&
-              !this->Walltime_Expired(t_current - t_start); 
-              ++this->iteration )
+        //     The iteration counter starts at zero or where a restored checkpoint left off. It is
+        //     incremented while the systems are locked, so that a checkpoint written from another
+        //     thread matches the configurations.
+        while ( continue_iterating() )
         {
             t_current = system_clock::now();
 
@@ -74,14 +109,28 @@ namespace Engine
             // Pre-iteration hook
             this->Hook_Pre_Iteration();
             // Do one single Iteration
-            this->Iteration();
+            //      The force calculations inside are timed separately, the rest is the update
+            {
+                SPIRIT_TIMER("Update");
+                this->Iteration();
+            }
             // Post-iteration hook
-            this->Hook_Post_Iteration();
+            {
+                SPIRIT_TIMER("Convergence check");
+                this->Hook_Post_Iteration();
+            }
 
             // Recalculate FPS
             this->t_iterations.pop_front();
             this->t_iterations.push_back(system_clock::now());
 
+            // Publish snapshots every n_iterations_snapshot steps
+            if (this->parameters->n_iterations_snapshot > 0 && 0 == (this->iteration + 1) % this->parameters->n_iterations_snapshot)
+            {
+                for (auto& system : this->systems)
+                    system->snapshots.Publish(*system, this->iteration + 1);
+            }
+
             // Log Output every n_iterations_log steps
             bool log = false;
             if (this->n_iterations_log > 0)
@@ -90,20 +139,74 @@ namespace Engine
             {
                 ++step;
                 this->Message_Step();
+                SPIRIT_TIMER("Save");
                 this->Save_Current(this->starttime, this->iteration, false, false);
             }
 
+            this->iteration_published = ++this->iteration;
+
             // Unlock systems
             this->Unlock();
         }
 
+        //---- Remember if the walltime ran out, so that the state can be checkpointed
+        this->walltime_expired = Decomposition::Any( this->Walltime_Expired(t_current - t_start) );
+
+        //---- Final save
+        {
+            SPIRIT_TIMER("Save");
+            this->Save_Current(this->starttime, this->iteration, false, true);
+        }
+
         //---- Log messages
         this->Message_End();
 
-        //---- Final save
-        this->Save_Current(this->starttime, this->iteration, false, true);
         //---- Finalize (set iterations_allowed to false etc.)
         this->Finalize();
+        //---- Final snapshots, after which readers get the systems' current data
+        this->Lock();
+        for (auto& system : this->systems)
+        {
+            system->snapshots.Publish(*system, this->iteration);
+            system->snapshots.live = false;
+        }
+        this->Unlock();
+        //---- Wait for the asynchronous output to be written
+        output.Drain();
+    }
+
+
+    void Method::Cancel()
+    {
+        this->cancelled = true;
+    }
+
+    bool Method::getWalltimeExpired()
+    {
+        return this->walltime_expired;
+    }
+
+    std::string Method::getCheckpointFile()
+    {
+        std::string fileTag;
+        if (this->parameters->output_file_tag == "<time>")
+            fileTag = this->starttime + "_";
+        else if (this->parameters->output_file_tag != "")
+            fileTag = this->parameters->output_file_tag + "_";
+        return this->parameters->output_folder + "/" + fileTag + "Checkpoint.bin";
+    }
+
+    void Method::Checkpoint_Write(IO::Binary_Writer & writer)
+    {
+        writer.Write(this->iteration);
+        writer.Write(this->step);
+    }
+
+    void Method::Checkpoint_Read(IO::Binary_Reader & reader)
+    {
+        reader.Read(this->iteration);
+        reader.Read(this->step);
+        this->iteration_published = this->iteration;
     }
 
 
@@ -121,7 +224,44 @@ namespace Engine
 
     int Method::getNIterations()
     {
-        return this->iteration;
+        return this->iteration_published;
+    }
+
+
+    std::vector<Profiling::Timer_Entry> Method::getTimings()
+    {
+        return this->timings.Entries();
+    }
+
+
+    void Method::Memory_Usage(Memory::Report & report) const
+    {
+        using Memory::Bytes;
+        report.Add("forces", Bytes(this->forces) + Bytes(this->forces_predictor));
+        report.Add("virtual forces", Bytes(this->forces_virtual) + Bytes(this->forces_virtual_predictor));
+        // The configurations are the spins of the systems, only the other ones belong to the Method
+        std::size_t bytes = Bytes(this->configurations) + Bytes(this->configurations_predictor) + Bytes(this->configurations_temp);
+        for (auto & configuration : this->configurations_predictor)
+            if (configuration) bytes += Bytes(*configuration);
+        for (auto & configuration : this->configurations_temp)
+            if (configuration) bytes += Bytes(*configuration);
+        report.Add("configurations", bytes);
+        report.Add("temporaries", Bytes(this->xi) + Bytes(this->temp1) + Bytes(this->temp2));
+        bytes = 0;
+        for (auto & entry : this->history)
+            bytes += Bytes(entry.second);
+        report.Add("history", bytes);
+    }
+
+    std::vector<std::string> Method::Memory_Summary() const
+    {
+        Memory::Report report("Memory");
+        this->Memory_Usage(report.Child("Workspace"));
+        // The systems are summed up by their parts
+        auto & systems = report.Child(fmt::format("Systems ({})", this->systems.size()));
+        for (auto & system : this->systems)
+            system->Memory_Usage(systems);
+        return report.Lines(2);
     }
 
 
@@ -167,6 +307,7 @@ namespace Engine
     {
         return  this->iteration < this->n_iterations &&
                 this->Iterations_Allowed() &&
+               !this->cancelled &&
                !this->StopFile_Present();
     }
 
@@ -197,6 +338,16 @@ namespace Engine
             "Tried to use Method::Save_Current() of the Method base class!");
     }
 
+    std::shared_ptr<const IO::Output_Selection> Method::Get_Output_Selection(int idx_system, std::shared_ptr<const Data::Geometry> geometry)
+    {
+        if (idx_system >= (int)this->output_selections.size())
+            this->output_selections.resize(idx_system + 1);
+        auto & selection = this->output_selections[idx_system];
+        if (!selection || !selection->Matches(*geometry, this->parameters->output_filter))
+            selection = std::make_shared<IO::Output_Selection>(geometry, this->parameters->output_filter);
+        return selection;
+    }
+
     void Method::Hook_Pre_Iteration()
     {
         // Not Implemented!
@@ -26,6 +26,11 @@ namespace Engine
 		this->noi = chain->noi;
 		this->nos = chain->images[0]->nos;
 
+		// Check that the forces, tangents and the buffers of the Solver fit into memory
+		Utility::Memory::Require("GNEB workspace",
+			(std::size_t(this->noi) * 5 + 1) * this->nos * sizeof(Vector3)
+			+ Method_Solver<solver>::Workspace_Bytes(this->noi, this->nos));
+
 		this->energies = std::vector<scalar>(this->noi, 0);
 		this->Rx = std::vector<scalar>(this->noi, 0);
 
@@ -70,6 +75,7 @@ namespace Engine
 	template <Solver solver>
 	void Method_GNEB<solver>::Calculate_Force(const std::vector<std::shared_ptr<vectorfield>> & configurations, std::vector<vectorfield> & forces)
 	{
+		SPIRIT_TIMER("Force");
 		int nos = configurations[0]->size();
 
 		// We assume here that we receive a vector of configurations that corresponds to the vector of systems we gave the Solver.
@@ -168,6 +174,7 @@ namespace Engine
 	void Method_GNEB<solver>::Calculate_Force_Virtual(const std::vector<std::shared_ptr<vectorfield>> & configurations, const std::vector<vectorfield> & forces, std::vector<vectorfield> & forces_virtual)
     {
 		using namespace Utility;
+		SPIRIT_TIMER("Virtual force");
 
 		// Calculate the cross product with the spin configuration to get direct minimization
 		for (unsigned int i = 1; i < configurations.size()-1; ++i)
@@ -294,13 +301,27 @@ namespace Engine
                                         ( std::string suffix, bool append )
 			{
 				// File name
-				std::string chainFile = preChainFile + suffix + ".txt";
+				auto format = IO::VF_FileFormat( this->parameters->output_configuration_filetype );
+				std::string chainFile = preChainFile + suffix + IO::Fileformat_Extension( format );
 
 				// Chain
                 std::string output_comment = fmt::format( "Iteration: {}", iteration );
-                IO::Write_Chain_Spin_Configuration( this->chain, chainFile, 
-                                                    IO::VF_FileFormat::SPIRIT_WHITESPACE_SPIN, 
-                                                    output_comment, append );
+                // Snapshot of the selected spins of the chain, written asynchronously
+                std::vector<std::shared_ptr<vectorfield>> images( this->chain->noi );
+                std::vector<std::shared_ptr<const Data::Geometry>> geometries( this->chain->noi );
+                std::size_t n_bytes = 0;
+                for( int img = 0; img < this->chain->noi; ++img )
+                {
+                    auto selection  = this->Get_Output_Selection( img, this->chain->images[img]->geometry );
+                    images[img]     = selection->Gather( *this->chain->images[img]->spins );
+                    geometries[img] = selection->geometry();
+                    n_bytes += 2 * images[img]->size() * sizeof(Vector3);
+                }
+                IO::Output_Queue::Enqueue( chainFile, [images, geometries, chainFile, format, output_comment, append]()
+                {
+                    IO::Write_Chain_Spin_Configuration( images, geometries, chainFile, format, 
+                                                        output_comment, append );
+                }, n_bytes );
             };
 
 			auto writeOutputEnergies = [this, preChainFile, preEnergiesFile, iteration](std::string suffix)
@@ -372,6 +393,16 @@ namespace Engine
 	template <Solver solver>
     std::string Method_GNEB<solver>::Name() { return "GNEB"; }
 
+    template <Solver solver>
+    void Method_GNEB<solver>::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        using Utility::Memory::Bytes;
+        Method_Solver<solver>::Memory_Usage(report);
+        report.Add("energies", Bytes(this->energies) + Bytes(this->Rx));
+        report.Add("forces", Bytes(this->F_total) + Bytes(this->F_gradient) + Bytes(this->F_spring));
+        report.Add("tangents", Bytes(this->tangents));
+    }
+
 	// Template instantiations
 	template class Method_GNEB<Solver::SIB>;
 	template class Method_GNEB<Solver::Heun>;
@@ -4,6 +4,7 @@
 #include <data/Spin_System.hpp>
 #include <data/Spin_System_Chain.hpp>
 #include <io/IO.hpp>
+#include <io/Trajectory.hpp>
 #include <utility/Logging.hpp>
 
 #include <iostream>
@@ -56,8 +57,12 @@ namespace Engine
         this->Initialize();
 
         // Initial force calculation s.t. it does not seem to be already converged
+        //      The PRNG is reset afterwards, so that starting a method does not consume random
+        //      numbers and a run restored from a checkpoint continues with the same thermal noise
+        auto prng = system->llg_parameters->prng;
         this->Calculate_Force(this->configurations, this->forces);
         this->Calculate_Force_Virtual(this->configurations, this->forces, this->forces_virtual);
+        system->llg_parameters->prng = prng;
         // Post iteration hook to get forceMaxAbsComponent etc
         this->Hook_Post_Iteration();
     }
@@ -66,6 +71,7 @@ namespace Engine
     template <Solver solver>
     void Method_LLG<solver>::Calculate_Force(const std::vector<std::shared_ptr<vectorfield>> & configurations, std::vector<vectorfield> & forces)
     {
+        SPIRIT_TIMER("Force");
         // Loop over images to calculate the total force on each Image
         for (unsigned int img = 0; img < this->systems.size(); ++img)
         {
@@ -84,6 +90,7 @@ namespace Engine
     void Method_LLG<solver>::Calculate_Force_Virtual(const std::vector<std::shared_ptr<vectorfield>> & configurations, const std::vector<vectorfield> & forces, std::vector<vectorfield> & forces_virtual)
     {
         using namespace Utility;
+        SPIRIT_TIMER("Virtual force");
 
         for (unsigned int i=0; i<configurations.size(); ++i)
         {
@@ -289,13 +296,17 @@ namespace Engine
             auto writeOutputConfiguration = [this, preSpinsFile, preEnergyFile, iteration](std::string suffix, bool append)
             {
                 // File name and comment
-                std::string spinsFile = preSpinsFile + suffix + ".txt";
+                auto format = IO::VF_FileFormat( this->parameters->output_configuration_filetype );
+                std::string spinsFile = preSpinsFile + suffix + IO::Fileformat_Extension( format );
                 std::string comment = std::to_string( iteration );
-                // Spin Configuration
-                IO::Write_Spin_Configuration( *( this->systems[0] )->spins, 
-                                              *( this->systems[0] )->geometry, spinsFile, 
-                                              IO::VF_FileFormat::SPIRIT_WHITESPACE_SPIN, 
-                                              comment, append );
+                // Spin Configuration, written asynchronously from a snapshot of the selected spins
+                auto selection = this->Get_Output_Selection( 0, this->systems[0]->geometry );
+                auto spins     = selection->Gather( *this->systems[0]->spins );
+                auto geometry  = selection->geometry();
+                IO::Output_Queue::Enqueue( spinsFile, [spins, geometry, spinsFile, format, comment, append]()
+                {
+                    IO::Write_Spin_Configuration( *spins, *geometry, spinsFile, format, comment, append );
+                }, 2 * spins->size() * sizeof(Vector3) );
             };
 
             auto writeOutputEnergy = [this, preSpinsFile, preEnergyFile, iteration](std::string suffix, bool append)
@@ -304,7 +315,8 @@ namespace Engine
 
                 // File name
                 std::string energyFile = preEnergyFile + suffix + ".txt";
-                std::string energyFilePerSpin = preEnergyFile + "-perSpin" + suffix + ".txt";
+                auto formatPerSpin = IO::VF_FileFormat( this->systems[0]->llg_parameters->output_energy_spin_resolved_filetype );
+                std::string energyFilePerSpin = preEnergyFile + "-perSpin" + suffix + IO::Fileformat_Extension( formatPerSpin );
 
                 // Energy
                 if (append)
@@ -321,7 +333,7 @@ namespace Engine
                     IO::Append_Image_Energy(*this->systems[0], iteration, energyFile, normalize);
                     if (this->systems[0]->llg_parameters->output_energy_spin_resolved)
                     {
-                        IO::Write_Image_Energy_per_Spin(*this->systems[0], energyFilePerSpin, normalize);
+                        IO::Write_Image_Energy_per_Spin(*this->systems[0], energyFilePerSpin, normalize, formatPerSpin);
                     }
                 }
             };
@@ -359,6 +371,30 @@ namespace Engine
                 writeOutputEnergy("-archive", true);
             }
 
+            // Binary trajectory output (appending frames)
+            if (this->systems[0]->llg_parameters->output_configuration_trajectory)
+            {
+                std::string trajectoryFile = this->parameters->output_folder + "/" + fileTag + "Image-" + s_img + "_Trajectory.bin";
+                auto selection = this->Get_Output_Selection( 0, this->systems[0]->geometry );
+                auto frame     = std::make_shared<IO::Trajectory_Frame>();
+                auto geometry  = selection->geometry();
+                auto names     = std::make_shared<std::vector<std::string>>();
+                frame->iteration = iteration;
+                frame->time      = iteration * this->systems[0]->llg_parameters->dt;
+                frame->energy    = this->systems[0]->E;
+                for (auto& contribution : this->systems[0]->E_array)
+                {
+                    names->push_back(contribution.first);
+                    frame->energy_contributions.push_back(contribution.second);
+                }
+                frame->spins = std::move( *selection->Gather( *this->systems[0]->spins ) );
+                auto encoding = IO::Trajectory_Encoding(this->systems[0]->llg_parameters->output_trajectory_encoding);
+                IO::Output_Queue::Enqueue( trajectoryFile, [frame, geometry, names, trajectoryFile, encoding]()
+                {
+                    IO::Append_Trajectory_Frame( trajectoryFile, *geometry, *frame, encoding, true, *names );
+                }, 2 * frame->spins.size() * sizeof(Vector3) );
+            }
+
             // Save Log
             Log.Append_to_File();
         }
@@ -368,6 +404,17 @@ namespace Engine
     template <Solver solver>
     std::string Method_LLG<solver>::Name() { return "LLG"; }
 
+    template <Solver solver>
+    void Method_LLG<solver>::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        using Utility::Memory::Bytes;
+        Method_Solver<solver>::Memory_Usage(report);
+        report.Add("gradient", Bytes(this->Gradient));
+        report.Add("temperature", Bytes(this->temperature_distribution));
+        report.Add("spin current gradient", Bytes(this->s_c_grad));
+        report.Add("convergence flags", this->force_converged.capacity() / 8);
+    }
+
 
     // Template instantiations
     template class Method_LLG<Solver::SIB>;
@@ -138,14 +138,17 @@ namespace Engine
         using namespace Utility;
 
         //---- Log messages
-        Log.SendBlock(Log_Level::All, this->SenderName,
+        std::vector<std::string> block
         {
             "------------  Started  " + this->Name() + " Calculation  ------------",
             "    Going to iterate " + fmt::format("{}", this->n_log) + " steps",
             "                with " + fmt::format("{}", this->n_iterations_log) + " iterations per step",
-            "   Target acceptance " + fmt::format("{}", this->acceptance_ratio_current),
-            "-----------------------------------------------------"
-        }, this->idx_image, this->idx_chain);
+            "   Target acceptance " + fmt::format("{}", this->acceptance_ratio_current)
+        };
+        for (auto & line : this->Memory_Summary())
+            block.push_back(line);
+        block.push_back("-----------------------------------------------------");
+        Log.SendBlock(Log_Level::All, this->SenderName, block, this->idx_image, this->idx_chain);
     }
 
     void Method_MC::Message_Step()
@@ -155,16 +158,17 @@ namespace Engine
         // Update time of current step
         auto t_current = system_clock::now();
 
-        // Send log message
-        Log.SendBlock(Log_Level::All, this->SenderName,
-        {
-            "----- " + this->Name() + " Calculation: " + Timing::DateTimePassed(t_current - this->t_start),
-            "    Step                         " + fmt::format("{} / {}", step, n_log),
-            "    Iteration                    " + fmt::format("{} / {}", this->iteration, n_iterations),
-            "    Time since last step:        " + Timing::DateTimePassed(t_current - this->t_last),
-            "    Iterations / sec:            " + fmt::format("{}", this->n_iterations_log / Timing::SecondsPassed(t_current - this->t_last)),
-            "    Current acceptance ratio:    " + fmt::format("{}", this->acceptance_ratio_current)
-        }, this->idx_image, this->idx_chain);
+        // Send log message, which is only created if it is printed or saved
+        if (Log.Accepts(Log_Level::All))
+            Log.SendBlock(Log_Level::All, this->SenderName,
+            {
+                "----- " + this->Name() + " Calculation: " + Timing::DateTimePassed(t_current - this->t_start),
+                "    Step                         " + fmt::format("{} / {}", step, n_log),
+                "    Iteration                    " + fmt::format("{} / {}", this->iteration, n_iterations),
+                "    Time since last step:        " + Timing::DateTimePassed(t_current - this->t_last),
+                "    Iterations / sec:            " + fmt::format("{}", this->n_iterations_log / Timing::SecondsPassed(t_current - this->t_last)),
+                "    Current acceptance ratio:    " + fmt::format("{}", this->acceptance_ratio_current)
+            }, this->idx_image, this->idx_chain);
 
         // Update time of last step
         this->t_last = t_current;
@@ -194,6 +198,8 @@ namespace Engine
         block.push_back("    Iteration         " + fmt::format("{} / {}", this->iteration, n_iterations));
         block.push_back("    Iterations / sec: " + fmt::format("{}", this->iteration / Timing::SecondsPassed(t_end - this->t_start)));
         block.push_back("    Acceptance ratio: " + fmt::format("{}", this->acceptance_ratio_current));
+        for (auto & line : this->timings.Summary())
+            block.push_back(line);
         block.push_back("-----------------------------------------------------");
         Log.SendBlock(Log_Level::All, this->SenderName, block, this->idx_image, this->idx_chain);
     }
@@ -203,6 +209,22 @@ namespace Engine
     {
     }
 
+    void Method_MC::Checkpoint_Write(IO::Binary_Writer & writer)
+    {
+        Method::Checkpoint_Write(writer);
+        writer.Write(this->cos_cone_angle);
+        writer.Write(this->acceptance_ratio_current);
+    }
+
+    void Method_MC::Checkpoint_Read(IO::Binary_Reader & reader)
+    {
+        Method::Checkpoint_Read(reader);
+        reader.Read(this->cos_cone_angle);
+        reader.Read(this->acceptance_ratio_current);
+    }
+
     // Method name as string
     std::string Method_MC::Name() { return "MC"; }
+    std::string Method_MC::SolverName() { return "None"; }
+    std::string Method_MC::SolverFullName() { return "None"; }
 }
\ No newline at end of file
@@ -33,6 +33,8 @@ namespace Engine
 		{
 			this->systems.push_back(this->collection->chains[ichain]->images.back());
 		}
+		this->noi = noc;
+		this->nos = nos;
 
 		// History
         this->history = std::map<std::string, std::vector<scalar>>{
@@ -41,6 +43,13 @@ namespace Engine
 		// We assume that the systems are not converged before the first iteration
 		this->force_max_abs_component = this->collection->parameters->force_convergence + 1.0;
 
+		// The dense Hessians dominate: one per chain, and the projector and projected Hessian
+		//		of the chain which is currently calculated
+		std::size_t dense = 9 * std::size_t(nos) * std::size_t(nos) * sizeof(scalar);
+		Utility::Memory::Require("MMF workspace", (noc + 3) * dense
+			+ (3 * std::size_t(noc) + 1) * nos * sizeof(Vector3)
+			+ Method_Solver<solver>::Workspace_Bytes(noc, nos));
+
 		this->hessian = std::vector<MatrixX>(noc, MatrixX(3*nos, 3*nos));	// [noc][3nos]
 		// Forces
 		this->gradient   = std::vector<vectorfield>(noc, vectorfield(nos));	// [noc][3nos]
@@ -52,6 +61,13 @@ namespace Engine
 		this->spins_last[0] = *this->systems[0]->spins;
 		this->Rx_last = 0.0;
 
+		// Forces
+		this->forces = std::vector<vectorfield>(this->noi, vectorfield(this->nos, {0,0,0}));	// [noi][nos]
+
+		// Create shared pointers to the method's systems' spin configurations
+		this->configurations = std::vector<std::shared_ptr<vectorfield>>(this->noi);
+		for (int i = 0; i<this->noi; ++i) this->configurations[i] = this->systems[i]->spins;
+
 		// Force function
 		// ToDo: move into parameters
 		this->mm_function = "Spectra Matrix"; // "Spectra Matrix" "Spectra Prefactor" "Lanczos"
@@ -64,6 +80,7 @@ namespace Engine
 	template <Solver solver>
     void Method_MMF<solver>::Calculate_Force(const std::vector<std::shared_ptr<vectorfield>> & configurations, std::vector<vectorfield> & forces)
     {
+		SPIRIT_TIMER("Force");
 		if (this->mm_function == "Spectra Matrix")
 		{
 			this->Calculate_Force_Spectra_Matrix(configurations, forces);
@@ -382,13 +399,17 @@ namespace Engine
 			auto writeOutputConfiguration = [this, preSpinsFile, preEnergyFile, iteration](std::string suffix, bool append)
 			{
 				// File name and comment
-				std::string spinsFile = preSpinsFile + suffix + ".txt";
+				auto format = IO::VF_FileFormat( this->parameters->output_configuration_filetype );
+				std::string spinsFile = preSpinsFile + suffix + IO::Fileformat_Extension( format );
                 std::string comment = std::to_string( iteration );
-				// Spin Configuration
-                IO::Write_Spin_Configuration( *( this->systems[0] )->spins, 
-                                              *( this->systems[0] )->geometry, spinsFile, 
-                                              IO::VF_FileFormat::SPIRIT_WHITESPACE_SPIN, 
-                                              comment, append );
+				// Spin Configuration, written asynchronously from a snapshot of the selected spins
+                auto selection = this->Get_Output_Selection( 0, this->systems[0]->geometry );
+                auto spins     = selection->Gather( *this->systems[0]->spins );
+                auto geometry  = selection->geometry();
+                IO::Output_Queue::Enqueue( spinsFile, [spins, geometry, spinsFile, format, comment, append]()
+                {
+                    IO::Write_Spin_Configuration( *spins, *geometry, spinsFile, format, comment, append );
+                }, 2 * spins->size() * sizeof(Vector3) );
 			};
 
 			auto writeOutputEnergy = [this, preSpinsFile, preEnergyFile, iteration](std::string suffix, bool append)
@@ -568,6 +589,20 @@ namespace Engine
 	template <Solver solver>
     std::string Method_MMF<solver>::Name() { return "MMF"; }
 
+    template <Solver solver>
+    void Method_MMF<solver>::Memory_Usage(Utility::Memory::Report & report) const
+    {
+        using Utility::Memory::Bytes;
+        Method_Solver<solver>::Memory_Usage(report);
+        std::size_t bytes = this->hessian.capacity() * sizeof(MatrixX);
+        for (auto & matrix : this->hessian)
+            bytes += Bytes(matrix);
+        report.Add("hessian", bytes);
+        report.Add("gradient", Bytes(this->gradient));
+        report.Add("minimum mode", Bytes(this->minimum_mode));
+        report.Add("last spins", Bytes(this->spins_last));
+    }
+
 	// Template instantiations
 	template class Method_MMF<Solver::SIB>;
 	template class Method_MMF<Solver::Heun>;
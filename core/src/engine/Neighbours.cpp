@@ -130,6 +130,14 @@ namespace Engine
 			return pairs;
 		}
 
+		intfield Get_Shell_Translations(const Data::Geometry & geometry, int nShells)
+		{
+			// The nShells + 10 is a value that is big enough by experience to 
+			// produce enough needed shells, but is small enough to run sufficiently fast
+			int tMax = nShells + 10;
+			return { std::min(tMax, geometry.n_cells[0]-1), std::min(tMax, geometry.n_cells[1]-1), std::min(tMax, geometry.n_cells[2]-1) };
+		}
+
 		neighbourfield Get_Neighbours_in_Shells(const Data::Geometry & geometry, int nShells)
 		{
 			auto neighbours = neighbourfield(0);
@@ -140,10 +148,8 @@ namespace Engine
 			Vector3 b = geometry.bravais_vectors[1];
 			Vector3 c = geometry.bravais_vectors[2];
 
-			// The nShells + 10 is a value that is big enough by experience to 
-			// produce enough needed shells, but is small enough to run sufficiently fast
-			int tMax = nShells + 10;
-			int imax = std::min(tMax, geometry.n_cells[0]-1), jmax = std::min(tMax, geometry.n_cells[1]-1), kmax = std::min(tMax, geometry.n_cells[2]-1);
+			auto translations = Get_Shell_Translations(geometry, nShells);
+			int imax = translations[0], jmax = translations[1], kmax = translations[2];
 			int i,j,k;
 			scalar dx, delta, radius;
 			Vector3 x0={0,0,0}, x1={0,0,0};
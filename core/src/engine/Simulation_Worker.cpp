@@ -0,0 +1,182 @@
+#include <engine/Simulation_Worker.hpp>
+#include <utility/Logging.hpp>
+
+#include <chrono>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef SPIRIT_USE_THREADS
+#include <deque>
+#include <thread>
+#include <vector>
+#endif
+
+namespace Engine
+{
+    Simulation_Task::Simulation_Task(std::shared_ptr<Method> method, std::function<void()> work, int n_threads) :
+        method(method), work(work), n_threads(n_threads), iteration_final(0), finished(false)
+    {
+        if (this->n_threads <= 0)
+        {
+            #ifdef _OPENMP
+            this->n_threads = omp_get_max_threads();
+            #else
+            this->n_threads = 1;
+            #endif
+        }
+    }
+
+    void Simulation_Task::Cancel()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->method)
+            this->method->Cancel();
+    }
+
+    bool Simulation_Task::Wait(scalar timeout)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        if (timeout < 0)
+            this->condition.wait(lock, [this] { return this->finished; });
+        else
+            this->condition.wait_for(lock, std::chrono::duration<scalar>(timeout), [this] { return this->finished; });
+        return this->finished;
+    }
+
+    bool Simulation_Task::Finished()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->finished;
+    }
+
+    int Simulation_Task::Iteration()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->finished)
+            return this->iteration_final;
+        return this->method->getNIterations();
+    }
+
+    namespace Simulation_Worker
+    {
+        std::atomic<int> n_threads_running(0);
+
+        int N_Threads_Running()
+        {
+            return n_threads_running;
+        }
+    }
+
+    void Simulation_Task::Run()
+    {
+        Simulation_Worker::n_threads_running += this->n_threads;
+
+        // The thread budget applies to the parallel regions started from this thread
+        #ifdef _OPENMP
+        int n_threads_default = omp_get_max_threads();
+        omp_set_num_threads(this->n_threads);
+        #endif
+
+        try
+        {
+            this->work();
+        }
+        catch( ... )
+        {
+            Log(Utility::Log_Level::Error, Utility::Log_Sender::All, "Simulation running in the background failed");
+        }
+
+        #ifdef _OPENMP
+        omp_set_num_threads(n_threads_default);
+        #endif
+
+        Simulation_Worker::n_threads_running -= this->n_threads;
+
+        // The method is released, as it is still kept by the State as long as it is needed
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->iteration_final = this->method->getNIterations();
+        this->method.reset();
+        this->work = nullptr;
+        this->finished = true;
+        this->condition.notify_all();
+    }
+
+    namespace Simulation_Worker
+    {
+        #ifdef SPIRIT_USE_THREADS
+
+        // Worker threads, which wait for tasks once their simulation has finished
+        class Pool
+        {
+        public:
+            // Running simulations are expected to have been cancelled (e.g. by State_Delete)
+            ~Pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stop = true;
+                }
+                condition.notify_all();
+                for( auto& thread : threads )
+                    thread.join();
+            }
+
+            void Start(std::shared_ptr<Simulation_Task> task)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(task);
+                if( (int)queue.size() > n_idle )
+                    threads.push_back(std::thread(&Pool::Run, this));
+                else
+                    condition.notify_one();
+            }
+
+        private:
+            void Run()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                while( true )
+                {
+                    ++n_idle;
+                    condition.wait(lock, [&] { return stop || !queue.empty(); });
+                    --n_idle;
+                    if( queue.empty() ) return;
+
+                    auto task = queue.front();
+                    queue.pop_front();
+
+                    lock.unlock();
+                    task->Run();
+                    task.reset();
+                    lock.lock();
+                }
+            }
+
+            std::deque<std::shared_ptr<Simulation_Task>> queue;
+            std::vector<std::thread> threads;
+            std::mutex mutex;
+            std::condition_variable condition;
+            int n_idle = 0;
+            bool stop = false;
+        };
+
+        Pool & Get_Pool()
+        {
+            static Pool pool;
+            return pool;
+        }
+
+        #endif
+
+        void Start(std::shared_ptr<Simulation_Task> task)
+        {
+            #ifdef SPIRIT_USE_THREADS
+            Get_Pool().Start(task);
+            #else
+            task->Run();
+            #endif
+        }
+    }
+}
@@ -0,0 +1,313 @@
+#include <engine/Sweep.hpp>
+#include <engine/Method_LLG.hpp>
+#include <engine/Method_MC.hpp>
+#include <engine/Hamiltonian_Heisenberg_Neighbours.hpp>
+#include <engine/Hamiltonian_Heisenberg_Pairs.hpp>
+#include <engine/Hamiltonian_Gaussian.hpp>
+#include <engine/Vectormath.hpp>
+#include <engine/Decomposition.hpp>
+#include <io/IO.hpp>
+#include <utility/Constants.hpp>
+#include <utility/Exception.hpp>
+#include <utility/Logging.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef SPIRIT_USE_THREADS
+#include <thread>
+#endif
+
+using namespace Utility;
+
+namespace Engine
+{
+    Sweep::Sweep(std::shared_ptr<Data::Spin_System> system, std::string method_type, Solver solver,
+                 std::vector<Sweep_Parameter> parameters, std::vector<scalar> points,
+                 bool warm_start, int n_workers, int n_iterations, int idx_image, int idx_chain) :
+        system(system), method_type(method_type), solver(solver), parameters(parameters), points(points),
+        warm_start(warm_start), n_workers(n_workers), idx_image(idx_image), idx_chain(idx_chain), n_points_done(0)
+    {
+        if (this->method_type != "LLG" && this->method_type != "MC")
+            spirit_throw(Exception_Classifier::Not_Implemented, Log_Level::Error,
+                fmt::format("Cannot sweep with the {} method, only LLG and MC are supported", this->method_type));
+        if (this->parameters.empty() || this->points.size() % this->parameters.size() != 0)
+            spirit_throw(Exception_Classifier::Unknown_Exception, Log_Level::Error,
+                fmt::format("{} values do not make up points of {} parameters", this->points.size(), this->parameters.size()));
+
+        // The Hamiltonian needs to have the parameters which are varied
+        auto neighbours = dynamic_cast<Hamiltonian_Heisenberg_Neighbours*>(this->system->hamiltonian.get());
+        auto pairs      = dynamic_cast<Hamiltonian_Heisenberg_Pairs*>(this->system->hamiltonian.get());
+        for (auto parameter : this->parameters)
+        {
+            if (parameter != Sweep_Parameter::Temperature && !neighbours && !pairs)
+                spirit_throw(Exception_Classifier::Not_Implemented, Log_Level::Error,
+                    "Only the temperature can be swept for the " + this->system->hamiltonian->Name() + " Hamiltonian");
+        }
+
+        if (this->n_workers <= 0)
+        {
+            #if defined(SPIRIT_USE_THREADS)
+            this->n_workers = std::thread::hardware_concurrency();
+            #elif defined(_OPENMP)
+            this->n_workers = omp_get_max_threads();
+            #else
+            this->n_workers = 1;
+            #endif
+        }
+        this->n_workers = std::max(1, std::min(this->n_workers, this->N_Points()));
+        // With several MPI ranks, the methods of concurrent workers would issue collective
+        //      operations in an undefined order across the ranks
+        if (Decomposition::N_Ranks() > 1)
+            this->n_workers = 1;
+
+        this->results = std::vector<scalar>(this->N_Points() * n_observables, std::numeric_limits<scalar>::quiet_NaN());
+
+        this->system->Lock();
+        try
+        {
+            this->spins_initial = *this->system->spins;
+            if (neighbours)
+            {
+                this->exchange_magnitudes = neighbours->exchange_magnitudes;
+                this->dmi_magnitudes = neighbours->dmi_magnitudes;
+            }
+            else if (pairs)
+            {
+                this->exchange_magnitudes = pairs->exchange_magnitudes;
+                this->dmi_magnitudes = pairs->dmi_magnitudes;
+            }
+
+            // The copies share the geometry, which is read-only during the iterations. Its
+            //      triangulation is created lazily, so it is kept here instead of being requested
+            //      by several workers at once.
+            if (this->system->geometry->dimensionality == 2)
+                this->triangulation = this->system->geometry->triangulation(1, this->system->hamiltonian->boundary_conditions);
+            for (int i = 0; i < this->n_workers; ++i)
+                this->systems.push_back(this->Copy_System(n_iterations));
+        }
+        catch( ... )
+        {
+            this->system->Unlock();
+            throw;
+        }
+        this->system->Unlock();
+    }
+
+    std::shared_ptr<Data::Spin_System> Sweep::Copy_System(int n_iterations)
+    {
+        // The copy constructor of Spin_System would also copy the geometry
+        std::unique_ptr<Engine::Hamiltonian> hamiltonian;
+        auto original = this->system->hamiltonian.get();
+        if (auto neighbours = dynamic_cast<Hamiltonian_Heisenberg_Neighbours*>(original))
+            hamiltonian.reset(new Hamiltonian_Heisenberg_Neighbours(*neighbours));
+        else if (auto pairs = dynamic_cast<Hamiltonian_Heisenberg_Pairs*>(original))
+            hamiltonian.reset(new Hamiltonian_Heisenberg_Pairs(*pairs));
+        else if (auto gaussian = dynamic_cast<Hamiltonian_Gaussian*>(original))
+            hamiltonian.reset(new Hamiltonian_Gaussian(*gaussian));
+        else
+            spirit_throw(Exception_Classifier::Not_Implemented, Log_Level::Error,
+                "Cannot sweep with the " + original->Name() + " Hamiltonian");
+
+        auto llg_parameters = std::unique_ptr<Data::Parameters_Method_LLG>(new Data::Parameters_Method_LLG(*this->system->llg_parameters));
+        auto mc_parameters  = std::unique_ptr<Data::Parameters_Method_MC>(new Data::Parameters_Method_MC(*this->system->mc_parameters));
+        llg_parameters->output_any = false;
+        mc_parameters->output_any  = false;
+        if (n_iterations > 0)
+        {
+            llg_parameters->n_iterations = n_iterations;
+            mc_parameters->n_iterations  = n_iterations;
+        }
+
+        return std::shared_ptr<Data::Spin_System>(new Data::Spin_System(std::move(hamiltonian),
+            this->system->geometry, std::move(llg_parameters), std::move(mc_parameters), false));
+    }
+
+    int Sweep::N_Points() const
+    {
+        return this->points.size() / this->parameters.size();
+    }
+
+    int Sweep::N_Points_Done() const
+    {
+        return this->n_points_done;
+    }
+
+    const std::vector<scalar> & Sweep::Results() const
+    {
+        return this->results;
+    }
+
+    void Sweep::Run(const std::string & filename)
+    {
+        this->filename = filename;
+        if (!this->filename.empty())
+        {
+            std::string header = "# point";
+            for (auto parameter : this->parameters)
+            {
+                if (parameter == Sweep_Parameter::Field)
+                    header += "  field";
+                else if (parameter == Sweep_Parameter::Temperature)
+                    header += "  temperature";
+                else if (parameter == Sweep_Parameter::Exchange)
+                    header += "  exchange";
+                else if (parameter == Sweep_Parameter::DMI)
+                    header += "  dmi";
+            }
+            header += "  E  M_x  M_y  M_z  Q  max_torque\n";
+            IO::String_to_File(header, this->filename);
+        }
+
+        Log(Log_Level::Info, Log_Sender::All, fmt::format("Sweep over {} points with {} workers",
+            this->N_Points(), this->n_workers), this->idx_image, this->idx_chain);
+
+        // Contiguous blocks of points, the first n_points % n_workers blocks get one more point
+        int n_points = this->N_Points();
+        auto block_begin = [&](int idx_worker)
+        {
+            return idx_worker * (n_points / this->n_workers) + std::min(idx_worker, n_points % this->n_workers);
+        };
+
+        #if defined(SPIRIT_USE_THREADS)
+        // Each worker gets an equal share of the OpenMP threads
+        int n_threads = 1;
+        #ifdef _OPENMP
+        n_threads = std::max(1, omp_get_max_threads() / this->n_workers);
+        #endif
+        std::vector<std::thread> workers;
+        for (int i = 0; i < this->n_workers; ++i)
+        {
+            workers.push_back(std::thread([&, i]()
+            {
+                #ifdef _OPENMP
+                omp_set_num_threads(n_threads);
+                #endif
+                this->Run_Block(i, block_begin(i), block_begin(i+1));
+            }));
+        }
+        for (auto & worker : workers)
+            worker.join();
+        #else
+        // The parallel regions of the methods are nested and therefore run by a single thread
+        #pragma omp parallel for schedule(static, 1) num_threads(this->n_workers)
+        for (int i = 0; i < this->n_workers; ++i)
+            this->Run_Block(i, block_begin(i), block_begin(i+1));
+        #endif
+
+        Log(Log_Level::Info, Log_Sender::All, fmt::format("Sweep finished {} of {} points",
+            this->n_points_done, n_points), this->idx_image, this->idx_chain);
+    }
+
+    void Sweep::Run_Block(int idx_worker, int idx_begin, int idx_end)
+    {
+        auto & copy = this->systems[idx_worker];
+        try
+        {
+            for (int idx_point = idx_begin; idx_point < idx_end; ++idx_point)
+            {
+                if (!this->system->iteration_allowed)
+                    break;
+
+                if (idx_point == idx_begin || !this->warm_start)
+                    *copy->spins = this->spins_initial;
+                this->Apply_Point(*copy, idx_point);
+
+                copy->iteration_allowed = true;
+                auto method = this->Create_Method(copy);
+                method->Iterate();
+                copy->iteration_allowed = false;
+
+                this->Record(idx_point, *copy, *method);
+            }
+        }
+        catch( ... )
+        {
+            Log(Log_Level::Error, Log_Sender::All, fmt::format("Worker {} of the sweep failed", idx_worker),
+                this->idx_image, this->idx_chain);
+        }
+    }
+
+    void Sweep::Apply_Point(Data::Spin_System & system, int idx_point)
+    {
+        // Every point gets its own random numbers, independent of the worker running it
+        system.llg_parameters->prng = std::mt19937(system.llg_parameters->rng_seed + idx_point);
+        system.mc_parameters->prng = std::mt19937(system.mc_parameters->rng_seed + idx_point);
+
+        auto neighbours = dynamic_cast<Hamiltonian_Heisenberg_Neighbours*>(system.hamiltonian.get());
+        auto pairs      = dynamic_cast<Hamiltonian_Heisenberg_Pairs*>(system.hamiltonian.get());
+        for (unsigned int i = 0; i < this->parameters.size(); ++i)
+        {
+            scalar value = this->points[idx_point * this->parameters.size() + i];
+            if (this->parameters[i] == Sweep_Parameter::Temperature)
+            {
+                system.llg_parameters->temperature = value;
+                system.mc_parameters->temperature = value;
+            }
+            else if (neighbours)
+                this->Apply_Heisenberg(*neighbours, this->parameters[i], value);
+            else if (pairs)
+                this->Apply_Heisenberg(*pairs, this->parameters[i], value);
+        }
+        system.hamiltonian->Update_Energy_Contributions();
+    }
+
+    template<typename Heisenberg>
+    void Sweep::Apply_Heisenberg(Heisenberg & hamiltonian, Sweep_Parameter parameter, scalar value)
+    {
+        if (parameter == Sweep_Parameter::Field)
+            hamiltonian.external_field_magnitude = value * Constants::mu_B;
+        else if (parameter == Sweep_Parameter::Exchange)
+            for (unsigned int j = 0; j < this->exchange_magnitudes.size(); ++j)
+                hamiltonian.exchange_magnitudes[j] = value * this->exchange_magnitudes[j];
+        else if (parameter == Sweep_Parameter::DMI)
+            for (unsigned int j = 0; j < this->dmi_magnitudes.size(); ++j)
+                hamiltonian.dmi_magnitudes[j] = value * this->dmi_magnitudes[j];
+    }
+
+    std::shared_ptr<Method> Sweep::Create_Method(std::shared_ptr<Data::Spin_System> system)
+    {
+        if (this->method_type == "MC")
+            return std::shared_ptr<Method>(new Method_MC(system, this->idx_image, this->idx_chain));
+        else if (this->solver == Solver::SIB)
+            return std::shared_ptr<Method>(new Method_LLG<Solver::SIB>(system, this->idx_image, this->idx_chain));
+        else if (this->solver == Solver::Heun)
+            return std::shared_ptr<Method>(new Method_LLG<Solver::Heun>(system, this->idx_image, this->idx_chain));
+        else if (this->solver == Solver::Depondt)
+            return std::shared_ptr<Method>(new Method_LLG<Solver::Depondt>(system, this->idx_image, this->idx_chain));
+        else if (this->solver == Solver::NCG)
+            return std::shared_ptr<Method>(new Method_LLG<Solver::NCG>(system, this->idx_image, this->idx_chain));
+        else
+            return std::shared_ptr<Method>(new Method_LLG<Solver::VP>(system, this->idx_image, this->idx_chain));
+    }
+
+    void Sweep::Record(int idx_point, Data::Spin_System & system, Method & method)
+    {
+        system.UpdateEnergy();
+        auto M = Vectormath::Magnetization(*system.spins);
+        scalar Q = 0;
+        if (!this->triangulation.empty())
+            Q = Vectormath::TopologicalCharge(*system.spins, this->triangulation);
+        std::vector<scalar> observables{ system.E, M[0], M[1], M[2], Q, method.getForceMaxAbsComponent() };
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        std::copy(observables.begin(), observables.end(), this->results.begin() + idx_point * n_observables);
+        ++this->n_points_done;
+
+        if (!this->filename.empty())
+        {
+            std::string line = fmt::format("{:>7}", idx_point);
+            for (unsigned int i = 0; i < this->parameters.size(); ++i)
+                line += fmt::format("  {:>14.8f}", this->points[idx_point * this->parameters.size() + i]);
+            for (auto value : observables)
+                line += fmt::format("  {:>18.10e}", value);
+            IO::Append_String_to_File(line + "\n", this->filename);
+        }
+    }
+}
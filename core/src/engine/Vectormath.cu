@@ -339,35 +339,53 @@ namespace Engine
             return solid_angle;
         }
 
-        scalar TopologicalCharge(const vectorfield & vf, const vectorfield & vf_pos, const std::vector<std::array<int, 3>> & triangulation)
+        scalar TopologicalCharge(const vectorfield & vf, const std::vector<std::array<int, 3>> & triangulation)
         {
-            // TODO: this still ignores periodical boundaries, as they are not part of the delaunay triangulation!
-
-            scalar charge = 0, sign;
-            Vector3 triangle_normal;
-            for (int i = 0; i < triangulation.size(); ++i)
+            // The triangles are oriented counter-clockwise with respect to the lattice plane normal,
+            //      so that no positions are needed and triangles wrapping around periodical
+            //      boundaries are counted correctly
+            scalar charge = 0;
+            for (int i = 0; i < (int)triangulation.size(); ++i)
             {
-                int i1 = triangulation[i][0];
-                int i2 = triangulation[i][1];
-                int i3 = triangulation[i][2];
+                auto& v1 = vf[triangulation[i][0]];
+                auto& v2 = vf[triangulation[i][1]];
+                auto& v3 = vf[triangulation[i][2]];
 
-                auto& vp1 = vf_pos[i1];
-                auto& vp2 = vf_pos[i2];
-                auto& vp3 = vf_pos[i3];
+                // charge += solid_angle_1(v1, v2, v3);
+                charge += solid_angle_2(v1, v2, v3);
+            }
+            return charge / (4*Pi);
+        }
+
+        void TopologicalChargeDensity(const vectorfield & vf, const std::vector<std::array<int, 3>> & triangulation, scalarfield & charge_density)
+        {
+            charge_density.resize(triangulation.size());
+            for (int i = 0; i < (int)triangulation.size(); ++i)
+            {
+                auto& v1 = vf[triangulation[i][0]];
+                auto& v2 = vf[triangulation[i][1]];
+                auto& v3 = vf[triangulation[i][2]];
 
-                // TODO: this will only work if the vf_pos are in the xy-plane!
-                triangle_normal = (vp1-vp2).cross(vp1-vp3);
-                triangle_normal.normalize();
-                sign = triangle_normal[2]/std::abs(triangle_normal[2]);
+                charge_density[i] = solid_angle_2(v1, v2, v3) / (4*Pi);
+            }
+        }
 
-                auto& v1 = vf[i1];
-                auto& v2 = vf[i2];
-                auto& v3 = vf[i3];
+        void TopologicalChargeDensity_per_Spin(const vectorfield & vf, const std::vector<std::array<int, 3>> & triangulation, scalarfield & charge_density)
+        {
+            // Each spin gets a third of the charge of every triangle it is a corner of
+            charge_density.assign(vf.size(), 0);
+            for (int i = 0; i < (int)triangulation.size(); ++i)
+            {
+                auto& v1 = vf[triangulation[i][0]];
+                auto& v2 = vf[triangulation[i][1]];
+                auto& v3 = vf[triangulation[i][2]];
 
-                // charge += sign * solid_angle_1(v1, v2, v3);
-                charge += sign * solid_angle_2(v1, v2, v3);
+                scalar charge = solid_angle_2(v1, v2, v3) / (12*Pi);
+                for (int k = 0; k < 3; ++k)
+                {
+                    charge_density[triangulation[i][k]] += charge;
+                }
             }
-            return charge / (4*Pi);
         }
 
         // Utility function for the SIB Solver
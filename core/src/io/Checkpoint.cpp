@@ -0,0 +1,370 @@
+#include <io/Checkpoint.hpp>
+#include <io/Mapped_File.hpp>
+#include <data/State.hpp>
+#include <engine/Method.hpp>
+#include <engine/Decomposition.hpp>
+#include <utility/Logging.hpp>
+#include <utility/Exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <random>
+#include <sstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+
+using namespace Utility;
+
+namespace IO
+{
+    // File signature and version of the format
+    const char checkpoint_magic[8] = { 'S', 'P', 'I', 'R', 'I', 'T', 'C', 'P' };
+    const std::uint32_t checkpoint_version = 1;
+
+    void Binary_Reader::Require(std::size_t n_bytes)
+    {
+        if (n_bytes > this->size - this->offset)
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                "Unexpected end of binary data");
+    }
+
+    template<typename PRNG>
+    std::string Serialize_PRNG(const PRNG & prng)
+    {
+        std::ostringstream stream;
+        stream << prng;
+        return stream.str();
+    }
+
+    // Parse the state of a random number generator, throws if it is invalid
+    std::mt19937 Deserialize_PRNG(const std::string & data, const std::string & filename)
+    {
+        std::mt19937 prng;
+        std::istringstream stream(data);
+        stream >> prng;
+        if (stream.fail())
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("Checkpoint \"{}\" contains an invalid random number generator state", filename));
+        return prng;
+    }
+
+    // Contents of a checkpoint, parsed completely before anything in the State is changed
+    struct Image_Data
+    {
+        std::int32_t nos, n_cell_atoms;
+        std::int32_t n_cells[3];
+        vectorfield spins;
+        std::mt19937 prng_llg, prng_mc;
+    };
+
+    struct Chain_Data
+    {
+        std::int32_t idx_active_image;
+        std::mt19937 prng_gneb;
+        std::vector<scalar> Rx;
+        std::vector<std::int32_t> image_type;
+        std::vector<Image_Data> images;
+    };
+
+    void Write_Method(Binary_Writer & writer, Engine::Method & method, int idx_image, int idx_chain)
+    {
+        Binary_Writer data;
+        method.Checkpoint_Write(data);
+
+        writer.Write(method.Name());
+        writer.Write(method.SolverName());
+        writer.Write<std::int32_t>(idx_image);
+        writer.Write<std::int32_t>(idx_chain);
+        writer.Write(data.Data());
+    }
+
+    // Write the chains, images and methods, returns the number of methods
+    int Write_State(Binary_Writer & writer, State & state)
+    {
+        auto& chains = state.collection->chains;
+
+        // Chains and images
+        writer.Write<std::int32_t>(state.collection->noc);
+        writer.Write<std::int32_t>(state.collection->idx_active_chain);
+        for (auto& chain : chains)
+        {
+            writer.Write<std::int32_t>(chain->noi);
+            writer.Write<std::int32_t>(chain->idx_active_image);
+            writer.Write(Serialize_PRNG(chain->gneb_parameters->prng));
+            writer.Write(chain->Rx);
+            std::vector<std::int32_t> image_type(chain->noi);
+            for (int img = 0; img < chain->noi; ++img)
+                image_type[img] = static_cast<std::int32_t>(chain->image_type[img]);
+            writer.Write(image_type);
+
+            for (auto& image : chain->images)
+            {
+                auto& geometry = *image->geometry;
+                writer.Write<std::int32_t>(image->nos);
+                writer.Write<std::int32_t>(geometry.n_cell_atoms);
+                for (int dim = 0; dim < 3; ++dim)
+                    writer.Write<std::int32_t>(geometry.n_cells[dim]);
+                writer.Write(*image->spins);
+                writer.Write(Serialize_PRNG(image->llg_parameters->prng));
+                writer.Write(Serialize_PRNG(image->mc_parameters->prng));
+            }
+        }
+
+        // Methods
+        std::vector<std::shared_ptr<Engine::Method>> methods;
+        std::vector<std::array<int, 2>> indices;
+        for (unsigned int ichain = 0; ichain < state.method_image.size(); ++ichain)
+        {
+            for (unsigned int img = 0; img < state.method_image[ichain].size(); ++img)
+            {
+                if (state.method_image[ichain][img])
+                {
+                    methods.push_back(state.method_image[ichain][img]);
+                    indices.push_back({ int(img), int(ichain) });
+                }
+            }
+            if (ichain < state.method_chain.size() && state.method_chain[ichain])
+            {
+                methods.push_back(state.method_chain[ichain]);
+                indices.push_back({ -1, int(ichain) });
+            }
+        }
+        if (state.method_collection)
+        {
+            methods.push_back(state.method_collection);
+            indices.push_back({ -1, -1 });
+        }
+        writer.Write<std::int32_t>(methods.size());
+        for (unsigned int i = 0; i < methods.size(); ++i)
+            Write_Method(writer, *methods[i], indices[i][0], indices[i][1]);
+        return methods.size();
+    }
+
+    void Write_Checkpoint(State & state, const std::string & filename)
+    {
+        // With MPI, all ranks hold the same data and only rank 0 writes
+        if (Engine::Decomposition::Rank() != 0) return;
+
+        Binary_Writer writer;
+        for (auto c : checkpoint_magic)
+            writer.Write(c);
+        writer.Write(checkpoint_version);
+        writer.Write<std::uint32_t>(sizeof(scalar));
+
+        // All chains and their images are locked while they and the methods are written, so that
+        // the data is consistent with a simulation which is still running. This includes the
+        // systems of all methods, which lock their image or chain for each iteration.
+        auto& chains = state.collection->chains;
+        for (auto& chain : chains)
+            chain->Lock();
+        int n_methods = 0;
+        try
+        {
+            n_methods = Write_State(writer, state);
+        }
+        catch( ... )
+        {
+            for (auto& chain : chains)
+                chain->Unlock();
+            throw;
+        }
+        for (auto& chain : chains)
+            chain->Unlock();
+
+        // Write to a temporary file and replace the checkpoint only when it is complete and
+        // on disk, so that a crash cannot leave a renamed but incomplete checkpoint
+        std::string filename_temp = filename + ".tmp";
+        std::FILE * file = std::fopen(filename_temp.c_str(), "wb");
+        if (!file)
+            spirit_throw(Exception_Classifier::File_not_Found, Log_Level::Error,
+                "Could not open \"" + filename_temp + "\" to write the checkpoint");
+        auto& data = writer.Data();
+        bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size() && std::fflush(file) == 0;
+        #ifdef _WIN32
+        written = written && _commit(_fileno(file)) == 0;
+        #else
+        written = written && fsync(fileno(file)) == 0;
+        #endif
+        written = std::fclose(file) == 0 && written;
+        if (!written)
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                "Could not write the checkpoint to \"" + filename_temp + "\"");
+
+        #ifdef _WIN32
+        std::remove(filename.c_str());
+        #endif
+        if (std::rename(filename_temp.c_str(), filename.c_str()) != 0)
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                "Could not rename \"" + filename_temp + "\" to \"" + filename + "\"");
+
+        Log(Log_Level::Info, Log_Sender::IO, fmt::format("Wrote checkpoint \"{}\" ({} chain(s), {} method(s), {} bytes)",
+            filename, chains.size(), n_methods, data.size()));
+    }
+
+    void Read_Checkpoint(State & state, const std::string & filename)
+    {
+        Mapped_File file(filename);
+        Binary_Reader reader(file.data(), file.size());
+
+        // Header
+        char magic[8];
+        for (auto& c : magic)
+            reader.Read(c);
+        if (!std::equal(magic, magic + 8, checkpoint_magic))
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                "\"" + filename + "\" is not a Spirit checkpoint");
+        std::uint32_t version, scalar_size;
+        reader.Read(version);
+        reader.Read(scalar_size);
+        if (version != checkpoint_version)
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("Checkpoint \"{}\" has version {}, but only version {} can be read", filename, version, checkpoint_version));
+        if (scalar_size != sizeof(scalar))
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("Checkpoint \"{}\" was written with {}-byte scalars, but this build uses {}-byte scalars", filename, scalar_size, sizeof(scalar)));
+
+        // Chains and images
+        std::int32_t noc, idx_active_chain;
+        reader.Read(noc);
+        reader.Read(idx_active_chain);
+        if (noc != state.collection->noc)
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("Checkpoint \"{}\" contains {} chains, but the State has {}", filename, noc, state.collection->noc));
+
+        std::vector<Chain_Data> chains(noc);
+        for (int ichain = 0; ichain < noc; ++ichain)
+        {
+            auto& chain = chains[ichain];
+            std::int32_t noi;
+            reader.Read(noi);
+            std::string prng_gneb;
+            reader.Read(chain.idx_active_image);
+            reader.Read(prng_gneb);
+            chain.prng_gneb = Deserialize_PRNG(prng_gneb, filename);
+            reader.Read(chain.Rx);
+            reader.Read(chain.image_type);
+            if (noi < 1 || chain.Rx.size() != std::size_t(noi) || chain.image_type.size() != std::size_t(noi))
+                spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                    fmt::format("Checkpoint \"{}\" contains inconsistent data for chain {}", filename, ichain));
+
+            auto& geometry = *state.collection->chains[ichain]->images[0]->geometry;
+            chain.images.resize(noi);
+            for (auto& image : chain.images)
+            {
+                reader.Read(image.nos);
+                reader.Read(image.n_cell_atoms);
+                for (int dim = 0; dim < 3; ++dim)
+                    reader.Read(image.n_cells[dim]);
+                std::string prng_llg, prng_mc;
+                reader.Read(image.spins);
+                reader.Read(prng_llg);
+                reader.Read(prng_mc);
+                image.prng_llg = Deserialize_PRNG(prng_llg, filename);
+                image.prng_mc  = Deserialize_PRNG(prng_mc, filename);
+
+                if (image.nos != geometry.nos || image.n_cell_atoms != geometry.n_cell_atoms ||
+                    image.n_cells[0] != geometry.n_cells[0] || image.n_cells[1] != geometry.n_cells[1] ||
+                    image.n_cells[2] != geometry.n_cells[2] || image.spins.size() != std::size_t(image.nos))
+                    spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                        fmt::format("Checkpoint \"{}\" was written for a different geometry", filename));
+            }
+        }
+
+        // Methods
+        std::int32_t n_methods;
+        reader.Read(n_methods);
+        std::vector<Method_Checkpoint> methods(n_methods);
+        for (auto& method : methods)
+        {
+            std::int32_t idx_image, idx_chain;
+            reader.Read(method.method_name);
+            reader.Read(method.solver_name);
+            reader.Read(idx_image);
+            reader.Read(idx_chain);
+            reader.Read(method.data);
+            method.idx_image = idx_image;
+            method.idx_chain = idx_chain;
+        }
+
+        // Apply to the State
+        for (int ichain = 0; ichain < noc; ++ichain)
+        {
+            auto& chain = *state.collection->chains[ichain];
+            auto& data  = chains[ichain];
+            int noi = data.images.size();
+
+            chain.Lock();
+
+            // Adjust the number of images, new images are copies of the last one
+            // (the chain's lock includes its images, so new images are locked and removed ones unlocked)
+            while (chain.noi < noi)
+            {
+                auto copy = std::make_shared<Data::Spin_System>(*chain.images.back());
+                copy->Lock();
+                chain.images.push_back(copy);
+                chain.image_type.push_back(Data::GNEB_Image_Type::Normal);
+                state.method_image[ichain].push_back(std::shared_ptr<Engine::Method>());
+                ++chain.noi;
+            }
+            while (chain.noi > noi)
+            {
+                chain.images.back()->Unlock();
+                chain.images.pop_back();
+                chain.image_type.pop_back();
+                state.method_image[ichain].pop_back();
+                --chain.noi;
+            }
+            int n_interpolated = noi + (noi - 1) * chain.gneb_parameters->n_E_interpolations;
+            chain.Rx_interpolated = std::vector<scalar>(n_interpolated, 0);
+            chain.E_interpolated  = std::vector<scalar>(n_interpolated, 0);
+            chain.E_array_interpolated = std::vector<std::vector<scalar>>(7, std::vector<scalar>(n_interpolated, 0));
+
+            chain.idx_active_image = std::min(std::max(0, int(data.idx_active_image)), noi - 1);
+            chain.gneb_parameters->prng = data.prng_gneb;
+            chain.Rx = data.Rx;
+            for (int img = 0; img < noi; ++img)
+                chain.image_type[img] = static_cast<Data::GNEB_Image_Type>(data.image_type[img]);
+
+            for (int img = 0; img < noi; ++img)
+            {
+                auto& image = *chain.images[img];
+                *image.spins = data.images[img].spins;
+                image.llg_parameters->prng = data.images[img].prng_llg;
+                image.mc_parameters->prng  = data.images[img].prng_mc;
+                image.UpdateEnergy();
+            }
+
+            chain.Unlock();
+        }
+        state.collection->idx_active_chain = std::min(std::max(0, int(idx_active_chain)), int(noc) - 1);
+        state.method_checkpoints = methods;
+
+        Log(Log_Level::Info, Log_Sender::IO, fmt::format("Read checkpoint \"{}\" ({} chain(s), {} method(s))",
+            filename, noc, n_methods));
+    }
+
+    void Apply_Method_Checkpoint(State & state, Engine::Method & method, int idx_image, int idx_chain)
+    {
+        auto& checkpoints = state.method_checkpoints;
+        for (auto it = checkpoints.begin(); it != checkpoints.end(); ++it)
+        {
+            if (it->idx_image == idx_image && it->idx_chain == idx_chain &&
+                it->method_name == method.Name() && it->solver_name == method.SolverName())
+            {
+                Binary_Reader reader(it->data.data(), it->data.size());
+                method.Checkpoint_Read(reader);
+                checkpoints.erase(it);
+                Log(Log_Level::Info, Log_Sender::IO, fmt::format("Continuing {} ({} solver) from iteration {} of the checkpoint",
+                    method.Name(), method.SolverName(), method.getNIterations()), idx_image, idx_chain);
+                return;
+            }
+        }
+    }
+}
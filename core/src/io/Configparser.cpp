@@ -547,6 +547,26 @@ namespace IO
         #endif // SPIRIT_ENABLE_PINNING
     }
 
+    // Reads the filter of the spin configuration output of a method, whose keywords start with prefix
+    void Output_Filter_from_Config(IO::Filter_File_Handle & myfile, const std::string & prefix, Data::Output_Filter & filter)
+    {
+        myfile.Read_3Vector(filter.cell_stride,       prefix + "_output_cell_stride",      false);
+        myfile.Read_Vector3(filter.position,          prefix + "_output_region_position",  false);
+        myfile.Read_Vector3(filter.r_cut_rectangular, prefix + "_output_region_box",       false);
+        myfile.Read_Single(filter.r_cut_cylindrical,  prefix + "_output_region_cylinder",  false);
+        myfile.Read_Single(filter.r_cut_spherical,    prefix + "_output_region_sphere",    false);
+        myfile.Read_Single(filter.inverted,           prefix + "_output_region_inverted",  false);
+    }
+
+    void Log_Output_Filter(const Data::Output_Filter & filter)
+    {
+        if (filter.All()) return;
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1} {2} {3}", "output_cell_stride", filter.cell_stride[0], filter.cell_stride[1], filter.cell_stride[2]));
+        if (filter.Region())
+            Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = position ({1}), box ({2}), cylinder {3}, sphere {4}, inverted {5}", "output_region",
+                filter.position.transpose(), filter.r_cut_rectangular.transpose(), filter.r_cut_cylindrical, filter.r_cut_spherical, filter.inverted));
+    }
+
     std::unique_ptr<Data::Parameters_Method_LLG> Parameters_Method_LLG_from_Config(const std::string configFile, const std::shared_ptr<Data::Pinning> pinning)
     {
         //-------------- Insert default values here -----------------------------
@@ -562,7 +582,12 @@ namespace IO
                 output_energy_step=true, 
                 output_energy_archive=true;
         bool output_configuration_step = false, 
-                output_configuration_archive = false;
+                output_configuration_archive = false,
+                output_configuration_trajectory = false;
+        int output_trajectory_encoding = IO_Trajectory_Float32;
+        int output_configuration_filetype = IO_Fileformat_Regular;
+        int output_energy_spin_resolved_filetype = IO_Fileformat_Regular;
+        Data::Output_Filter output_filter;
         // Maximum walltime in seconds
         long int max_walltime = 0;
         std::string str_max_walltime;
@@ -573,6 +598,8 @@ namespace IO
         long int n_iterations = (int)2E+6;
         // Number of iterations after which the system is logged to file
         long int n_iterations_log = 100;
+        // Number of iterations after which a snapshot of the system is published
+        long int n_iterations_snapshot = 10;
         // Temperature in K
         scalar temperature = 0.0;
         // Temperature gradient
@@ -609,15 +636,21 @@ namespace IO
                 myfile.Read_Single(output_initial, "llg_output_initial");
                 myfile.Read_Single(output_final,   "llg_output_final");
                 myfile.Read_Single(output_energy_spin_resolved,    "llg_output_energy_spin_resolved");
+                myfile.Read_Single(output_energy_spin_resolved_filetype, "llg_output_energy_spin_resolved_filetype");
                 myfile.Read_Single(output_energy_step,             "llg_output_energy_step");
                 myfile.Read_Single(output_energy_archive,          "llg_output_energy_archive");
                 myfile.Read_Single(output_energy_divide_by_nspins, "llg_output_energy_divide_by_nspins");
                 myfile.Read_Single(output_configuration_step,    "llg_output_configuration_step");
                 myfile.Read_Single(output_configuration_archive, "llg_output_configuration_archive");
+                myfile.Read_Single(output_configuration_trajectory, "llg_output_configuration_trajectory");
+                myfile.Read_Single(output_trajectory_encoding,      "llg_output_trajectory_encoding");
+                myfile.Read_Single(output_configuration_filetype,   "llg_output_configuration_filetype");
+                Output_Filter_from_Config(myfile, "llg", output_filter);
                 myfile.Read_Single(str_max_walltime, "llg_max_walltime");
                 myfile.Read_Single(seed, "llg_seed");
                 myfile.Read_Single(n_iterations, "llg_n_iterations");
                 myfile.Read_Single(n_iterations_log, "llg_n_iterations_log");
+                myfile.Read_Single(n_iterations_snapshot, "llg_n_iterations_snapshot");
                 myfile.Read_Single(dt, "llg_dt");
                 myfile.Read_Single(temperature, "llg_temperature");
                 myfile.Read_Vector3(temperature_gradient_direction, "llg_temperature_gradient_direction");
@@ -657,6 +690,7 @@ namespace IO
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "maximum walltime", str_max_walltime));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "n_iterations", n_iterations));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "n_iterations_log", n_iterations_log));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "n_iterations_snapshot", n_iterations_snapshot));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "output_folder", output_folder));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "output_any", output_any));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "output_initial", output_initial));
@@ -664,9 +698,14 @@ namespace IO
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_energy_step", output_energy_step));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_energy_archive", output_energy_archive));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_energy_spin_resolved", output_energy_spin_resolved));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_energy_spin_resolved_filetype", output_energy_spin_resolved_filetype));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_energy_divide_by_nspins", output_energy_divide_by_nspins));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_configuration_step", output_configuration_step));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_configuration_archive", output_configuration_archive));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_configuration_trajectory", output_configuration_trajectory));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_trajectory_encoding", output_trajectory_encoding));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_configuration_filetype", output_configuration_filetype));
+        Log_Output_Filter(output_filter);
 
         max_walltime = (long int)Utility::Timing::DurationFromString(str_max_walltime).count();
         auto llg_params = std::unique_ptr<Data::Parameters_Method_LLG>(new Data::Parameters_Method_LLG(
@@ -675,6 +714,12 @@ namespace IO
             force_convergence, n_iterations, n_iterations_log, max_walltime, pinning, seed,
             temperature, temperature_gradient_direction, temperature_gradient_inclination,
             damping, beta, dt, renorm_sd, stt_use_gradient, stt_magnitude, stt_polarisation_normal));
+        llg_params->output_configuration_trajectory = output_configuration_trajectory;
+        llg_params->output_trajectory_encoding = output_trajectory_encoding;
+        llg_params->output_configuration_filetype = output_configuration_filetype;
+        llg_params->output_energy_spin_resolved_filetype = output_energy_spin_resolved_filetype;
+        llg_params->output_filter = output_filter;
+        llg_params->n_iterations_snapshot = n_iterations_snapshot;
         Log(Log_Level::Info, Log_Sender::IO, "Parameters LLG: built");
         return llg_params;
     }// end Parameters_Method_LLG_from_Config
@@ -695,6 +740,7 @@ namespace IO
                 output_energy_archive = true;
         bool output_configuration_step = false,
                 output_configuration_archive = false;
+        Data::Output_Filter output_filter;
         // Maximum walltime in seconds
         long int max_walltime = 0;
         std::string str_max_walltime;
@@ -705,6 +751,8 @@ namespace IO
         int n_iterations = (int)2E+6;
         // Number of iterations after which the system is logged to file
         int n_iterations_log = 100;
+        // Number of iterations after which a snapshot of the system is published
+        int n_iterations_snapshot = 10;
         // Temperature in K
         scalar temperature = 0.0;
         // Acceptance ratio
@@ -730,10 +778,12 @@ namespace IO
                 myfile.Read_Single(output_energy_divide_by_nspins, "mc_output_energy_divide_by_nspins");
                 myfile.Read_Single(output_configuration_step, "mc_output_configuration_step");
                 myfile.Read_Single(output_configuration_archive, "mc_output_configuration_archive");
+                Output_Filter_from_Config(myfile, "mc", output_filter);
                 myfile.Read_Single(str_max_walltime, "mc_max_walltime");
                 myfile.Read_Single(seed, "mc_seed");
                 myfile.Read_Single(n_iterations, "mc_n_iterations");
                 myfile.Read_Single(n_iterations_log, "mc_n_iterations_log");
+                myfile.Read_Single(n_iterations_snapshot, "mc_n_iterations_snapshot");
                 myfile.Read_Single(temperature, "mc_temperature");
                 myfile.Read_Single(acceptance_ratio, "mc_acceptance_ratio");
             }// end try
@@ -752,6 +802,7 @@ namespace IO
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "maximum walltime", str_max_walltime));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "n_iterations", n_iterations));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "n_iterations_log", n_iterations_log));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "n_iterations_snapshot", n_iterations_snapshot));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "output_folder", output_folder));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "output_any", output_any));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "output_initial", output_initial));
@@ -762,9 +813,12 @@ namespace IO
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_energy_divide_by_nspins", output_energy_divide_by_nspins));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_configuration_step", output_configuration_step));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_configuration_archive", output_configuration_archive));
+        Log_Output_Filter(output_filter);
         max_walltime = (long int)Utility::Timing::DurationFromString(str_max_walltime).count();
         auto mc_params = std::unique_ptr<Data::Parameters_Method_MC>(new Data::Parameters_Method_MC(output_folder, output_file_tag, { output_any, output_initial, output_final, output_energy_step, output_energy_archive, output_energy_spin_resolved,
             output_energy_divide_by_nspins, output_configuration_step, output_configuration_archive }, n_iterations, n_iterations_log, max_walltime, pinning, seed, temperature, acceptance_ratio));
+        mc_params->output_filter = output_filter;
+        mc_params->n_iterations_snapshot = n_iterations_snapshot;
         Log(Log_Level::Info, Log_Sender::IO, "Parameters MC: built");
         return mc_params;
     }
@@ -783,6 +837,8 @@ namespace IO
                 output_energies_interpolated = true, 
                 output_energies_divide_by_nspins = true, 
                 output_chain_step = false;
+        int output_chain_filetype = IO_Fileformat_Regular;
+        Data::Output_Filter output_filter;
         // Maximum walltime in seconds
         long int max_walltime = 0;
         std::string str_max_walltime;
@@ -794,6 +850,8 @@ namespace IO
         int n_iterations = (int)2E+6;
         // Number of iterations after which the system is logged to file
         int n_iterations_log = 100;
+        // Number of iterations after which a snapshot of the system is published
+        int n_iterations_snapshot = 10;
         // Number of Energy Interpolation points
         int n_E_interpolations = 10;
         //------------------------------- Parser --------------------------------
@@ -813,11 +871,14 @@ namespace IO
                 myfile.Read_Single(output_energies_interpolated, "gneb_output_energies_interpolated");
                 myfile.Read_Single(output_energies_divide_by_nspins, "gneb_output_energies_divide_by_nspins");
                 myfile.Read_Single(output_chain_step, "gneb_output_chain_step");
+                myfile.Read_Single(output_chain_filetype, "gneb_output_chain_filetype");
+                Output_Filter_from_Config(myfile, "gneb", output_filter);
                 myfile.Read_Single(str_max_walltime, "gneb_max_walltime");
                 myfile.Read_Single(spring_constant, "gneb_spring_constant");
                 myfile.Read_Single(force_convergence, "gneb_force_convergence");
                 myfile.Read_Single(n_iterations, "gneb_n_iterations");
                 myfile.Read_Single(n_iterations_log, "gneb_n_iterations_log");
+                myfile.Read_Single(n_iterations_snapshot, "gneb_n_iterations_snapshot");
                 myfile.Read_Single(n_E_interpolations, "gneb_n_energy_interpolations");
             }// end try
             catch (...)
@@ -835,16 +896,22 @@ namespace IO
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "maximum walltime", str_max_walltime));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "n_iterations", n_iterations));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "n_iterations_log", n_iterations_log));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "n_iterations_snapshot", n_iterations_snapshot));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "output_folder", output_folder));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "output_any", output_any));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "output_initial", output_initial));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "output_final", output_final));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "output_energies_step", output_energies_step));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "output_chain_step", output_chain_step));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<18} = {1}", "output_chain_filetype", output_chain_filetype));
+        Log_Output_Filter(output_filter);
 
         max_walltime = (long int)Utility::Timing::DurationFromString(str_max_walltime).count();
         auto gneb_params = std::unique_ptr<Data::Parameters_Method_GNEB>(new Data::Parameters_Method_GNEB(output_folder, output_file_tag, { output_any, output_initial, output_final, output_energies_step, output_energies_interpolated, output_energies_divide_by_nspins, output_chain_step },
             force_convergence, n_iterations, n_iterations_log, max_walltime, pinning, spring_constant, n_E_interpolations));
+        gneb_params->output_configuration_filetype = output_chain_filetype;
+        gneb_params->output_filter = output_filter;
+        gneb_params->n_iterations_snapshot = n_iterations_snapshot;
         Log(Log_Level::Info, Log_Sender::IO, "Parameters GNEB: built");
         return gneb_params;
     }// end Parameters_Method_LLG_from_Config
@@ -864,6 +931,8 @@ namespace IO
                 output_energy_divide_by_nspins = true, 
                 output_configuration_step = false, 
                 output_configuration_archive = true;
+        int output_configuration_filetype = IO_Fileformat_Regular;
+        Data::Output_Filter output_filter;
         // Maximum walltime in seconds
         long int max_walltime = 0;
         std::string str_max_walltime;
@@ -873,6 +942,8 @@ namespace IO
         int n_iterations = (int)2E+6;
         // Number of iterations after which the system is logged to file
         int n_iterations_log = 100;
+        // Number of iterations after which a snapshot of the system is published
+        int n_iterations_snapshot = 10;
         
         //------------------------------- Parser --------------------------------
         Log(Log_Level::Info, Log_Sender::IO, "Parameters MMF: building");
@@ -892,10 +963,13 @@ namespace IO
                 myfile.Read_Single(output_energy_divide_by_nspins, "mmf_output_energy_divide_by_nspins");
                 myfile.Read_Single(output_configuration_step, "mmf_output_configuration_step");
                 myfile.Read_Single(output_configuration_archive, "mmf_output_configuration_archive");
+                myfile.Read_Single(output_configuration_filetype, "mmf_output_configuration_filetype");
+                Output_Filter_from_Config(myfile, "mmf", output_filter);
                 myfile.Read_Single(str_max_walltime, "mmf_max_walltime");
                 myfile.Read_Single(force_convergence, "mmf_force_convergence");
                 myfile.Read_Single(n_iterations, "mmf_n_iterations");
                 myfile.Read_Single(n_iterations_log, "mmf_n_iterations_log");
+                myfile.Read_Single(n_iterations_snapshot, "mmf_n_iterations_snapshot");
             }// end try
             catch (...)
             {
@@ -910,6 +984,7 @@ namespace IO
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "maximum walltime", str_max_walltime));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "n_iterations", n_iterations));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "n_iterations_log", n_iterations_log));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "n_iterations_snapshot", n_iterations_snapshot));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "output_folder", output_folder));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "output_any", output_any));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<17} = {1}", "output_initial", output_initial));
@@ -919,9 +994,14 @@ namespace IO
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_energy_divide_by_nspins", output_energy_divide_by_nspins));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_configuration_step", output_configuration_step));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_configuration_archive", output_configuration_archive));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<30} = {1}", "output_configuration_filetype", output_configuration_filetype));
+        Log_Output_Filter(output_filter);
         max_walltime = (long int)Utility::Timing::DurationFromString(str_max_walltime).count();
         auto mmf_params = std::unique_ptr<Data::Parameters_Method_MMF>(new Data::Parameters_Method_MMF(output_folder, output_file_tag, {output_any, output_initial, output_final, output_energy_step, output_energy_archive, output_energy_divide_by_nspins, output_configuration_step,output_configuration_archive },
             force_convergence, n_iterations, n_iterations_log, max_walltime, pinning));
+        mmf_params->output_configuration_filetype = output_configuration_filetype;
+        mmf_params->output_filter = output_filter;
+        mmf_params->n_iterations_snapshot = n_iterations_snapshot;
         Log(Log_Level::Info, Log_Sender::IO, "Parameters MMF: built");
         return mmf_params;
     }
@@ -1019,6 +1099,7 @@ namespace IO
         int dm_chirality = 1;
         // Dipole-Dipole interaction radius
         scalar dd_radius = 0.0;
+        auto ddi_method = Engine::DDI_Method::Cutoff;
 
         //------------------------------- Parser --------------------------------
         Log(Log_Level::Info, Log_Sender::IO, "Hamiltonian_Heisenberg_Neighbours: building");
@@ -1182,6 +1263,14 @@ namespace IO
                 IO::Filter_File_Handle myfile(configFile);
 
                 myfile.Read_Single(dd_radius, "dd_radius");
+
+                // Summation method of the DDI
+                std::string ddi_method_str = "cutoff";
+                myfile.Read_Single(ddi_method_str, "ddi_method", false);
+                if (ddi_method_str == "ewald")
+                    ddi_method = Engine::DDI_Method::Ewald;
+                else if (ddi_method_str != "cutoff")
+                    Log(Log_Level::Warning, Log_Sender::IO, fmt::format("Unknown ddi_method \"{}\", using cutoff", ddi_method_str));
             }// end try
             catch( ... )
             {
@@ -1208,12 +1297,13 @@ namespace IO
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<19} = {1}", "D_ij[0]", dij[0]));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<19} = {1}", "DM chirality", dm_chirality));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<19} = {1}", "dd_radius", dd_radius));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<19} = {1}", "ddi_method", ddi_method == Engine::DDI_Method::Ewald ? "ewald" : "cutoff"));
         auto hamiltonian = std::unique_ptr<Engine::Hamiltonian_Heisenberg_Neighbours>(new Engine::Hamiltonian_Heisenberg_Neighbours(
                 mu_s, B, B_normal,
                 anisotropy_index, anisotropy_magnitude, anisotropy_normal,
                 jij,
                 dij, dm_chirality,
-                dd_radius,
+                dd_radius, ddi_method,
                 geometry,
                 boundary_conditions
             ));
@@ -1253,6 +1343,7 @@ namespace IO
         pairfield exchange_pairs(0); scalarfield exchange_magnitudes(0);
         pairfield dmi_pairs(0); scalarfield dmi_magnitudes(0); vectorfield dmi_normals(0);
         scalar ddi_radius = 0.0;
+        auto ddi_method = Engine::DDI_Method::Cutoff;
 
         // ------------ Triplet Interactions ------------
         int n_triplets = 0;
@@ -1268,6 +1359,9 @@ namespace IO
         bool quadruplets_from_file = false;
         quadrupletfield quadruplets(0); scalarfield quadruplet_magnitudes(0);
 
+        // Folder for binary caches of the interactions read from files (none if empty)
+        std::string interactions_cache_folder = "";
+
         //------------------------------- Parser --------------------------------
         Log(Log_Level::Info, Log_Sender::IO, "Hamiltonian_Heisenberg_Pairs: building");
         // iteration variables
@@ -1393,6 +1487,8 @@ namespace IO
             {
                 IO::Filter_File_Handle myfile(configFile);
 
+                myfile.Read_Single(interactions_cache_folder, "interactions_cache_folder", false);
+
                 // Interaction Pairs
                 if (myfile.Find("n_interaction_pairs"))
                     interaction_pairs_file = configFile;
@@ -1404,7 +1500,7 @@ namespace IO
                     // The file name should be valid so we try to read it
                     Pairs_from_File(interaction_pairs_file, geometry, n_pairs,
                         exchange_pairs, exchange_magnitudes,
-                        dmi_pairs, dmi_magnitudes, dmi_normals);
+                        dmi_pairs, dmi_magnitudes, dmi_normals, interactions_cache_folder);
                 }
                 //else
                 //{
@@ -1425,6 +1521,14 @@ namespace IO
                 //		Dipole-Dipole Pairs
                 // Dipole Dipole radius
                 myfile.Read_Single(ddi_radius, "dd_radius");
+
+                // Summation method of the DDI
+                std::string ddi_method_str = "cutoff";
+                myfile.Read_Single(ddi_method_str, "ddi_method", false);
+                if (ddi_method_str == "ewald")
+                    ddi_method = Engine::DDI_Method::Ewald;
+                else if (ddi_method_str != "cutoff")
+                    Log(Log_Level::Warning, Log_Sender::IO, fmt::format("Unknown ddi_method \"{}\", using cutoff", ddi_method_str));
             }// end try
             catch( ... )
             {
@@ -1445,7 +1549,7 @@ namespace IO
                 {
                     // The file name should be valid so we try to read it
                     Triplets_from_File(triplets_file, geometry, n_triplets,
-                        triplets, triplet_magnitudes1, triplet_magnitudes2);
+                        triplets, triplet_magnitudes1, triplet_magnitudes2, interactions_cache_folder);
                 }
 
             }
@@ -1468,7 +1572,7 @@ namespace IO
                 {
                     // The file name should be valid so we try to read it
                     Quadruplets_from_File(quadruplets_file, geometry, n_quadruplets,
-                        quadruplets, quadruplet_magnitudes);
+                        quadruplets, quadruplet_magnitudes, interactions_cache_folder);
                 }
 
             }// end try
@@ -1490,13 +1594,16 @@ namespace IO
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<19} = {1}", "K[0]", K));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<19} = {1}", "K_normal[0]", K_normal.transpose()));
         Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<19} = {1}", "dd_radius", ddi_radius));
+        Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<19} = {1}", "ddi_method", ddi_method == Engine::DDI_Method::Ewald ? "ewald" : "cutoff"));
+        if (interactions_cache_folder != "")
+            Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("        {0:<19} = {1}", "interactions cache", interactions_cache_folder));
         auto hamiltonian = std::unique_ptr<Engine::Hamiltonian_Heisenberg_Pairs>(new Engine::Hamiltonian_Heisenberg_Pairs(
             mu_s,
             B, B_normal,
             anisotropy_index, anisotropy_magnitude, anisotropy_normal,
             exchange_pairs, exchange_magnitudes,
             dmi_pairs, dmi_magnitudes, dmi_normals,
-            ddi_radius,
+            ddi_radius, ddi_method,
             triplets, triplet_magnitudes1, triplet_magnitudes2,
             quadruplets, quadruplet_magnitudes,
             geometry,
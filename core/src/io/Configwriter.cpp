@@ -92,6 +92,23 @@ namespace IO
     }// end Geometry_to_Config
 
 
+    // Filter of the spin configuration output of a method, whose keywords start with prefix
+    std::string Output_Filter_to_Config(const std::string & prefix, const Data::Output_Filter & filter, int width)
+    {
+        std::string config = "";
+        if (filter.All()) return config;
+        config += fmt::format("{:<{}} {} {} {}\n", prefix + "_output_cell_stride", width, filter.cell_stride[0], filter.cell_stride[1], filter.cell_stride[2]);
+        if (filter.Region())
+        {
+            config += fmt::format("{:<{}} {}\n", prefix + "_output_region_position", width, filter.position.transpose());
+            config += fmt::format("{:<{}} {}\n", prefix + "_output_region_box",      width, filter.r_cut_rectangular.transpose());
+            config += fmt::format("{:<{}} {}\n", prefix + "_output_region_cylinder", width, filter.r_cut_cylindrical);
+            config += fmt::format("{:<{}} {}\n", prefix + "_output_region_sphere",   width, filter.r_cut_spherical);
+            config += fmt::format("{:<{}} {:d}\n", prefix + "_output_region_inverted", width, filter.inverted);
+        }
+        return config;
+    }
+
     void Parameters_Method_LLG_to_Config(const std::string configFile, const std::shared_ptr<Data::Parameters_Method_LLG> parameters)
     {
         std::string config = "";
@@ -102,12 +119,18 @@ namespace IO
         config += fmt::format("{:<35} {:d}\n", "llg_output_energy_step",              parameters->output_energy_step);
         config += fmt::format("{:<35} {:d}\n", "llg_output_energy_archive",           parameters->output_energy_archive);
         config += fmt::format("{:<35} {:d}\n", "llg_output_energy_spin_resolved",     parameters->output_energy_spin_resolved);
+        config += fmt::format("{:<35} {}\n",   "llg_output_energy_spin_resolved_filetype", parameters->output_energy_spin_resolved_filetype);
         config += fmt::format("{:<35} {:d}\n", "llg_output_energy_divide_by_nspins",  parameters->output_energy_divide_by_nspins);
         config += fmt::format("{:<35} {:d}\n", "llg_output_configuration_step",       parameters->output_configuration_step);
         config += fmt::format("{:<35} {:d}\n", "llg_output_configuration_archive",    parameters->output_configuration_archive);
+        config += fmt::format("{:<35} {:d}\n", "llg_output_configuration_trajectory", parameters->output_configuration_trajectory);
+        config += fmt::format("{:<35} {}\n",   "llg_output_trajectory_encoding",      parameters->output_trajectory_encoding);
+        config += fmt::format("{:<35} {}\n",   "llg_output_configuration_filetype",   parameters->output_configuration_filetype);
+        config += Output_Filter_to_Config("llg", parameters->output_filter, 35);
         config += fmt::format("{:<35} {:e}\n", "llg_force_convergence",               parameters->force_convergence);
         config += fmt::format("{:<35} {}\n",   "llg_n_iterations",                    parameters->n_iterations);
         config += fmt::format("{:<35} {}\n",   "llg_n_iterations_log",                parameters->n_iterations_log);
+        config += fmt::format("{:<35} {}\n",   "llg_n_iterations_snapshot",           parameters->n_iterations_snapshot);
         config += fmt::format("{:<35} {}\n",   "llg_seed",                            parameters->rng_seed);
         config += fmt::format("{:<35} {}\n",   "llg_temperature",                     parameters->temperature);
         config += fmt::format("{:<35} {}\n",   "llg_damping",                         parameters->damping);
@@ -131,8 +154,10 @@ namespace IO
         config += fmt::format("{:<35} {:d}\n", "mc_output_energy_divide_by_nspins",  parameters->output_energy_divide_by_nspins);
         config += fmt::format("{:<35} {:d}\n", "mc_output_configuration_step",       parameters->output_configuration_step);
         config += fmt::format("{:<35} {:d}\n", "mc_output_configuration_archive",    parameters->output_configuration_archive);
+        config += Output_Filter_to_Config("mc", parameters->output_filter, 35);
         config += fmt::format("{:<35} {}\n",   "mc_n_iterations",                    parameters->n_iterations);
         config += fmt::format("{:<35} {}\n",   "mc_n_iterations_log",                parameters->n_iterations_log);
+        config += fmt::format("{:<35} {}\n",   "mc_n_iterations_snapshot",           parameters->n_iterations_snapshot);
         config += fmt::format("{:<35} {}\n",   "mc_seed",                            parameters->rng_seed);
         config += fmt::format("{:<35} {}\n",   "mc_temperature",                     parameters->temperature);
         config += fmt::format("{:<35} {}\n",   "mc_acceptance_ratio",                parameters->acceptance_ratio_target);
@@ -151,9 +176,12 @@ namespace IO
         config += fmt::format("{:<38} {:d}\n", "gneb_output_energies_interpolated",     parameters->output_energies_interpolated);
         config += fmt::format("{:<38} {:d}\n", "gneb_output_energies_divide_by_nspins", parameters->output_energies_divide_by_nspins);
         config += fmt::format("{:<38} {:d}\n", "gneb_output_chain_step",                parameters->output_chain_step);
+        config += fmt::format("{:<38} {}\n",   "gneb_output_chain_filetype",            parameters->output_configuration_filetype);
+        config += Output_Filter_to_Config("gneb", parameters->output_filter, 38);
         config += fmt::format("{:<38} {:e}\n", "gneb_force_convergence",                parameters->force_convergence);
         config += fmt::format("{:<38} {}\n",   "gneb_n_iterations",                     parameters->n_iterations);
         config += fmt::format("{:<38} {}\n",   "gneb_n_iterations_log",                 parameters->n_iterations_log);
+        config += fmt::format("{:<38} {}\n",   "gneb_n_iterations_snapshot",            parameters->n_iterations_snapshot);
         config += fmt::format("{:<38} {}\n",   "gneb_spring_constant",                  parameters->spring_constant);
         config += fmt::format("{:<38} {}\n",   "gneb_n_energy_interpolations",          parameters->n_E_interpolations);
         config += "############### End GNEB Parameters ##############";
@@ -172,9 +200,12 @@ namespace IO
         config += fmt::format("{:<38} {:d}\n", "mmf_output_energy_divide_by_nspins", parameters->output_energy_divide_by_nspins);
         config += fmt::format("{:<38} {:d}\n", "mmf_output_configuration_step",      parameters->output_configuration_step);
         config += fmt::format("{:<38} {:d}\n", "mmf_output_configuration_archive",   parameters->output_configuration_archive);
+        config += fmt::format("{:<38} {}\n",   "mmf_output_configuration_filetype",  parameters->output_configuration_filetype);
+        config += Output_Filter_to_Config("mmf", parameters->output_filter, 38);
         config += fmt::format("{:<38} {:e}\n", "mmf_force_convergence",              parameters->force_convergence);
         config += fmt::format("{:<38} {}\n",   "mmf_n_iterations",                   parameters->n_iterations);
         config += fmt::format("{:<38} {}\n",   "mmf_n_iterations_log",               parameters->n_iterations_log);
+        config += fmt::format("{:<38} {}\n",   "mmf_n_iterations_snapshot",          parameters->n_iterations_snapshot);
         config += "############### End MMF Parameters ###############";
         Append_String_to_File(config, configFile);
     }// end Parameters_Method_MMF_to_Config
@@ -221,6 +252,7 @@ namespace IO
         config += "\n";
         config += "\n";
         config += fmt::format("{:<25} {}\n", "dd_radius", ham->ddi_radius);
+        config += fmt::format("{:<25} {}\n", "ddi_method", ham->ddi_method == Engine::DDI_Method::Ewald ? "ewald" : "cutoff");
         Append_String_to_File(config, configFile);
     }// end Hamiltonian_Heisenberg_Neighbours_to_Config
 
@@ -277,6 +309,11 @@ namespace IO
             }
         }
 
+        // Dipole-dipole interaction
+        config += "###    Dipole-dipole interaction:\n";
+        config += fmt::format("{:<25} {}\n", "dd_radius", ham->ddi_radius);
+        config += fmt::format("{:<25} {}\n", "ddi_method", ham->ddi_method == Engine::DDI_Method::Ewald ? "ewald" : "cutoff");
+
         // Triplets
             // has to be done
 
@@ -1,10 +1,18 @@
 #include <io/IO.hpp>
 #include <io/Filter_File_Handle.hpp>
 #include <io/Dataparser.hpp>
+#include <io/OVF_File.hpp>
+#include <io/Checkpoint.hpp>
+#include <io/Mapped_File.hpp>
+#include <engine/Decomposition.hpp>
 #include <engine/Vectormath.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Exception.hpp>
 
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <fstream>
 #include <thread>
@@ -75,7 +83,7 @@ namespace IO
     Reads a configuration file into an existing Spin_System
     */
     void Read_Spin_Configuration( std::shared_ptr<Data::Spin_System> s, const std::string file, 
-                                  VF_FileFormat format )
+                                  VF_FileFormat format, int idx_image_infile )
     {
         std::ifstream myfile(file);
         if (myfile.is_open())
@@ -128,14 +136,12 @@ namespace IO
             
                 if (i < s->nos) { Log(Log_Level::Warning, Log_Sender::IO, "NOS mismatch in Read Spin Configuration"); }
             }
-            else if ( format == VF_FileFormat::OVF_BIN8 || 
-                      format == VF_FileFormat::OVF_BIN4 || 
-                      format == VF_FileFormat::OVF_TEXT )
+            else if ( Is_OVF_Format( format ) )
             {
                 auto& spins = *s->spins;
                 auto& geometry = *s->geometry;
 
-                Read_From_OVF( spins, geometry, file, format );
+                Read_From_OVF( spins, geometry, file, format, idx_image_infile );
             }
             else
             {
@@ -194,6 +200,18 @@ namespace IO
         std::ifstream myfile(file);
         if (myfile.is_open())
         {
+            // OVF files contain one segment per image
+            std::string first_line;
+            std::getline(myfile, first_line);
+            std::transform(first_line.begin(), first_line.end(), first_line.begin(), ::tolower);
+            if (first_line.find("# oommf ovf") == 0)
+            {
+                myfile.close();
+                Read_SpinChain_From_OVF(c, file);
+                return;
+            }
+            myfile.seekg(0);
+
             Log(Log_Level::Info, Log_Sender::IO, std::string("Reading SpinChain File ").append(file));
             std::string line = "";
             std::istringstream iss(line);
@@ -308,6 +326,43 @@ namespace IO
 
 
 
+    void Read_SpinChain_From_OVF(std::shared_ptr<Data::Spin_System_Chain> c, const std::string file)
+    {
+        try
+        {
+            Log(Log_Level::Info, Log_Sender::IO, std::string("Reading SpinChain OVF File ").append(file));
+            OVF_File ovf(file);
+            int noi = ovf.n_segments();
+
+            for (int img = 0; img < noi; ++img)
+            {
+                if (img >= c->noi)
+                {
+                    Log(Log_Level::Warning, Log_Sender::IO, fmt::format("NOI(file) = {} > NOI(chain) = {}. Appending image {}", noi, c->noi, img+1));
+                    // Copy Image
+                    auto new_system = std::make_shared<Data::Spin_System>(Data::Spin_System(*c->images[img-1]));
+                    new_system->Lock();
+                    // Add to chain
+                    c->noi++;
+                    c->images.push_back(new_system);
+                    c->image_type.push_back(Data::GNEB_Image_Type::Normal);
+                }
+
+                auto& image = *c->images[img];
+                ovf.Read_Segment(*image.spins, *image.geometry, img);
+                Vectormath::normalize_vectors(*image.spins);
+            }
+
+            if (noi < c->noi) Log(Log_Level::Warning, Log_Sender::IO, fmt::format("NOI(chain) = {} > NOI(file) = {}", c->noi, noi));
+            Log(Log_Level::Info, Log_Sender::IO, std::string("Done Reading SpinChain OVF File ").append(file));
+        }
+        catch (...)
+        {
+            spirit_rethrow(fmt::format("Failed to read OVF file \"{}\".", file));
+        }
+    }
+
+
     /*
     Read from Anisotropy file
     */
@@ -330,7 +385,7 @@ namespace IO
             if (file.Find("n_anisotropy"))
             {
                 // Read n interaction pairs
-                file.iss >> n_anisotropy;
+                file.tokens >> n_anisotropy;
                 Log(Log_Level::Debug, Log_Sender::IO, fmt::format("Anisotropy file {} should have {} vectors", anisotropyFile, n_anisotropy));
             }
             else
@@ -346,7 +401,7 @@ namespace IO
             file.GetLine(); // first line contains the columns
             for (unsigned int i = 0; i < columns.size(); ++i)
             {
-                file.iss >> columns[i];
+                file.tokens >> columns[i];
                 if (!columns[i].compare(0, 1, "i"))    col_i = i;
                 else if (!columns[i].compare(0, 2, "K")) { col_K = i;    K_magnitude = true; }
                 else if (!columns[i].compare(0, 2, "Kx"))    col_Kx = i;
@@ -379,23 +434,23 @@ namespace IO
                 for (unsigned int i = 0; i < columns.size(); ++i)
                 {
                     if (i == col_i)
-                        file.iss >> spin_i;
+                        file.tokens >> spin_i;
                     else if (i == col_K)
-                        file.iss >> spin_K;
+                        file.tokens >> spin_K;
                     else if (i == col_Kx && K_xyz)
-                        file.iss >> spin_K1;
+                        file.tokens >> spin_K1;
                     else if (i == col_Ky && K_xyz)
-                        file.iss >> spin_K2;
+                        file.tokens >> spin_K2;
                     else if (i == col_Kz && K_xyz)
-                        file.iss >> spin_K3;
+                        file.tokens >> spin_K3;
                     else if (i == col_Ka && K_abc)
-                        file.iss >> spin_K1;
+                        file.tokens >> spin_K1;
                     else if (i == col_Kb && K_abc)
-                        file.iss >> spin_K2;
+                        file.tokens >> spin_K2;
                     else if (i == col_Kc && K_abc)
-                        file.iss >> spin_K3;
+                        file.tokens >> spin_K3;
                     else
-                        file.iss >> sdump;
+                        file.tokens >> sdump;
                 }
                 K_temp = { spin_K1, spin_K2, spin_K3 };
                 // K_temp.normalize();
@@ -433,156 +488,312 @@ namespace IO
     }
 
     /*
-    Read from Pairs file by Markus & Bernd
+    Bulk reading of interaction tables
     */
-    void Pairs_from_File(const std::string pairsFile, const std::shared_ptr<Data::Geometry> geometry, int & nop,
-        pairfield & exchange_pairs, scalarfield & exchange_magnitudes,
-        pairfield & dmi_pairs, scalarfield & dmi_magnitudes, vectorfield & dmi_normals)
+
+    // Finds an interaction table: the first line after the keyword with the number of rows (or
+    // the top of the file) contains the column names, the rows follow
+    void Find_Interaction_Table(Filter_File_Handle & file, const std::string & keyword, const std::string & name,
+        std::vector<std::string> & columns, std::size_t & begin, std::size_t & n_rows)
     {
-        Log(Log_Level::Info, Log_Sender::IO, fmt::format("Reading spin pairs from file \"{}\"", pairsFile));
-        try
+        long n = -1;
+        if (file.Find(keyword))
         {
-            std::vector<std::string> columns(20);    // at least: 2 (indices) + 3 (J) + 3 (DMI)
-            // column indices of pair indices and interactions
-            int n_pairs = 0;
-            int col_i = -1, col_j = -1, col_da = -1, col_db = -1, col_dc = -1,
-                col_J = -1, col_DMIx = -1, col_DMIy = -1, col_DMIz = -1,
-                col_Dij = -1, col_DMIa = -1, col_DMIb = -1, col_DMIc = -1;
-            bool J = false, DMI_xyz = false, DMI_abc = false, Dij = false;
-            int pair_periodicity = 0;
-            Vector3 pair_D_temp = { 0, 0, 0 };
-            // Get column indices
-            Filter_File_Handle file(pairsFile);
+            file.tokens >> n;
+            Log(Log_Level::Debug, Log_Sender::IO, fmt::format("File {} should have {} {}", file.filename, n, name));
+        }
+        else
+        {
+            // First line should contain the columns, then read the whole file
+            file.ResetStream();
+            Log(Log_Level::Info, Log_Sender::IO, fmt::format("Trying to parse {} columns from top of file {}", name, file.filename));
+        }
 
-            if (file.Find("n_interaction_pairs"))
-            {
-                // Read n interaction pairs
-                file.iss >> n_pairs;
-                Log(Log_Level::Parameter, Log_Sender::IO, fmt::format("File {} should have {} pairs", pairsFile, n_pairs));
-            }
-            else
+        // At most 20 columns are considered
+        file.GetLine();
+        columns.clear();
+        std::string column;
+        while (columns.size() < 20 && file.tokens >> column)
+            columns.push_back(column);
+
+        begin = file.Next_Line();
+        n_rows = file.Lines().size() - begin;
+        if (n >= 0 && std::size_t(n) < n_rows)
+            n_rows = n;
+    }
+
+    // Parses the rows of an interaction table in parallel. The value of column col is stored at
+    // position slot_of_column[col] of the row, columns with a slot of -1 are skipped. Values
+    // which cannot be read (e.g. in empty lines) are zero.
+    std::vector<double> Parse_Interaction_Table(const std::vector<std::string> & lines, std::size_t begin,
+        std::size_t n_rows, const std::vector<int> & slot_of_column, int n_slots)
+    {
+        std::vector<double> values(n_rows * n_slots, 0);
+        #pragma omp parallel for
+        for (long row = 0; row < long(n_rows); ++row)
+        {
+            Line_Tokenizer tokens;
+            tokens.Set(lines[begin + row].c_str());
+            double * row_values = &values[row * n_slots];
+            double value = 0;
+            std::string dump;
+            for (std::size_t col = 0; col < slot_of_column.size(); ++col)
             {
-                // Read the whole file
-                n_pairs = (int)1e8;
-                // First line should contain the columns
-                file.ResetStream();
-                Log(Log_Level::Info, Log_Sender::IO, "Trying to parse spin pairs columns from top of file " + pairsFile);
+                if (slot_of_column[col] >= 0)
+                {
+                    if (!(tokens >> value)) break;
+                    row_values[slot_of_column[col]] = value;
+                }
+                else if (!(tokens >> dump)) break;
             }
+        }
+        return values;
+    }
 
-            file.GetLine(); 
-            for (unsigned int i = 0; i < columns.size(); ++i)
+    // Name of the binary cache file for interactions read from a file. It contains a hash of the
+    // file contents and of everything else the interactions depend on (extra), so that a cache
+    // file is only reused for the same input. Empty if no cache folder is given.
+    std::string Interaction_Cache_File(const std::string & cache_folder, const std::string & kind,
+        const std::string & filename, const std::string & extra)
+    {
+        if (cache_folder == "")
+            return "";
+
+        // 64 bit FNV-1a
+        std::uint64_t hash = 14695981039346656037ULL;
+        auto add = [&hash](const char * data, std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
             {
-                file.iss >> columns[i];
-                if      (columns[i] == "i")    col_i = i;
-                else if (columns[i] == "j")    col_j = i;
-                else if (columns[i] == "da")   col_da = i;
-                else if (columns[i] == "db")   col_db = i;
-                else if (columns[i] == "dc")   col_dc = i;
-                else if (columns[i] == "jij")  { col_J = i;    J = true; }
-                else if (columns[i] == "dij")  { col_Dij = i;    Dij = true; }
-                else if (columns[i] == "dijx") col_DMIx = i;
-                else if (columns[i] == "dijy") col_DMIy = i;
-                else if (columns[i] == "dijz") col_DMIz = i;
-                else if (columns[i] == "dija") col_DMIx = i;
-                else if (columns[i] == "dijb") col_DMIy = i;
-                else if (columns[i] == "dijc") col_DMIz = i;
-
-                if (col_DMIx >= 0 && col_DMIy >= 0 && col_DMIz >= 0) DMI_xyz = true;
-                if (col_DMIa >= 0 && col_DMIb >= 0 && col_DMIc >= 0) DMI_abc = true;
+                hash ^= (unsigned char)data[i];
+                hash *= 1099511628211ULL;
             }
+        };
+        Mapped_File file(filename);
+        add(file.data(), file.size());
+        add(kind.data(), kind.size());
+        add(extra.data(), extra.size());
+        std::uint32_t scalar_size = sizeof(scalar);
+        add(reinterpret_cast<const char *>(&scalar_size), sizeof(scalar_size));
+
+        return fmt::format("{}/{}_{:016x}.bin", cache_folder, kind, hash);
+    }
 
-            // Check if interactions have been found in header
-            if (!J && !DMI_xyz && !DMI_abc) Log(Log_Level::Warning, Log_Sender::IO, "No interactions could be found in pairs file " + pairsFile);
+    const char interaction_cache_magic[8] = { 'S', 'P', 'I', 'R', 'I', 'T', 'I', 'C' };
 
-            // Pair Indices
-            int pair_i = 0, pair_j = 0, pair_da = 0, pair_db = 0, pair_dc = 0;
-            scalar pair_Jij = 0, pair_Dij = 0, pair_D1 = 0, pair_D2 = 0, pair_D3 = 0;
+    // Reads interactions from a cache file, returns false if there is no valid cache file
+    bool Read_Interaction_Cache(const std::string & cache_file, const std::function<void(Binary_Reader &)> & read)
+    {
+        if (cache_file == "" || !std::ifstream(cache_file).good())
+            return false;
+        try
+        {
+            Mapped_File file(cache_file);
+            Binary_Reader reader(file.data(), file.size());
+            char magic[8];
+            for (auto& c : magic)
+                reader.Read(c);
+            if (std::memcmp(magic, interaction_cache_magic, sizeof(magic)) != 0)
+                return false;
+            read(reader);
+            if (!reader.At_End())
+                return false;
+            Log(Log_Level::Info, Log_Sender::IO, fmt::format("Read interactions from cache file \"{}\"", cache_file));
+            return true;
+        }
+        catch( ... )
+        {
+            Log(Log_Level::Warning, Log_Sender::IO, fmt::format("Ignoring invalid cache file \"{}\"", cache_file));
+            return false;
+        }
+    }
 
-            // Get actual Pairs Data
-            int i_pair = 0;
-            std::string sdump;
-            while (file.GetLine() && i_pair < n_pairs)
+    // Writes interactions to a cache file, failing to do so is not an error
+    void Write_Interaction_Cache(const std::string & cache_file, const std::function<void(Binary_Writer &)> & write)
+    {
+        // With MPI, all ranks hold the same data and only rank 0 writes
+        if (cache_file == "" || Engine::Decomposition::Rank() != 0)
+            return;
+
+        Binary_Writer writer;
+        for (auto c : interaction_cache_magic)
+            writer.Write(c);
+        write(writer);
+
+        // Write to a temporary file first, so that an incomplete cache file is never read
+        std::string tmp_file = cache_file + ".tmp";
+        std::ofstream file(tmp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(writer.Data().data(), writer.Data().size());
+        file.close();
+        if (!file.good() || std::rename(tmp_file.c_str(), cache_file.c_str()) != 0)
+        {
+            std::remove(tmp_file.c_str());
+            Log(Log_Level::Warning, Log_Sender::IO, fmt::format("Could not write cache file \"{}\"", cache_file));
+        }
+    }
+
+    /*
+    Read from Pairs file by Markus & Bernd
+    */
+    void Pairs_from_File(const std::string pairsFile, const std::shared_ptr<Data::Geometry> geometry, int & nop,
+        pairfield & exchange_pairs, scalarfield & exchange_magnitudes,
+        pairfield & dmi_pairs, scalarfield & dmi_magnitudes, vectorfield & dmi_normals,
+        const std::string cache_folder)
+    {
+        Log(Log_Level::Info, Log_Sender::IO, fmt::format("Reading spin pairs from file \"{}\"", pairsFile));
+        try
+        {
+            pairfield new_exchange_pairs, new_dmi_pairs;
+            scalarfield new_exchange_magnitudes, new_dmi_magnitudes;
+            vectorfield new_dmi_normals;
+            std::int32_t n_rows = 0;
+
+            // The DMI vectors may be given in terms of the bravais vectors
+            std::string cache_file = Interaction_Cache_File(cache_folder, "pairs", pairsFile,
+                std::string(reinterpret_cast<const char *>(geometry->bravais_vectors.data()), 3 * sizeof(Vector3)));
+            bool cached = Read_Interaction_Cache(cache_file, [&](Binary_Reader & reader)
+            {
+                reader.Read(n_rows);
+                reader.Read(new_exchange_pairs);
+                reader.Read(new_exchange_magnitudes);
+                reader.Read(new_dmi_pairs);
+                reader.Read(new_dmi_magnitudes);
+                reader.Read(new_dmi_normals);
+            });
+
+            if (!cached)
             {
-                // Read a Pair from the File
+                // column indices of pair indices and interactions
+                int col_i = -1, col_j = -1, col_da = -1, col_db = -1, col_dc = -1,
+                    col_J = -1, col_DMIx = -1, col_DMIy = -1, col_DMIz = -1,
+                    col_Dij = -1, col_DMIa = -1, col_DMIb = -1, col_DMIc = -1;
+                bool J = false, DMI_xyz = false, DMI_abc = false, Dij = false;
+
+                // Get column indices
+                Filter_File_Handle file(pairsFile);
+                std::vector<std::string> columns;
+                std::size_t begin = 0, n = 0;
+                Find_Interaction_Table(file, "n_interaction_pairs", "pairs", columns, begin, n);
                 for (unsigned int i = 0; i < columns.size(); ++i)
                 {
-                    if (i == col_i)
-                        file.iss >> pair_i;
-                    else if (i == col_j)
-                        file.iss >> pair_j;
-                    else if (i == col_da)
-                        file.iss >> pair_da;
-                    else if (i == col_db)
-                        file.iss >> pair_db;
-                    else if (i == col_dc)
-                        file.iss >> pair_dc;
-                    else if (i == col_J && J)
-                        file.iss >> pair_Jij;
-                    else if (i == col_Dij && Dij)
-                        file.iss >> pair_Dij;
-                    else if (i == col_DMIa && DMI_abc)
-                        file.iss >> pair_D1;
-                    else if (i == col_DMIb && DMI_abc)
-                        file.iss >> pair_D2;
-                    else if (i == col_DMIc && DMI_abc)
-                        file.iss >> pair_D3;
-                    else if (i == col_DMIx && DMI_xyz)
-                        file.iss >> pair_D1;
-                    else if (i == col_DMIy && DMI_xyz)
-                        file.iss >> pair_D2;
-                    else if (i == col_DMIz && DMI_xyz)
-                        file.iss >> pair_D3;
-                    else
-                        file.iss >> sdump;
-                }// end for columns
+                    if      (columns[i] == "i")    col_i = i;
+                    else if (columns[i] == "j")    col_j = i;
+                    else if (columns[i] == "da")   col_da = i;
+                    else if (columns[i] == "db")   col_db = i;
+                    else if (columns[i] == "dc")   col_dc = i;
+                    else if (columns[i] == "jij")  { col_J = i;    J = true; }
+                    else if (columns[i] == "dij")  { col_Dij = i;    Dij = true; }
+                    else if (columns[i] == "dijx") col_DMIx = i;
+                    else if (columns[i] == "dijy") col_DMIy = i;
+                    else if (columns[i] == "dijz") col_DMIz = i;
+                    else if (columns[i] == "dija") col_DMIx = i;
+                    else if (columns[i] == "dijb") col_DMIy = i;
+                    else if (columns[i] == "dijc") col_DMIz = i;
+
+                    if (col_DMIx >= 0 && col_DMIy >= 0 && col_DMIz >= 0) DMI_xyz = true;
+                    if (col_DMIa >= 0 && col_DMIb >= 0 && col_DMIc >= 0) DMI_abc = true;
+                }
+
+                // Check if interactions have been found in header
+                if (!J && !DMI_xyz && !DMI_abc) Log(Log_Level::Warning, Log_Sender::IO, "No interactions could be found in pairs file " + pairsFile);
 
-                // DMI vector orientation
-                if (DMI_abc)
+                // Position of the columns in the parsed rows
+                enum { S_i, S_j, S_da, S_db, S_dc, S_J, S_Dij, S_D1, S_D2, S_D3, N_Slots };
+                std::vector<int> slot_of_column(columns.size(), -1);
+                for (int i = 0; i < int(columns.size()); ++i)
                 {
-                    pair_D_temp = { pair_D1, pair_D2, pair_D3 };
-                    pair_D1 = pair_D_temp.dot(geometry->bravais_vectors[0]);
-                    pair_D2 = pair_D_temp.dot(geometry->bravais_vectors[1]);
-                    pair_D3 = pair_D_temp.dot(geometry->bravais_vectors[2]);
+                    if (i == col_i)                         slot_of_column[i] = S_i;
+                    else if (i == col_j)                    slot_of_column[i] = S_j;
+                    else if (i == col_da)                   slot_of_column[i] = S_da;
+                    else if (i == col_db)                   slot_of_column[i] = S_db;
+                    else if (i == col_dc)                   slot_of_column[i] = S_dc;
+                    else if (i == col_J && J)               slot_of_column[i] = S_J;
+                    else if (i == col_Dij && Dij)           slot_of_column[i] = S_Dij;
+                    else if (i == col_DMIa && DMI_abc)      slot_of_column[i] = S_D1;
+                    else if (i == col_DMIb && DMI_abc)      slot_of_column[i] = S_D2;
+                    else if (i == col_DMIc && DMI_abc)      slot_of_column[i] = S_D3;
+                    else if (i == col_DMIx && DMI_xyz)      slot_of_column[i] = S_D1;
+                    else if (i == col_DMIy && DMI_xyz)      slot_of_column[i] = S_D2;
+                    else if (i == col_DMIz && DMI_xyz)      slot_of_column[i] = S_D3;
                 }
-                // DMI vector normalisation
-                if (Dij)
+                auto values = Parse_Interaction_Table(file.Lines(), begin, n, slot_of_column, N_Slots);
+                n_rows = n;
+
+                // DMI vector orientation and normalisation
+                #pragma omp parallel for
+                for (long row = 0; row < long(n); ++row)
                 {
-                    scalar dnorm = std::sqrt(std::pow(pair_D1, 2) + std::pow(pair_D2, 2) + std::pow(pair_D3, 2));
-                    if (dnorm != 0)
+                    double * v = &values[row * N_Slots];
+                    if (DMI_abc)
                     {
-                        pair_D1 = pair_D1 / dnorm;
-                        pair_D2 = pair_D2 / dnorm;
-                        pair_D3 = pair_D3 / dnorm;
+                        Vector3 D_temp = { scalar(v[S_D1]), scalar(v[S_D2]), scalar(v[S_D3]) };
+                        v[S_D1] = D_temp.dot(geometry->bravais_vectors[0]);
+                        v[S_D2] = D_temp.dot(geometry->bravais_vectors[1]);
+                        v[S_D3] = D_temp.dot(geometry->bravais_vectors[2]);
                     }
-                }
-                else
-                {
-                    pair_Dij = std::sqrt(std::pow(pair_D1, 2) + std::pow(pair_D2, 2) + std::pow(pair_D3, 2));
-                    if (pair_Dij != 0)
+                    scalar dnorm = std::sqrt(std::pow(scalar(v[S_D1]), 2) + std::pow(scalar(v[S_D2]), 2) + std::pow(scalar(v[S_D3]), 2));
+                    if (!Dij)
+                        v[S_Dij] = dnorm;
+                    if (dnorm != 0)
                     {
-                        pair_D1 = pair_D1 / pair_Dij;
-                        pair_D2 = pair_D2 / pair_Dij;
-                        pair_D3 = pair_D3 / pair_Dij;
+                        v[S_D1] = scalar(v[S_D1]) / dnorm;
+                        v[S_D2] = scalar(v[S_D2]) / dnorm;
+                        v[S_D3] = scalar(v[S_D3]) / dnorm;
                     }
                 }
 
-                // Add the indices and parameters to the corresponding lists
-                if (pair_Jij != 0)
+                // Count and then add the non-zero interactions
+                std::size_t n_exchange = 0, n_dmi = 0;
+                for (std::size_t row = 0; row < n; ++row)
                 {
-                    exchange_pairs.push_back({ pair_i, pair_j, { pair_da, pair_db, pair_dc } });
-                    exchange_magnitudes.push_back(pair_Jij);
+                    if (scalar(values[row * N_Slots + S_J]) != 0)   ++n_exchange;
+                    if (scalar(values[row * N_Slots + S_Dij]) != 0) ++n_dmi;
                 }
-                if (pair_Dij != 0)
+                new_exchange_pairs.resize(n_exchange);
+                new_exchange_magnitudes.resize(n_exchange);
+                new_dmi_pairs.resize(n_dmi);
+                new_dmi_magnitudes.resize(n_dmi);
+                new_dmi_normals.resize(n_dmi);
+                std::size_t i_exchange = 0, i_dmi = 0;
+                for (std::size_t row = 0; row < n; ++row)
                 {
-                    dmi_pairs.push_back({ pair_i, pair_j, { pair_da, pair_db, pair_dc } });
-                    dmi_magnitudes.push_back(pair_Dij);
-                    dmi_normals.push_back(Vector3{pair_D1, pair_D2, pair_D3});
+                    const double * v = &values[row * N_Slots];
+                    Pair pair{ int(v[S_i]), int(v[S_j]), { int(v[S_da]), int(v[S_db]), int(v[S_dc]) } };
+                    if (scalar(v[S_J]) != 0)
+                    {
+                        new_exchange_pairs[i_exchange] = pair;
+                        new_exchange_magnitudes[i_exchange] = scalar(v[S_J]);
+                        ++i_exchange;
+                    }
+                    if (scalar(v[S_Dij]) != 0)
+                    {
+                        new_dmi_pairs[i_dmi] = pair;
+                        new_dmi_magnitudes[i_dmi] = scalar(v[S_Dij]);
+                        new_dmi_normals[i_dmi] = Vector3{ scalar(v[S_D1]), scalar(v[S_D2]), scalar(v[S_D3]) };
+                        ++i_dmi;
+                    }
                 }
 
-                ++i_pair;
-            }// end while GetLine
-            Log(Log_Level::Info, Log_Sender::IO, fmt::format("Done reading {} spin pairs from file \"{}\"", i_pair, pairsFile));
-            nop = i_pair;
+                Write_Interaction_Cache(cache_file, [&](Binary_Writer & writer)
+                {
+                    writer.Write(n_rows);
+                    writer.Write(new_exchange_pairs);
+                    writer.Write(new_exchange_magnitudes);
+                    writer.Write(new_dmi_pairs);
+                    writer.Write(new_dmi_magnitudes);
+                    writer.Write(new_dmi_normals);
+                });
+            }
+
+            // Add the interactions to the corresponding lists
+            exchange_pairs.insert(exchange_pairs.end(), new_exchange_pairs.begin(), new_exchange_pairs.end());
+            exchange_magnitudes.insert(exchange_magnitudes.end(), new_exchange_magnitudes.begin(), new_exchange_magnitudes.end());
+            dmi_pairs.insert(dmi_pairs.end(), new_dmi_pairs.begin(), new_dmi_pairs.end());
+            dmi_magnitudes.insert(dmi_magnitudes.end(), new_dmi_magnitudes.begin(), new_dmi_magnitudes.end());
+            dmi_normals.insert(dmi_normals.end(), new_dmi_normals.begin(), new_dmi_normals.end());
+
+            Log(Log_Level::Info, Log_Sender::IO, fmt::format("Done reading {} spin pairs from file \"{}\"", n_rows, pairsFile));
+            nop = n_rows;
         }// end try
         catch( ... )
         {
@@ -596,132 +807,117 @@ namespace IO
     Read from Quadruplet file
     */
     void Quadruplets_from_File(const std::string quadrupletsFile, const std::shared_ptr<Data::Geometry>, int & noq,
-        quadrupletfield & quadruplets, scalarfield & quadruplet_magnitudes)
+        quadrupletfield & quadruplets, scalarfield & quadruplet_magnitudes, const std::string cache_folder)
     {
         Log(Log_Level::Info, Log_Sender::IO, "Reading spin quadruplets from file " + quadrupletsFile);
         try
         {
-            std::vector<std::string> columns(20);    // at least: 4 (indices) + 3*3 (positions) + 1 (magnitude)
-            // column indices of pair indices and interactions
-            int col_i = -1;
-            int col_j = -1, col_da_j = -1, col_db_j = -1, col_dc_j = -1, periodicity_j = 0;
-            int col_k = -1, col_da_k = -1, col_db_k = -1, col_dc_k = -1, periodicity_k = 0;
-            int col_l = -1, col_da_l = -1, col_db_l = -1, col_dc_l = -1, periodicity_l = 0;
-            int    col_Q = -1;
-            bool Q = false;
-            int max_periods_a = 0, max_periods_b = 0, max_periods_c = 0;
-            int quadruplet_periodicity = 0;
-            int n_quadruplets = 0;
+            quadrupletfield new_quadruplets;
+            scalarfield new_magnitudes;
+            std::int32_t n_rows = 0;
 
-            // Get column indices
-            Filter_File_Handle file(quadrupletsFile);
-
-            if (file.Find("n_interaction_quadruplets"))
-            {
-                // Read n interaction quadruplets
-                file.iss >> n_quadruplets;
-                Log(Log_Level::Debug, Log_Sender::IO, fmt::format("File {} should have {} quadruplets", quadrupletsFile, n_quadruplets));
-            }
-            else
-            {
-                // Read the whole file
-                n_quadruplets = (int)1e8;
-                // First line should contain the columns
-                file.ResetStream();
-                Log(Log_Level::Info, Log_Sender::IO, "Trying to parse quadruplet columns from top of file " + quadrupletsFile);
-            }
-
-            file.GetLine();
-            for (unsigned int i = 0; i < columns.size(); ++i)
+            std::string cache_file = Interaction_Cache_File(cache_folder, "quadruplets", quadrupletsFile, "");
+            bool cached = Read_Interaction_Cache(cache_file, [&](Binary_Reader & reader)
             {
-                file.iss >> columns[i];
-                if      (columns[i] == "i")    col_i = i;
-                else if (columns[i] == "j")    col_j = i;
-                else if (columns[i] == "da_j")    col_da_j = i;
-                else if (columns[i] == "db_j")    col_db_j = i;
-                else if (columns[i] == "dc_j")    col_dc_j = i;
-                else if (columns[i] == "k")    col_k = i;
-                else if (columns[i] == "da_k")    col_da_k = i;
-                else if (columns[i] == "db_k")    col_db_k = i;
-                else if (columns[i] == "dc_k")    col_dc_k = i;
-                else if (columns[i] == "l")    col_l = i;
-                else if (columns[i] == "da_l")    col_da_l = i;
-                else if (columns[i] == "db_l")    col_db_l = i;
-                else if (columns[i] == "dc_l")    col_dc_l = i;
-                else if (columns[i] == "q")    { col_Q = i;    Q = true; }
-            }
+                reader.Read(n_rows);
+                reader.Read(new_quadruplets);
+                reader.Read(new_magnitudes);
+            });
 
-            // Check if interactions have been found in header
-            if (!Q) Log(Log_Level::Warning, Log_Sender::IO, "No interactions could be found in header of quadruplets file " + quadrupletsFile);
-
-            // Quadruplet Indices
-            int q_i = 0;
-            int q_j = 0, q_da_j = 0, q_db_j = 0, q_dc_j = 0;
-            int q_k = 0, q_da_k = 0, q_db_k = 0, q_dc_k = 0;
-            int q_l = 0, q_da_l = 0, q_db_l = 0, q_dc_l = 0;
-            scalar q_Q;
-
-            // Get actual Quadruplets Data
-            int i_quadruplet = 0;
-            std::string sdump;
-            while (file.GetLine() && i_quadruplet < n_quadruplets)
+            if (!cached)
             {
-                // Read a Quadruplet from the File
+                // column indices of quadruplet indices and interactions
+                int col_i = -1;
+                int col_j = -1, col_da_j = -1, col_db_j = -1, col_dc_j = -1;
+                int col_k = -1, col_da_k = -1, col_db_k = -1, col_dc_k = -1;
+                int col_l = -1, col_da_l = -1, col_db_l = -1, col_dc_l = -1;
+                int col_Q = -1;
+                bool Q = false;
+
+                // Get column indices
+                Filter_File_Handle file(quadrupletsFile);
+                std::vector<std::string> columns;
+                std::size_t begin = 0, n = 0;
+                Find_Interaction_Table(file, "n_interaction_quadruplets", "quadruplets", columns, begin, n);
                 for (unsigned int i = 0; i < columns.size(); ++i)
                 {
-                    // i
-                    if (i == col_i)
-                        file.iss >> q_i;
-                    // j
-                    else if (i == col_j)
-                        file.iss >> q_j;
-                    else if (i == col_da_j)
-                        file.iss >> q_da_j;
-                    else if (i == col_db_j)
-                        file.iss >> q_db_j;
-                    else if (i == col_dc_j)
-                        file.iss >> q_dc_j;
-                    // k
-                    else if (i == col_k)
-                        file.iss >> q_k;
-                    else if (i == col_da_k)
-                        file.iss >> q_da_k;
-                    else if (i == col_db_k)
-                        file.iss >> q_db_k;
-                    else if (i == col_dc_k)
-                        file.iss >> q_dc_k;
-                    // l
-                    else if (i == col_l)
-                        file.iss >> q_l;
-                    else if (i == col_da_l)
-                        file.iss >> q_da_l;
-                    else if (i == col_db_l)
-                        file.iss >> q_db_l;
-                    else if (i == col_dc_l)
-                        file.iss >> q_dc_l;
-                    // Quadruplet magnitude
-                    else if (i == col_Q && Q)
-                        file.iss >> q_Q;
-                    // Otherwise dump the line
-                    else
-                        file.iss >> sdump;
-                }// end for columns
-                
+                    if      (columns[i] == "i")    col_i = i;
+                    else if (columns[i] == "j")    col_j = i;
+                    else if (columns[i] == "da_j")    col_da_j = i;
+                    else if (columns[i] == "db_j")    col_db_j = i;
+                    else if (columns[i] == "dc_j")    col_dc_j = i;
+                    else if (columns[i] == "k")    col_k = i;
+                    else if (columns[i] == "da_k")    col_da_k = i;
+                    else if (columns[i] == "db_k")    col_db_k = i;
+                    else if (columns[i] == "dc_k")    col_dc_k = i;
+                    else if (columns[i] == "l")    col_l = i;
+                    else if (columns[i] == "da_l")    col_da_l = i;
+                    else if (columns[i] == "db_l")    col_db_l = i;
+                    else if (columns[i] == "dc_l")    col_dc_l = i;
+                    else if (columns[i] == "q")    { col_Q = i;    Q = true; }
+                }
+
+                // Check if interactions have been found in header
+                if (!Q) Log(Log_Level::Warning, Log_Sender::IO, "No interactions could be found in header of quadruplets file " + quadrupletsFile);
 
-                // Add the indices and parameter to the corresponding list
-                if (q_Q != 0)
+                // Position of the columns in the parsed rows
+                enum { S_i, S_j, S_da_j, S_db_j, S_dc_j, S_k, S_da_k, S_db_k, S_dc_k,
+                       S_l, S_da_l, S_db_l, S_dc_l, S_Q, N_Slots };
+                std::vector<int> slot_of_column(columns.size(), -1);
+                for (int i = 0; i < int(columns.size()); ++i)
                 {
-                    quadruplets.push_back({ q_i, q_j, q_k, q_l,
-                        { q_da_j, q_db_j, q_db_j },
-                        { q_da_k, q_db_k, q_db_k },
-                        { q_da_l, q_db_l, q_db_l } });
-                    quadruplet_magnitudes.push_back(q_Q);
+                    if (i == col_i)             slot_of_column[i] = S_i;
+                    else if (i == col_j)        slot_of_column[i] = S_j;
+                    else if (i == col_da_j)     slot_of_column[i] = S_da_j;
+                    else if (i == col_db_j)     slot_of_column[i] = S_db_j;
+                    else if (i == col_dc_j)     slot_of_column[i] = S_dc_j;
+                    else if (i == col_k)        slot_of_column[i] = S_k;
+                    else if (i == col_da_k)     slot_of_column[i] = S_da_k;
+                    else if (i == col_db_k)     slot_of_column[i] = S_db_k;
+                    else if (i == col_dc_k)     slot_of_column[i] = S_dc_k;
+                    else if (i == col_l)        slot_of_column[i] = S_l;
+                    else if (i == col_da_l)     slot_of_column[i] = S_da_l;
+                    else if (i == col_db_l)     slot_of_column[i] = S_db_l;
+                    else if (i == col_dc_l)     slot_of_column[i] = S_dc_l;
+                    else if (i == col_Q && Q)   slot_of_column[i] = S_Q;
                 }
+                auto values = Parse_Interaction_Table(file.Lines(), begin, n, slot_of_column, N_Slots);
+                n_rows = n;
+
+                // Count and then add the non-zero interactions
+                std::size_t n_quadruplets = 0;
+                for (std::size_t row = 0; row < n; ++row)
+                    if (scalar(values[row * N_Slots + S_Q]) != 0) ++n_quadruplets;
+                new_quadruplets.resize(n_quadruplets);
+                new_magnitudes.resize(n_quadruplets);
+                std::size_t i_quadruplet = 0;
+                for (std::size_t row = 0; row < n; ++row)
+                {
+                    const double * v = &values[row * N_Slots];
+                    if (scalar(v[S_Q]) == 0)
+                        continue;
+                    new_quadruplets[i_quadruplet] = { int(v[S_i]), int(v[S_j]), int(v[S_k]), int(v[S_l]),
+                        { int(v[S_da_j]), int(v[S_db_j]), int(v[S_dc_j]) },
+                        { int(v[S_da_k]), int(v[S_db_k]), int(v[S_dc_k]) },
+                        { int(v[S_da_l]), int(v[S_db_l]), int(v[S_dc_l]) } };
+                    new_magnitudes[i_quadruplet] = scalar(v[S_Q]);
+                    ++i_quadruplet;
+                }
+
+                Write_Interaction_Cache(cache_file, [&](Binary_Writer & writer)
+                {
+                    writer.Write(n_rows);
+                    writer.Write(new_quadruplets);
+                    writer.Write(new_magnitudes);
+                });
+            }
+
+            // Add the indices and parameters to the corresponding lists
+            quadruplets.insert(quadruplets.end(), new_quadruplets.begin(), new_quadruplets.end());
+            quadruplet_magnitudes.insert(quadruplet_magnitudes.end(), new_magnitudes.begin(), new_magnitudes.end());
 
-                ++i_quadruplet;
-            }// end while GetLine
-            Log(Log_Level::Info, Log_Sender::IO, fmt::format("Done reading {} spin quadruplets from file {}", i_quadruplet, quadrupletsFile));
-            noq = i_quadruplet;
+            Log(Log_Level::Info, Log_Sender::IO, fmt::format("Done reading {} spin quadruplets from file {}", n_rows, quadrupletsFile));
+            noq = n_rows;
         }// end try
         catch( ... )
         {
@@ -733,137 +929,128 @@ namespace IO
     Read from Triplet file
     */
     void Triplets_from_File(const std::string tripletsFile, const std::shared_ptr<Data::Geometry>, int & noq,
-        tripletfield & triplets, scalarfield & triplet_magnitudes1, scalarfield & triplet_magnitudes2)
+        tripletfield & triplets, scalarfield & triplet_magnitudes1, scalarfield & triplet_magnitudes2,
+        const std::string cache_folder)
     {
         Log(Log_Level::Info, Log_Sender::IO, "Reading spin triplets from file " + tripletsFile);
         try
         {
-            std::vector<std::string> columns(20);    // at least: 4 (indices) + 3*3 (positions) + 1 (magnitude)
-            // column indices of pair indices and interactions
-            int col_i = -1;
-            int col_j = -1, col_da_j = -1, col_db_j = -1, col_dc_j = -1, periodicity_j = 0;
-            int col_k = -1, col_da_k = -1, col_db_k = -1, col_dc_k = -1, periodicity_k = 0;
-            int col_l = -1, col_da_l = -1, col_db_l = -1, col_dc_l = -1, periodicity_l = 0;
-            int col_Q1 = -1, col_Q2;
-            int col_na = -1, col_nb = -1, col_nc = -1;
-            bool Q1 = false;
-            bool Q2 = false;
-            int max_periods_a = 0, max_periods_b = 0, max_periods_c = 0;
-            int triplet_periodicity = 0;
-            int n_triplets = 0;
-
-            // Get column indices
-            Filter_File_Handle file(tripletsFile);
+            tripletfield new_triplets;
+            scalarfield new_magnitudes1, new_magnitudes2;
+            std::int32_t n_rows = 0;
 
-            if (file.Find("n_interaction_triplets"))
-            {
-                // Read n interaction triplets
-                file.iss >> n_triplets;
-                Log(Log_Level::Debug, Log_Sender::IO, fmt::format("File {} should have {} triplets", tripletsFile, n_triplets));
-            }
-            else
+            std::string cache_file = Interaction_Cache_File(cache_folder, "triplets", tripletsFile, "");
+            bool cached = Read_Interaction_Cache(cache_file, [&](Binary_Reader & reader)
             {
-                // Read the whole file
-                n_triplets = (int)1e8;
-                // First line should contain the columns
-                file.ResetStream();
-                Log(Log_Level::Info, Log_Sender::IO, "Trying to parse triplet columns from top of file " + tripletsFile);
-            }
+                reader.Read(n_rows);
+                reader.Read(new_triplets);
+                reader.Read(new_magnitudes1);
+                reader.Read(new_magnitudes2);
+            });
 
-            file.GetLine();
-            for (unsigned int i = 0; i < columns.size(); ++i)
+            if (!cached)
             {
-                file.iss >> columns[i];
-                if      (columns[i] == "i")    col_i = i;
-                else if (columns[i] == "j")    col_j = i;
-                else if (columns[i] == "da_j")    col_da_j = i;
-                else if (columns[i] == "db_j")    col_db_j = i;
-                else if (columns[i] == "dc_j")    col_dc_j = i;
-                else if (columns[i] == "k")    col_k = i;
-                else if (columns[i] == "da_k")    col_da_k = i;
-                else if (columns[i] == "db_k")    col_db_k = i;
-                else if (columns[i] == "dc_k")    col_dc_k = i;
-                else if (columns[i] == "q1")    { col_Q1 = i;   Q1 = true; }
-                else if (columns[i] == "na")    col_na = i;
-                else if (columns[i] == "nb")    col_nb = i;
-                else if (columns[i] == "nc")    col_nc = i;
-                else if (columns[i] == "q2")    { col_Q2 = i;    Q2 = true; }
-            }
+                // column indices of triplet indices and interactions
+                int col_i = -1;
+                int col_j = -1, col_da_j = -1, col_db_j = -1, col_dc_j = -1;
+                int col_k = -1, col_da_k = -1, col_db_k = -1, col_dc_k = -1;
+                int col_Q1 = -1, col_Q2 = -1;
+                int col_na = -1, col_nb = -1, col_nc = -1;
+                bool Q1 = false;
+                bool Q2 = false;
+
+                // Get column indices
+                Filter_File_Handle file(tripletsFile);
+                std::vector<std::string> columns;
+                std::size_t begin = 0, n = 0;
+                Find_Interaction_Table(file, "n_interaction_triplets", "triplets", columns, begin, n);
+                for (unsigned int i = 0; i < columns.size(); ++i)
+                {
+                    if      (columns[i] == "i")    col_i = i;
+                    else if (columns[i] == "j")    col_j = i;
+                    else if (columns[i] == "da_j")    col_da_j = i;
+                    else if (columns[i] == "db_j")    col_db_j = i;
+                    else if (columns[i] == "dc_j")    col_dc_j = i;
+                    else if (columns[i] == "k")    col_k = i;
+                    else if (columns[i] == "da_k")    col_da_k = i;
+                    else if (columns[i] == "db_k")    col_db_k = i;
+                    else if (columns[i] == "dc_k")    col_dc_k = i;
+                    else if (columns[i] == "q1")    { col_Q1 = i;   Q1 = true; }
+                    else if (columns[i] == "na")    col_na = i;
+                    else if (columns[i] == "nb")    col_nb = i;
+                    else if (columns[i] == "nc")    col_nc = i;
+                    else if (columns[i] == "q2")    { col_Q2 = i;    Q2 = true; }
+                }
 
-            // Check if interactions have been found in header
-            if (!Q1) Log(Log_Level::Warning, Log_Sender::IO, "No interactions could be found in header of triplets file " + tripletsFile);
-            if (!Q2) Log(Log_Level::Warning, Log_Sender::IO, "No interactions could be found in header of triplets file " + tripletsFile);
+                // Check if interactions have been found in header
+                if (!Q1) Log(Log_Level::Warning, Log_Sender::IO, "No interactions could be found in header of triplets file " + tripletsFile);
+                if (!Q2) Log(Log_Level::Warning, Log_Sender::IO, "No interactions could be found in header of triplets file " + tripletsFile);
 
-            // triplet Indices
-            int q_i = 0;
-            int q_j = 0, q_da_j = 0, q_db_j = 0, q_dc_j = 0;
-            int q_k = 0, q_da_k = 0, q_db_k = 0, q_dc_k = 0;
-            scalar q_na = 0, q_nb = 0, q_nc = 0;
-            scalar q_Q1, q_Q2;
+                // Position of the columns in the parsed rows
+                enum { S_i, S_j, S_da_j, S_db_j, S_dc_j, S_k, S_da_k, S_db_k, S_dc_k,
+                       S_na, S_nb, S_nc, S_Q1, S_Q2, N_Slots };
+                std::vector<int> slot_of_column(columns.size(), -1);
+                for (int i = 0; i < int(columns.size()); ++i)
+                {
+                    if (i == col_i)             slot_of_column[i] = S_i;
+                    else if (i == col_j)        slot_of_column[i] = S_j;
+                    else if (i == col_da_j)     slot_of_column[i] = S_da_j;
+                    else if (i == col_db_j)     slot_of_column[i] = S_db_j;
+                    else if (i == col_dc_j)     slot_of_column[i] = S_dc_j;
+                    else if (i == col_k)        slot_of_column[i] = S_k;
+                    else if (i == col_da_k)     slot_of_column[i] = S_da_k;
+                    else if (i == col_db_k)     slot_of_column[i] = S_db_k;
+                    else if (i == col_dc_k)     slot_of_column[i] = S_dc_k;
+                    else if (i == col_na)       slot_of_column[i] = S_na;
+                    else if (i == col_nb)       slot_of_column[i] = S_nb;
+                    else if (i == col_nc)       slot_of_column[i] = S_nc;
+                    else if (i == col_Q1 && Q1) slot_of_column[i] = S_Q1;
+                    else if (i == col_Q2 && Q2) slot_of_column[i] = S_Q2;
+                }
+                auto values = Parse_Interaction_Table(file.Lines(), begin, n, slot_of_column, N_Slots);
+                n_rows = n;
 
-            // Get actual triplets Data
-            int i_triplet = 0;
-            std::string sdump;
-            while (file.GetLine() && i_triplet < n_triplets)
-            {
-                // Read a triplet from the File
-                for (unsigned int i = 0; i < columns.size(); ++i)
+                // Count and then add the non-zero interactions
+                std::size_t n_triplets = 0;
+                for (std::size_t row = 0; row < n; ++row)
                 {
-                    // i
-                    if (i == col_i)
-                        file.iss >> q_i;
-                    // j
-                    else if (i == col_j)
-                        file.iss >> q_j;
-                    else if (i == col_da_j)
-                        file.iss >> q_da_j;
-                    else if (i == col_db_j)
-                        file.iss >> q_db_j;
-                    else if (i == col_dc_j)
-                        file.iss >> q_dc_j;
-                    // k
-                    else if (i == col_k)
-                        file.iss >> q_k;
-                    else if (i == col_da_k)
-                        file.iss >> q_da_k;
-                    else if (i == col_db_k)
-                        file.iss >> q_db_k;
-                    else if (i == col_dc_k)
-                        file.iss >> q_dc_k;
-                    // n
-                    else if (i == col_na)
-                        file.iss >> q_na;
-                    else if (i == col_nb)
-                        file.iss >> q_nb;
-                    else if (i == col_nc)
-                        file.iss >> q_nc;
-                    // triplet magnitude
-                    else if (i == col_Q1 && Q1)
-                        file.iss >> q_Q1;
-                    else if (i == col_Q2 && Q2)
-                        file.iss >> q_Q2;
-                    // Otherwise dump the line
-                    else
-                        file.iss >> sdump;
-                }// end for columns
-                
+                    if (scalar(values[row * N_Slots + S_Q1]) != 0 || scalar(values[row * N_Slots + S_Q2]) != 0)
+                        ++n_triplets;
+                }
+                new_triplets.resize(n_triplets);
+                new_magnitudes1.resize(n_triplets);
+                new_magnitudes2.resize(n_triplets);
+                std::size_t i_triplet = 0;
+                for (std::size_t row = 0; row < n; ++row)
+                {
+                    const double * v = &values[row * N_Slots];
+                    if (scalar(v[S_Q1]) == 0 && scalar(v[S_Q2]) == 0)
+                        continue;
+                    new_triplets[i_triplet] = { int(v[S_i]), int(v[S_j]), int(v[S_k]),
+                        { int(v[S_da_j]), int(v[S_db_j]), int(v[S_dc_j]) },
+                        { int(v[S_da_k]), int(v[S_db_k]), int(v[S_dc_k]) },
+                        { scalar(v[S_na]), scalar(v[S_nb]), scalar(v[S_nc]) } };
+                    new_magnitudes1[i_triplet] = scalar(v[S_Q1]);
+                    new_magnitudes2[i_triplet] = scalar(v[S_Q2]);
+                    ++i_triplet;
+                }
 
-                // Add the indices and parameter to the corresponding list
-                if (q_Q1 != 0 || q_Q2 != 0)
+                Write_Interaction_Cache(cache_file, [&](Binary_Writer & writer)
                 {
-                    triplets.push_back({ q_i, q_j, q_k,
-                        { q_da_j, q_db_j, q_db_j },
-                        { q_da_k, q_db_k, q_db_k },
-                        { q_na, q_nb, q_nc } });
-                    triplet_magnitudes1.push_back(q_Q1);
-                    triplet_magnitudes2.push_back(q_Q2);
+                    writer.Write(n_rows);
+                    writer.Write(new_triplets);
+                    writer.Write(new_magnitudes1);
+                    writer.Write(new_magnitudes2);
+                });
+            }
 
-                }
+            // Add the indices and parameters to the corresponding lists
+            triplets.insert(triplets.end(), new_triplets.begin(), new_triplets.end());
+            triplet_magnitudes1.insert(triplet_magnitudes1.end(), new_magnitudes1.begin(), new_magnitudes1.end());
+            triplet_magnitudes2.insert(triplet_magnitudes2.end(), new_magnitudes2.begin(), new_magnitudes2.end());
 
-                ++i_triplet;
-            }// end while GetLine
-            Log(Log_Level::Info, Log_Sender::IO, fmt::format("Done reading {} spin triplets from file {}", i_triplet, tripletsFile));
-            noq = i_triplet;
+            Log(Log_Level::Info, Log_Sender::IO, fmt::format("Done reading {} spin triplets from file {}", n_rows, tripletsFile));
+            noq = n_rows;
         }// end try
         catch( ... )
         {
@@ -871,7 +1058,6 @@ namespace IO
         }
     } // End Triplets_from_File
 
-
     void Defects_from_File(const std::string defectsFile, int & n_defects,
         intfield & defect_indices, intfield & defect_types)
     {
@@ -887,7 +1073,7 @@ namespace IO
             if (myfile.Find("n_defects"))
             {
                 // Read n interaction pairs
-                myfile.iss >> nod;
+                myfile.tokens >> nod;
                 Log(Log_Level::Debug, Log_Sender::IO, fmt::format("File {} should have {} defects", defectsFile, nod));
             }
             else
@@ -903,7 +1089,7 @@ namespace IO
             while (myfile.GetLine() && i_defect < nod)
             {
                 int index, type;
-                myfile.iss >> index >> type;
+                myfile.tokens >> index >> type;
                 indices.push_back(index);
                 types.push_back(type);
                 ++i_defect;
@@ -937,7 +1123,7 @@ namespace IO
             if (myfile.Find("n_pinned"))
             {
                 // Read n interaction pairs
-                myfile.iss >> nop;
+                myfile.tokens >> nop;
                 Log(Log_Level::Debug, Log_Sender::IO, fmt::format("File {} should have {} pinned sites", pinnedFile, nop));
             }
             else
@@ -954,7 +1140,7 @@ namespace IO
             {
                 int index;
                 scalar sx, sy, sz;
-                myfile.iss >> index >> sx >> sy >> sz;
+                myfile.tokens >> index >> sx >> sy >> sz;
                 indices.push_back(index);
                 spins.push_back({sx, sy, sz});
                 ++i_pinned;
@@ -1009,180 +1195,13 @@ namespace IO
     }
 
     void Read_From_OVF( vectorfield & vf, const Data::Geometry & geometry, std::string ovfFileName, 
-                        VF_FileFormat format )
+                        VF_FileFormat format, int idx_segment )
     {
         try
         {
             Log( Log_Level::Info, Log_Sender::IO, "Start reading OOMMF OVF file" );
-            Filter_File_Handle myfile( ovfFileName, format );
-            
-            // Initialize strings
-            std::string ovf_version = "";
-            std::string ovf_title = "";
-            std::string ovf_meshunit = "";
-            std::string ovf_meshtype = "";
-            std::string ovf_valueunits = "";
-            Vector3 ovf_xyz_max(0,0,0);
-            Vector3 ovf_xyz_min(0,0,0);
-            //std::string valueunits_list = "";
-            int ovf_valuedim = 0;
-            // Irregular mesh attributes
-            int ovf_pointcount = 0;
-            // Rectangular mesh attributes
-            Vector3 ovf_xyz_base(0,0,0);
-            Vector3 ovf_xyz_stepsize(0,0,0);
-            std::array<int, 3> ovf_xyz_nodes{ {0,0,0} };
-            // Raw data attributes
-            std::string ovf_data_representation = "";
-            int ovf_binary_length = 0;
-            
-            // OVF Header Block
-            
-            // first line - OVF version
-            myfile.Read_String( ovf_version, "# OOMMF OVF" );
-            if( ovf_version != "2.0" && ovf_version != "2" )
-            {
-                spirit_throw( Utility::Exception_Classifier::Bad_File_Content, 
-                              Utility::Log_Level::Error,
-                              fmt::format( "OVF {0} is not supported", ovf_version ) );
-            }
-            
-            // Title
-            myfile.Read_String( ovf_title, "# Title:" );
-            
-            // mesh units 
-            myfile.Read_Single( ovf_meshunit, "# meshunit:" );
-            
-            // value's dimensions
-            myfile.Require_Single( ovf_valuedim, "# valuedim:" );
-            
-            // value's units
-            myfile.Read_String( ovf_valueunits, "# valueunits:" );
-            
-            // value's labels
-            myfile.Read_String( ovf_valueunits, "# valuelabels:" );
-            
-            // {x,y,z} x {min,max}
-            myfile.Read_Single( ovf_xyz_min[0], "# xmin:" );
-            myfile.Read_Single( ovf_xyz_min[1], "# ymin:" );
-            myfile.Read_Single( ovf_xyz_min[2], "# zmin:" );
-            myfile.Read_Single( ovf_xyz_max[0], "# xmax:" );
-            myfile.Read_Single( ovf_xyz_max[1], "# ymax:" );
-            myfile.Read_Single( ovf_xyz_max[2], "# zmax:" );
-            
-            // meshtype
-            myfile.Require_Single( ovf_meshtype, "# meshtype:" );
-            
-            // TODO: Change the throw to something more meaningfull we don't need want termination
-            if( ovf_meshtype != "rectangular" && ovf_meshtype != "irregular" )
-            {
-                spirit_throw(Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
-                    "Mesh type must be either \"rectangular\" or \"irregular\"");
-            }
-            
-            // Emit Header to Log
-            
-            auto lvl = Log_Level::Parameter;
-            auto sender = Log_Sender::IO;
-            
-            Log( lvl, sender, fmt::format( "# OVF version             = {}", ovf_version ) );
-            Log( lvl, sender, fmt::format( "# OVF title               = {}", ovf_title ) );
-            Log( lvl, sender, fmt::format( "# OVF values dimensions   = {}", ovf_valuedim ) );
-            Log( lvl, sender, fmt::format( "# OVF meshunit            = {}", ovf_meshunit ) );
-            Log( lvl, sender, fmt::format( "# OVF xmin                = {}", ovf_xyz_min[0] ) );
-            Log( lvl, sender, fmt::format( "# OVF ymin                = {}", ovf_xyz_min[1] ) );
-            Log( lvl, sender, fmt::format( "# OVF zmin                = {}", ovf_xyz_min[2] ) );
-            Log( lvl, sender, fmt::format( "# OVF xmax                = {}", ovf_xyz_max[0] ) );
-            Log( lvl, sender, fmt::format( "# OVF ymax                = {}", ovf_xyz_max[1] ) );
-            Log( lvl, sender, fmt::format( "# OVF zmax                = {}", ovf_xyz_max[2] ) );
-            
-            // For different mesh types
-            if( ovf_meshtype == "rectangular" )
-            {
-                // {x,y,z} x {base,stepsize,nodes} 
-                
-                myfile.Require_Single( ovf_xyz_base[0], "# xbase:" );
-                myfile.Require_Single( ovf_xyz_base[1], "# ybase:" );
-                myfile.Require_Single( ovf_xyz_base[2], "# zbase:" );
-                
-                myfile.Require_Single( ovf_xyz_stepsize[0], "# xstepsize:" );
-                myfile.Require_Single( ovf_xyz_stepsize[1], "# ystepsize:" );
-                myfile.Require_Single( ovf_xyz_stepsize[2], "# zstepsize:" );
-                
-                myfile.Require_Single( ovf_xyz_nodes[0], "# xnodes:" );
-                myfile.Require_Single( ovf_xyz_nodes[1], "# ynodes:" );
-                myfile.Require_Single( ovf_xyz_nodes[2], "# znodes:" );
-                
-                // Write to Log
-                Log( lvl, sender, fmt::format( "# OVF meshtype <{}>", ovf_meshtype ) );
-                Log( lvl, sender, fmt::format( "# xbase      = {:.8f}", ovf_xyz_base[0] ) );
-                Log( lvl, sender, fmt::format( "# ybase      = {:.8f}", ovf_xyz_base[1] ) );
-                Log( lvl, sender, fmt::format( "# zbase      = {:.8f}", ovf_xyz_base[2] ) );
-                Log( lvl, sender, fmt::format( "# xstepsize  = {:.8f}", ovf_xyz_stepsize[0] ) );
-                Log( lvl, sender, fmt::format( "# ystepsize  = {:.8f}", ovf_xyz_stepsize[1] ) );
-                Log( lvl, sender, fmt::format( "# zstepsize  = {:.8f}", ovf_xyz_stepsize[2] ) );
-                Log( lvl, sender, fmt::format( "# xnodes     = {}", ovf_xyz_nodes[0] ) );
-                Log( lvl, sender, fmt::format( "# ynodes     = {}", ovf_xyz_nodes[1] ) );
-                Log( lvl, sender, fmt::format( "# znodes     = {}", ovf_xyz_nodes[2] ) );
-            }
-            
-            // Check mesh type
-            if ( ovf_meshtype == "irregular" )
-            {
-                // pointcount
-                myfile.Require_Single( ovf_pointcount, "# pointcount:" );
-                
-                // Write to Log
-                Log( lvl, sender, fmt::format( "# OVF meshtype <{}>", ovf_meshtype ) );
-                Log( lvl, sender, fmt::format( "# OVF point count = {}", ovf_pointcount ) );
-            }
-            
-            // Check that nos is smaller or equal to the nos of the current image
-            int ovf_nos = ovf_xyz_nodes[0] * ovf_xyz_nodes[1] * ovf_xyz_nodes[2];
-            if ( ovf_nos > geometry.nos )
-                spirit_throw(Utility::Exception_Classifier::Bad_File_Content, 
-                    Utility::Log_Level::Error,"NOS of the OVF file is greater than the NOS in the "
-                    "current image");
-            
-            // Check if the geometry of the ovf file is the same with the one of the current image
-            if ( ovf_xyz_nodes[0] != geometry.n_cells[0] ||
-                 ovf_xyz_nodes[1] != geometry.n_cells[1] ||
-                 ovf_xyz_nodes[2] != geometry.n_cells[2] )
-            {
-                Log(Log_Level::Warning, sender, fmt::format("The geometry of the OVF file "
-                    "does not much the geometry of the current image") );
-            }
-            
-            // Raw data representation
-            myfile.Read_String( ovf_data_representation, "# Begin: Data" );
-            std::istringstream repr( ovf_data_representation );
-            repr >> ovf_data_representation;
-            if( ovf_data_representation == "binary" ) 
-                repr >> ovf_binary_length;
-            
-            Log( lvl, sender, fmt::format( "# OVF data representation = {}", ovf_data_representation ) );
-            Log( lvl, sender, fmt::format( "# OVF binary length       = {}", ovf_binary_length ) );
-            
-            // Check that representation and binary length valures are ok
-            if( ovf_data_representation != "text" && ovf_data_representation != "binary" )
-            {
-                spirit_throw(Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
-                    "Data representation must be either \"text\" or \"binary\"");
-            }
-            
-            if( ovf_data_representation == "binary" && 
-                 ovf_binary_length != 4 && ovf_binary_length != 8  )
-            {
-                spirit_throw(Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
-                    "Binary representation can be either \"binary 8\" or \"binary 4\"");
-            }
-
-            // Read the data
-            if( ovf_data_representation == "binary" )
-                OVF_Read_Binary( myfile, ovf_binary_length, ovf_xyz_nodes, vf );
-            else if( ovf_data_representation == "text" )
-                OVF_Read_Text( myfile, geometry, vf ); 
-        
+            OVF_File file( ovfFileName );
+            file.Read_Segment( vf, geometry, idx_segment );
         }
         catch (...) 
         {
@@ -1190,129 +1209,4 @@ namespace IO
         }
     }
     
-    void OVF_Read_Binary( Filter_File_Handle& myfile, const int ovf_binary_length, 
-                          const std::array<int, 3>& ovf_xyz_nodes, vectorfield & vf )
-    {
-        try
-        {        
-            // Set the input stream indicator to the end of the line describing the data block
-            myfile.iss.seekg( std::ios::end );
-            
-            // Check if the initial check value of the binary data is valid
-            if( !OVF_Check_Binary_Initial_Values( myfile, ovf_binary_length ) )
-                spirit_throw(Utility::Exception_Classifier::Bad_File_Content, Utility::Log_Level::Error,
-                    "The OVF initial binary value could not be read correctly");
-
-            // Comparison of datum size compared to scalar type
-            if ( ovf_binary_length == 4 )
-            {
-                int vectorsize = 3 * sizeof(float);
-                float buffer[3];
-                int index;
-                for( int k=0; k<ovf_xyz_nodes[2]; k++ )
-                {
-                    for( int j=0; j<ovf_xyz_nodes[1]; j++ )
-                    {
-                        for( int i=0; i<ovf_xyz_nodes[0]; i++ )
-                        {
-                            index = i + j*ovf_xyz_nodes[0] + k*ovf_xyz_nodes[0]*ovf_xyz_nodes[1];
-
-                            myfile.myfile->read(reinterpret_cast<char *>(&buffer[0]), vectorsize);
-
-                            vf[index][0] = static_cast<scalar>(buffer[0]);
-                            vf[index][1] = static_cast<scalar>(buffer[1]);
-                            vf[index][2] = static_cast<scalar>(buffer[2]);
-                        }
-                    }
-                }
-                
-            }
-            else if (ovf_binary_length == 8)
-            {
-                int vectorsize = 3 * sizeof(double);
-                double buffer[3];
-                int index;
-                for (int k = 0; k<ovf_xyz_nodes[2]; k++)
-                {
-                    for (int j = 0; j<ovf_xyz_nodes[1]; j++)
-                    {
-                        for (int i = 0; i<ovf_xyz_nodes[0]; i++)
-                        {
-                            index = i + j*ovf_xyz_nodes[0] + k*ovf_xyz_nodes[0] * ovf_xyz_nodes[1];
-
-                            myfile.myfile->read(reinterpret_cast<char *>(&buffer[0]), vectorsize);
-
-                            vf[index][0] = static_cast<scalar>(buffer[0]);
-                            vf[index][1] = static_cast<scalar>(buffer[1]);
-                            vf[index][2] = static_cast<scalar>(buffer[2]);
-                        }
-                    }
-                }
-
-            }
-        }
-        catch (...)
-        {
-            spirit_rethrow(    "Failed to read OVF binary data" );
-        }
-    }
-    
-    bool OVF_Check_Binary_Initial_Values( Filter_File_Handle& myfile, const int ovf_binary_length )
-    {
-        try
-        {
-            // create initial check values for the binary data (see OVF specification)
-            uint64_t hex_8byte = 0x42DC12218377DE40;
-            double reference_8byte = *reinterpret_cast<double *>( &hex_8byte );
-            double read_8byte = 0;
-            
-            uint32_t hex_4byte = 0x4996B438;
-            float reference_4byte = *reinterpret_cast<float *>( &hex_4byte );
-            float read_4byte = 0;
-            
-            // check the validity of the initial check value read with the reference one
-            if ( ovf_binary_length == 4 )
-            {    
-                myfile.myfile->read( reinterpret_cast<char *>( &read_4byte ), sizeof(float) );
-                if ( read_4byte != reference_4byte ) 
-                {
-                    spirit_throw( Utility::Exception_Classifier::Bad_File_Content, 
-                                  Utility::Log_Level::Error,
-                                  "OVF initial check value of binary data is inconsistent" );
-                }
-            }
-            else if ( ovf_binary_length == 8 )
-            {
-                myfile.myfile->read( reinterpret_cast<char *>( &read_8byte ), sizeof(double) );
-                if ( read_8byte != reference_8byte )
-                {
-                    spirit_throw( Utility::Exception_Classifier::Bad_File_Content, 
-                                  Utility::Log_Level::Error,
-                                  "OVF initial check value of binary data is inconsistent" );
-                }
-            }
-            
-            return true;
-        }
-        catch (...)
-        {
-            spirit_rethrow(    "Failed to check OVF initial binary value" );
-            return false;
-        }
-    }
-    
-    //// TODO: this function should extended in a way that reads an OVF file with valuedimen larger
-    // than 3. Right now it is reading only the configurarion components.
-    void OVF_Read_Text( Filter_File_Handle& myfile, const Data::Geometry& geometry, vectorfield& vf )
-    {
-        try
-        {
-            Read_ColumnVector_Configuration( myfile, ' ', 0, vf, geometry );
-        }
-        catch (...)
-        {
-            spirit_rethrow(    "Failed to check OVF initial binary value" );
-        }
-    }
-    
 }// end namespace IO
\ No newline at end of file
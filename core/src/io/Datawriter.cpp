@@ -1,6 +1,8 @@
 #include <io/IO.hpp>
 #include <io/Fileformat.hpp>
+#include <io/OVF_File.hpp>
 #include <engine/Vectormath.hpp>
+#include <engine/Decomposition.hpp>
 #include <utility/Logging.hpp>
 #include <utility/Version.hpp>
 
@@ -13,12 +15,12 @@
 #include <iomanip>
 #include <cctype>
 
-#include <fmt/format.h>
-
-#ifdef CORE_USE_THREADS
-#include <thread>
+#ifdef _OPENMP
+#include <omp.h>
 #endif
 
+#include <fmt/format.h>
+
 namespace IO
 {
 	void Write_Energy_Header( const Data::Spin_System & s, const std::string filename, 
@@ -104,39 +106,70 @@ namespace IO
 		Append_String_to_File(line, filename);
 	}
 
-	void Write_Image_Energy_per_Spin( const Data::Spin_System & s, const std::string filename, 
-                                       bool normalize_by_nos )
+	void Write_Image_Energy_per_Spin( Data::Spin_System & s, const std::string filename, 
+                                       bool normalize_by_nos, VF_FileFormat format )
 	{
 		bool readability_toggle = true;
 		scalar nd = 1.0; // nos divide
 		if (normalize_by_nos) nd = 1.0 / s.nos;
 		else nd = 1;
 
-		// s.UpdateEnergy();
+		// The total energy per spin is calculated into the buffer of the system and the
+		// contributions into those of the Hamiltonian, so that no fields are allocated per call
+		auto& contributions_spins = s.UpdateEnergy_per_Spin();
+		auto& E_spins = s.E_per_spin;
+		int nos = s.nos;
+		int n_contributions = contributions_spins.size();
+
+		// Binary output with one value dimension per contribution
+		if (Is_OVF_Format(format))
+		{
+			std::vector<const scalarfield *> fields{ &E_spins };
+			std::vector<std::string> labels{ "E_tot" };
+			for (auto& contribution : contributions_spins)
+			{
+				fields.push_back(&contribution.second);
+				labels.push_back("E_" + contribution.first);
+			}
+			Write_OVF_Scalars(fields, labels, *s.geometry, filename, format, 
+				"Energy contributions per spin", nd);
+			return;
+		}
 
 		Write_Energy_Header(s, filename, {"ispin", "E_tot"});
-		
-		std::vector<std::pair<std::string, scalarfield>> contributions_spins(0);
-		s.hamiltonian->Energy_Contributions_per_Spin(*s.spins, contributions_spins);
 
-		std::string data = "";
-		for (int ispin=0; ispin<s.nos; ++ispin)
+		// The lines are formatted in parallel, in chunks of spins
+		int n_chunks = 1;
+		#ifdef _OPENMP
+		n_chunks = 4 * omp_get_max_threads();
+		#endif
+		n_chunks = std::max(1, std::min(n_chunks, nos));
+		std::vector<std::string> chunks(n_chunks);
+
+		#pragma omp parallel for
+		for (int c=0; c<n_chunks; ++c)
 		{
-			scalar E_spin=0;
-            
-            // BUG: if the energy is not updated at least one this will raise a SIGSEGV
-			
-            for (auto& contribution : contributions_spins) E_spin += contribution.second[ispin];
-			data += fmt::format(" {:^20} || {:^20.10f} |", ispin, E_spin * nd);
-			for (auto pair : contributions_spins)
+			fmt::MemoryWriter writer;
+			for (int ispin = c*nos/n_chunks; ispin < (c+1)*nos/n_chunks; ++ispin)
 			{
-				data += fmt::format("| {:^20.10f} ", pair.second[ispin] * nd);
+				writer.write(" {:^20} || {:^20.10f} |", ispin, E_spins[ispin] * nd);
+				for (int i=0; i<n_contributions; ++i)
+					writer.write("| {:^20.10f} ", contributions_spins[i].second[ispin] * nd);
+				writer << '\n';
 			}
-			data += "\n";
+			chunks[c] = writer.str();
+			if (!readability_toggle) std::replace( chunks[c].begin(), chunks[c].end(), '|', ' ');
 		}
 
-		if (!readability_toggle) std::replace( data.begin(), data.end(), '|', ' ');
-		Append_String_to_File(data, filename);
+		// With MPI, all ranks hold the same data and only rank 0 writes
+		if (Engine::Decomposition::Rank() != 0) return;
+		std::ofstream file(filename, std::ofstream::out | std::ofstream::app);
+		if (!file.is_open())
+		{
+			Log(Utility::Log_Level::Error, Utility::Log_Sender::All, "Could not open " + filename + " to append to file");
+			return;
+		}
+		for (auto& chunk : chunks) file.write(chunk.data(), chunk.size());
 	}
 
 	void Write_System_Force(const Data::Spin_System & s, const std::string filename)
@@ -267,6 +300,7 @@ namespace IO
             case VF_FileFormat::OVF_BIN8:
             case VF_FileFormat::OVF_BIN4:
             case VF_FileFormat::OVF_TEXT:
+            case VF_FileFormat::OVF_BIN4_ZLIB:
                 Save_To_OVF( geometry.positions, geometry, filename, format, comment );
                 break;
             default:
@@ -296,7 +330,9 @@ namespace IO
             case VF_FileFormat::OVF_BIN8:
             case VF_FileFormat::OVF_BIN4:
             case VF_FileFormat::OVF_TEXT:
-            Save_To_OVF( vf, geometry, filename, format, comment );
+            case VF_FileFormat::OVF_BIN4_ZLIB:
+            case VF_FileFormat::OVF_OCT16:
+            Save_To_OVF( vf, geometry, filename, format, comment, append );
             break;
             default:
             Log( Utility::Log_Level::Error, Utility::Log_Sender::API, fmt::format( "Non "
@@ -312,13 +348,32 @@ namespace IO
                                          const std::string filename, VF_FileFormat format, 
                                          const std::string comment, bool append )
     {
-        // except OVF format
-        if ( format == VF_FileFormat::OVF_BIN8 || 
-             format == VF_FileFormat::OVF_BIN4 ||
-             format == VF_FileFormat::OVF_TEXT )
+        std::vector<std::shared_ptr<vectorfield>> images( chain->noi );
+        std::vector<std::shared_ptr<const Data::Geometry>> geometries( chain->noi );
+        for (int image = 0; image < chain->noi; ++image )
+        {
+            images[image]     = chain->images[image]->spins;
+            geometries[image] = chain->images[image]->geometry;
+        }
+        Write_Chain_Spin_Configuration( images, geometries, filename, format, comment, append );
+    }
+
+    void Write_Chain_Spin_Configuration( const std::vector<std::shared_ptr<vectorfield>>& images, 
+                                         const std::vector<std::shared_ptr<const Data::Geometry>>& geometries, 
+                                         const std::string filename, VF_FileFormat format, 
+                                         const std::string comment, bool append )
+    {
+        // OVF files contain one segment per image
+        if ( Is_OVF_Format( format ) )
         {
-            Log( Utility::Log_Level::Error, Utility::Log_Sender::IO, fmt::format( "OVF "
-                 "Format does not support Chain write" ), -1, -1 );
+            std::vector<const vectorfield *> vfs;
+            std::vector<const Data::Geometry *> geoms;
+            for (unsigned int image = 0; image < images.size(); ++image )
+            {
+                vfs.push_back( images[image].get() );
+                geoms.push_back( geometries[image].get() );
+            }
+            Write_OVF( vfs, geoms, filename, format, comment, append );
             return;
         }
         
@@ -328,11 +383,11 @@ namespace IO
         // Header
         std::string output_to_file;
         output_to_file = fmt::format( "### Spin Chain Configuration for {} images with NOS = {} "
-                                      "after iteration {}\n#\n", chain->noi, chain->images[0]->nos, 
+                                      "after iteration {}\n#\n", images.size(), images[0]->size(), 
                                       comment );
         Append_String_to_File( output_to_file, filename );
         
-        for (int image = 0; image < chain->noi; ++image )
+        for (int image = 0; image < images.size(); ++image )
         {
             //// NOTE: with that implementation we are dumping the output_to_file twice for every
             // image. One for the image number header and one with the call to Save_To_SPIRIT(). 
@@ -345,8 +400,7 @@ namespace IO
             output_to_file = fmt::format( "# Image No {}\n", image );
             Append_String_to_File( output_to_file, filename );
             
-            Save_To_SPIRIT( *chain->images[image]->spins, *chain->images[image]->geometry, 
-                            filename, format, comment );
+            Save_To_SPIRIT( *images[image], *geometries[image], filename, format, comment );
         }
     }
     
@@ -360,7 +414,7 @@ namespace IO
         if ( append )
             Append_String_to_File( output_to_file, filename );
         else
-            Dump_to_File( output_to_file, filename );
+            String_to_File( output_to_file, filename );
     }
     
     void Save_To_SPIRIT( const vectorfield& vf, const Data::Geometry& geometry, 
@@ -435,173 +489,9 @@ namespace IO
     
     // Save vectorfield and positions to file OVF in OVF format
     void Save_To_OVF( const vectorfield& vf, const Data::Geometry& geometry, std::string filename, 
-                      VF_FileFormat format, const std::string comment )
+                      VF_FileFormat format, const std::string comment, bool append )
     {
-        std::string output_to_file = "";
-        std::string empty_line = "#\n";
-        output_to_file.reserve( int( 0x08000000 ) );  // reserve 128[MByte]
-        
-        std::string datatype = "";
-        
-        if ( format == VF_FileFormat::OVF_BIN8 ) 
-            datatype = "Binary 8";
-        
-        if ( format == VF_FileFormat::OVF_BIN4 )
-            datatype = "Binary 4";
-        
-        if ( format == VF_FileFormat::OVF_TEXT )
-            datatype = "Text";
-        
-        // Header
-        output_to_file += fmt::format( "# OOMMF OVF 2.0\n" );
-        output_to_file += fmt::format( empty_line );
-        
-        output_to_file += fmt::format( "# Segment count: 1\n" );
-        output_to_file += fmt::format( empty_line );
-        
-        output_to_file += fmt::format( "# Begin: Segment\n" );
-        output_to_file += fmt::format( "# Begin: Header\n" );
-        output_to_file += fmt::format( empty_line );
-        
-        output_to_file += fmt::format( "# Title: SPIRIT Version {}\n", Utility::version_full );
-        output_to_file += fmt::format( empty_line );
-        
-        output_to_file += fmt::format( "# Desc: {}\n", comment );
-        output_to_file += fmt::format( empty_line );
-        
-        // The value dimension is always 3 in this implementation since we are writting Vector3-data
-        output_to_file += fmt::format( "# valuedim: {} ##Value dimension\n", 3 );
-        output_to_file += fmt::format( "# valueunits: None None None\n" );
-        output_to_file += fmt::format( "# valuelabels: spin_x_component spin_y_component "
-                                       "spin_z_component \n" );
-        output_to_file += fmt::format( empty_line );
-        
-        output_to_file += fmt::format( "## Fundamental mesh measurement unit. "
-                                       "Treated as a label:\n" );
-        output_to_file += fmt::format( "# meshunit: nm\n" );                  //// TODO: treat that
-        output_to_file += fmt::format( empty_line );
-        
-        output_to_file += fmt::format( "# xmin: {}\n", geometry.bounds_min[0] );
-        output_to_file += fmt::format( "# ymin: {}\n", geometry.bounds_min[1] );
-        output_to_file += fmt::format( "# zmin: {}\n", geometry.bounds_min[2] );
-        output_to_file += fmt::format( "# xmax: {}\n", geometry.bounds_max[0] );
-        output_to_file += fmt::format( "# ymax: {}\n", geometry.bounds_max[1] );
-        output_to_file += fmt::format( "# zmax: {}\n", geometry.bounds_max[2] );
-        output_to_file += fmt::format( empty_line );
-        
-        // XXX: Spirit does not support irregular geometry yet. We are emmiting rectangular mesh
-        output_to_file += fmt::format( "# meshtype: rectangular\n" );
-        
-        // XXX: maybe this is not true for every system
-        output_to_file += fmt::format( "# xbase: {}\n", 0 );
-        output_to_file += fmt::format( "# ybase: {}\n", 0 );
-        output_to_file += fmt::format( "# zbase: {}\n", 0 );
-        
-        output_to_file += fmt::format( "# xstepsize: {}\n", 
-                                       geometry.lattice_constant * geometry.bravais_vectors[0][0] );
-        output_to_file += fmt::format( "# ystepsize: {}\n", 
-                                       geometry.lattice_constant * geometry.bravais_vectors[1][1] );
-        output_to_file += fmt::format( "# zstepsize: {}\n", 
-                                       geometry.lattice_constant * geometry.bravais_vectors[2][2] );
-        
-        output_to_file += fmt::format( "# xnodes: {}\n", geometry.n_cells[0] );
-        output_to_file += fmt::format( "# ynodes: {}\n", geometry.n_cells[1] );
-        output_to_file += fmt::format( "# znodes: {}\n", geometry.n_cells[2] );
-        output_to_file += fmt::format( empty_line );
-        
-        output_to_file += fmt::format( "# End: Header\n" );
-        output_to_file += fmt::format( empty_line );
-        
-        // Data
-        output_to_file += fmt::format( "# Begin: Data {}\n", datatype );
-        
-        if ( format == VF_FileFormat::OVF_BIN8 || format == VF_FileFormat::OVF_BIN4 )
-        {
-            Dump_to_File( output_to_file, filename );   // dump to file
-            output_to_file = "\n";                      // reset output string (start new line)
-            Write_OVF_bin_data( vf, geometry, filename, format ); // write the binary
-        }
-        else if ( format == VF_FileFormat::OVF_TEXT )
-        {
-            Write_OVF_text_data( vf, geometry, output_to_file );
-        }
-        
-        output_to_file += fmt::format( "# End: Data {}\n", datatype );
-        
-        output_to_file += fmt::format( "# End: Segment\n" );
-        
-        // after data writting append output if binary or dump output if text
-        if ( format == VF_FileFormat::OVF_BIN8 || format == VF_FileFormat::OVF_BIN4 )
-            Append_String_to_File( output_to_file, filename );
-        else if ( format == VF_FileFormat::OVF_TEXT )
-            Dump_to_File( output_to_file, filename );
-        
-    }
-    
-    // Writes the OVF bin data
-    void Write_OVF_bin_data( const vectorfield& vf, const Data::Geometry& geometry, 
-                             const std::string filename, VF_FileFormat format )
-    {
-        // Open the file to append binary
-        std::ofstream outputfile( filename, std::ios::out | std::ios::app | std::ios::binary ); 
-        outputfile.seekp( std::ios::end );                      // go to the end of the header
-        
-        // float test value
-        uint32_t hex_4b_test = 0x4996B438;
-        float ref_4b_test = *reinterpret_cast<float *>( &hex_4b_test );
-        
-        // double test value
-        uint64_t hex_8b_test = 0x42DC12218377DE40;
-        double ref_8b_test = *reinterpret_cast<double *>( &hex_8b_test );
-        
-        if( format == VF_FileFormat::OVF_BIN8 )
-        {
-			// Write binary test value
-			outputfile.write( reinterpret_cast<char *>(&ref_8b_test), sizeof(ref_8b_test) );
-			double buffer[3];
-
-			// Convert every vector of the vf into vector<double> and then write it out
-			for( unsigned int i=0; i<vf.size(); ++i )
-			{                    
-			    buffer[0] = static_cast<double>(vf[i][0]);
-			    buffer[1] = static_cast<double>(vf[i][1]);
-			    buffer[2] = static_cast<double>(vf[i][2]);
-			        
-			    outputfile.write( reinterpret_cast<char *>(&buffer[0]), 
-			                        3 * sizeof(double) ); 
-			}
-        }
-        else if( format == VF_FileFormat::OVF_BIN4 )
-        {
-			// write binary test value
-			outputfile.write( reinterpret_cast<char *>(&ref_4b_test), sizeof(ref_4b_test) );
-			    
-			float buffer[3];
-			    
-			// convert every vector of the vf into vector<float> and then write it out
-			for( unsigned int i=0; i<vf.size(); i++ )
-			{
-			    buffer[0] = static_cast<float>(vf[i][0]);
-			    buffer[1] = static_cast<float>(vf[i][1]);
-			    buffer[2] = static_cast<float>(vf[i][2]);
-			        
-			    outputfile.write( reinterpret_cast<char *>( &buffer[0] ), 
-			                        3 * sizeof(float) ); 
-			}
-        }
-        
-        outputfile.close();
-    }
-    
-    // Writes the OVF text data
-    void Write_OVF_text_data( const vectorfield& vf, const Data::Geometry& geometry, 
-                              std::string& output_to_file )
-    {
-        for (int iatom = 0; iatom < vf.size(); ++iatom)
-        {
-                output_to_file += fmt::format( "{:20.10f} {:20.10f} {:20.10f}\n", 
-                                               vf[iatom][0], vf[iatom][1], vf[iatom][2] );
-        }
+        Write_OVF( { &vf }, { &geometry }, filename, format, comment, append );
     }
     
 }
\ No newline at end of file
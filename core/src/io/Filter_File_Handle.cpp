@@ -4,18 +4,259 @@
 
 #include <iostream>
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
+#include <mutex>
 #include <thread>
 #include <string>
 #include <cstring>
 #include <sstream>
-#include <iostream>
-#include <algorithm>
+
+#include <sys/stat.h>
 
 using namespace Utility;
 
 namespace IO
 {
+    /*----------------------------------------------------------------------------------------------- */
+    /*------------------------------------- Line_Tokenizer ------------------------------------------ */
+    /*----------------------------------------------------------------------------------------------- */
+
+    bool Line_Tokenizer::Skip_Whitespace()
+    {
+        while ( *this->pos != '\0' && std::isspace( (unsigned char)*this->pos ) )
+            ++this->pos;
+        if ( *this->pos == '\0' )
+            this->failed = true;
+        return !this->failed;
+    }
+
+    Line_Tokenizer & Line_Tokenizer::operator>>( int & value )
+    {
+        long l = value;
+        *this >> l;
+        if ( !this->failed )
+            value = (int)l;
+        return *this;
+    }
+
+    Line_Tokenizer & Line_Tokenizer::operator>>( long & value )
+    {
+        if ( this->failed || !this->Skip_Whitespace() )
+            return *this;
+        char * end;
+        long l = std::strtol( this->pos, &end, 10 );
+        if ( end == this->pos )
+            this->failed = true;
+        else
+        {
+            value = l;
+            this->pos = end;
+        }
+        return *this;
+    }
+
+    Line_Tokenizer & Line_Tokenizer::operator>>( float & value )
+    {
+        if ( this->failed || !this->Skip_Whitespace() )
+            return *this;
+        char * end;
+        float f = std::strtof( this->pos, &end );
+        if ( end == this->pos )
+            this->failed = true;
+        else
+        {
+            value = f;
+            this->pos = end;
+        }
+        return *this;
+    }
+
+    Line_Tokenizer & Line_Tokenizer::operator>>( double & value )
+    {
+        if ( this->failed || !this->Skip_Whitespace() )
+            return *this;
+        char * end;
+        double d = std::strtod( this->pos, &end );
+        if ( end == this->pos )
+            this->failed = true;
+        else
+        {
+            value = d;
+            this->pos = end;
+        }
+        return *this;
+    }
+
+    Line_Tokenizer & Line_Tokenizer::operator>>( std::string & value )
+    {
+        if ( this->failed || !this->Skip_Whitespace() )
+            return *this;
+        const char * begin = this->pos;
+        while ( *this->pos != '\0' && !std::isspace( (unsigned char)*this->pos ) )
+            ++this->pos;
+        value.assign( begin, this->pos );
+        return *this;
+    }
+
+    /*----------------------------------------------------------------------------------------------- */
+    /*------------------------------------- Filtered files ------------------------------------------ */
+    /*----------------------------------------------------------------------------------------------- */
+
+    // Recently read files, reused as long as their size, modification time and (where the
+    //      modification time only has a resolution of seconds) contents do not change.
+    //      The cache is bounded by the total size of the files, so that large data files (e.g.
+    //      text OVF files) are not kept in memory after they have been read. The most recently
+    //      read file is kept in any case, so that handles opened one after the other on a large
+    //      input file do not read and index it again.
+    struct Filtered_File_Cache_Entry
+    {
+        std::string filename, comment_tag;
+        long long size, mtime;
+        std::uint64_t hash;
+        std::shared_ptr<const Filtered_File> file;
+    };
+    static std::mutex filtered_file_cache_mutex;
+    static std::vector<Filtered_File_Cache_Entry> filtered_file_cache;
+    static long long filtered_file_cache_bytes = 0;
+    const long long filtered_file_cache_max_bytes = 4*1024*1024;
+
+    #if defined(_WIN32)
+    // The contents are compared as well, as a file rewritten within a second keeps its stamp
+    const bool compare_contents = true;
+    #else
+    const bool compare_contents = false;
+    #endif
+
+    bool File_Stamp( const std::string & filename, long long & size, long long & mtime )
+    {
+        struct stat info;
+        if ( stat( filename.c_str(), &info ) != 0 )
+            return false;
+        size = (long long)info.st_size;
+        #if defined(_WIN32)
+        mtime = (long long)info.st_mtime;
+        #elif defined(__APPLE__)
+        mtime = (long long)info.st_mtimespec.tv_sec * 1000000000LL + info.st_mtimespec.tv_nsec;
+        #else
+        mtime = (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+        #endif
+        return true;
+    }
+
+    // 64 bit FNV-1a hash of the contents of a file
+    std::uint64_t Contents_Hash( const std::string & contents )
+    {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for ( char c : contents )
+        {
+            hash ^= (unsigned char)c;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    bool Read_Contents( const std::string & filename, std::string & contents )
+    {
+        std::ifstream myfile( filename, std::ios::in | std::ios::binary );
+        if ( !myfile.is_open() )
+            return false;
+        contents.assign( (std::istreambuf_iterator<char>(myfile)), std::istreambuf_iterator<char>() );
+        return true;
+    }
+
+    std::shared_ptr<const Filtered_File> Filter_Contents( const std::string & contents, 
+                                                          const std::string & comment_tag )
+    {
+        auto file = std::make_shared<Filtered_File>();
+        std::size_t begin = 0;
+        while ( begin < contents.size() )
+        {
+            std::size_t end = contents.find( '\n', begin );
+            if ( end == std::string::npos )
+                end = contents.size();
+
+            // Remove separator characters and comments, skip lines starting with a comment
+            std::string line;
+            line.reserve( end - begin );
+            for ( std::size_t i = begin; i < end; ++i )
+            {
+                char c = contents[i];
+                if ( c != '|' && c != '+' )
+                    line.push_back( (char)std::tolower( (unsigned char)c ) );
+            }
+            begin = end + 1;
+            std::string::size_type start = line.find( comment_tag );
+            if ( start == 0 )
+                continue;
+            if ( start != std::string::npos )
+                line.erase( start );
+
+            // Index lines which may start with a keyword
+            if ( !line.empty() && ( std::isalpha( (unsigned char)line[0] ) || line[0] == '_' ) )
+            {
+                std::size_t word_end = 0;
+                while ( word_end < line.size() && !std::isspace( (unsigned char)line[word_end] ) )
+                    ++word_end;
+                file->index[line.substr( 0, word_end )].push_back( file->lines.size() );
+            }
+            file->lines.push_back( std::move( line ) );
+        }
+        return file;
+    }
+
+    std::shared_ptr<const Filtered_File> Get_Filtered_File( const std::string & filename, 
+                                                            const std::string & comment_tag )
+    {
+        long long size = 0, mtime = 0;
+        if ( !File_Stamp( filename, size, mtime ) )
+            return nullptr;
+        std::string contents;
+        std::uint64_t hash = 0;
+        if ( compare_contents )
+        {
+            if ( !Read_Contents( filename, contents ) )
+                return nullptr;
+            hash = Contents_Hash( contents );
+        }
+
+        std::lock_guard<std::mutex> guard( filtered_file_cache_mutex );
+        for ( auto& entry : filtered_file_cache )
+        {
+            if ( entry.filename == filename && entry.comment_tag == comment_tag && 
+                 entry.size == size && entry.mtime == mtime && entry.hash == hash )
+                return entry.file;
+        }
+
+        if ( !compare_contents && !Read_Contents( filename, contents ) )
+            return nullptr;
+        auto file = Filter_Contents( contents, comment_tag );
+
+        auto stale = std::remove_if( filtered_file_cache.begin(), filtered_file_cache.end(),
+            [&]( const Filtered_File_Cache_Entry & entry )
+            { return entry.filename == filename && entry.comment_tag == comment_tag; } );
+        for ( auto it = stale; it != filtered_file_cache.end(); ++it )
+            filtered_file_cache_bytes -= it->size;
+        filtered_file_cache.erase( stale, filtered_file_cache.end() );
+
+        // The oldest entries are dropped to make room, but the new one is kept even if it is
+        // larger than the cache
+        filtered_file_cache.push_back( { filename, comment_tag, size, mtime, hash, file } );
+        filtered_file_cache_bytes += size;
+        while ( filtered_file_cache.size() > 1 && filtered_file_cache_bytes > filtered_file_cache_max_bytes )
+        {
+            filtered_file_cache_bytes -= filtered_file_cache.front().size;
+            filtered_file_cache.erase( filtered_file_cache.begin() );
+        }
+        return file;
+    }
+
+    /*----------------------------------------------------------------------------------------------- */
+    /*---------------------------------- Filter_File_Handle ----------------------------------------- */
+    /*----------------------------------------------------------------------------------------------- */
+
     Filter_File_Handle::Filter_File_Handle( const std::string& filename, IO::VF_FileFormat format ):
         filename(filename), iss("")
     {
@@ -23,8 +264,7 @@ namespace IO
         this->dump = "";
         this->line = "";
         this->found = std::string::npos;
-        this->myfile = std::unique_ptr<std::ifstream>( new std::ifstream( filename,
-                                                        std::ios::in | std::ios::binary ) );
+        this->next_line = 0;
         
         // set the comment tag
         switch( this->ff )
@@ -32,6 +272,8 @@ namespace IO
             case VF_FileFormat::OVF_BIN8:
             case VF_FileFormat::OVF_BIN4:
             case VF_FileFormat::OVF_TEXT:
+            case VF_FileFormat::OVF_BIN4_ZLIB:
+            case VF_FileFormat::OVF_OCT16:
                 this->comment_tag = "##";
                 break;
             // for every SPIRIT file format
@@ -39,63 +281,86 @@ namespace IO
                 this->comment_tag = "#";
         }
         
-        // if the file is not open
-        if ( !this->myfile->is_open() )
+        // if the file could not be read
+        this->file = Get_Filtered_File( filename, this->comment_tag );
+        if ( !this->file )
         spirit_throw(Exception_Classifier::File_not_Found, Log_Level::Error, fmt::format("Could not open file \"{}\"", filename));
     }
 
     Filter_File_Handle::~Filter_File_Handle()
     { 
-        myfile->close();
     }
 
     bool Filter_File_Handle::GetLine_Handle()
     {
-        this->line = "";
-        
         //	if there is a next line
-        if ( (bool) getline( *this->myfile, this->line ) )
+        if ( this->next_line < this->file->lines.size() )
         {
-            //  remove separator characters
-            Remove_Chars_From_String( this->line, (char *) "|+" );
-            
-            // if the string does not start with a comment identifier
-            if ( Remove_Comments_From_String( this->line ) ) 
-                return true;
-            else 
-                return GetLine();
+            this->line = this->file->lines[this->next_line];
+            ++this->next_line;
+            return true;
         }
+        this->line = "";
         return false;     // if there is no next line, return false
     }
 
     bool Filter_File_Handle::GetLine()
     {
         if (Filter_File_Handle::GetLine_Handle())
-        {
-            // decapitalize line
-            std::transform( this->line.begin(), this->line.end(), this->line.begin(), ::tolower );
-            
             return Filter_File_Handle::Find_in_Line("");
-        }
         return false;
     }
 
     void Filter_File_Handle::ResetStream()
     {
-        myfile->clear();
-        myfile->seekg(0, std::ios::beg);
+        this->next_line = 0;
     }
 
     bool Filter_File_Handle::Find(const std::string & s)
     {
-        myfile->clear();
-        myfile->seekg(0, std::ios::beg);
+        std::size_t idx_found = std::string::npos;
+        auto& lines = this->file->lines;
 
-        while (GetLine())
+        if ( !s.empty() && ( std::isalpha( (unsigned char)s[0] ) || s[0] == '_' ) )
         {
-            if (Find_in_Line(s)) return true;
+            // Look up the lines starting with a word which begins like s
+            std::string word = s.substr( 0, s.find_first_of( " \t" ) );
+            auto& index = this->file->index;
+            for ( auto it = index.lower_bound( word ); 
+                  it != index.end() && !it->first.compare( 0, word.size(), word ); ++it )
+            {
+                for ( auto idx_line : it->second )
+                {
+                    if ( idx_line >= idx_found )
+                        break;
+                    if ( !lines[idx_line].compare( 0, s.size(), s ) )
+                    {
+                        idx_found = idx_line;
+                        break;
+                    }
+                }
+            }
         }
-        return false;
+        else
+        {
+            for ( std::size_t idx_line = 0; idx_line < lines.size(); ++idx_line )
+            {
+                if ( !lines[idx_line].compare( 0, s.size(), s ) )
+                {
+                    idx_found = idx_line;
+                    break;
+                }
+            }
+        }
+
+        if ( idx_found == std::string::npos )
+        {
+            this->next_line = lines.size();
+            return false;
+        }
+        this->line = lines[idx_found];
+        this->next_line = idx_found + 1;
+        return Find_in_Line(s);
     }
 
     bool Filter_File_Handle::Find_in_Line( const std::string & s )
@@ -106,13 +371,17 @@ namespace IO
             iss.clear();    // empty the stream
             iss.str(line);  // copy line into the iss stream
             dump = "";      // TODO: since we have the init in the constructor we might not need that
+            tokens.Set( line.c_str() );
             
             // if s is not empty
             if ( s.compare("") )
             {
                 int words = Count_Words( s );
                 for( int i=0; i<words; i++ )
+                {
                     iss >> dump;
+                    tokens >> dump;
+                }
             }
             
             return true;
@@ -130,14 +399,14 @@ namespace IO
 
     bool Filter_File_Handle::Remove_Comments_From_String( std::string &str )
     {
-        std::string::size_type start = this->line.find( this->comment_tag );
+        std::string::size_type start = str.find( this->comment_tag );
         
         // if the line starts with a comment return false
         if ( start == 0 ) return false;
         
         // if the line has a comment somewhere remove it by trimming
         if ( start != std::string::npos )
-            line.erase( this->line.begin() + start , this->line.end() );
+            str.erase( str.begin() + start , str.end() );
         
         // return true
         return true;
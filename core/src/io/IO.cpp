@@ -13,6 +13,7 @@
 #include <cctype>
 
 #include <io/IO.hpp>
+#include <engine/Decomposition.hpp>
 #include <utility/Logging.hpp>
 
 using Utility::Log_Level;
@@ -23,27 +24,22 @@ namespace IO
     // ------ Saving Helpers --------------------------------------------
 
     /*
-        Dump_to_File detaches a thread which writes the given string to a file.
-        This is asynchronous (i.e. fire & forget)
+        Dump_to_File queues the writing of the given string in the asynchronous output.
+        The text is moved into the task, so the caller does not wait for it to be written.
     */
-    void Dump_to_File(const std::string text, const std::string name)
+    void Dump_to_File(std::string text, const std::string name)
     {
-        
-        #ifdef CORE_USE_THREADS
-        // thread:      method       args  args    args   detatch thread
-        std::thread(String_to_File, text, name).detach();
-        #else
-        String_to_File(text, name);
-        #endif
+        auto n_bytes = text.size();
+        auto data = std::make_shared<std::string>(std::move(text));
+        Output_Queue::Enqueue(name, [data, name]() { String_to_File(*data, name); }, n_bytes);
     }
 
-    void Dump_to_File(const std::vector<std::string> text, const std::string name, const int no)
+    void Dump_to_File(std::vector<std::string> text, const std::string name, const int no)
     {
-        #ifdef CORE_USE_THREADS
-        std::thread(Strings_to_File, text, name, no).detach();
-        #else
-        Strings_to_File(text, name, no);
-        #endif
+        std::size_t n_bytes = 0;
+        for (auto& t : text) n_bytes += t.size();
+        auto data = std::make_shared<std::vector<std::string>>(std::move(text));
+        Output_Queue::Enqueue(name, [data, name, no]() { Strings_to_File(*data, name, no); }, n_bytes);
     }
 
     /*
@@ -52,6 +48,8 @@ namespace IO
     */
     void Strings_to_File(const std::vector<std::string> text, const std::string name, const int no)
     {
+        // With MPI, all ranks hold the same data and only rank 0 writes
+        if (Engine::Decomposition::Rank() != 0) return;
 
         std::ofstream myfile;
         myfile.open(name);
@@ -72,6 +70,9 @@ namespace IO
 
     void Append_String_to_File(const std::string text, const std::string name)
     {
+        // With MPI, all ranks hold the same data and only rank 0 writes
+        if (Engine::Decomposition::Rank() != 0) return;
+
         std::ofstream myfile;
         myfile.open(name, std::ofstream::out | std::ofstream::app);
         if (myfile.is_open())
@@ -0,0 +1,63 @@
+#include <io/Mapped_File.hpp>
+#include <utility/Exception.hpp>
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Utility;
+
+namespace IO
+{
+    Mapped_File::Mapped_File(const std::string & filename) :
+        begin(nullptr), length(0), mapped(false)
+    {
+        #ifndef _WIN32
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            spirit_throw(Exception_Classifier::File_not_Found, Log_Level::Error,
+                "Could not open file \"" + filename + "\"");
+
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+            info.st_size = -1;
+        if (info.st_size > 0)
+        {
+            void * address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED)
+            {
+                this->begin  = static_cast<const char *>(address);
+                this->length = info.st_size;
+                this->mapped = true;
+            }
+        }
+        close(fd);
+        if (this->mapped || info.st_size == 0)
+            return;
+        #endif
+
+        // Fall back to reading the whole file
+        std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+            spirit_throw(Exception_Classifier::File_not_Found, Log_Level::Error,
+                "Could not open file \"" + filename + "\"");
+        this->buffer.resize(file.tellg());
+        file.seekg(0);
+        file.read(this->buffer.data(), this->buffer.size());
+        this->begin  = this->buffer.data();
+        this->length = this->buffer.size();
+    }
+
+    Mapped_File::~Mapped_File()
+    {
+        #ifndef _WIN32
+        if (this->mapped)
+            munmap(const_cast<char *>(this->begin), this->length);
+        #endif
+    }
+}
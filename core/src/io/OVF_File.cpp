@@ -0,0 +1,956 @@
+#include <io/OVF_File.hpp>
+#include <engine/Decomposition.hpp>
+#include <utility/Logging.hpp>
+#include <utility/Exception.hpp>
+#include <utility/Version.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef SPIRIT_USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <fmt/format.h>
+
+using namespace Utility;
+
+namespace IO
+{
+    // Check values at the beginning of binary data (see OVF specification)
+    const std::uint32_t check_value_4 = 0x4996B438;
+    const std::uint64_t check_value_8 = 0x42DC12218377DE40;
+
+    // Compressed data blocks start with the uncompressed and the compressed size
+    const std::size_t compressed_header_length = 2 * sizeof(std::uint64_t);
+    // Upper bound of the compression ratio of zlib, used to reject corrupt block sizes
+    const std::uint64_t max_compression_ratio = 1032;
+    #ifdef SPIRIT_USE_ZLIB
+    const bool zlib_available = true;
+    #else
+    const bool zlib_available = false;
+    #endif
+
+    // Scale of the 2 byte integers of the octahedral encoding
+    const scalar octahedral_scale = 32767;
+
+    // Number of chunks into which text data is split for parallel conversion
+    int N_Chunks()
+    {
+        #ifdef _OPENMP
+        return 4 * omp_get_max_threads();
+        #else
+        return 1;
+        #endif
+    }
+
+    std::string Trim(const std::string & s)
+    {
+        auto begin = s.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) return "";
+        auto end = s.find_last_not_of(" \t\r\n");
+        return s.substr(begin, end - begin + 1);
+    }
+
+    std::string Lowercase(std::string s)
+    {
+        std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+        return s;
+    }
+
+    // Splits a header line "# key: value ## comment" into lowercase key and value
+    bool Header_Entry(const std::string & line, std::string & key, std::string & value)
+    {
+        if (line.size() < 2 || line[0] != '#' || line[1] == '#') return false;
+        auto colon = line.find(':');
+        if (colon == std::string::npos) return false;
+        key   = Lowercase(Trim(line.substr(1, colon - 1)));
+        value = line.substr(colon + 1);
+        auto comment = value.find("##");
+        if (comment != std::string::npos) value.erase(comment);
+        value = Trim(value);
+        return true;
+    }
+
+    // Reads the line starting at pos and returns the position of the next line
+    std::size_t Get_Line(const char * data, std::size_t size, std::size_t pos, std::string & line)
+    {
+        const char * end = static_cast<const char *>(std::memchr(data + pos, '\n', size - pos));
+        std::size_t line_end = end ? end - data : size;
+        line.assign(data + pos, line_end - pos);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        return end ? line_end + 1 : size;
+    }
+
+    // Position of the next "# End: Data" line at or after pos
+    std::size_t Find_End_Data(const char * data, std::size_t size, std::size_t pos)
+    {
+        while (pos < size)
+        {
+            const char * hash = static_cast<const char *>(std::memchr(data + pos, '#', size - pos));
+            if (!hash) break;
+            std::size_t at = hash - data;
+            if (at == 0 || data[at-1] == '\n' || data[at-1] == '\r')
+            {
+                std::string line;
+                Get_Line(data, size, at, line);
+                std::string key, value;
+                if (Header_Entry(line, key, value) && key == "end" && Lowercase(value).compare(0, 4, "data") == 0)
+                    return at;
+            }
+            pos = at + 1;
+        }
+        return std::string::npos;
+    }
+
+    void Require_Zlib()
+    {
+        if (!zlib_available)
+            spirit_throw(Exception_Classifier::Not_Implemented, Log_Level::Error,
+                "Compressed OVF data requires Spirit to be built with SPIRIT_USE_ZLIB");
+    }
+
+    // Appends the compressed block of raw to buffer
+    void Compress_Data(const std::string & raw, std::string & buffer)
+    {
+        Require_Zlib();
+        #ifdef SPIRIT_USE_ZLIB
+        std::size_t offset = buffer.size();
+        uLongf length = compressBound(raw.size());
+        buffer.resize(offset + compressed_header_length + length);
+        int status = compress2(reinterpret_cast<Bytef *>(&buffer[offset + compressed_header_length]), &length,
+            reinterpret_cast<const Bytef *>(raw.data()), raw.size(), Z_DEFAULT_COMPRESSION);
+        if (status != Z_OK)
+            spirit_throw(Exception_Classifier::Unknown_Exception, Log_Level::Error,
+                fmt::format("Compression of OVF data failed with zlib error {}", status));
+        std::uint64_t sizes[2] = { raw.size(), length };
+        std::memcpy(&buffer[offset], sizes, sizeof(sizes));
+        buffer.resize(offset + compressed_header_length + length);
+        #endif
+    }
+
+    // Decompresses the block starting at block into raw, which is expected to hold expected_length bytes
+    void Decompress_Data(const char * block, std::size_t expected_length, std::string & raw)
+    {
+        Require_Zlib();
+        #ifdef SPIRIT_USE_ZLIB
+        std::uint64_t sizes[2];
+        std::memcpy(sizes, block, sizeof(sizes));
+        if (sizes[0] != expected_length)
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("Compressed OVF data has {} bytes, but {} were expected", sizes[0], expected_length));
+        raw.resize(sizes[0]);
+        uLongf length = sizes[0];
+        int status = uncompress(reinterpret_cast<Bytef *>(&raw[0]), &length,
+            reinterpret_cast<const Bytef *>(block + compressed_header_length), sizes[1]);
+        if (status != Z_OK || length != sizes[0])
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("Compressed OVF data is corrupt (zlib error {})", status));
+        #endif
+    }
+
+    // Encodes a unit vector by its position on the octahedron |x|+|y|+|z|=1, of which the lower
+    // half is folded outwards onto the square |x|+|y|<=1. Zero vectors are encoded as +z.
+    void Octahedral_Encode(const Vector3 & v, std::int16_t encoded[2])
+    {
+        scalar norm = std::abs(v[0]) + std::abs(v[1]) + std::abs(v[2]);
+        scalar x = 0, y = 0;
+        if (norm > 0)
+        {
+            x = v[0] / norm;
+            y = v[1] / norm;
+            if (v[2] < 0)
+            {
+                scalar x_upper = x;
+                x = (1 - std::abs(y))       * (x >= 0 ? 1 : -1);
+                y = (1 - std::abs(x_upper)) * (y >= 0 ? 1 : -1);
+            }
+        }
+        encoded[0] = std::int16_t(std::round(x * octahedral_scale));
+        encoded[1] = std::int16_t(std::round(y * octahedral_scale));
+    }
+
+    Vector3 Octahedral_Decode(const std::int16_t encoded[2])
+    {
+        scalar x = encoded[0] / octahedral_scale;
+        scalar y = encoded[1] / octahedral_scale;
+        scalar z = 1 - std::abs(x) - std::abs(y);
+        if (z < 0)
+        {
+            scalar x_folded = x;
+            x = (1 - std::abs(y))        * (x >= 0 ? 1 : -1);
+            y = (1 - std::abs(x_folded)) * (y >= 0 ? 1 : -1);
+        }
+        return Vector3{ x, y, z }.normalized();
+    }
+
+    bool Valid_Check_Value(const char * data, int length)
+    {
+        if (length == 4)
+        {
+            std::uint32_t check;
+            std::memcpy(&check, data, length);
+            return check == check_value_4;
+        }
+        std::uint64_t check;
+        std::memcpy(&check, data, length);
+        return check == check_value_8;
+    }
+
+    // Bytes per vector and of the check value preceding the vectors of binary data
+    std::size_t Value_Stride(const std::string & representation, int valuedim, int binary_length)
+    {
+        return representation == "octahedral" ? 2 * binary_length : valuedim * binary_length;
+    }
+
+    std::size_t Check_Length(const std::string & representation, int binary_length)
+    {
+        return representation == "binary" ? binary_length : 0;
+    }
+
+    OVF_File::OVF_File(const std::string & filename) :
+        filename(filename), file(new Mapped_File(filename))
+    {
+        const char * data = file->data();
+        std::size_t size  = file->size();
+
+        std::string line, key, value;
+        std::size_t pos = size > 0 ? Get_Line(data, size, 0, line) : 0;
+        std::string first = Lowercase(Trim(line));
+        if (first.compare(0, 11, "# oommf ovf") != 0)
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("\"{}\" is not an OVF file", filename));
+        std::string version = Trim(first.substr(11));
+        if (version != "2.0" && version != "2")
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("OVF {0} is not supported", version));
+
+        int segment_count = -1;
+        while (pos < size)
+        {
+            pos = Get_Line(data, size, pos, line);
+            if (!Header_Entry(line, key, value)) continue;
+            if (key == "segment count")
+                segment_count = std::atoi(value.c_str());
+            else if (key == "begin" && Lowercase(value) == "segment")
+            {
+                Segment segment;
+                pos = this->Index_Segment(pos, segment);
+                this->segments.push_back(segment);
+            }
+        }
+
+        if (this->segments.empty())
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("OVF file \"{}\" contains no segments", filename));
+        if (segment_count >= 0 && segment_count != int(this->segments.size()))
+            Log(Log_Level::Warning, Log_Sender::IO, fmt::format("OVF file \"{}\" declares {} segments, "
+                "but contains {}", filename, segment_count, this->segments.size()));
+    }
+
+    std::size_t OVF_File::Index_Segment(std::size_t pos, Segment & segment)
+    {
+        const char * data = file->data();
+        std::size_t size  = file->size();
+
+        std::string line, key, value;
+        while (pos < size)
+        {
+            pos = Get_Line(data, size, pos, line);
+            if (!Header_Entry(line, key, value)) continue;
+
+            if      (key == "title")      segment.title = value;
+            else if (key == "valuedim")   segment.valuedim = std::atoi(value.c_str());
+            else if (key == "meshtype")   segment.meshtype = Lowercase(value);
+            else if (key == "xnodes")     segment.nodes[0] = std::atoi(value.c_str());
+            else if (key == "ynodes")     segment.nodes[1] = std::atoi(value.c_str());
+            else if (key == "znodes")     segment.nodes[2] = std::atoi(value.c_str());
+            else if (key == "pointcount") segment.pointcount = std::atoi(value.c_str());
+            else if (key == "end" && Lowercase(value) == "segment")
+                return pos;
+            else if (key == "begin" && Lowercase(value).compare(0, 4, "data") == 0)
+            {
+                std::istringstream repr(Lowercase(value).substr(4));
+                std::string compression;
+                repr >> segment.representation;
+                if (segment.representation == "binary" || segment.representation == "octahedral")
+                    repr >> segment.binary_length >> compression;
+                segment.compressed = compression == "zlib";
+
+                // Check the header
+                if (segment.valuedim < 3)
+                    spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                        fmt::format("OVF value dimension {} is not supported", segment.valuedim));
+                if (segment.meshtype == "rectangular")
+                    segment.n_values = segment.nodes[0] * segment.nodes[1] * segment.nodes[2];
+                else if (segment.meshtype == "irregular")
+                    segment.n_values = segment.pointcount;
+                else
+                    spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                        "Mesh type must be either \"rectangular\" or \"irregular\"");
+                if (segment.representation != "text" && segment.representation != "binary" &&
+                    segment.representation != "octahedral")
+                    spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                        "Data representation must be either \"text\", \"binary\" or \"octahedral\"");
+                if (segment.representation == "binary" && segment.binary_length != 4 && segment.binary_length != 8)
+                    spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                        "Binary representation can be either \"binary 8\" or \"binary 4\"");
+                if (segment.representation == "octahedral" && segment.binary_length != 2)
+                    spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                        "Octahedral representation must be \"octahedral 2\"");
+                if (!compression.empty() && !segment.compressed)
+                    spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                        fmt::format("OVF data compression \"{}\" is not supported", compression));
+
+                segment.data_begin = pos;
+                std::size_t check_length = Check_Length(segment.representation, segment.binary_length);
+                std::size_t stride = Value_Stride(segment.representation, segment.valuedim, segment.binary_length);
+                if (segment.compressed)
+                {
+                    // The sizes of the block give its end and the number of values, the check
+                    // value is verified after decompression
+                    std::uint64_t sizes[2];
+                    if (pos + compressed_header_length > size)
+                        spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                            "OVF compressed data ends prematurely");
+                    std::memcpy(sizes, data + pos, sizeof(sizes));
+                    if (sizes[1] > size - pos - compressed_header_length || sizes[0] < check_length)
+                        spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                            "OVF compressed data ends prematurely");
+                    if ((sizes[0] - check_length) % stride != 0 ||
+                        (sizes[0] - check_length) / stride > std::uint64_t(std::numeric_limits<int>::max()) ||
+                        sizes[0] > max_compression_ratio * (sizes[1] + 1))
+                        spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                            "OVF compressed data has an invalid size");
+                    segment.data_end = pos + compressed_header_length + sizes[1];
+                    segment.n_values = int((sizes[0] - check_length) / stride);
+                }
+                else if (segment.representation != "text")
+                {
+                    // Check value
+                    if (pos + check_length > size)
+                        spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                            "OVF binary data ends prematurely");
+                    if (check_length > 0 && !Valid_Check_Value(data + pos, check_length))
+                        spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                            "OVF initial check value of binary data is inconsistent");
+
+                    // The data normally ends after the number of values given by the mesh, but
+                    // e.g. files with several atoms per cell contain more
+                    std::size_t values_begin = pos + check_length;
+                    std::size_t expected_end = values_begin + segment.n_values * stride;
+                    std::size_t end = Find_End_Data(data, size, std::min(expected_end, size));
+                    if (end == std::string::npos)
+                        end = Find_End_Data(data, size, values_begin);
+                    if (end == std::string::npos)
+                        spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                            "OVF binary data is not terminated");
+                    if (end > values_begin && data[end-1] == '\n') --end;
+                    segment.data_end = end;
+                    segment.n_values = int((end - values_begin) / stride);
+                }
+                else
+                {
+                    segment.data_end = Find_End_Data(data, size, pos);
+                    if (segment.data_end == std::string::npos)
+                        spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                            "OVF text data is not terminated");
+                }
+                pos = Get_Line(data, size, segment.data_end, line);
+            }
+        }
+
+        if (segment.representation.empty())
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                "OVF segment contains no data");
+        return pos;
+    }
+
+    int OVF_File::n_segments() const
+    {
+        return this->segments.size();
+    }
+
+    int OVF_File::n_values(int idx_segment) const
+    {
+        return this->segments.at(idx_segment).n_values;
+    }
+
+    void OVF_File::Read_Segment(vectorfield & vf, const Data::Geometry & geometry, int idx_segment) const
+    {
+        if (idx_segment < 0 || idx_segment >= this->n_segments())
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("OVF file \"{}\" has no segment {}", this->filename, idx_segment));
+        auto& segment = this->segments[idx_segment];
+
+        auto lvl = Log_Level::Parameter;
+        auto sender = Log_Sender::IO;
+        Log( lvl, sender, fmt::format( "# OVF segment             = {} of {}", idx_segment+1, this->n_segments() ) );
+        Log( lvl, sender, fmt::format( "# OVF title               = {}", segment.title ) );
+        Log( lvl, sender, fmt::format( "# OVF values dimensions   = {}", segment.valuedim ) );
+        Log( lvl, sender, fmt::format( "# OVF meshtype            = {}", segment.meshtype ) );
+        Log( lvl, sender, fmt::format( "# OVF nodes               = {} {} {}", segment.nodes[0], segment.nodes[1], segment.nodes[2] ) );
+        Log( lvl, sender, fmt::format( "# OVF data representation = {}", segment.representation ) );
+        Log( lvl, sender, fmt::format( "# OVF binary length       = {}", segment.binary_length ) );
+
+        // Check that nos is smaller or equal to the nos of the current image
+        if ( segment.n_values > geometry.nos )
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                "NOS of the OVF file is greater than the NOS in the current image");
+
+        // Check if the geometry of the ovf file is the same with the one of the current image
+        if ( segment.meshtype == "rectangular" &&
+             ( segment.nodes[0] != geometry.n_cells[0] ||
+               segment.nodes[1] != geometry.n_cells[1] ||
+               segment.nodes[2] != geometry.n_cells[2] ) )
+        {
+            Log(Log_Level::Warning, sender, "The geometry of the OVF file does not match the geometry "
+                "of the current image");
+        }
+
+        int n = std::min(int(vf.size()), geometry.nos);
+        if (segment.representation == "text")
+            this->Read_Text(segment, vf, n);
+        else
+            this->Read_Binary(segment, vf, std::min(n, segment.n_values));
+    }
+
+    template<typename T>
+    void Convert_Binary(const char * values, std::size_t stride, vectorfield & vf, int n)
+    {
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+        {
+            T buffer[3];
+            std::memcpy(buffer, values + i * stride, sizeof(buffer));
+            vf[i] = Vector3{ scalar(buffer[0]), scalar(buffer[1]), scalar(buffer[2]) };
+        }
+    }
+
+    void Convert_Octahedral(const char * values, vectorfield & vf, int n)
+    {
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+        {
+            std::int16_t encoded[2];
+            std::memcpy(encoded, values + i * sizeof(encoded), sizeof(encoded));
+            vf[i] = Octahedral_Decode(encoded);
+        }
+    }
+
+    void OVF_File::Read_Binary(const Segment & segment, vectorfield & vf, int n) const
+    {
+        const char * data = this->file->data() + segment.data_begin;
+        std::string raw;
+        if (segment.compressed)
+        {
+            // The number of values was checked against the geometry before, which bounds the allocation
+            std::size_t expected_length = Check_Length(segment.representation, segment.binary_length) +
+                std::size_t(segment.n_values) * Value_Stride(segment.representation, segment.valuedim, segment.binary_length);
+            Decompress_Data(data, expected_length, raw);
+            data = raw.data();
+            if (segment.representation == "binary" && !Valid_Check_Value(data, segment.binary_length))
+                spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                    "OVF initial check value of binary data is inconsistent");
+        }
+
+        const char * values = data + Check_Length(segment.representation, segment.binary_length);
+        std::size_t stride = Value_Stride(segment.representation, segment.valuedim, segment.binary_length);
+        if (segment.representation == "octahedral")
+            Convert_Octahedral(values, vf, n);
+        else if (segment.binary_length == 4)
+            Convert_Binary<float>(values, stride, vf, n);
+        else
+            Convert_Binary<double>(values, stride, vf, n);
+    }
+
+    // Whether a line of text data contains values, i.e. is neither empty nor a comment
+    bool Is_Data_Line(const char * begin, const char * end)
+    {
+        while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r')) ++begin;
+        return begin < end && *begin != '#';
+    }
+
+    void OVF_File::Read_Text(const Segment & segment, vectorfield & vf, int n) const
+    {
+        const char * data  = this->file->data();
+        const char * begin = data + segment.data_begin;
+        const char * end   = data + segment.data_end;
+
+        // Split the data into chunks of whole lines
+        int n_chunks = N_Chunks();
+        std::vector<const char *> chunks(n_chunks + 1, end);
+        chunks[0] = begin;
+        for (int c = 1; c < n_chunks; ++c)
+        {
+            const char * at = std::max(chunks[c-1], begin + (end - begin) * c / n_chunks);
+            const char * line_end = static_cast<const char *>(std::memchr(at, '\n', end - at));
+            chunks[c] = line_end ? line_end + 1 : end;
+        }
+
+        // Count the lines of each chunk to find the index of its first vector
+        std::vector<int> offsets(n_chunks + 1, 0);
+        #pragma omp parallel for
+        for (int c = 0; c < n_chunks; ++c)
+        {
+            int count = 0;
+            for (const char * line = chunks[c]; line < chunks[c+1]; )
+            {
+                const char * line_end = static_cast<const char *>(std::memchr(line, '\n', chunks[c+1] - line));
+                if (!line_end) line_end = chunks[c+1];
+                if (Is_Data_Line(line, line_end)) ++count;
+                line = line_end + 1;
+            }
+            offsets[c+1] = count;
+        }
+        for (int c = 0; c < n_chunks; ++c)
+            offsets[c+1] += offsets[c];
+        if (offsets[n_chunks] < n)
+            Log(Log_Level::Warning, Log_Sender::IO, fmt::format("OVF file \"{}\" contains {} vectors, "
+                "expected {}", this->filename, offsets[n_chunks], n));
+
+        // Convert the lines
+        #pragma omp parallel for
+        for (int c = 0; c < n_chunks; ++c)
+        {
+            int idx = offsets[c];
+            for (const char * line = chunks[c]; line < chunks[c+1] && idx < n; )
+            {
+                const char * line_end = static_cast<const char *>(std::memchr(line, '\n', chunks[c+1] - line));
+                if (!line_end) line_end = chunks[c+1];
+                if (Is_Data_Line(line, line_end))
+                {
+                    // The data block is followed by the "# End: Data" line, so strtod stops in the file
+                    const char * value = line;
+                    for (int dim = 0; dim < 3; ++dim)
+                    {
+                        char * value_end;
+                        double x = std::strtod(value, &value_end);
+                        if (value_end > line_end) value_end = const_cast<char *>(value);
+                        vf[idx][dim] = value_end == value ? 0 : scalar(x);
+                        value = value_end;
+                    }
+                    ++idx;
+                }
+                line = line_end + 1;
+            }
+        }
+    }
+
+    std::string Segment_Header( const Data::Geometry & geometry, const std::string & datatype,
+                                const std::string & comment,
+                                const std::vector<std::string> & labels = { "spin_x_component",
+                                    "spin_y_component", "spin_z_component" } )
+    {
+        std::string empty_line = "#\n";
+        std::string header = "";
+
+        header += fmt::format( "# Begin: Segment\n" );
+        header += fmt::format( "# Begin: Header\n" );
+        header += fmt::format( empty_line );
+
+        header += fmt::format( "# Title: SPIRIT Version {}\n", Utility::version_full );
+        header += fmt::format( empty_line );
+
+        header += fmt::format( "# Desc: {}\n", comment );
+        header += fmt::format( empty_line );
+
+        // The value dimension is 3 for Vector3-data and the number of fields for scalar data
+        std::string units = "", valuelabels = "";
+        for ( auto& label : labels )
+        {
+            units += units.empty() ? "None" : " None";
+            valuelabels += label + " ";
+        }
+        header += fmt::format( "# valuedim: {} ##Value dimension\n", labels.size() );
+        header += fmt::format( "# valueunits: {}\n", units );
+        header += fmt::format( "# valuelabels: {}\n", valuelabels );
+        header += fmt::format( empty_line );
+
+        header += fmt::format( "## Fundamental mesh measurement unit. "
+                               "Treated as a label:\n" );
+        header += fmt::format( "# meshunit: nm\n" );                  //// TODO: treat that
+        header += fmt::format( empty_line );
+
+        header += fmt::format( "# xmin: {}\n", geometry.bounds_min[0] );
+        header += fmt::format( "# ymin: {}\n", geometry.bounds_min[1] );
+        header += fmt::format( "# zmin: {}\n", geometry.bounds_min[2] );
+        header += fmt::format( "# xmax: {}\n", geometry.bounds_max[0] );
+        header += fmt::format( "# ymax: {}\n", geometry.bounds_max[1] );
+        header += fmt::format( "# zmax: {}\n", geometry.bounds_max[2] );
+        header += fmt::format( empty_line );
+
+        // A geometry whose spins do not fill its lattice, e.g. the spins of an output region, is
+        // written as an irregular mesh of nos points
+        if ( geometry.nos != geometry.n_cells_total * geometry.n_cell_atoms )
+        {
+            header += fmt::format( "# meshtype: irregular\n" );
+            header += fmt::format( "# pointcount: {}\n", geometry.nos );
+        }
+        else
+        {
+            header += fmt::format( "# meshtype: rectangular\n" );
+
+            // XXX: maybe this is not true for every system
+            header += fmt::format( "# xbase: {}\n", 0 );
+            header += fmt::format( "# ybase: {}\n", 0 );
+            header += fmt::format( "# zbase: {}\n", 0 );
+
+            header += fmt::format( "# xstepsize: {}\n",
+                                   geometry.lattice_constant * geometry.bravais_vectors[0][0] );
+            header += fmt::format( "# ystepsize: {}\n",
+                                   geometry.lattice_constant * geometry.bravais_vectors[1][1] );
+            header += fmt::format( "# zstepsize: {}\n",
+                                   geometry.lattice_constant * geometry.bravais_vectors[2][2] );
+
+            header += fmt::format( "# xnodes: {}\n", geometry.n_cells[0] );
+            header += fmt::format( "# ynodes: {}\n", geometry.n_cells[1] );
+            header += fmt::format( "# znodes: {}\n", geometry.n_cells[2] );
+        }
+        header += fmt::format( empty_line );
+
+        header += fmt::format( "# End: Header\n" );
+        header += fmt::format( empty_line );
+
+        header += fmt::format( "# Begin: Data {}\n", datatype );
+        return header;
+    }
+
+    template<typename T>
+    void Write_Binary_Data( const vectorfield & vf, std::string & buffer )
+    {
+        std::size_t offset = buffer.size();
+        buffer.resize( offset + sizeof(T) * (1 + 3 * vf.size()) );
+        char * data = &buffer[offset];
+
+        if ( sizeof(T) == 4 )
+            std::memcpy( data, &check_value_4, sizeof(T) );
+        else
+            std::memcpy( data, &check_value_8, sizeof(T) );
+        data += sizeof(T);
+
+        int n = vf.size();
+        #pragma omp parallel for
+        for ( int i = 0; i < n; ++i )
+        {
+            T values[3] = { T(vf[i][0]), T(vf[i][1]), T(vf[i][2]) };
+            std::memcpy( data + i * sizeof(values), values, sizeof(values) );
+        }
+    }
+
+    // Writes the scaled values of the fields interleaved, i.e. all values of a spin together
+    template<typename T>
+    void Write_Binary_Scalars( const std::vector<const scalarfield *> & fields, scalar scale,
+                               std::string & buffer )
+    {
+        int n = fields.empty() ? 0 : fields[0]->size();
+        int dim = fields.size();
+        std::size_t offset = buffer.size();
+        buffer.resize( offset + sizeof(T) * (1 + dim * n) );
+        char * data = &buffer[offset];
+
+        if ( sizeof(T) == 4 )
+            std::memcpy( data, &check_value_4, sizeof(T) );
+        else
+            std::memcpy( data, &check_value_8, sizeof(T) );
+        data += sizeof(T);
+
+        #pragma omp parallel for
+        for ( int i = 0; i < n; ++i )
+        {
+            for ( int d = 0; d < dim; ++d )
+            {
+                T value = T( (*fields[d])[i] * scale );
+                std::memcpy( data + (i * dim + d) * sizeof(T), &value, sizeof(T) );
+            }
+        }
+    }
+
+    void Write_Octahedral_Data( const vectorfield & vf, std::string & buffer )
+    {
+        std::size_t offset = buffer.size();
+        buffer.resize( offset + 2 * sizeof(std::int16_t) * vf.size() );
+        char * data = &buffer[offset];
+
+        int n = vf.size();
+        #pragma omp parallel for
+        for ( int i = 0; i < n; ++i )
+        {
+            std::int16_t encoded[2];
+            Octahedral_Encode( vf[i], encoded );
+            std::memcpy( data + i * sizeof(encoded), encoded, sizeof(encoded) );
+        }
+    }
+
+    // Formats the vectors in chunks, which are written one after the other
+    void Write_Text_Data( const vectorfield & vf, std::ofstream & outputfile )
+    {
+        int n = vf.size();
+        int n_chunks = std::max( 1, std::min( N_Chunks(), n ) );
+        std::vector<std::string> chunks( n_chunks );
+
+        #pragma omp parallel for
+        for ( int c = 0; c < n_chunks; ++c )
+        {
+            fmt::MemoryWriter writer;
+            for ( int i = c * n / n_chunks; i < (c + 1) * n / n_chunks; ++i )
+                writer.write( "{:20.10f} {:20.10f} {:20.10f}\n", vf[i][0], vf[i][1], vf[i][2] );
+            chunks[c] = writer.str();
+        }
+
+        for ( auto& chunk : chunks )
+            outputfile.write( chunk.data(), chunk.size() );
+    }
+
+    void Write_Text_Scalars( const std::vector<const scalarfield *> & fields, scalar scale,
+                             std::ofstream & outputfile )
+    {
+        int n = fields.empty() ? 0 : fields[0]->size();
+        int n_chunks = std::max( 1, std::min( N_Chunks(), n ) );
+        std::vector<std::string> chunks( n_chunks );
+
+        #pragma omp parallel for
+        for ( int c = 0; c < n_chunks; ++c )
+        {
+            fmt::MemoryWriter writer;
+            for ( int i = c * n / n_chunks; i < (c + 1) * n / n_chunks; ++i )
+            {
+                for ( auto field : fields )
+                    writer.write( "{:20.10f} ", (*field)[i] * scale );
+                writer << '\n';
+            }
+            chunks[c] = writer.str();
+        }
+
+        for ( auto& chunk : chunks )
+            outputfile.write( chunk.data(), chunk.size() );
+    }
+
+    // Finds the value of the "# Segment count:" line in the header of a file
+    bool Find_Segment_Count( const Mapped_File & file, std::size_t & begin, std::size_t & end )
+    {
+        std::string line, key, value;
+        for ( std::size_t pos = 0; pos < file.size(); )
+        {
+            std::size_t next = Get_Line( file.data(), file.size(), pos, line );
+            if ( Header_Entry( line, key, value ) )
+            {
+                if ( key == "segment count" )
+                {
+                    begin = pos + line.find( ':' ) + 1;
+                    end   = pos + line.size();
+                    return true;
+                }
+                if ( key == "begin" ) return false;
+            }
+            pos = next;
+        }
+        return false;
+    }
+
+    void Write_OVF( const std::vector<const vectorfield *> & vfs,
+                    const std::vector<const Data::Geometry *> & geometries,
+                    const std::string & filename, VF_FileFormat format,
+                    const std::string & comment, bool append )
+    {
+        // With MPI, all ranks hold the same data and only rank 0 writes
+        if (Engine::Decomposition::Rank() != 0) return;
+
+        std::string datatype = "";
+        if ( format == VF_FileFormat::OVF_BIN8 )
+            datatype = "Binary 8";
+        else if ( format == VF_FileFormat::OVF_BIN4 )
+            datatype = "Binary 4";
+        else if ( format == VF_FileFormat::OVF_TEXT )
+            datatype = "Text";
+        else if ( format == VF_FileFormat::OVF_BIN4_ZLIB )
+            datatype = "Binary 4 Zlib";
+        else if ( format == VF_FileFormat::OVF_OCT16 )
+            datatype = zlib_available ? "Octahedral 2 Zlib" : "Octahedral 2";
+        if ( format == VF_FileFormat::OVF_BIN4_ZLIB )
+            Require_Zlib();
+
+        // Segments already in the file to which is appended. Only the header is read, so that
+        // appending does not index all existing segments again.
+        int n_existing = 0;
+        std::size_t count_begin = 0, count_end = 0;
+        std::string contents;
+        if ( append && std::ifstream( filename ).good() )
+        {
+            try
+            {
+                Mapped_File existing( filename );
+                std::string line;
+                if ( existing.size() > 0 )
+                    Get_Line( existing.data(), existing.size(), 0, line );
+                line = Lowercase( Trim( line ) );
+                if ( line == "# oommf ovf 2.0" || line == "# oommf ovf 2" )
+                {
+                    if ( Find_Segment_Count( existing, count_begin, count_end ) )
+                        n_existing = std::atoi( std::string( existing.data() + count_begin, count_end - count_begin ).c_str() );
+                }
+                // The file has to be rewritten if the new segment count does not fit in place
+                std::size_t count_length = fmt::format( " {:06}", n_existing + vfs.size() ).size();
+                if ( n_existing > 0 && count_length > count_end - count_begin )
+                    contents.assign( existing.data(), existing.size() );
+            }
+            catch( ... )
+            {
+                n_existing = 0;
+            }
+            if ( n_existing <= 0 )
+                Log( Log_Level::Warning, Log_Sender::IO, fmt::format( "Cannot append to \"{}\", which "
+                     "is not a valid OVF file. It will be overwritten.", filename ) );
+        }
+
+        std::ofstream outputfile;
+        if ( n_existing > 0 )
+        {
+            // Update the segment count in the header, in place if the number fits
+            std::string count = fmt::format( " {:06}", n_existing + vfs.size() );
+            if ( contents.empty() )
+            {
+                count.resize( count_end - count_begin, ' ' );
+                std::fstream file( filename, std::ios::in | std::ios::out | std::ios::binary );
+                file.seekp( count_begin );
+                file.write( count.data(), count.size() );
+            }
+            else
+            {
+                contents.replace( count_begin, count_end - count_begin, count );
+                std::ofstream file( filename, std::ios::out | std::ios::binary | std::ios::trunc );
+                file.write( contents.data(), contents.size() );
+            }
+            outputfile.open( filename, std::ios::out | std::ios::binary | std::ios::app );
+        }
+        else
+        {
+            outputfile.open( filename, std::ios::out | std::ios::binary | std::ios::trunc );
+            std::string header = "# OOMMF OVF 2.0\n#\n";
+            header += fmt::format( "# Segment count: {:06}\n#\n", vfs.size() );
+            outputfile.write( header.data(), header.size() );
+        }
+        if ( !outputfile.is_open() )
+            spirit_throw( Exception_Classifier::File_not_Found, Log_Level::Error,
+                          fmt::format( "Could not open \"{}\" to write OVF data", filename ) );
+
+        for ( unsigned int i = 0; i < vfs.size(); ++i )
+        {
+            auto& vf = *vfs[i];
+            std::string segment = Segment_Header( *geometries[i], datatype, comment );
+
+            // Binary data is converted into the buffer of the segment, which is written at once
+            if ( format == VF_FileFormat::OVF_BIN8 || format == VF_FileFormat::OVF_BIN4 )
+            {
+                if ( format == VF_FileFormat::OVF_BIN8 )
+                    Write_Binary_Data<double>( vf, segment );
+                else
+                    Write_Binary_Data<float>( vf, segment );
+                segment += "\n";
+            }
+            // Compressed and octahedral data is converted into a separate buffer first
+            else if ( format == VF_FileFormat::OVF_BIN4_ZLIB || format == VF_FileFormat::OVF_OCT16 )
+            {
+                std::string raw;
+                if ( format == VF_FileFormat::OVF_BIN4_ZLIB )
+                    Write_Binary_Data<float>( vf, raw );
+                else
+                    Write_Octahedral_Data( vf, raw );
+                if ( zlib_available )
+                    Compress_Data( raw, segment );
+                else
+                    segment += raw;
+                segment += "\n";
+            }
+            else
+            {
+                outputfile.write( segment.data(), segment.size() );
+                segment = "";
+                Write_Text_Data( vf, outputfile );
+            }
+
+            segment += fmt::format( "# End: Data {}\n", datatype );
+            segment += fmt::format( "# End: Segment\n" );
+            outputfile.write( segment.data(), segment.size() );
+        }
+
+        outputfile.close();
+        if ( outputfile.fail() )
+            spirit_throw( Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                          fmt::format( "Could not write OVF data to \"{}\"", filename ) );
+    }
+
+    void Write_OVF_Scalars( const std::vector<const scalarfield *> & fields,
+                            const std::vector<std::string> & labels,
+                            const Data::Geometry & geometry, const std::string & filename,
+                            VF_FileFormat format, const std::string & comment, scalar scale )
+    {
+        // With MPI, all ranks hold the same data and only rank 0 writes
+        if (Engine::Decomposition::Rank() != 0) return;
+
+        // The octahedral encoding is only defined for unit vectors, so that scalars are written
+        // as 4 byte binary data instead, compressed if zlib is available
+        if ( format == VF_FileFormat::OVF_OCT16 )
+            format = zlib_available ? VF_FileFormat::OVF_BIN4_ZLIB : VF_FileFormat::OVF_BIN4;
+
+        std::string datatype = "";
+        if ( format == VF_FileFormat::OVF_BIN8 )
+            datatype = "Binary 8";
+        else if ( format == VF_FileFormat::OVF_BIN4 )
+            datatype = "Binary 4";
+        else if ( format == VF_FileFormat::OVF_TEXT )
+            datatype = "Text";
+        else if ( format == VF_FileFormat::OVF_BIN4_ZLIB )
+            datatype = "Binary 4 Zlib";
+        if ( format == VF_FileFormat::OVF_BIN4_ZLIB )
+            Require_Zlib();
+
+        std::ofstream outputfile( filename, std::ios::out | std::ios::binary | std::ios::trunc );
+        if ( !outputfile.is_open() )
+            spirit_throw( Exception_Classifier::File_not_Found, Log_Level::Error,
+                          fmt::format( "Could not open \"{}\" to write OVF data", filename ) );
+
+        std::string segment = "# OOMMF OVF 2.0\n#\n";
+        segment += fmt::format( "# Segment count: {:06}\n#\n", 1 );
+        segment += Segment_Header( geometry, datatype, comment, labels );
+
+        if ( format == VF_FileFormat::OVF_BIN8 )
+            Write_Binary_Scalars<double>( fields, scale, segment );
+        else if ( format == VF_FileFormat::OVF_BIN4 )
+            Write_Binary_Scalars<float>( fields, scale, segment );
+        else if ( format == VF_FileFormat::OVF_BIN4_ZLIB )
+        {
+            std::string raw;
+            Write_Binary_Scalars<float>( fields, scale, raw );
+            Compress_Data( raw, segment );
+        }
+        else
+        {
+            outputfile.write( segment.data(), segment.size() );
+            segment = "";
+            Write_Text_Scalars( fields, scale, outputfile );
+        }
+        if ( format != VF_FileFormat::OVF_TEXT )
+            segment += "\n";
+
+        segment += fmt::format( "# End: Data {}\n", datatype );
+        segment += fmt::format( "# End: Segment\n" );
+        outputfile.write( segment.data(), segment.size() );
+
+        outputfile.close();
+        if ( outputfile.fail() )
+            spirit_throw( Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                          fmt::format( "Could not write OVF data to \"{}\"", filename ) );
+    }
+}
@@ -0,0 +1,214 @@
+#include <io/Output_Queue.hpp>
+#include <utility/Logging.hpp>
+
+#include <atomic>
+#include <exception>
+
+#ifdef SPIRIT_USE_THREADS
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+using Utility::Log_Level;
+using Utility::Log_Sender;
+
+namespace IO
+{
+    namespace Output_Queue
+    {
+        // Default limit of the memory held by queued tasks: 512 MiB
+        std::atomic<std::size_t> max_bytes( std::size_t(1) << 29 );
+
+        // The group the tasks queued by this thread belong to
+        thread_local Group * current_group = nullptr;
+
+        void Execute(const std::string & filename, const std::function<void()> & task)
+        {
+            try
+            {
+                task();
+            }
+            catch( const std::exception & ex )
+            {
+                Log(Log_Level::Error, Log_Sender::IO, "Writing " + filename + " failed: " + ex.what());
+            }
+            catch( ... )
+            {
+                Log(Log_Level::Error, Log_Sender::IO, "Writing " + filename + " failed");
+            }
+        }
+
+        #ifdef SPIRIT_USE_THREADS
+
+        struct Task
+        {
+            std::string filename;
+            std::function<void()> function;
+            std::size_t n_bytes;
+            std::shared_ptr<std::size_t> group_pending;
+        };
+
+        struct Writer
+        {
+            std::deque<Task> queue;
+            std::condition_variable condition;
+            bool busy = false;
+            std::thread thread;
+        };
+
+        // The writer threads and their queues, all guarded by a single mutex
+        class Pool
+        {
+        public:
+            Pool(int n_writers) : writers(n_writers)
+            {
+                for( auto& writer : writers )
+                    writer.thread = std::thread(&Pool::Run, this, std::ref(writer));
+            }
+
+            // Remaining output is written before the program exits
+            ~Pool()
+            {
+                Drain();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stop = true;
+                }
+                for( auto& writer : writers )
+                {
+                    writer.condition.notify_one();
+                    writer.thread.join();
+                }
+            }
+
+            void Enqueue(const std::string & filename, std::function<void()> && function, std::size_t n_bytes,
+                         std::shared_ptr<std::size_t> group_pending)
+            {
+                auto& writer = writers[std::hash<std::string>()(filename) % writers.size()];
+
+                std::unique_lock<std::mutex> lock(mutex);
+                // Back-pressure: wait for queued output to be written. A task larger than the
+                // limit is accepted once the queue is empty.
+                space_available.wait(lock, [&] { return bytes_queued == 0 || bytes_queued + n_bytes <= max_bytes; });
+                writer.queue.push_back(Task{ filename, std::move(function), n_bytes, group_pending });
+                bytes_queued += n_bytes;
+                if( group_pending )
+                    ++*group_pending;
+                writer.condition.notify_one();
+            }
+
+            void Drain()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                idle.wait(lock, [&]
+                {
+                    for( auto& writer : writers )
+                        if( writer.busy || !writer.queue.empty() ) return false;
+                    return true;
+                });
+            }
+
+            void Drain(const std::size_t & group_pending)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                idle.wait(lock, [&] { return group_pending == 0; });
+            }
+
+        private:
+            void Run(Writer & writer)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                while( true )
+                {
+                    writer.condition.wait(lock, [&] { return stop || !writer.queue.empty(); });
+                    if( writer.queue.empty() ) return;
+
+                    Task task = std::move(writer.queue.front());
+                    writer.queue.pop_front();
+                    writer.busy = true;
+
+                    lock.unlock();
+                    Execute(task.filename, task.function);
+                    task.function = nullptr;
+                    lock.lock();
+
+                    writer.busy = false;
+                    bytes_queued -= task.n_bytes;
+                    if( task.group_pending )
+                        --*task.group_pending;
+                    space_available.notify_all();
+                    idle.notify_all();
+                }
+            }
+
+            std::vector<Writer> writers;
+            std::mutex mutex;
+            std::condition_variable space_available, idle;
+            std::size_t bytes_queued = 0;
+            bool stop = false;
+        };
+
+        // Created on first use, so that it is destroyed before the logging it depends on
+        Pool & Get_Pool()
+        {
+            static Pool pool(2);
+            return pool;
+        }
+
+        #endif
+
+        #ifdef SPIRIT_USE_THREADS
+        void Enqueue(const std::string & filename, std::function<void()> task, std::size_t n_bytes)
+        {
+            std::shared_ptr<std::size_t> group_pending;
+            if( current_group )
+                group_pending = current_group->n_pending;
+            Get_Pool().Enqueue(filename, std::move(task), n_bytes, group_pending);
+        }
+        #else
+        // The tasks are executed immediately, so their size does not matter
+        void Enqueue(const std::string & filename, std::function<void()> task, std::size_t)
+        {
+            Execute(filename, task);
+        }
+        #endif
+
+        void Drain()
+        {
+            #ifdef SPIRIT_USE_THREADS
+            Get_Pool().Drain();
+            #endif
+        }
+
+        Group::Group() : previous(current_group), n_pending(std::make_shared<std::size_t>(0))
+        {
+            current_group = this;
+        }
+
+        Group::~Group()
+        {
+            current_group = this->previous;
+        }
+
+        void Group::Drain()
+        {
+            #ifdef SPIRIT_USE_THREADS
+            Get_Pool().Drain(*this->n_pending);
+            #endif
+        }
+
+        void Set_Max_Bytes(std::size_t bytes)
+        {
+            max_bytes = bytes;
+        }
+
+        std::size_t Get_Max_Bytes()
+        {
+            return max_bytes;
+        }
+    }
+}
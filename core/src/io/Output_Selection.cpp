@@ -0,0 +1,143 @@
+#include <io/Output_Selection.hpp>
+#include <utility/Configurations.hpp>
+#include <utility/Exception.hpp>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+using namespace Utility;
+
+namespace IO
+{
+    Output_Selection::Output_Selection(std::shared_ptr<const Data::Geometry> shared_geometry, const Data::Output_Filter & filter) :
+        filter(filter), bravais_vectors(shared_geometry->bravais_vectors), n_cells(shared_geometry->n_cells),
+        cell_atoms(shared_geometry->cell_atoms), lattice_constant(shared_geometry->lattice_constant), all(filter.All())
+    {
+        const auto & geometry = *shared_geometry;
+
+        for (int dim = 0; dim < 3; ++dim)
+        {
+            if (filter.cell_stride[dim] < 1)
+                spirit_throw(Exception_Classifier::Input_parse_failed, Log_Level::Error,
+                    fmt::format("Output cell stride must be positive, but is {}", filter.cell_stride[dim]));
+        }
+
+        if (this->all)
+        {
+            this->selected_geometry = shared_geometry;
+            return;
+        }
+
+        // Lattice of every n-th cell: the bravais vectors are multiplied by the stride, so the
+        // basis atoms, given in units of the bravais vectors, are divided by it
+        std::vector<Vector3> strided_bravais = geometry.bravais_vectors;
+        std::vector<Vector3> strided_atoms   = geometry.cell_atoms;
+        intfield strided_n_cells(3);
+        for (int dim = 0; dim < 3; ++dim)
+        {
+            int stride = filter.cell_stride[dim];
+            strided_bravais[dim] *= stride;
+            for (auto & atom : strided_atoms)
+                atom[dim] /= stride;
+            strided_n_cells[dim] = (geometry.n_cells[dim] + stride - 1) / stride;
+        }
+        auto strided_geometry = std::make_shared<Data::Geometry>(strided_bravais, strided_n_cells,
+            strided_atoms, geometry.cell_atom_types, geometry.lattice_constant);
+        this->selected_geometry = strided_geometry;
+        auto & g = *strided_geometry;
+
+        // Indices of the spins of the strided lattice in the full lattice
+        int n_cell_atoms = geometry.n_cell_atoms;
+        this->selected = intfield(g.nos);
+        for (int c = 0; c < g.n_cells[2]; ++c)
+        {
+            for (int b = 0; b < g.n_cells[1]; ++b)
+            {
+                for (int a = 0; a < g.n_cells[0]; ++a)
+                {
+                    int cell_strided = a + g.n_cells[0] * (b + g.n_cells[1] * c);
+                    int cell = a * filter.cell_stride[0] + geometry.n_cells[0] *
+                        (b * filter.cell_stride[1] + geometry.n_cells[1] * c * filter.cell_stride[2]);
+                    for (int ibasis = 0; ibasis < n_cell_atoms; ++ibasis)
+                        this->selected[n_cell_atoms * cell_strided + ibasis] = n_cell_atoms * cell + ibasis;
+                }
+            }
+        }
+        // The types may differ from the basis, e.g. due to defects
+        for (int i = 0; i < g.nos; ++i)
+            g.atom_types[i] = geometry.atom_types[this->selected[i]];
+
+        // Restrict to the region, keeping the positions and types of the remaining spins
+        if (filter.Region())
+        {
+            auto in_region = Configurations::Filter_Region(filter.position, filter.r_cut_rectangular,
+                filter.r_cut_cylindrical, filter.r_cut_spherical, filter.inverted);
+            int n = 0;
+            for (int i = 0; i < g.nos; ++i)
+            {
+                if (in_region(Vector3::Zero(), g.positions[i]))
+                {
+                    this->selected[n] = this->selected[i];
+                    g.positions[n]    = g.positions[i];
+                    g.atom_types[n]   = g.atom_types[i];
+                    ++n;
+                }
+            }
+            this->selected.resize(n);
+            g.positions.resize(n);
+            g.atom_types.resize(n);
+            g.nos = n;
+
+            // The spins no longer fill the lattice, so the bounds are those of the remaining
+            // positions (the OVF header then describes an irregular mesh of g.nos points)
+            if (n > 0)
+            {
+                g.bounds_min = g.positions[0];
+                g.bounds_max = g.positions[0];
+                for (int i = 1; i < n; ++i)
+                {
+                    g.bounds_min = g.bounds_min.cwiseMin(g.positions[i]);
+                    g.bounds_max = g.bounds_max.cwiseMax(g.positions[i]);
+                }
+                g.center = 0.5 * (g.bounds_min + g.bounds_max);
+            }
+        }
+    }
+
+    bool Output_Selection::Matches(const Data::Geometry & geometry, const Data::Output_Filter & filter) const
+    {
+        return filter == this->filter && geometry.n_cells == this->n_cells &&
+            geometry.bravais_vectors == this->bravais_vectors && geometry.cell_atoms == this->cell_atoms &&
+            geometry.lattice_constant == this->lattice_constant;
+    }
+
+    int Output_Selection::n_selected() const
+    {
+        return this->selected_geometry->nos;
+    }
+
+    const intfield & Output_Selection::indices() const
+    {
+        return this->selected;
+    }
+
+    std::shared_ptr<const Data::Geometry> Output_Selection::geometry() const
+    {
+        return this->selected_geometry;
+    }
+
+    std::shared_ptr<vectorfield> Output_Selection::Gather(const vectorfield & vf) const
+    {
+        if (this->all)
+            return std::make_shared<vectorfield>(vf);
+
+        int n = this->selected.size();
+        auto gathered = std::make_shared<vectorfield>(n);
+        auto & out = *gathered;
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+            out[i] = vf[this->selected[i]];
+        return gathered;
+    }
+}
@@ -0,0 +1,315 @@
+#include <io/Trajectory.hpp>
+#include <io/Checkpoint.hpp>
+#include <engine/Decomposition.hpp>
+#include <utility/Logging.hpp>
+#include <utility/Exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <fmt/format.h>
+
+using namespace Utility;
+
+namespace IO
+{
+    // File signature and version of the format
+    const char trajectory_magic[8] = { 'S', 'P', 'I', 'R', 'I', 'T', 'T', 'J' };
+    const std::uint32_t trajectory_version = 1;
+    const double quantisation_scale = 32767;
+
+    std::size_t Bytes_per_Component(Trajectory_Encoding encoding)
+    {
+        if (encoding == Trajectory_Encoding::Float64)
+            return sizeof(double);
+        else if (encoding == Trajectory_Encoding::Float32)
+            return sizeof(float);
+        else if (encoding == Trajectory_Encoding::Quantised16)
+            return sizeof(std::int16_t);
+        spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+            fmt::format("Unknown trajectory encoding {}", int(encoding)));
+    }
+
+    std::size_t Frame_Size(Trajectory_Encoding encoding, bool with_energies, int n_contributions, int nos)
+    {
+        // Iteration, time, energies and spins
+        std::size_t size = sizeof(std::int64_t) + sizeof(double);
+        if (with_energies)
+            size += (1 + n_contributions) * sizeof(double);
+        return size + 3 * nos * Bytes_per_Component(encoding);
+    }
+
+    template<typename T>
+    void Encode_Spins(const vectorfield & spins, char * data)
+    {
+        int n = spins.size();
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+        {
+            T values[3] = { T(spins[i][0]), T(spins[i][1]), T(spins[i][2]) };
+            std::memcpy(data + 3 * i * sizeof(T), values, 3 * sizeof(T));
+        }
+    }
+
+    void Encode_Spins_Quantised(const vectorfield & spins, char * data)
+    {
+        int n = spins.size();
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+        {
+            std::int16_t values[3];
+            for (int dim = 0; dim < 3; ++dim)
+            {
+                double x = std::max(-1.0, std::min(1.0, double(spins[i][dim])));
+                values[dim] = std::int16_t(std::lround(x * quantisation_scale));
+            }
+            std::memcpy(data + 3 * i * sizeof(std::int16_t), values, 3 * sizeof(std::int16_t));
+        }
+    }
+
+    template<typename T>
+    void Decode_Spins(const char * data, vectorfield & spins)
+    {
+        int n = spins.size();
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+        {
+            T values[3];
+            std::memcpy(values, data + 3 * i * sizeof(T), 3 * sizeof(T));
+            spins[i] = Vector3{ scalar(values[0]), scalar(values[1]), scalar(values[2]) };
+        }
+    }
+
+    void Decode_Spins_Quantised(const char * data, vectorfield & spins)
+    {
+        int n = spins.size();
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+        {
+            std::int16_t values[3];
+            std::memcpy(values, data + 3 * i * sizeof(std::int16_t), 3 * sizeof(std::int16_t));
+            Vector3 spin{ scalar(values[0] / quantisation_scale), scalar(values[1] / quantisation_scale),
+                          scalar(values[2] / quantisation_scale) };
+            // Undo the rounding error of the length
+            scalar norm = spin.norm();
+            spins[i] = norm > 0 ? Vector3(spin / norm) : spin;
+        }
+    }
+
+    std::string Trajectory_Header( const Data::Geometry & geometry, Trajectory_Encoding encoding,
+                                   bool with_energies, const std::vector<std::string> & energy_names )
+    {
+        Binary_Writer body;
+        body.Write<std::uint32_t>(with_energies);
+        body.Write<std::uint32_t>(with_energies ? energy_names.size() : 0);
+        if (with_energies)
+        {
+            for (auto& name : energy_names)
+                body.Write(name);
+        }
+        body.Write<std::int32_t>(geometry.nos);
+        body.Write<std::int32_t>(geometry.n_cell_atoms);
+        for (int dim = 0; dim < 3; ++dim)
+            body.Write<std::int32_t>(geometry.n_cells[dim]);
+        for (auto& position : geometry.positions)
+        {
+            for (int dim = 0; dim < 3; ++dim)
+                body.Write<double>(position[dim]);
+        }
+
+        // Fixed part: signature, version, encoding and the sizes of the header and of the frames
+        Binary_Writer header;
+        for (auto c : trajectory_magic)
+            header.Write(c);
+        header.Write(trajectory_version);
+        header.Write<std::uint32_t>(std::uint32_t(encoding));
+        std::uint64_t header_size = header.Data().size() + 2 * sizeof(std::uint64_t) + body.Data().size();
+        header.Write<std::uint64_t>(header_size);
+        header.Write<std::uint64_t>(Frame_Size(encoding, with_energies, energy_names.size(), geometry.nos));
+        return header.Data() + body.Data();
+    }
+
+    void Append_Trajectory_Frame( const std::string & filename, const Data::Geometry & geometry,
+                                  const Trajectory_Frame & frame, Trajectory_Encoding encoding,
+                                  bool with_energies, const std::vector<std::string> & energy_names )
+    {
+        // With MPI, all ranks hold the same data and only rank 0 writes
+        if (Engine::Decomposition::Rank() != 0) return;
+
+        if (int(frame.spins.size()) != geometry.nos)
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("Trajectory frame has {} spins, but the geometry has {}", frame.spins.size(), geometry.nos));
+
+        // Determine where the frame goes: after the last complete frame of an existing file
+        std::size_t offset = 0;
+        bool exists = std::ifstream(filename).good();
+        if (exists)
+        {
+            Trajectory_File existing(filename);
+            if ( existing.nos() != geometry.nos || existing.with_energies() != with_energies ||
+                 (with_energies && existing.energy_names().size() != frame.energy_contributions.size()) )
+                spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                    fmt::format("Cannot append frame to trajectory file \"{}\", which was written for a "
+                                "different system or with different energies", filename));
+            encoding = existing.encoding();
+            offset = existing.header_size() + existing.n_frames() * existing.frame_size();
+        }
+        else if (with_energies && energy_names.size() != frame.energy_contributions.size())
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("Got {} energy contributions but {} names for trajectory file \"{}\"",
+                    frame.energy_contributions.size(), energy_names.size(), filename));
+
+        // Serialise the frame
+        int n_contributions = with_energies ? frame.energy_contributions.size() : 0;
+        std::string data(Frame_Size(encoding, with_energies, n_contributions, geometry.nos), '\0');
+        char * pos = &data[0];
+        std::int64_t iteration = frame.iteration;
+        double time = frame.time;
+        std::memcpy(pos, &iteration, sizeof(iteration)); pos += sizeof(iteration);
+        std::memcpy(pos, &time, sizeof(time));           pos += sizeof(time);
+        if (with_energies)
+        {
+            double energy = frame.energy;
+            std::memcpy(pos, &energy, sizeof(energy)); pos += sizeof(energy);
+            for (auto contribution : frame.energy_contributions)
+            {
+                double value = contribution;
+                std::memcpy(pos, &value, sizeof(value)); pos += sizeof(value);
+            }
+        }
+        if (encoding == Trajectory_Encoding::Float64)
+            Encode_Spins<double>(frame.spins, pos);
+        else if (encoding == Trajectory_Encoding::Float32)
+            Encode_Spins<float>(frame.spins, pos);
+        else
+            Encode_Spins_Quantised(frame.spins, pos);
+
+        // Write the header of a new file, or overwrite anything behind the last complete frame
+        if (exists)
+        {
+            std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(offset);
+            file.write(data.data(), data.size());
+            if (!file.good())
+                spirit_throw(Exception_Classifier::File_not_Found, Log_Level::Error,
+                    fmt::format("Could not append frame to trajectory file \"{}\"", filename));
+        }
+        else
+        {
+            std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+                spirit_throw(Exception_Classifier::File_not_Found, Log_Level::Error,
+                    fmt::format("Could not open trajectory file \"{}\"", filename));
+            std::string header = Trajectory_Header(geometry, encoding, with_energies, energy_names);
+            file.write(header.data(), header.size());
+            file.write(data.data(), data.size());
+        }
+    }
+
+    Trajectory_File::Trajectory_File(const std::string & filename) :
+        filename(filename), file(new Mapped_File(filename))
+    {
+        try
+        {
+            Binary_Reader reader(this->file->data(), this->file->size());
+
+            char magic[8];
+            for (auto& c : magic)
+                reader.Read(c);
+            if (std::memcmp(magic, trajectory_magic, sizeof(magic)) != 0)
+                spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                    "Not a Spirit trajectory file");
+
+            std::uint32_t version, encoding, with_energies, n_contributions;
+            std::uint64_t header_size, frame_size;
+            reader.Read(version);
+            if (version != trajectory_version)
+                spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                    fmt::format("Unsupported trajectory file version {}", version));
+            reader.Read(encoding);
+            reader.Read(header_size);
+            reader.Read(frame_size);
+            reader.Read(with_energies);
+            reader.Read(n_contributions);
+
+            this->spin_encoding = Trajectory_Encoding(encoding);
+            this->energies = with_energies != 0;
+            this->contributions.resize(n_contributions);
+            for (auto& name : this->contributions)
+                reader.Read(name);
+
+            std::int32_t nos, n_cell_atoms, n_cells[3];
+            reader.Read(nos);
+            reader.Read(n_cell_atoms);
+            for (auto& n : n_cells)
+                reader.Read(n);
+            this->n_spins = nos;
+            this->cell_atoms = n_cell_atoms;
+            this->cells = std::vector<int>(n_cells, n_cells + 3);
+            this->atom_positions = vectorfield(nos);
+            for (auto& position : this->atom_positions)
+            {
+                double x[3];
+                for (auto& xi : x)
+                    reader.Read(xi);
+                position = Vector3{ scalar(x[0]), scalar(x[1]), scalar(x[2]) };
+            }
+
+            if (frame_size != Frame_Size(this->spin_encoding, this->energies, n_contributions, nos))
+                spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                    "Inconsistent frame size in trajectory header");
+            this->header_bytes = header_size;
+            this->frame_bytes = frame_size;
+            if (this->file->size() < header_size)
+                spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                    "Incomplete trajectory header");
+            // Only complete frames count
+            this->frames = (this->file->size() - header_size) / frame_size;
+        }
+        catch( ... )
+        {
+            spirit_rethrow(fmt::format("Could not read trajectory file \"{}\"", filename));
+        }
+    }
+
+    void Trajectory_File::Read_Frame(int idx_frame, Trajectory_Frame & frame) const
+    {
+        if (idx_frame < 0 || idx_frame >= this->frames)
+            spirit_throw(Exception_Classifier::Bad_File_Content, Log_Level::Error,
+                fmt::format("Trajectory file \"{}\" has no frame {} ({} frames)",
+                    this->filename, idx_frame, this->frames));
+
+        const char * pos = this->file->data() + this->header_bytes + idx_frame * this->frame_bytes;
+        std::int64_t iteration;
+        double time;
+        std::memcpy(&iteration, pos, sizeof(iteration)); pos += sizeof(iteration);
+        std::memcpy(&time, pos, sizeof(time));           pos += sizeof(time);
+        frame.iteration = iteration;
+        frame.time = time;
+
+        frame.energy_contributions.resize(this->contributions.size());
+        if (this->energies)
+        {
+            double value;
+            std::memcpy(&value, pos, sizeof(value)); pos += sizeof(value);
+            frame.energy = value;
+            for (auto& contribution : frame.energy_contributions)
+            {
+                std::memcpy(&value, pos, sizeof(value)); pos += sizeof(value);
+                contribution = value;
+            }
+        }
+        else
+            frame.energy = 0;
+
+        frame.spins.resize(this->n_spins);
+        if (this->spin_encoding == Trajectory_Encoding::Float64)
+            Decode_Spins<double>(pos, frame.spins);
+        else if (this->spin_encoding == Trajectory_Encoding::Float32)
+            Decode_Spins<float>(pos, frame.spins);
+        else
+            Decode_Spins_Quantised(pos, frame.spins);
+    }
+}
@@ -35,6 +35,23 @@ namespace Utility
 			}
 		}
 
+		filterfunction Filter_Region(Vector3 position, Vector3 r_cut_rectangular, scalar r_cut_cylindrical, scalar r_cut_spherical, bool inverted)
+		{
+			return [position, r_cut_rectangular, r_cut_cylindrical, r_cut_spherical, inverted]
+				(const Vector3& spin, const Vector3& pos) -> bool
+			{
+				Vector3 r_rectangular = pos - position;
+				scalar r_cylindrical = std::sqrt(std::pow(r_rectangular[0], 2) + std::pow(r_rectangular[1], 2));
+				scalar r_spherical   = r_rectangular.norm();
+				bool inside = ( r_cut_rectangular[0] < 0 || std::abs(r_rectangular[0]) < r_cut_rectangular[0] )
+					&& ( r_cut_rectangular[1] < 0 || std::abs(r_rectangular[1]) < r_cut_rectangular[1] )
+					&& ( r_cut_rectangular[2] < 0 || std::abs(r_rectangular[2]) < r_cut_rectangular[2] )
+					&& ( r_cut_cylindrical    < 0 || r_cylindrical < r_cut_cylindrical )
+					&& ( r_cut_spherical      < 0 || r_spherical   < r_cut_spherical );
+				return inside != inverted;
+			};
+		}
+
 		void Move(vectorfield& configuration, const Data::Geometry & geometry, int da, int db, int dc)
 		{
 			int delta = geometry.n_cell_atoms*da + geometry.n_cell_atoms*geometry.n_cells[0] * db + geometry.n_cell_atoms*geometry.n_cells[0] * geometry.n_cells[1] * dc;
@@ -43,6 +60,59 @@ namespace Utility
 			std::rotate(configuration.begin(), configuration.begin() + delta, configuration.end());
 		}
 
+		intfield Remap_Indices(const Data::Geometry & geometry_old, const Data::Geometry & geometry_new, Remap_Mode mode)
+		{
+			auto& n_cells_old = geometry_old.n_cells;
+			auto& n_cells_new = geometry_new.n_cells;
+			int n_cell_atoms_old = geometry_old.n_cell_atoms;
+			int n_cell_atoms_new = geometry_new.n_cell_atoms;
+
+			// Offset of the previous lattice inside the new one
+			std::array<int, 3> offset{ 0, 0, 0 };
+			if (mode == Remap_Mode::Centre)
+			{
+				for (int dim = 0; dim < 3; ++dim)
+					offset[dim] = (n_cells_new[dim] - n_cells_old[dim]) / 2;
+			}
+
+			intfield indices_old(geometry_new.nos);
+			#pragma omp parallel for
+			for (int cell_c = 0; cell_c < n_cells_new[2]; ++cell_c)
+			{
+				std::array<int, 3> cell_old;
+				for (int cell_b = 0; cell_b < n_cells_new[1]; ++cell_b)
+				{
+					for (int cell_a = 0; cell_a < n_cells_new[0]; ++cell_a)
+					{
+						std::array<int, 3> cell_new{ cell_a, cell_b, cell_c };
+						for (int dim = 0; dim < 3; ++dim)
+						{
+							cell_old[dim] = cell_new[dim] - offset[dim];
+							if (mode == Remap_Mode::Tile)
+								cell_old[dim] = (cell_old[dim] % n_cells_old[dim] + n_cells_old[dim]) % n_cells_old[dim];
+							else
+								cell_old[dim] = std::min(std::max(cell_old[dim], 0), n_cells_old[dim] - 1);
+						}
+
+						int idx_cell_new = Engine::Vectormath::idx_from_translations(n_cells_new, n_cell_atoms_new, cell_new);
+						int idx_cell_old = Engine::Vectormath::idx_from_translations(n_cells_old, n_cell_atoms_old, cell_old);
+						for (int ibasis = 0; ibasis < n_cell_atoms_new; ++ibasis)
+							indices_old[idx_cell_new + ibasis] = idx_cell_old + ibasis % n_cell_atoms_old;
+					}
+				}
+			}
+			return indices_old;
+		}
+
+		void Remap(vectorfield & configuration, const intfield & indices_old)
+		{
+			vectorfield remapped(indices_old.size());
+			#pragma omp parallel for
+			for (int i = 0; i < (int)indices_old.size(); ++i)
+				remapped[i] = configuration[indices_old[i]];
+			configuration.swap(remapped);
+		}
+
 		void Insert(Data::Spin_System &s, const vectorfield& configuration, int shift, filterfunction filter)
 		{
 			auto& spins = *s.spins;
@@ -1,10 +1,14 @@
 ﻿#include <utility/Logging.hpp>
 #include <utility/Timing.hpp>
 #include <io/IO.hpp>
+#include <io/Output_Queue.hpp>
 
+#include <algorithm>
+#include <fstream>
 #include <string>
 #include <iostream>
 #include <ctime>
+#include <thread>
 #include <signal.h>
 
 #include <fmt/format.h>
@@ -123,7 +127,9 @@ namespace Utility
         return result;
     }
 
-    LoggingHandler::LoggingHandler()
+    const int LoggingHandler::buffer_size;
+
+    LoggingHandler::LoggingHandler() : log_entries(new Slot[buffer_size]), pending(new Pending_Batches)
     {
         // Set the default Log parameters
         output_folder = ".";
@@ -145,59 +151,51 @@ namespace Utility
         save_positions_final    = false;
         save_neighbours_initial = false;
         save_neighbours_final   = false;
+        rank       = 0;
         n_entries  = 0;
         n_errors   = 0;
         n_warnings = 0;
+        no_dumped  = 0;
+
+        for (int i=0; i<buffer_size; ++i)
+        {
+            log_entries[i].busy = false;
+            log_entries[i].idx_entry = -1;
+            log_entries[i].kept = false;
+        }
     }
 
-    void LoggingHandler::Send(Log_Level level, Log_Sender sender, std::string message, int idx_image, int idx_chain)
+    bool LoggingHandler::Accepts(Log_Level level) const
     {
-        // Lock mutex because of reallocation (push_back)
-        std::lock_guard<std::mutex> guard(mutex);
-
-        // All messages are saved in the Log
-        LogEntry entry = { std::chrono::system_clock::now(), sender, level, message, idx_image, idx_chain };
-        log_entries.push_back(entry);
-
-        // Increment message count
-        n_entries++;
-        // Increment error count
-        if (level == Log_Level::Error)
-            n_errors++;
-        // Increment warning count
-        if (level == Log_Level::Warning)
-            n_warnings++;
-
-        // Determine message color in console
-        auto color = termcolor::reset;
-        if (level <= Log_Level::Warning)
-            color = termcolor::yellow;
-        if (level <= Log_Level::Error)
-            color = termcolor::red;
-        if (level == Log_Level::All)
-            color = termcolor::reset;
-
-        // If level <= verbosity, we print to console, but Error and Severe are always printed
-        if ((messages_to_console && level <= level_console) || level == Log_Level::Error || level == Log_Level::Severe)
-            std::cout << color << LogEntryToString(log_entries.back()) << termcolor::reset << std::endl;
+        // Error and Severe are always printed
+        return (messages_to_console && level <= level_console) || (messages_to_file && level <= level_file)
+            || level == Log_Level::Error || level == Log_Level::Severe;
     }
 
-    void LoggingHandler::SendBlock(Log_Level level, Log_Sender sender, std::vector<std::string> messages, int idx_image, int idx_chain)
+    void LoggingHandler::Store(LogEntry entry)
     {
-        // Lock mutex because of reallocation (push_back)
-        std::lock_guard<std::mutex> guard(mutex);
-
-        std::vector<LogEntry> entries;
-        for (auto& message : messages)
+        auto level = entry.level;
+        bool to_console = rank == 0 && ((messages_to_console && entry.level <= level_console) 
+            || entry.level == Log_Level::Error || entry.level == Log_Level::Severe);
+        std::string line = "";
+        if (to_console) line = LogEntryToString(entry);
+
+        // Each entry gets its own index, which determines its slot in the ring buffer
+        int idx_entry = n_entries++;
+        auto& slot = log_entries[idx_entry % buffer_size];
+        while (slot.busy.exchange(true, std::memory_order_acquire))
+            std::this_thread::yield();
+        // A newer entry may have been stored in the slot if the buffer wrapped around meanwhile
+        if (slot.idx_entry < idx_entry)
         {
-            // All messages are saved in the Log
-            LogEntry entry = { std::chrono::system_clock::now(), sender, level, message, idx_image, idx_chain };
-            log_entries.push_back(entry);
-            entries.push_back(entry);
-
-            // Increment message count
-            n_entries++;
+            slot.entry = std::move(entry);
+            slot.kept = true;
+            slot.idx_entry = idx_entry;
+        }
+        slot.busy.store(false, std::memory_order_release);
 
+        if (to_console)
+        {
             // Determine message color in console
             auto color = termcolor::reset;
             if (level <= Log_Level::Warning)
@@ -207,32 +205,93 @@ namespace Utility
             if (level == Log_Level::All)
                 color = termcolor::reset;
 
-            // If level <= verbosity, we print to console, but Error and Severe are always printed
-            if ((messages_to_console && level <= level_console) || level == Log_Level::Error || level == Log_Level::Severe)
-                std::cout << color << LogEntryToString(log_entries.back()) << termcolor::reset << std::endl;
+            std::lock_guard<std::mutex> guard(mutex_console);
+            std::cout << color << line << termcolor::reset << std::endl;
         }
     }
 
+    void LoggingHandler::Skip()
+    {
+        // Discarded messages are counted, but only mark their slot as done
+        int idx_entry = n_entries++;
+        auto& slot = log_entries[idx_entry % buffer_size];
+        while (slot.busy.exchange(true, std::memory_order_acquire))
+            std::this_thread::yield();
+        if (slot.idx_entry < idx_entry)
+        {
+            slot.entry = LogEntry();
+            slot.kept = false;
+            slot.idx_entry = idx_entry;
+        }
+        slot.busy.store(false, std::memory_order_release);
+    }
+
+    void LoggingHandler::Send(Log_Level level, Log_Sender sender, std::string message, int idx_image, int idx_chain)
+    {
+        // Increment error count
+        if (level == Log_Level::Error)
+            n_errors++;
+        // Increment warning count
+        if (level == Log_Level::Warning)
+            n_warnings++;
+
+        // Messages which are neither printed nor saved are discarded
+        if (!Accepts(level))
+            Skip();
+        else
+            Store({ std::chrono::system_clock::now(), sender, level, std::move(message), idx_image, idx_chain });
+    }
+
+    void LoggingHandler::SendBlock(Log_Level level, Log_Sender sender, std::vector<std::string> messages, int idx_image, int idx_chain)
+    {
+        // Messages which are neither printed nor saved are discarded
+        if (!Accepts(level))
+        {
+            for (unsigned int i=0; i<messages.size(); ++i)
+                Skip();
+            return;
+        }
+
+        auto time = std::chrono::system_clock::now();
+        for (auto& message : messages)
+            Store({ time, sender, level, std::move(message), idx_image, idx_chain });
+    }
+
     void LoggingHandler::operator() (Log_Level level, Log_Sender sender, std::string message, int idx_image, int idx_chain)
     {
-        Send(level, sender, message, idx_image, idx_chain);
+        Send(level, sender, std::move(message), idx_image, idx_chain);
     }
 
     void LoggingHandler::operator() (Log_Level level, Log_Sender sender, std::vector<std::string> messages, int idx_image, int idx_chain)
     {
-        SendBlock(level, sender, messages, idx_image, idx_chain);
+        SendBlock(level, sender, std::move(messages), idx_image, idx_chain);
     }
 
-    std::vector<LogEntry> LoggingHandler::GetEntries()
+    std::vector<LogEntry> LoggingHandler::GetEntries(int idx_first, int idx_last)
     {
-        return log_entries;
+        if (idx_last < 0) idx_last = n_entries;
+        // Older entries have been overwritten
+        idx_first = std::max(idx_first, idx_last - buffer_size);
+
+        std::vector<LogEntry> entries;
+        for (int idx_entry = std::max(idx_first, 0); idx_entry < idx_last; ++idx_entry)
+        {
+            auto& slot = log_entries[idx_entry % buffer_size];
+            while (slot.busy.exchange(true, std::memory_order_acquire))
+                std::this_thread::yield();
+            // Skip entries which were discarded, are still being stored or have been overwritten
+            if (slot.idx_entry == idx_entry && slot.kept)
+                entries.push_back(slot.entry);
+            slot.busy.store(false, std::memory_order_release);
+        }
+        return entries;
     }
 
     std::vector<LogEntry> LoggingHandler::Filter(Log_Level level, Log_Sender sender, int idx_image, int idx_chain)
     {
         // Get vector of Log entries
         auto result = std::vector<LogEntry>();
-        for (auto entry : log_entries) {
+        for (auto entry : GetEntries()) {
             if (level == Log_Level::All || level == entry.level) {
                 if (sender == Log_Sender::All || sender == entry.sender) {
                     if (idx_image == -1 || idx_image == entry.idx_image) {
@@ -242,35 +301,113 @@ namespace Utility
                     }// endif image no
                 }// endif sender
             }// endif level
-        }// endfor i -> log_entries.size()
+        }// endfor entry
 
         // Return
-        return std::vector<LogEntry>();
+        return result;
     }
 
-    void LoggingHandler::Append_to_File()
+    int LoggingHandler::Collect(int idx_first, int idx_last, std::vector<LogEntry> & entries, int & n_lost)
     {
-        if (this->messages_to_file)
+        // Older entries have been overwritten
+        n_lost = std::max(0, idx_last - buffer_size - idx_first);
+
+        int idx_entry = idx_first + n_lost;
+        for (; idx_entry < idx_last; ++idx_entry)
         {
-            // Log this event
-            Send(Log_Level::Info, Log_Sender::All, "Appending Log to file " + output_folder + "/" + fileName);
-            
-            // Gather the string
-            std::string logstring = "";
-            int begin_append = no_dumped;
-            no_dumped = n_entries;
-            for (int i=begin_append; i<n_entries; ++i)
+            auto& slot = log_entries[idx_entry % buffer_size];
+            while (slot.busy.exchange(true, std::memory_order_acquire))
+                std::this_thread::yield();
+            int idx_slot = slot.idx_entry;
+            if (idx_slot == idx_entry && slot.kept)
+                entries.push_back(slot.entry);
+            slot.busy.store(false, std::memory_order_release);
+
+            // An entry which is still being stored ends the collected range
+            if (idx_slot < idx_entry)
+                break;
+            // The entry may have been overwritten since idx_last was read
+            if (idx_slot > idx_entry)
+                ++n_lost;
+        }
+        return idx_entry;
+    }
+
+    void LoggingHandler::Write_to_File(bool append)
+    {
+        std::string filename = output_folder + "/" + fileName;
+        std::size_t n_bytes = 0;
+        {
+            // Take the entries which have not yet been written, or all of them for a new file.
+            //      Entries which are still being stored are left for the next time.
+            std::lock_guard<std::mutex> guard(mutex_file);
+            int idx_first = append ? int(no_dumped) : 0;
+            int idx_last = n_entries;
+            if (append && idx_first >= idx_last) return;
+            File_Batch batch{ filename, append, level_file, 0, {} };
+            no_dumped = Collect(idx_first, idx_last, batch.entries, batch.n_lost);
+
+            // With MPI, all ranks hold the same data and only rank 0 writes
+            if (rank != 0) return;
+            n_bytes = batch.entries.size() * sizeof(LogEntry);
+            std::lock_guard<std::mutex> guard_pending(pending->mutex);
+            pending->batches.push_back(std::move(batch));
+        }
+
+        // The formatting and writing is queued in the asynchronous output after mutex_file has
+        //      been released, as Enqueue may block until enough output has been written
+        auto pending = this->pending;
+        IO::Output_Queue::Enqueue(filename, [pending, filename]()
+        {
+            // Take the batches for this file in the order in which they were collected. Batches
+            //      which were queued meanwhile may be taken as well, their own tasks then find none.
+            std::vector<File_Batch> batches;
+            {
+                std::lock_guard<std::mutex> guard(pending->mutex);
+                for (auto it = pending->batches.begin(); it != pending->batches.end();)
+                {
+                    if (it->filename == filename)
+                    {
+                        batches.push_back(std::move(*it));
+                        it = pending->batches.erase(it);
+                    }
+                    else
+                        ++it;
+                }
+            }
+
+            for (auto& batch : batches)
             {
-                auto level = log_entries[i].level;
-                if (level <= level_file || level == Log_Level::Error || level == Log_Level::Severe)
+                // Gather the string
+                std::string logstring = "";
+                if (batch.n_lost > 0)
+                    logstring += fmt::format("{} Log entries were overwritten before they could be written to file\n", batch.n_lost);
+                for (auto& entry : batch.entries)
                 {
-                    logstring.append(LogEntryToString(log_entries[i]));
-                    logstring.append("\n");
+                    if (entry.level <= batch.level_file || entry.level == Log_Level::Error || entry.level == Log_Level::Severe)
+                    {
+                        logstring.append(LogEntryToString(entry));
+                        logstring.append("\n");
+                    }
                 }
+
+                // Written directly, as the IO functions would log the writing of the Log
+                std::ofstream file(filename, batch.append ? std::ofstream::out | std::ofstream::app : std::ofstream::out);
+                if (file.is_open())
+                    file << logstring;
+                else
+                    std::cerr << "Could not open " << filename << " to write the Log" << std::endl;
             }
+        }, n_bytes);
+    }
 
-            // Append to file
-            IO::Append_String_to_File(logstring, output_folder + "/" + fileName);
+    void LoggingHandler::Append_to_File()
+    {
+        if (this->messages_to_file)
+        {
+            // Log this event
+            Send(Log_Level::Info, Log_Sender::All, "Appending Log to file " + output_folder + "/" + fileName);
+            Write_to_File(true);
         }
         else
         {
@@ -285,21 +422,7 @@ namespace Utility
         {
             // Log this event
             Send(Log_Level::Info, Log_Sender::All, "Dumping Log to file " + output_folder + "/" + fileName);
-
-            // Gather the string
-            std::string logstring = "";
-            for (int i=0; i<n_entries; ++i)
-            {
-                auto level = log_entries[i].level;
-                if (level <= level_file || level == Log_Level::Error || level == Log_Level::Severe)
-                {
-                    logstring.append(LogEntryToString(log_entries[i]));
-                    logstring.append("\n");
-                }
-            }
-
-            // Write the string to file
-            IO::String_to_File(logstring, output_folder + "/" + fileName);
+            Write_to_File(false);
         }
         else
         {
@@ -0,0 +1,121 @@
+#include <utility/Memory.hpp>
+#include <utility/Exception.hpp>
+#include <utility/Logging.hpp>
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <unistd.h>
+#endif
+
+namespace Utility
+{
+    namespace Memory
+    {
+        Report::Report(const std::string & name) :
+            name(name), bytes(0)
+        {
+        }
+
+        void Report::Add(const std::string & name, std::size_t bytes)
+        {
+            this->Child(name).bytes += bytes;
+        }
+
+        Report & Report::Child(const std::string & name)
+        {
+            for (auto & child : this->children)
+            {
+                if (child->name == name)
+                    return *child;
+            }
+            this->children.push_back(std::unique_ptr<Report>(new Report(name)));
+            return *this->children.back();
+        }
+
+        std::size_t Report::Bytes() const
+        {
+            std::size_t total = this->bytes;
+            for (auto & child : this->children)
+                total += child->Bytes();
+            return total;
+        }
+
+        std::vector<std::string> Report::Lines(int max_depth, std::size_t min_bytes) const
+        {
+            std::vector<std::string> lines;
+            this->Lines(lines, 0, max_depth, min_bytes);
+            return lines;
+        }
+
+        void Report::Lines(std::vector<std::string> & lines, int depth, int max_depth, std::size_t min_bytes) const
+        {
+            std::string indent(4 * (depth + 1), ' ');
+            lines.push_back(fmt::format("{:<40} {:>12}", indent + this->name + ":", Format_Bytes(this->Bytes())));
+            if (max_depth >= 0 && depth >= max_depth)
+                return;
+            for (auto & child : this->children)
+            {
+                if (child->Bytes() >= min_bytes && child->Bytes() > 0)
+                    child->Lines(lines, depth + 1, max_depth, min_bytes);
+            }
+        }
+
+        std::string Format_Bytes(std::size_t bytes)
+        {
+            if (bytes >= (std::size_t(1) << 30))
+                return fmt::format("{:.2f} GiB", bytes / scalar(std::size_t(1) << 30));
+            else if (bytes >= (std::size_t(1) << 20))
+                return fmt::format("{:.2f} MiB", bytes / scalar(std::size_t(1) << 20));
+            else if (bytes >= (std::size_t(1) << 10))
+                return fmt::format("{:.2f} KiB", bytes / scalar(std::size_t(1) << 10));
+            return fmt::format("{} B", bytes);
+        }
+
+        std::size_t Available()
+        {
+            #if defined(_WIN32)
+            MEMORYSTATUSEX status;
+            status.dwLength = sizeof(status);
+            if (GlobalMemoryStatusEx(&status))
+                return std::size_t(status.ullAvailPhys);
+            return 0;
+            #else
+            // On Linux, MemAvailable includes the caches which can be dropped
+            std::ifstream meminfo("/proc/meminfo");
+            std::string line;
+            while (std::getline(meminfo, line))
+            {
+                std::istringstream stream(line);
+                std::string key;
+                std::size_t kilobytes = 0;
+                if (stream >> key >> kilobytes && key == "MemAvailable:")
+                    return kilobytes * 1024;
+            }
+            #if defined(_SC_AVPHYS_PAGES) && defined(_SC_PAGE_SIZE)
+            long pages = sysconf(_SC_AVPHYS_PAGES);
+            long page_size = sysconf(_SC_PAGE_SIZE);
+            if (pages > 0 && page_size > 0)
+                return std::size_t(pages) * std::size_t(page_size);
+            #endif
+            return 0;
+            #endif
+        }
+
+        void Require(const std::string & what, std::size_t bytes)
+        {
+            std::size_t available = Available();
+            if (available > 0 && bytes > available)
+                spirit_throw(Exception_Classifier::Insufficient_Memory, Log_Level::Error,
+                    fmt::format("The {} requires {}, but only {} are available", what, Format_Bytes(bytes), Format_Bytes(available)));
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include <utility/Profiling.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Utility
+{
+    namespace Profiling
+    {
+        namespace
+        {
+            // Timings the calling thread collects into and its innermost running timer
+            thread_local Timings * current_timings = nullptr;
+            thread_local Scoped_Timer * current_timer = nullptr;
+        }
+
+        void Timings::Add(const char * name, std::chrono::steady_clock::duration duration)
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            // The names are string literals, so there are only few and they can be compared by address
+            for (auto & entry : this->entries)
+            {
+                if (entry.name == name)
+                {
+                    ++entry.count;
+                    entry.duration += duration;
+                    return;
+                }
+            }
+            this->entries.push_back({name, 1, duration});
+        }
+
+        void Timings::Reset()
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->entries.clear();
+        }
+
+        std::vector<Timer_Entry> Timings::Entries() const
+        {
+            std::vector<Timer_Entry> result;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                for (auto & entry : this->entries)
+                {
+                    scalar seconds = std::chrono::duration<scalar>(entry.duration).count();
+                    // The same name may be used at several places
+                    auto merged = std::find_if(result.begin(), result.end(),
+                        [&](const Timer_Entry & e) { return std::strcmp(e.name.c_str(), entry.name) == 0; });
+                    if (merged != result.end())
+                    {
+                        merged->count += entry.count;
+                        merged->seconds += seconds;
+                    }
+                    else
+                        result.push_back({entry.name, entry.count, seconds});
+                }
+            }
+            std::stable_sort(result.begin(), result.end(),
+                [](const Timer_Entry & a, const Timer_Entry & b) { return a.seconds > b.seconds; });
+            return result;
+        }
+
+        std::vector<std::string> Timings::Summary() const
+        {
+            auto entries = this->Entries();
+            if (entries.empty())
+                return {};
+
+            scalar total = 0;
+            for (auto & entry : entries)
+                total += entry.seconds;
+
+            std::vector<std::string> lines;
+            lines.push_back(fmt::format("    Timings ({:.3f} s in timed scopes):", total));
+            for (auto & entry : entries)
+            {
+                scalar share = total > 0 ? 100 * entry.seconds / total : 0;
+                lines.push_back(fmt::format("        {:<22} {:>10.3f} s {:>6.1f} % {:>10} calls",
+                    entry.name + ":", entry.seconds, share, entry.count));
+            }
+            return lines;
+        }
+
+        Collector::Collector(Timings & timings) :
+            previous_timings(current_timings), previous_timer(current_timer)
+        {
+            current_timings = &timings;
+            current_timer = nullptr;
+        }
+
+        Collector::~Collector()
+        {
+            current_timings = this->previous_timings;
+            current_timer = this->previous_timer;
+        }
+
+        Scoped_Timer::Scoped_Timer(const char * name) :
+            name(name), timings(current_timings)
+        {
+            if (!this->timings)
+                return;
+            this->parent = current_timer;
+            current_timer = this;
+            this->children = std::chrono::steady_clock::duration::zero();
+            this->start = std::chrono::steady_clock::now();
+        }
+
+        Scoped_Timer::~Scoped_Timer()
+        {
+            if (!this->timings)
+                return;
+            auto duration = std::chrono::steady_clock::now() - this->start;
+            this->timings->Add(this->name, duration - this->children);
+            if (this->parent)
+                this->parent->children += duration;
+            current_timer = this->parent;
+        }
+    }
+}
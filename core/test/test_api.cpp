@@ -4,9 +4,26 @@
 #include <Spirit/Chain.h>
 #include <Spirit/System.h>
 #include <Spirit/Configurations.h>
+#include <Spirit/Geometry.h>
+#include <Spirit/Hamiltonian.h>
 #include <Spirit/Quantities.h>
 #include <Spirit/Simulation.h>
+#include <Spirit/Parameters.h>
+#include <Spirit/Log.h>
+#include <engine/Hamiltonian_Heisenberg_Neighbours.hpp>
+#include <io/Output_Queue.hpp>
 #include <utility/Exception.hpp>
+#include <utility/Logging.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#ifdef SPIRIT_USE_THREADS
+#include <thread>
+#endif
 
 auto inputfile = "core/test/input/api.cfg";
 
@@ -68,6 +85,37 @@ TEST_CASE( "State", "[state]" )
         CHECK_NOTHROW( from_indices( state.get(), idx_image, idx_chain, image, chain ) );
         REQUIRE( idx_chain == 0 ); // the negative index chain must be promoted to the active chain
     }
+
+    SECTION( "Memory report" )
+    {
+        auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+        Parameters_Set_LLG_Output_General( state.get(), false, false, false );
+        Simulation_PlayPause( state.get(), "LLG", "SIB", 10 );
+
+        int n = State_Get_Memory_Report( state.get() );
+        std::vector<char> names( n*State_Memory_Name_Length );
+        std::vector<int> depths( n );
+        std::vector<long long> bytes( n );
+        REQUIRE( State_Get_Memory_Report( state.get(), n, names.data(), depths.data(), bytes.data() ) == n );
+        REQUIRE( std::string( &names[0] ) == "State" );
+        REQUIRE( depths[0] == 0 );
+
+        // The State contains the spins of each image and the workspace of the finished method,
+        //      and the bytes of the top-level entries sum up to the total
+        std::map<std::string, long long> entries;
+        long long sum = 0;
+        for (int i = 1; i < n; ++i)
+        {
+            entries[std::string( &names[i*State_Memory_Name_Length] )] += bytes[i];
+            if (depths[i] == 1)
+                sum += bytes[i];
+        }
+        REQUIRE( sum == bytes[0] );
+        REQUIRE( entries["spins"] >= (long long)(state->active_chain->noi * state->active_image->nos * sizeof(Vector3)) );
+        REQUIRE( entries["Geometry"] > 0 );
+        REQUIRE( entries["Hamiltonian"] > 0 );
+        REQUIRE( entries["Methods"] > 0 );
+    }
 }
 
 TEST_CASE( "Configurations", "[configurations]" )
@@ -122,6 +170,132 @@ TEST_CASE( "Configurations", "[configurations]" )
 	}
 }
 
+TEST_CASE( "Geometry", "[geometry]" )
+{
+	auto state = std::shared_ptr<State>(State_Setup(inputfile), State_Delete);
+
+	SECTION("Triangulation")
+	{
+		// The triangles of a 100x100 lattice are generated from the cells
+		const int * indices = nullptr;
+		int n_triangles = Geometry_Get_Triangulation(state.get(), &indices);
+		REQUIRE( n_triangles == 2*99*99 );
+		REQUIRE( indices != nullptr );
+
+		// Every n_cell_step'th cell
+		n_triangles = Geometry_Get_Triangulation(state.get(), &indices, 2);
+		REQUIRE( n_triangles == 2*49*49 );
+
+		// Periodic boundary conditions add the triangles wrapping around the lattice
+		auto& geometry = *state->active_image->geometry;
+		REQUIRE( geometry.triangulation(1, intfield{1, 1, 0}).size() == 2*100*100 );
+		REQUIRE( geometry.triangulation(1, intfield{1, 0, 0}).size() == 2*100*99 );
+
+		// Each combination of boundary conditions is cached, so the triangulations stay valid side by side
+		auto& triangles_open     = geometry.triangulation(1, intfield{0, 0, 0});
+		auto& triangles_periodic = geometry.triangulation(1, intfield{1, 1, 0});
+		REQUIRE( &geometry.triangulation(1, intfield{0, 0, 0}) == &triangles_open );
+		REQUIRE( triangles_open.size() == 2*99*99 );
+		REQUIRE( triangles_periodic.size() == 2*100*100 );
+
+		#ifdef SPIRIT_USE_THREADS
+		// Concurrent callers get the same triangulation
+		std::vector<const std::vector<Data::triangle_t>*> results(4, nullptr);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < 4; ++i)
+			threads.emplace_back([&, i]() { results[i] = &geometry.triangulation(2, intfield{1, 1, 0}); });
+		for (auto& thread : threads)
+			thread.join();
+		for (int i = 1; i < 4; ++i)
+			REQUIRE( results[i] == results[0] );
+		REQUIRE( results[0]->size() == 2*50*50 );
+		#endif
+
+		// Boundary conditions have to be given for all directions
+		REQUIRE_THROWS( geometry.triangulation(1, intfield{1, 1}) );
+
+		// Hexagonal lattice
+		Geometry_Set_Bravais_Lattice(state.get(), "hex2d60");
+		n_triangles = Geometry_Get_Triangulation(state.get(), &indices);
+		REQUIRE( n_triangles == 2*99*99 );
+	}
+
+	SECTION("Resize")
+	{
+		Configuration_MinusZ(state.get());
+		Configuration_Skyrmion(state.get(), 6.0, 1.0, -90.0, true, false, false);
+		REQUIRE( Quantity_Get_Topological_Charge(state.get()) == Approx(1) );
+
+		// Centring keeps the single skyrmion and extends the background
+		int n_cells[3]{ 150, 150, 1 };
+		Geometry_Set_N_Cells(state.get(), n_cells, Geometry_Remap_Centre);
+		REQUIRE( System_Get_NOS(state.get()) == 150*150 );
+		REQUIRE( Quantity_Get_Topological_Charge(state.get()) == Approx(1).epsilon(1e-4) );
+
+		// Tiling repeats it
+		n_cells[0] = 300;
+		Geometry_Set_N_Cells(state.get(), n_cells, Geometry_Remap_Tile);
+		REQUIRE( System_Get_NOS(state.get()) == 300*150 );
+		REQUIRE( Quantity_Get_Topological_Charge(state.get()) == Approx(2).epsilon(1e-4) );
+	}
+
+	SECTION("Cell atoms")
+	{
+		float jij[1]{ 10 };
+		float dij[1]{ 6 };
+		float normal[3]{ 0, 0, 1 };
+		Hamiltonian_Set_Exchange(state.get(), 1, jij);
+		Hamiltonian_Set_DMI(state.get(), 1, dij);
+		auto& ham = *(Engine::Hamiltonian_Heisenberg_Neighbours*)state->active_image->hamiltonian.get();
+		REQUIRE( ham.Name() == "Heisenberg (Neighbours)" );
+
+		// A second basis atom in the centre of the cell gets its own neighbour shells
+		float atom_0[3]{ 0, 0, 0 };
+		float atom_1[3]{ 0.5, 0.5, 0 };
+		float * atoms[2]{ atom_0, atom_1 };
+		Geometry_Set_Cell_Atoms(state.get(), 2, atoms);
+		Hamiltonian_Set_Anisotropy(state.get(), 0.5, normal);
+		REQUIRE( ham.mu_s.size() == 2 );
+		REQUIRE( ham.anisotropy_indices.size() == 2 );
+		REQUIRE( ham.dmi_normals.size() == ham.dmi_neighbours.size() );
+		int n_neighbours_1 = 0;
+		for (auto& neigh : ham.exchange_neighbours)
+			if (neigh.i == 1) ++n_neighbours_1;
+		REQUIRE( n_neighbours_1 == 4 );
+		REQUIRE( std::isfinite(System_Get_Energy(state.get())) );
+
+		// Removing it again removes its neighbours and anisotropy
+		Geometry_Set_Cell_Atoms(state.get(), 1, atoms);
+		REQUIRE( ham.mu_s.size() == 1 );
+		REQUIRE( ham.anisotropy_indices.size() == 1 );
+		REQUIRE( ham.dmi_normals.size() == ham.dmi_neighbours.size() );
+		for (auto& neigh : ham.exchange_neighbours)
+			REQUIRE( (neigh.i == 0 && neigh.j == 0) );
+		for (auto& neigh : ham.dmi_neighbours)
+			REQUIRE( (neigh.i == 0 && neigh.j == 0) );
+		REQUIRE( std::isfinite(System_Get_Energy(state.get())) );
+
+		// Resizing a large lattice does not change the neighbour shells, so they are kept
+		auto exchange_neighbours = ham.exchange_neighbours.data();
+		int n_cells[3]{ 120, 80, 1 };
+		Geometry_Set_N_Cells(state.get(), n_cells);
+		REQUIRE( ham.exchange_neighbours.data() == exchange_neighbours );
+		REQUIRE( std::isfinite(System_Get_Energy(state.get())) );
+	}
+
+	SECTION("Tetrahedra")
+	{
+		int n_cells[3]{ 10, 10, 10 };
+		Geometry_Set_N_Cells(state.get(), n_cells);
+		REQUIRE( Geometry_Get_Dimensionality(state.get()) == 3 );
+
+		// Every cube is split into six tetrahedra
+		const int * indices = nullptr;
+		int n_tetrahedra = Geometry_Get_Tetrahedra(state.get(), &indices);
+		REQUIRE( n_tetrahedra == 6*9*9*9 );
+	}
+}
+
 TEST_CASE( "Quantities", "[quantities]" )
 {
 	SECTION("Magnetization")
@@ -171,5 +345,371 @@ TEST_CASE( "Quantities", "[quantities]" )
 			float charge = Quantity_Get_Topological_Charge(state.get());
 			REQUIRE(charge == Approx(1));
 		}
+
+		SECTION("charge density")
+		{
+			Configuration_MinusZ(state.get());
+			Configuration_Skyrmion(state.get(), 6.0, 1.0, -90.0, true, false, false);
+			float charge = Quantity_Get_Topological_Charge(state.get());
+
+			// The charge per triangle sums up to the total charge
+			int n_triangles = Quantity_Get_Topological_Charge_Density(state.get(), nullptr, nullptr);
+			REQUIRE( n_triangles > 0 );
+			std::vector<float> density(n_triangles);
+			std::vector<int> indices(3*n_triangles);
+			REQUIRE( Quantity_Get_Topological_Charge_Density(state.get(), density.data(), indices.data()) == n_triangles );
+			float sum = 0;
+			for (auto& d : density) sum += d;
+			REQUIRE( sum == Approx(charge).epsilon(1e-4) );
+
+			// As does the charge per spin
+			std::vector<float> density_per_spin(System_Get_NOS(state.get()));
+			Quantity_Get_Topological_Charge_Density_per_Spin(state.get(), density_per_spin.data());
+			sum = 0;
+			for (auto& d : density_per_spin) sum += d;
+			REQUIRE( sum == Approx(charge).epsilon(1e-4) );
+		}
+	}
+}
+
+TEST_CASE( "Snapshot", "[snapshot]" )
+{
+	auto state = std::shared_ptr<State>(State_Setup(inputfile), State_Delete);
+	int nos = System_Get_NOS(state.get());
+	std::vector<scalar> spins(3*nos), field(3*nos);
+
+	SECTION("Without simulation")
+	{
+		// The current spins are returned, without an iteration
+		Configuration_PlusZ(state.get());
+		REQUIRE( System_Get_Spin_Snapshot(state.get(), spins.data(), field.data()) == -1 );
+		for (int i = 0; i < nos; ++i)
+			REQUIRE( spins[3*i+2] == Approx(1) );
+	}
+
+	SECTION("After simulation")
+	{
+		// The last snapshot published by the method corresponds to the final state
+		Parameters_Set_LLG_Output_General(state.get(), false, false, false);
+		Configuration_Random(state.get());
+		Simulation_PlayPause(state.get(), "LLG", "Depondt", 25);
+		auto snapshot = state->active_image->snapshots.Get();
+		REQUIRE( snapshot );
+		REQUIRE( snapshot->iteration >= 0 );
+		REQUIRE_FALSE( state->active_image->snapshots.live );
+
+		// Without a running simulation, the API returns the current spins
+		REQUIRE( System_Get_Spin_Snapshot(state.get(), spins.data()) == -1 );
+		scalar * directions = System_Get_Spin_Directions(state.get());
+		for (int i = 0; i < 3*nos; ++i)
+			REQUIRE( snapshot->spins[i/3][i%3] == directions[i] );
+		for (int i = 0; i < 3*nos; ++i)
+			REQUIRE( spins[i] == directions[i] );
+	}
+}
+
+TEST_CASE( "Simulation", "[simulation]" )
+{
+	auto state = std::shared_ptr<State>(State_Setup(inputfile), State_Delete);
+	Parameters_Set_LLG_Output_General(state.get(), false, false, false);
+
+	SECTION("Background simulation")
+	{
+		Configuration_Random(state.get());
+		int handle = Simulation_Start_Async(state.get(), "LLG", "Depondt", 20, -1, 1);
+		REQUIRE( handle >= 0 );
+		REQUIRE( Simulation_Wait_Async(state.get(), handle) );
+		REQUIRE( state->method_image[0][0]->getNIterations() == 20 );
+		REQUIRE_FALSE( Simulation_Running_Image(state.get()) );
+
+		// The handle of a finished simulation is released once it has been joined
+		REQUIRE( state->simulations_async.empty() );
+		REQUIRE_FALSE( Simulation_Finished_Async(state.get(), handle) );
+
+		// or found to be finished
+		handle = Simulation_Start_Async(state.get(), "LLG", "Depondt", 20, -1, 1);
+		int iteration = 0;
+		while( !Simulation_Finished_Async(state.get(), handle) )
+			iteration = Simulation_Get_Iteration_Async(state.get(), handle);
+		REQUIRE( iteration <= 20 );
+		REQUIRE( state->simulations_async.empty() );
+	}
+
+	#ifdef SPIRIT_USE_THREADS
+	SECTION("Cancellation")
+	{
+		Configuration_Random(state.get());
+		int handle = Simulation_Start_Async(state.get(), "LLG", "Depondt", 1000000000, -1, 1);
+		REQUIRE( handle >= 0 );
+		// A second simulation cannot be started on the same image
+		REQUIRE( Simulation_Start_Async(state.get(), "LLG", "Depondt") == -1 );
+		REQUIRE_FALSE( Simulation_Wait_Async(state.get(), handle, 0.01f) );
+		Simulation_Cancel_Async(state.get(), handle);
+		REQUIRE( Simulation_Wait_Async(state.get(), handle, 10) );
+		REQUIRE( state->method_image[0][0]->getNIterations() < 1000000000 );
+		REQUIRE_FALSE( Simulation_Running_Image(state.get()) );
+	}
+
+	SECTION("Concurrent background simulations")
+	{
+		// Background simulations can be started, polled and released from several threads at once
+		Configuration_Random(state.get());
+		Chain_Image_to_Clipboard(state.get());
+		int n_threads = 4;
+		for (int i = 1; i < n_threads; ++i)
+			Chain_Insert_Image_After(state.get());
+		std::vector<int> handles(n_threads, -1);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < n_threads; ++t)
+		{
+			threads.push_back(std::thread([&state, &handles, t]()
+			{
+				handles[t] = Simulation_Start_Async(state.get(), "LLG", "Depondt", 20, -1, 1, t);
+				while( handles[t] >= 0 && !Simulation_Finished_Async(state.get(), handles[t]) )
+					Simulation_Get_Iteration_Async(state.get(), handles[t]);
+			}));
+		}
+		for (auto& thread : threads)
+			thread.join();
+		for (int t = 0; t < n_threads; ++t)
+		{
+			REQUIRE( handles[t] >= 0 );
+			REQUIRE( state->method_image[0][t]->getNIterations() == 20 );
+			for (int u = 0; u < t; ++u)
+				REQUIRE( handles[t] != handles[u] );
+		}
+		REQUIRE( state->simulations_async.empty() );
 	}
-}
\ No newline at end of file
+	#endif
+
+	SECTION("Sweep")
+	{
+		Configuration_Random(state.get());
+		int nos = System_Get_NOS(state.get());
+		std::vector<scalar> spins_initial(System_Get_Spin_Directions(state.get()),
+			System_Get_Spin_Directions(state.get()) + 3*nos);
+
+		// Points with the same parameters give the same results, independent of the worker
+		int parameters[] = { Sweep_Parameter_Field, Sweep_Parameter_Temperature };
+		scalar points[] = { 5, 0,  5, 0,  5, 0,  5, 0 };
+		std::vector<scalar> results(4*Sweep_N_Observables, 0);
+		REQUIRE( Simulation_Sweep(state.get(), "LLG", "Depondt", 2, parameters, 4, points, results.data(),
+			false, 2, "", 20) == 4 );
+		for (int i = 1; i < 4; ++i)
+		{
+			for (int j = 0; j < Sweep_N_Observables; ++j)
+				REQUIRE( results[i*Sweep_N_Observables + j] == results[j] );
+		}
+		REQUIRE_FALSE( std::isnan(results[0]) );
+
+		// The image itself is not changed
+		scalar * spins = System_Get_Spin_Directions(state.get());
+		for (int i = 0; i < 3*nos; ++i)
+			REQUIRE( spins[i] == spins_initial[i] );
+		REQUIRE_FALSE( Simulation_Running_Image(state.get()) );
+
+		// Neither are its parameters
+		int n_iterations, n_iterations_log;
+		Parameters_Get_LLG_N_Iterations(state.get(), &n_iterations, &n_iterations_log);
+		REQUIRE( n_iterations != 20 );
+
+		// With a warm start, the second point continues from the first one
+		std::vector<scalar> results_warm(2*Sweep_N_Observables, 0);
+		REQUIRE( Simulation_Sweep(state.get(), "LLG", "Depondt", 2, parameters, 2, points, results_warm.data(),
+			true, 1, "", 20) == 2 );
+		for (int j = 0; j < Sweep_N_Observables; ++j)
+			REQUIRE( results_warm[j] == results[j] );
+		REQUIRE( results_warm[Sweep_N_Observables] != results[Sweep_N_Observables] );
+
+		// Different parameters give different results. The random numbers of a point at nonzero
+		// temperature depend on its index, but not on the worker running it.
+		scalar points_temperature[] = { 0, 0,  5, 0,  5, 10,  5, 10 };
+		std::vector<scalar> results_one(4*Sweep_N_Observables, 0), results_two(4*Sweep_N_Observables, 0);
+		REQUIRE( Simulation_Sweep(state.get(), "LLG", "Depondt", 2, parameters, 4, points_temperature,
+			results_one.data(), false, 1, "", 20) == 4 );
+		REQUIRE( Simulation_Sweep(state.get(), "LLG", "Depondt", 2, parameters, 4, points_temperature,
+			results_two.data(), false, 2, "", 20) == 4 );
+		REQUIRE( results_one == results_two );
+		REQUIRE( results_one[0] != results_one[Sweep_N_Observables] );
+		REQUIRE( results_one[Sweep_N_Observables] != results_one[2*Sweep_N_Observables] );
+		REQUIRE( results_one[2*Sweep_N_Observables] != results_one[3*Sweep_N_Observables] );
+		for (int j = 0; j < Sweep_N_Observables; ++j)
+			REQUIRE( results_one[Sweep_N_Observables + j] == results[j] );
+
+		// Invalid parameters
+		int parameters_invalid[] = { 42 };
+		REQUIRE( Simulation_Sweep(state.get(), "LLG", "Depondt", 1, parameters_invalid, 4, points) == 0 );
+		REQUIRE( Simulation_Sweep(state.get(), "GNEB", "Depondt", 1, parameters, 4, points) == 0 );
+	}
+
+	SECTION("Timings")
+	{
+		Configuration_Random(state.get());
+		Simulation_PlayPause(state.get(), "LLG", "SIB", 10);
+		int n = Simulation_Get_Timings(state.get());
+		#ifdef SPIRIT_ENABLE_TIMINGS
+		std::vector<char> names(n*Simulation_Timing_Name_Length);
+		std::vector<int> counts(n);
+		std::vector<scalar> seconds(n);
+		REQUIRE( Simulation_Get_Timings(state.get(), n, names.data(), counts.data(), seconds.data()) == n );
+
+		// The SIB solver calculates the force twice per iteration
+		std::map<std::string, int> calls;
+		for (int i = 0; i < n; ++i)
+		{
+			calls[std::string(&names[i*Simulation_Timing_Name_Length])] = counts[i];
+			REQUIRE( seconds[i] >= 0 );
+			if (i > 0)
+				REQUIRE( seconds[i] <= seconds[i-1] );
+		}
+		REQUIRE( calls["Update"] == 10 );
+		REQUIRE( calls["Force"] == 20 );
+		REQUIRE( calls["Virtual force"] == 20 );
+		REQUIRE( calls["Gradient Exchange"] == 20 );
+		REQUIRE( calls["Save"] >= 2 );
+		#else
+		REQUIRE( n == 0 );
+		#endif
+	}
+}
+
+TEST_CASE( "Log", "[log]" )
+{
+	auto state = std::shared_ptr<State>(State_Setup(inputfile), State_Delete);
+	bool to_console = Log_Get_Output_To_Console(state.get());
+	bool to_file = Log_Get_Output_To_File(state.get());
+	int level_file = Log_Get_Output_File_Level(state.get());
+
+	SECTION("Filtered messages")
+	{
+		// Messages which are neither printed nor saved are not kept, but still counted
+		Log_Set_Output_To_Console(state.get(), false);
+		Log_Set_Output_To_File(state.get(), false);
+		int n_entries  = Log_Get_N_Entries(state.get());
+		int n_warnings = Log_Get_N_Warnings(state.get());
+		REQUIRE_FALSE( Log.Accepts(Utility::Log_Level::All) );
+		Log_Send(state.get(), Log_Level_Info, Log_Sender_API, "Info message");
+		Log_Send(state.get(), Log_Level_Warning, Log_Sender_API, "Warning message");
+		REQUIRE( Log_Get_N_Entries(state.get()) == n_entries + 2 );
+		REQUIRE( Log_Get_N_Warnings(state.get()) == n_warnings + 1 );
+		REQUIRE( Log_Get_Entries(state.get(), n_entries).empty() );
+	}
+
+	SECTION("Ring buffer")
+	{
+		// Only the most recent entries are kept
+		Log_Set_Output_To_Console(state.get(), false);
+		Log_Set_Output_To_File(state.get(), true);
+		Log_Set_Output_File_Level(state.get(), Log_Level_Debug);
+		int n_entries = Log_Get_N_Entries(state.get());
+		int n_messages = Utility::LoggingHandler::buffer_size + 100;
+		for (int i = 0; i < n_messages; ++i)
+			Log_Send(state.get(), Log_Level_Debug, Log_Sender_API, std::to_string(i).c_str());
+		REQUIRE( Log_Get_N_Entries(state.get()) == n_entries + n_messages );
+
+		auto entries = Log_Get_Entries(state.get());
+		REQUIRE( (int)entries.size() == Utility::LoggingHandler::buffer_size );
+		REQUIRE( entries.front().message == "100" );
+		REQUIRE( entries.back().message == std::to_string(n_messages - 1) );
+
+		entries = Log_Get_Entries(state.get(), n_entries + n_messages - 10);
+		REQUIRE( entries.size() == 10 );
+		REQUIRE( entries.front().message == std::to_string(n_messages - 10) );
+	}
+
+	#ifdef SPIRIT_USE_THREADS
+	SECTION("Concurrent messages")
+	{
+		Log_Set_Output_To_Console(state.get(), false);
+		Log_Set_Output_To_File(state.get(), true);
+		Log_Set_Output_File_Level(state.get(), Log_Level_Debug);
+		int n_entries = Log_Get_N_Entries(state.get());
+		int n_threads = 4, n_messages = 1000;
+		std::vector<std::thread> threads;
+		for (int t = 0; t < n_threads; ++t)
+		{
+			threads.push_back(std::thread([&state, t, n_messages]()
+			{
+				for (int i = 0; i < n_messages; ++i)
+					Log_Send(state.get(), Log_Level_Debug, Log_Sender_API, std::to_string(i).c_str(), t);
+			}));
+		}
+		for (auto& thread : threads)
+			thread.join();
+		REQUIRE( Log_Get_N_Entries(state.get()) == n_entries + n_threads * n_messages );
+
+		// The messages of each thread are kept in order
+		auto entries = Log_Get_Entries(state.get(), n_entries);
+		REQUIRE( (int)entries.size() == n_threads * n_messages );
+		std::vector<int> next(n_threads, 0);
+		for (auto& entry : entries)
+			REQUIRE( entry.message == std::to_string(next[entry.idx_image]++) );
+	}
+
+	SECTION("Concurrent append")
+	{
+		// Appending from several threads while other threads send messages writes every message
+		// exactly once and in order, also when the asynchronous output is at its memory limit
+		std::string folder = Log.output_folder, filename = Log.fileName;
+		std::size_t max_bytes = IO::Output_Queue::Get_Max_Bytes();
+		IO::Output_Queue::Set_Max_Bytes(1);
+		Log.output_folder = "core/test/io_test_files";
+		Log.fileName = "log_append.txt";
+		Log_Set_Output_To_Console(state.get(), false);
+		Log_Set_Output_To_File(state.get(), true);
+		Log_Set_Output_File_Level(state.get(), Log_Level_Debug);
+		Log_Dump(state.get());
+		int n_threads = 4, n_messages = 1000;
+		std::vector<std::thread> threads;
+		for (int t = 0; t < n_threads; ++t)
+		{
+			threads.push_back(std::thread([&state, n_messages, t]()
+			{
+				for (int i = 0; i < n_messages; ++i)
+				{
+					std::string message = "concurrent append message " + std::to_string(t) + " " + std::to_string(i);
+					Log_Send(state.get(), Log_Level_Debug, Log_Sender_API, message.c_str());
+				}
+			}));
+		}
+		for (int t = 0; t < 2; ++t)
+		{
+			threads.push_back(std::thread([&state]()
+			{
+				for (int i = 0; i < 25; ++i)
+					Log_Append(state.get());
+			}));
+		}
+		for (auto& thread : threads)
+			thread.join();
+		Log_Append(state.get());
+		IO::Output_Queue::Drain();
+		IO::Output_Queue::Set_Max_Bytes(max_bytes);
+
+		std::ifstream file("core/test/io_test_files/log_append.txt");
+		std::string line, tag = "concurrent append message ";
+		int n_lines = 0;
+		std::vector<int> next(n_threads, 0);
+		while (std::getline(file, line))
+		{
+			auto pos = line.find(tag);
+			if (pos == std::string::npos)
+				continue;
+			++n_lines;
+			std::istringstream numbers(line.substr(pos + tag.size()));
+			int t, i;
+			numbers >> t >> i;
+			INFO( line );
+			REQUIRE( i == next[t]++ );
+		}
+		REQUIRE( n_lines == n_threads * n_messages );
+
+		Log.output_folder = folder;
+		Log.fileName = filename;
+	}
+	#endif
+
+	Log_Set_Output_To_Console(state.get(), to_console);
+	Log_Set_Output_To_File(state.get(), to_file);
+	Log_Set_Output_File_Level(state.get(), level_file);
+}
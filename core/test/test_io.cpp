@@ -1,14 +1,32 @@
 #include <catch.hpp>
 #include <io/IO.hpp>
+#include <io/OVF_File.hpp>
+#include <io/Trajectory.hpp>
+#include <io/Output_Selection.hpp>
+#include <io/Filter_File_Handle.hpp>
+#include <io/Dataparser.hpp>
+#include <data/State.hpp>
 #include <Spirit/State.h>
 #include <Spirit/Configurations.h>
 #include <Spirit/System.h>
 #include <Spirit/Chain.h>
+#include <Spirit/IO.h>
+#include <Spirit/Simulation.h>
+#include <Spirit/Parameters.h>
+#include <atomic>
 #include <utility>
 #include <vector>
 #include <iostream>
 #include <algorithm>
 #include <string>
+#include <tuple>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <iterator>
 
 const char inputfile[] = "core/test/input/fd_neighbours.cfg";
 
@@ -187,4 +205,692 @@ TEST_CASE( "IO-OVF-CAPITALIZATION", "[io-ovf]")
        REQUIRE( data[i*3+1] == Approx( 0 ) );
        REQUIRE( data[i*3+2] == Approx( -1 ) );
    }
-}
\ No newline at end of file
+}
+TEST_CASE( "IO-OVF-SEGMENTS", "[io-ovf]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    int nos = System_Get_NOS( state.get() );
+    
+    // create 2 additional images
+    Chain_Image_to_Clipboard( state.get() );
+    Chain_Insert_Image_Before( state.get() );
+    Chain_Insert_Image_Before( state.get() );
+    Configuration_MinusZ( state.get(), defaultPos, defaultRect, -1, -1, false, 0 );
+    Configuration_Random( state.get(), defaultPos, defaultRect, -1, -1, false, false, 1 );
+    Configuration_Domain( state.get(), std::array<float,3>{ {1, 0, 0} }.data(), defaultPos, 
+                          defaultRect, -1, -1, false, 2 );
+    
+    std::vector<std::vector<scalar>> spins( 3 );
+    for (int img=0; img<3; img++)
+    {
+        scalar * data = System_Get_Spin_Directions( state.get(), img );
+        spins[img].assign( data, data + 3*nos );
+    }
+    
+    std::vector<std::tuple< std::string, int, double >>  filetypes { 
+        { "core/test/io_test_files/chain_ovf_txt.ovf",   IO_Fileformat_OVF_text, 1e-8  },
+        { "core/test/io_test_files/chain_ovf_bin_4.ovf", IO_Fileformat_OVF_bin4, 1e-6  },
+        { "core/test/io_test_files/chain_ovf_bin_8.ovf", IO_Fileformat_OVF_bin8, 1e-12 } };
+    
+    for ( auto file : filetypes )
+    {
+        const char * filename = std::get<0>( file ).c_str();
+        int filetype = std::get<1>( file );
+        double epsilon = std::get<2>( file );
+        INFO( "IO OVF segments " + std::get<0>( file ) );
+        
+        // Every image is written as a segment
+        IO_Chain_Write( state.get(), filename, filetype );
+        REQUIRE( IO_N_Images_In_File( state.get(), filename, filetype ) == 3 );
+        
+        // A single segment can be read into an image
+        auto state_read = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+        IO_Image_Read( state_read.get(), filename, filetype, 2 );
+        scalar * data = System_Get_Spin_Directions( state_read.get() );
+        for (int i=0; i<3*nos; i++)
+            REQUIRE( data[i] == Approx( spins[2][i] ).epsilon( epsilon ) );
+        
+        // All segments are read into the images of a chain
+        IO_Chain_Read( state_read.get(), filename, filetype );
+        REQUIRE( Chain_Get_NOI( state_read.get() ) == 3 );
+        for (int img=0; img<3; img++)
+        {
+            data = System_Get_Spin_Directions( state_read.get(), img );
+            for (int i=0; i<3*nos; i++)
+                REQUIRE( data[i] == Approx( spins[img][i] ).epsilon( epsilon ) );
+        }
+    }
+    
+    // Counting images is only supported for OVF files
+    IO_Image_Write( state.get(), "core/test/io_test_files/image_regular.data", IO_Fileformat_Regular );
+    REQUIRE( IO_N_Images_In_File( state.get(), "core/test/io_test_files/image_regular.data", IO_Fileformat_Regular ) == -1 );
+
+    // Appending adds segments to the file
+    const char filename[] = "core/test/io_test_files/image_ovf_append.ovf";
+    IO_Image_Write( state.get(), filename, IO_Fileformat_OVF_bin8, "-", 0 );
+    IO_Image_Append( state.get(), filename, IO_Fileformat_OVF_bin8, "-", 1 );
+    IO_Image_Append( state.get(), filename, IO_Fileformat_OVF_bin8, "-", 2 );
+    IO::OVF_File ovf( filename );
+    REQUIRE( ovf.n_segments() == 3 );
+    {
+        std::ifstream file( filename );
+        std::string line;
+        std::getline( file, line );
+        std::getline( file, line );
+        std::getline( file, line );
+        REQUIRE( line == "# Segment count: 000003" );
+    }
+    
+    auto state_read = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    IO_Image_Read( state_read.get(), filename, IO_Fileformat_OVF_bin8, 1 );
+    scalar * data = System_Get_Spin_Directions( state_read.get() );
+    for (int i=0; i<3*nos; i++)
+        REQUIRE( data[i] == Approx( spins[1][i] ).epsilon( 1e-12 ) );
+}
+
+TEST_CASE( "IO-OVF-COMPRESSED", "[io-ovf]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    int nos = System_Get_NOS( state.get() );
+
+    Chain_Image_to_Clipboard( state.get() );
+    Chain_Insert_Image_Before( state.get() );
+    Configuration_Random( state.get(), defaultPos, defaultRect, -1, -1, false, false, 0 );
+    Configuration_Skyrmion( state.get(), 5, 1, -90, false, false, false, defaultPos,
+                            defaultRect, -1, -1, false, 1 );
+
+    std::vector<std::vector<scalar>> spins( 2 );
+    for (int img=0; img<2; img++)
+    {
+        scalar * data = System_Get_Spin_Directions( state.get(), img );
+        spins[img].assign( data, data + 3*nos );
+    }
+
+    // The octahedral encoding is lossy, but the deviation of each component is bounded
+    std::vector<std::tuple< std::string, int, double >> filetypes {
+        { "core/test/io_test_files/chain_ovf_oct16.ovf", IO_Fileformat_OVF_oct16, 1e-4 } };
+    #ifdef SPIRIT_USE_ZLIB
+    filetypes.push_back( std::make_tuple( std::string( "core/test/io_test_files/chain_ovf_bin4_zlib.ovf" ),
+                                          IO_Fileformat_OVF_bin4_zlib, 1e-6 ) );
+    #endif
+
+    for ( auto file : filetypes )
+    {
+        const char * filename = std::get<0>( file ).c_str();
+        int filetype = std::get<1>( file );
+        double max_deviation = std::get<2>( file );
+        INFO( "IO OVF compressed " + std::get<0>( file ) );
+
+        IO_Chain_Write( state.get(), filename, filetype );
+        IO::OVF_File ovf( filename );
+        REQUIRE( ovf.n_segments() == 2 );
+        REQUIRE( ovf.n_values( 1 ) == nos );
+
+        auto state_read = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+        IO_Chain_Read( state_read.get(), filename, filetype );
+        REQUIRE( Chain_Get_NOI( state_read.get() ) == 2 );
+        for (int img=0; img<2; img++)
+        {
+            scalar * data = System_Get_Spin_Directions( state_read.get(), img );
+            for (int i=0; i<3*nos; i++)
+                REQUIRE( std::abs( data[i] - spins[img][i] ) < max_deviation );
+        }
+    }
+
+    #ifdef SPIRIT_USE_ZLIB
+    // A corrupt size of the uncompressed data is rejected instead of being allocated
+    {
+        const char filename[] = "core/test/io_test_files/image_ovf_bin4_zlib_corrupt.ovf";
+        IO_Image_Write( state.get(), filename, IO_Fileformat_OVF_bin4_zlib );
+        std::string contents;
+        {
+            std::ifstream file( filename, std::ios::binary );
+            contents.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+        }
+        std::string begin_data = "# Begin: Data Binary 4 Zlib\n";
+        std::size_t pos = contents.find( begin_data );
+        REQUIRE( pos != std::string::npos );
+        pos += begin_data.size();
+        std::uint64_t raw_size;
+        std::memcpy( &raw_size, &contents[pos], sizeof( raw_size ) );
+        REQUIRE( raw_size == 4 * ( 1 + 3 * std::uint64_t( nos ) ) );
+        raw_size = std::uint64_t( 1 ) << 62;
+        std::memcpy( &contents[pos], &raw_size, sizeof( raw_size ) );
+        {
+            std::ofstream file( filename, std::ios::binary | std::ios::trunc );
+            file.write( contents.data(), contents.size() );
+        }
+        REQUIRE_THROWS( IO::OVF_File{ filename } );
+    }
+    #endif
+}
+
+TEST_CASE( "IO-ENERGY-PER-SPIN", "[io-energy]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    int nos = System_Get_NOS( state.get() );
+    Configuration_Skyrmion( state.get(), 5, 1, -90, false, false, false, defaultPos,
+                            defaultRect, -1, -1, false );
+    System_Update_Data( state.get() );
+    auto& image = *state->active_image;
+    int n_contributions = image.E_array.size();
+
+    SECTION( "Text" )
+    {
+        const char filename[] = "core/test/io_test_files/E_per_spin.data";
+        IO_Image_Write_Energy_per_Spin( state.get(), filename );
+
+        // Header lines followed by one line per spin, the energies being normalized by nos
+        std::ifstream file( filename );
+        std::vector<std::string> lines;
+        std::string line;
+        while ( std::getline( file, line ) )
+            lines.push_back( line );
+        REQUIRE( (int)lines.size() > nos );
+        double E = 0;
+        for (int i=0; i<nos; i++)
+        {
+            std::string & entry = lines[lines.size() - nos + i];
+            REQUIRE( std::stoi( entry ) == i );
+            E += std::stod( entry.substr( entry.find( "||" ) + 2 ) );
+        }
+        REQUIRE( E * nos == Approx( image.E ) );
+
+        // The energies are calculated into the buffers of the image, which are reused
+        auto E_per_spin = image.E_per_spin.data();
+        IO_Image_Write_Energy_per_Spin( state.get(), filename );
+        REQUIRE( image.E_per_spin.data() == E_per_spin );
+    }
+
+    SECTION( "OVF" )
+    {
+        const char filename[] = "core/test/io_test_files/E_per_spin.ovf";
+        IO_Image_Write_Energy_per_Spin( state.get(), filename, IO_Fileformat_OVF_bin8 );
+
+        std::ifstream file( filename, std::ios::binary );
+        std::string contents( (std::istreambuf_iterator<char>( file )), std::istreambuf_iterator<char>() );
+        REQUIRE( contents.find( "# valuedim: " + std::to_string( n_contributions + 1 ) + " " ) != std::string::npos );
+        std::string begin = "# Begin: Data Binary 8\n";
+        auto data_begin = contents.find( begin ) + begin.size();
+        REQUIRE( contents.size() > data_begin + 8 * (1 + (n_contributions + 1) * nos) );
+
+        // Check value, followed by the total energy and the contributions of each spin
+        std::vector<double> data( 1 + (n_contributions + 1) * nos );
+        std::memcpy( data.data(), &contents[data_begin], 8 * data.size() );
+        REQUIRE( data[0] == 123456789012345.0 );
+        double E = 0;
+        std::vector<double> E_contributions( n_contributions, 0 );
+        for (int i=0; i<nos; i++)
+        {
+            double * values = &data[1 + i * (n_contributions + 1)];
+            double E_spin = 0;
+            for (int j=0; j<n_contributions; j++)
+            {
+                E_spin += values[1 + j];
+                E_contributions[j] += values[1 + j];
+            }
+            REQUIRE( values[0] == Approx( E_spin ) );
+            E += values[0];
+        }
+        REQUIRE( E * nos == Approx( image.E ) );
+        for (int j=0; j<n_contributions; j++)
+            REQUIRE( std::abs( E_contributions[j] * nos - image.E_array[j].second ) < 1e-6 * (1 + std::abs( image.E )) );
+    }
+}
+
+TEST_CASE( "IO-OUTPUT-SELECTION", "[io-selection]" )
+{
+    // Square lattice with a basis of two atoms
+    auto shared_geometry = std::make_shared<Data::Geometry>( Data::Geometry::BravaisVectorsSC(), intfield{ 9, 8, 1 },
+                             std::vector<Vector3>{ Vector3{ 0, 0, 0 }, Vector3{ 0.5, 0.5, 0 } },
+                             intfield{ 0, 0 }, 1 );
+    auto & geometry = *shared_geometry;
+    vectorfield spins( geometry.nos );
+    for (int i = 0; i < geometry.nos; ++i)
+        spins[i] = Vector3{ scalar(i), 0, 1 };
+
+    SECTION( "All spins" )
+    {
+        IO::Output_Selection selection( shared_geometry, Data::Output_Filter() );
+        REQUIRE( selection.n_selected() == geometry.nos );
+        // The geometry is shared rather than copied
+        REQUIRE( selection.geometry() == shared_geometry );
+        REQUIRE( *selection.Gather( spins ) == spins );
+    }
+
+    SECTION( "Cell stride" )
+    {
+        Data::Output_Filter filter;
+        filter.cell_stride = { {2, 3, 1} };
+        IO::Output_Selection selection( shared_geometry, filter );
+        auto & selected = *selection.geometry();
+
+        // The written spins form a lattice of every 2nd and 3rd cell
+        REQUIRE( selected.n_cells == intfield( { 5, 3, 1 } ) );
+        REQUIRE( selection.n_selected() == 2 * 5 * 3 );
+        auto gathered = selection.Gather( spins );
+        for (int i = 0; i < selection.n_selected(); ++i)
+        {
+            int idx = selection.indices()[i];
+            REQUIRE( (selected.positions[i] - geometry.positions[idx]).norm() < 1e-12 );
+            REQUIRE( (*gathered)[i] == spins[idx] );
+        }
+        REQUIRE( selection.Matches( geometry, filter ) );
+        filter.cell_stride = { {1, 1, 1} };
+        REQUIRE_FALSE( selection.Matches( geometry, filter ) );
+    }
+
+    SECTION( "Region" )
+    {
+        Data::Output_Filter filter;
+        filter.position          = Vector3{ 4, 4, 0 };
+        filter.r_cut_rectangular = Vector3{ 2, 1.5, -1 };
+        IO::Output_Selection selection( shared_geometry, filter );
+        auto & selected = *selection.geometry();
+
+        int n_inside = 0;
+        for (int i = 0; i < geometry.nos; ++i)
+        {
+            Vector3 r = geometry.positions[i] - filter.position;
+            if (std::abs(r[0]) < 2 && std::abs(r[1]) < 1.5) ++n_inside;
+        }
+        REQUIRE( n_inside > 0 );
+        REQUIRE( selection.n_selected() == n_inside );
+        REQUIRE( selected.nos == n_inside );
+        for (int i = 0; i < selection.n_selected(); ++i)
+        {
+            REQUIRE( (selected.positions[i] - geometry.positions[selection.indices()[i]]).norm() < 1e-12 );
+            for (int dim = 0; dim < 3; ++dim)
+            {
+                REQUIRE( selected.positions[i][dim] >= selected.bounds_min[dim] );
+                REQUIRE( selected.positions[i][dim] <= selected.bounds_max[dim] );
+            }
+        }
+
+        // The selected spins are written as an irregular mesh and can be read back
+        auto gathered = selection.Gather( spins );
+        std::vector<std::pair<std::string, IO::VF_FileFormat>> formats {
+            { "core/test/io_test_files/region_txt.ovf",   IO::VF_FileFormat::OVF_TEXT },
+            { "core/test/io_test_files/region_bin_8.ovf", IO::VF_FileFormat::OVF_BIN8 } };
+        for (auto & format : formats)
+        {
+            IO::Write_OVF( { gathered.get() }, { &selected }, format.first, format.second, "region" );
+
+            std::ifstream file( format.first );
+            std::string contents( (std::istreambuf_iterator<char>( file )), std::istreambuf_iterator<char>() );
+            REQUIRE( contents.find( "# meshtype: irregular" ) != std::string::npos );
+            REQUIRE( contents.find( "# pointcount: " + std::to_string( n_inside ) ) != std::string::npos );
+            REQUIRE( contents.find( "# xnodes" ) == std::string::npos );
+
+            IO::OVF_File ovf( format.first );
+            REQUIRE( ovf.n_segments() == 1 );
+            REQUIRE( ovf.n_values( 0 ) == n_inside );
+            vectorfield read( n_inside );
+            ovf.Read_Segment( read, selected );
+            for (int i = 0; i < n_inside; ++i)
+                REQUIRE( (read[i] - (*gathered)[i]).norm() < 1e-12 );
+        }
+
+        // The inverted region selects the remaining spins
+        filter.inverted = true;
+        IO::Output_Selection outside( shared_geometry, filter );
+        REQUIRE( outside.n_selected() == geometry.nos - n_inside );
+    }
+}
+
+TEST_CASE( "IO-TRAJECTORY", "[io-trajectory]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    int nos = System_Get_NOS( state.get() );
+    
+    // Three different configurations as frames
+    std::vector<std::vector<scalar>> spins( 3 );
+    std::vector<float> energies( 3 );
+    for (int frame=0; frame<3; frame++)
+    {
+        if (frame == 0)
+            Configuration_PlusZ( state.get(), defaultPos, defaultRect );
+        else if (frame == 1)
+            Configuration_Random( state.get(), defaultPos, defaultRect );
+        else
+            Configuration_Domain( state.get(), std::array<float,3>{ {1, 0, 0} }.data() );
+        scalar * data = System_Get_Spin_Directions( state.get() );
+        spins[frame].assign( data, data + 3*nos );
+        System_Update_Data( state.get() );
+        energies[frame] = System_Get_Energy( state.get() );
+    }
+    
+    std::vector<std::tuple< std::string, int, double >> encodings { 
+        { "core/test/io_test_files/trajectory_f64.bin", IO_Trajectory_Float64,     1e-12 },
+        { "core/test/io_test_files/trajectory_f32.bin", IO_Trajectory_Float32,     1e-6  },
+        { "core/test/io_test_files/trajectory_q16.bin", IO_Trajectory_Quantised16, 1e-4  } };
+    
+    for ( auto encoding : encodings )
+    {
+        const char * filename = std::get<0>( encoding ).c_str();
+        double epsilon = std::get<2>( encoding );
+        INFO( "IO trajectory " + std::get<0>( encoding ) );
+        std::remove( filename );
+        
+        for (int frame=0; frame<3; frame++)
+        {
+            std::copy( spins[frame].begin(), spins[frame].end(), System_Get_Spin_Directions( state.get() ) );
+            IO_Image_Trajectory_Append( state.get(), filename, 10*frame, 0.5f*frame, std::get<1>( encoding ) );
+        }
+        REQUIRE( IO_Trajectory_N_Frames( state.get(), filename ) == 3 );
+        
+        // An incomplete frame at the end is ignored and overwritten by the next frame
+        std::ofstream( filename, std::ios::app | std::ios::binary ) << "incomplete";
+        REQUIRE( IO_Trajectory_N_Frames( state.get(), filename ) == 3 );
+        IO_Image_Trajectory_Append( state.get(), filename, 30, 1.5f, std::get<1>( encoding ) );
+        REQUIRE( IO_Trajectory_N_Frames( state.get(), filename ) == 4 );
+        IO::Trajectory_File trajectory( filename );
+        REQUIRE( trajectory.nos() == nos );
+        REQUIRE( trajectory.with_energies() );
+        REQUIRE( int(trajectory.encoding()) == std::get<1>( encoding ) );
+        
+        // Frames can be read in any order
+        auto state_read = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+        for (int frame : { 2, 0, 1 })
+        {
+            float time = 0, energy = 0;
+            int iteration = IO_Image_Trajectory_Read_Frame( state_read.get(), filename, frame, &time, &energy );
+            REQUIRE( iteration == 10*frame );
+            REQUIRE( time == Approx( 0.5f*frame ) );
+            REQUIRE( energy == Approx( energies[frame] ) );
+            scalar * data = System_Get_Spin_Directions( state_read.get() );
+            for (int i=0; i<3*nos; i++)
+                REQUIRE( data[i] == Approx( spins[frame][i] ).epsilon( epsilon ) );
+        }
+    }
+}
+
+TEST_CASE( "IO-FILTER-FILE-HANDLE", "[io-filter]" )
+{
+    const std::string filename = "core/test/io_test_files/filter_file_handle.cfg";
+    IO::String_to_File( "# Comment line\n"
+                        "n_basis_cells_x 4 # trailing comment\n"
+                        "n_basis_cells   8\n"
+                        "Mu_s 2.5\n"
+                        "  indented 1\n"
+                        "n_pairs 2\n"
+                        "i j  Jij\n"
+                        "0 1  1.5\n"
+                        "1 0 -2e-1\n", filename );
+    
+    {
+        IO::Filter_File_Handle file( filename );
+        
+        // Keywords are found by prefix in file order, ignoring capitalization and comments
+        int n = 0;
+        REQUIRE( file.Read_Single( n, "n_basis_cells", false ) );
+        REQUIRE( n == 4 );
+        scalar mu_s = 0;
+        REQUIRE( file.Read_Single( mu_s, "MU_S", false ) );
+        REQUIRE( mu_s == Approx( 2.5 ) );
+        REQUIRE( !file.Find( "indented" ) );
+        REQUIRE( !file.Find( "comment" ) );
+        
+        // Reading continues after the keyword
+        REQUIRE( file.Find( "n_pairs" ) );
+        file.tokens >> n;
+        REQUIRE( n == 2 );
+        REQUIRE( file.GetLine() );
+        std::string column;
+        file.tokens >> column >> column >> column;
+        REQUIRE( column == "jij" );
+        std::vector<scalar> J;
+        int i = -1, j = -1;
+        scalar Jij = 0;
+        while( file.GetLine() && file.tokens >> i >> j >> Jij )
+            J.push_back( Jij );
+        REQUIRE( J.size() == 2 );
+        REQUIRE( J[0] == Approx( 1.5 ) );
+        REQUIRE( J[1] == Approx( -0.2 ) );
+        REQUIRE( !( file.tokens >> Jij ) );
+    }
+    
+    // A changed file is read again
+    IO::String_to_File( "n_basis_cells_x 16\n", filename );
+    IO::Filter_File_Handle file( filename );
+    int n = 0;
+    REQUIRE( file.Read_Single( n, "n_basis_cells_x", false ) );
+    REQUIRE( n == 16 );
+
+    // Also if it is rewritten right away with the same size
+    IO::String_to_File( "n_basis_cells_x 32\n", filename );
+    IO::Filter_File_Handle file_rewritten( filename );
+    REQUIRE( file_rewritten.Read_Single( n, "n_basis_cells_x", false ) );
+    REQUIRE( n == 32 );
+
+    // A large file is read and indexed once for consecutive handles
+    const std::string filename_large = "core/test/io_test_files/filter_file_handle_large.cfg";
+    std::string table = "n_pairs 200000\n";
+    for (int i = 0; i < 200000; ++i)
+        table += "0 1  0 0 0  1.0000000000  0.0000000000\n";
+    REQUIRE( table.size() > 4*1024*1024 );
+    IO::String_to_File( table, filename_large );
+    IO::Filter_File_Handle large_first( filename_large );
+    IO::Filter_File_Handle large_second( filename_large );
+    REQUIRE( &large_first.Lines() == &large_second.Lines() );
+}
+
+TEST_CASE( "IO-INTERACTION-TABLES", "[io-interactions]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    auto geometry = state->active_image->geometry;
+    
+    const std::string filename = "core/test/io_test_files/interaction_pairs.txt";
+    const std::string cache_folder = "core/test/io_test_files";
+    IO::String_to_File( "# Pairs with an unused column\n"
+                        "n_interaction_pairs 4\n"
+                        "i j  da db dc  unused  jij  dij  dijx dijy dijz\n"
+                        "0 0   1  0  0  a       10.0 6.0  1    0    0\n"
+                        "0 0   0  1  0  b       0    2.0  0    3    4\n"
+                        "\n"
+                        "0 0   0 -1  0  c       -1.5 0    0    0    0\n"
+                        "0 0   0  0  1  d       7    7    7    7    7\n", filename );
+    
+    // Parsed from the file, then written to and read from the cache
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        INFO( "Pass " << pass );
+        int nop = 0;
+        pairfield exchange_pairs, dmi_pairs;
+        scalarfield exchange_magnitudes, dmi_magnitudes;
+        vectorfield dmi_normals;
+        IO::Pairs_from_File( filename, geometry, nop, exchange_pairs, exchange_magnitudes, 
+                             dmi_pairs, dmi_magnitudes, dmi_normals, pass == 0 ? "" : cache_folder );
+        
+        // The table ends after 4 rows, the empty line counts as a row without interactions
+        REQUIRE( nop == 4 );
+        REQUIRE( exchange_pairs.size() == 2 );
+        REQUIRE( exchange_pairs[1].translations[1] == -1 );
+        REQUIRE( exchange_magnitudes[0] == Approx( 10 ) );
+        REQUIRE( exchange_magnitudes[1] == Approx( -1.5 ) );
+        REQUIRE( dmi_pairs.size() == 2 );
+        REQUIRE( dmi_pairs[1].translations[1] == 1 );
+        REQUIRE( dmi_magnitudes[1] == Approx( 2 ) );
+        REQUIRE( dmi_normals[1][1] == Approx( 0.6 ) );
+        REQUIRE( dmi_normals[1][2] == Approx( 0.8 ) );
+    }
+}
+
+TEST_CASE( "IO-INTERACTION-TRANSLATIONS", "[io-interactions]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    auto geometry = state->active_image->geometry;
+
+    // The translations along the third basis vector are read from the dc columns
+    const std::string triplets_file = "core/test/io_test_files/interaction_triplets.txt";
+    IO::String_to_File( "n_interaction_triplets 1\n"
+                        "i j da_j db_j dc_j k da_k db_k dc_k q1 na nb nc q2\n"
+                        "0 0  1    2    3  0  -1   -2   -3  1.5 0  0  1  2.5\n", triplets_file );
+    int n_triplets = 0;
+    tripletfield triplets;
+    scalarfield triplet_magnitudes1, triplet_magnitudes2;
+    IO::Triplets_from_File( triplets_file, geometry, n_triplets, triplets, triplet_magnitudes1, triplet_magnitudes2 );
+    REQUIRE( triplets.size() == 1 );
+    REQUIRE( triplets[0].d_j[0] == 1 );
+    REQUIRE( triplets[0].d_j[1] == 2 );
+    REQUIRE( triplets[0].d_j[2] == 3 );
+    REQUIRE( triplets[0].d_k[2] == -3 );
+
+    const std::string quadruplets_file = "core/test/io_test_files/interaction_quadruplets.txt";
+    IO::String_to_File( "n_interaction_quadruplets 1\n"
+                        "i j da_j db_j dc_j k da_k db_k dc_k l da_l db_l dc_l q\n"
+                        "0 0  1    2    3  0   4    5    6  0   7    8    9  0.5\n", quadruplets_file );
+    int noq = 0;
+    quadrupletfield quadruplets;
+    scalarfield quadruplet_magnitudes;
+    IO::Quadruplets_from_File( quadruplets_file, geometry, noq, quadruplets, quadruplet_magnitudes );
+    REQUIRE( quadruplets.size() == 1 );
+    REQUIRE( quadruplets[0].d_j[1] == 2 );
+    REQUIRE( quadruplets[0].d_j[2] == 3 );
+    REQUIRE( quadruplets[0].d_k[2] == 6 );
+    REQUIRE( quadruplets[0].d_l[2] == 9 );
+    REQUIRE( quadruplet_magnitudes[0] == Approx( 0.5 ) );
+}
+
+TEST_CASE( "IO-OUTPUT-QUEUE", "[io-queue]" )
+{
+    const std::string filename = "core/test/io_test_files/output_queue.txt";
+    const int n_lines = 200;
+    
+    // A small limit, so that queueing has to wait for the writers
+    auto max_bytes = IO::Output_Queue::Get_Max_Bytes();
+    IO::Output_Queue::Set_Max_Bytes( 64 );
+    
+    IO::String_to_File( "", filename );
+    for (int i=0; i<n_lines; i++)
+    {
+        std::string line = std::to_string( i ) + "\n";
+        IO::Output_Queue::Enqueue( filename, [line, filename]() 
+        { 
+            IO::Append_String_to_File( line, filename ); 
+        }, line.size() );
+    }
+    IO::Output_Queue::Drain();
+    IO::Output_Queue::Set_Max_Bytes( max_bytes );
+    
+    // All lines must have been written in the order they were queued
+    std::ifstream ifile( filename );
+    std::string line;
+    int i = 0;
+    while( std::getline( ifile, line ) )
+    {
+        REQUIRE( line == std::to_string( i ) );
+        ++i;
+    }
+    REQUIRE( i == n_lines );
+    
+    // A group waits for the tasks queued while it exists
+    std::atomic<int> n_written( 0 );
+    {
+        IO::Output_Queue::Group group;
+        for (int i=0; i<10; i++)
+            IO::Output_Queue::Enqueue( filename, [&n_written]() { ++n_written; } );
+        group.Drain();
+        REQUIRE( n_written == 10 );
+    }
+}
+
+TEST_CASE( "IO-CHECKPOINT", "[io-checkpoint]" )
+{
+    const char cfgfile[] = "core/test/input/physics_larmor.cfg";
+    const char checkpoint[] = "core/test/io_test_files/checkpoint.bin";
+    
+    auto state = std::shared_ptr<State>( State_Setup( cfgfile ), State_Delete );
+    int nos = System_Get_NOS( state.get() );
+    
+    // Run a few iterations and write a checkpoint
+    Configuration_Random( state.get() );
+    Simulation_PlayPause( state.get(), "LLG", "VP", 10 );
+    IO_State_Checkpoint( state.get(), checkpoint );
+    
+    scalar * data = System_Get_Spin_Directions( state.get() );
+    std::vector<scalar> spins( data, data + 3*nos );
+    
+    // Restoring has to reproduce the spins exactly
+    Configuration_PlusZ( state.get() );
+    IO_State_Restore( state.get(), checkpoint );
+    data = System_Get_Spin_Directions( state.get() );
+    for (int i=0; i<3*nos; i++)
+        REQUIRE( data[i] == spins[i] );
+    
+    // The next matching method continues from the iteration of the checkpoint,
+    // so with the same number of iterations it has nothing left to do
+    Simulation_PlayPause( state.get(), "LLG", "VP", 10 );
+    data = System_Get_Spin_Directions( state.get() );
+    for (int i=0; i<3*nos; i++)
+        REQUIRE( data[i] == spins[i] );
+    
+    // A file which is not a checkpoint must not change the State
+    Configuration_PlusZ( state.get() );
+    spins.assign( data, data + 3*nos );
+    IO_State_Restore( state.get(), cfgfile );
+    data = System_Get_Spin_Directions( state.get() );
+    for (int i=0; i<3*nos; i++)
+        REQUIRE( data[i] == spins[i] );
+}
+
+TEST_CASE( "IO-CHECKPOINT-CONTINUE", "[io-checkpoint]" )
+{
+    const char checkpoint_start[] = "core/test/io_test_files/checkpoint_start.bin";
+    const char checkpoint[]       = "core/test/io_test_files/checkpoint_continue.bin";
+
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+    int nos = System_Get_NOS( state.get() );
+    auto get_spins = [&]()
+    {
+        scalar * data = System_Get_Spin_Directions( state.get() );
+        return std::vector<scalar>( data, data + 3*nos );
+    };
+
+    // The VP solver carries velocities from one iteration to the next, the SIB solver at
+    // nonzero temperature draws random numbers in each iteration
+    std::vector<std::pair<const char *, float>> runs{ { "VP", 0 }, { "SIB", 10 } };
+    for (auto & run : runs)
+    {
+        INFO( "Solver " << run.first );
+        Parameters_Set_LLG_Temperature( state.get(), run.second );
+        Configuration_Random( state.get() );
+        IO_State_Checkpoint( state.get(), checkpoint_start );
+
+        // Uninterrupted run
+        Simulation_PlayPause( state.get(), "LLG", run.first, 20 );
+        auto spins_uninterrupted = get_spins();
+
+        // Interrupted run from the same start, continued after other iterations in between
+        IO_State_Restore( state.get(), checkpoint_start );
+        Simulation_PlayPause( state.get(), "LLG", run.first, 10 );
+        IO_State_Checkpoint( state.get(), checkpoint );
+        Configuration_PlusZ( state.get() );
+        Simulation_PlayPause( state.get(), "LLG", run.first, 7 );
+        IO_State_Restore( state.get(), checkpoint );
+        Simulation_PlayPause( state.get(), "LLG", run.first, 20 );
+
+        auto spins_continued = get_spins();
+        for (int i=0; i<3*nos; i++)
+            REQUIRE( spins_continued[i] == spins_uninterrupted[i] );
+    }
+
+    // A checkpoint with an invalid random number generator state does not change the State
+    std::string contents;
+    {
+        std::ifstream file( checkpoint, std::ios::in | std::ios::binary );
+        contents.assign( (std::istreambuf_iterator<char>( file )), std::istreambuf_iterator<char>() );
+    }
+    // The text of the GNEB generator of the first chain follows the header (16 bytes), the
+    // chain counts (8 bytes), the image counts (8 bytes) and its length (8 bytes)
+    REQUIRE( contents.size() > 40 );
+    contents[40] = 'x';
+    {
+        std::ofstream file( checkpoint, std::ios::out | std::ios::binary | std::ios::trunc );
+        file.write( contents.data(), contents.size() );
+    }
+    Configuration_PlusZ( state.get() );
+    auto spins_plusz = get_spins();
+    IO_State_Restore( state.get(), checkpoint );
+    REQUIRE( get_spins() == spins_plusz );
+}
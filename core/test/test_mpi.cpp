@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include <Spirit/State.h>
+#include <Spirit/Geometry.h>
+#include <Spirit/Configurations.h>
+#include <Spirit/Simulation.h>
+#include <Spirit/Quantities.h>
+#include <data/State.hpp>
+#include <engine/Decomposition.hpp>
+
+#include <mpi.h>
+
+// Each test is run with the decomposition across all ranks of MPI_COMM_WORLD
+// and compared to the serial result, obtained on MPI_COMM_SELF
+const std::vector<const char *> inputfiles{ "core/test/input/api.cfg", "core/test/input/fd_pairs.cfg" };
+
+std::shared_ptr<State> setup_state(const char * inputfile)
+{
+    auto state = std::shared_ptr<State>( State_Setup( inputfile ), State_Delete );
+
+    // Make sure each rank owns more than a single layer of cells
+    int n_cells[3] = { 12, 12, 1 };
+    Geometry_Set_N_Cells( state.get(), n_cells );
+
+    // Same random configuration on all ranks
+    Configuration_Random( state.get() );
+    Engine::Decomposition::Broadcast( *state->active_image->spins );
+    return state;
+}
+
+TEST_CASE( "Decomposed gradient and energy", "[mpi]" )
+{
+    for( auto inputfile : inputfiles )
+    {
+        auto state = setup_state( inputfile );
+        auto& image = *state->active_image;
+        auto& spins = *image.spins;
+
+        Engine::Decomposition::Set_Communicator( MPI_COMM_WORLD );
+        vectorfield gradient( spins.size() );
+        image.hamiltonian->Gradient( spins, gradient );
+        scalar energy = image.hamiltonian->Energy( spins );
+
+        Engine::Decomposition::Set_Communicator( MPI_COMM_SELF );
+        vectorfield gradient_serial( spins.size() );
+        image.hamiltonian->Gradient( spins, gradient_serial );
+        scalar energy_serial = image.hamiltonian->Energy( spins );
+
+        INFO( "Input file: " << inputfile );
+        REQUIRE( energy == Approx( energy_serial ) );
+        for( unsigned int i = 0; i < spins.size(); ++i )
+        {
+            INFO( "i = " << i << ", gradient = " << gradient[i].transpose() << ", serial = " << gradient_serial[i].transpose() );
+            REQUIRE( gradient[i].isApprox( gradient_serial[i] ) );
+        }
+
+        Engine::Decomposition::Set_Communicator( MPI_COMM_WORLD );
+    }
+}
+
+TEST_CASE( "Decomposed LLG iterations", "[mpi]" )
+{
+    auto state = setup_state( "core/test/input/api.cfg" );
+    auto& spins = *state->active_image->spins;
+    vectorfield spins_initial = spins;
+
+    // Simulation_PlayPause runs the given number of iterations before returning
+    Engine::Decomposition::Set_Communicator( MPI_COMM_WORLD );
+    Simulation_PlayPause( state.get(), "LLG", "Depondt", 20 );
+    vectorfield spins_decomposed = spins;
+    float torque = Simulation_Get_MaxTorqueComponent( state.get() );
+
+    Engine::Decomposition::Set_Communicator( MPI_COMM_SELF );
+    spins = spins_initial;
+    Simulation_PlayPause( state.get(), "LLG", "Depondt", 20 );
+    float torque_serial = Simulation_Get_MaxTorqueComponent( state.get() );
+
+    REQUIRE( torque == Approx( torque_serial ) );
+    for( unsigned int i = 0; i < spins.size(); ++i )
+    {
+        INFO( "i = " << i );
+        REQUIRE( spins_decomposed[i].isApprox( spins[i] ) );
+    }
+
+    Engine::Decomposition::Set_Communicator( MPI_COMM_WORLD );
+}
@@ -6,7 +6,10 @@
 #include <Spirit/Hamiltonian.h>
 #include <Spirit/Constants.h>
 #include <Spirit/Parameters.h>
+#include <Spirit/Geometry.h>
 #include <data/State.hpp>
+#include <engine/Vectormath.hpp>
+#include <utility/Constants.hpp>
 #include <Eigen/Dense>
 #include <Eigen/Core>
 #include <iostream>
@@ -138,3 +141,117 @@ TEST_CASE( "Finite Differences", "[physics]" )
         REQUIRE( hessian_fd.isApprox( hessian ) );
     }
 }
+
+TEST_CASE( "Ewald summation of the DDI", "[physics]" )
+{
+    // simple cubic lattice with lattice constant 1 and mu_s = 2
+    auto state = std::shared_ptr<State>( State_Setup( "core/test/input/physics_larmor.cfg" ), State_Delete );
+    auto& image = *state->active_image;
+    Hamiltonian_Set_DDI_Method( state.get(), Hamiltonian_DDI_Ewald );
+
+    float mu_s;
+    Hamiltonian_Get_mu_s( state.get(), &mu_s );
+    // energy of two parallel moments mu_s at a distance of 1 Angstrom, perpendicular to their connection
+    scalar unit = Utility::Constants::mu_0 * std::pow( Utility::Constants::mu_B * mu_s, 2 )
+                    / ( 4*Utility::Constants::Pi * 1e-30 );
+
+    auto ddi_energy_per_spin = [&]()
+    {
+        for( auto& contribution : image.hamiltonian->Energy_Contributions( *image.spins ) )
+            if( contribution.first == "DD" ) return contribution.second / state->nos;
+        return scalar(0);
+    };
+
+    float x[3] = { 1, 0, 0 };
+    float z[3] = { 0, 0, 1 };
+
+    SECTION( "Film" )
+    {
+        // sum of 1/|n|^3 over the square lattice
+        scalar S = 9.0336216831;
+        bool periodical[3] = { true, true, false };
+        int n_cells[3] = { 3, 3, 1 };
+        Hamiltonian_Set_Boundary_Conditions( state.get(), periodical );
+        Geometry_Set_N_Cells( state.get(), n_cells );
+
+        Configuration_Domain( state.get(), z );
+        REQUIRE( ddi_energy_per_spin() == Approx( S/2 * unit ) );
+        Configuration_Domain( state.get(), x );
+        REQUIRE( ddi_energy_per_spin() == Approx( -S/4 * unit ) );
+    }
+
+    SECTION( "Wire" )
+    {
+        // sum of 1/n^3 over the integers is 2 zeta(3)
+        scalar zeta_3 = 1.2020569031596;
+        bool periodical[3] = { true, false, false };
+        int n_cells[3] = { 4, 1, 1 };
+        Hamiltonian_Set_Boundary_Conditions( state.get(), periodical );
+        Geometry_Set_N_Cells( state.get(), n_cells );
+
+        Configuration_Domain( state.get(), x );
+        REQUIRE( ddi_energy_per_spin() == Approx( -2*zeta_3 * unit ) );
+        Configuration_Domain( state.get(), z );
+        REQUIRE( ddi_energy_per_spin() == Approx( zeta_3 * unit ) );
+    }
+
+    SECTION( "Bulk" )
+    {
+        // a cubic ferromagnet in a conducting environment has the Lorentz energy -2pi/3 per spin
+        bool periodical[3] = { true, true, true };
+        int n_cells[3] = { 2, 2, 2 };
+        Hamiltonian_Set_Boundary_Conditions( state.get(), periodical );
+        Geometry_Set_N_Cells( state.get(), n_cells );
+
+        Configuration_Domain( state.get(), z );
+        REQUIRE( ddi_energy_per_spin() == Approx( -2*Utility::Constants::Pi/3 * unit ) );
+        Configuration_Domain( state.get(), x );
+        REQUIRE( ddi_energy_per_spin() == Approx( -2*Utility::Constants::Pi/3 * unit ) );
+
+        // a checkerboard antiferromagnet has no net moment, so the spherical direct sum converges to the same energy
+        auto& spins = *image.spins;
+        auto& geometry = *image.geometry;
+        for( int i = 0; i < state->nos; ++i )
+        {
+            auto t = Engine::Vectormath::translations_from_idx( geometry.n_cells, geometry.n_cell_atoms, i );
+            spins[i] = Vector3{ 1, 1, 1 }.normalized() * ( ( t[0] + t[1] + t[2] ) % 2 == 0 ? 1 : -1 );
+        }
+        scalar E_direct = 0;
+        int n_max = 20;
+        for( int i = 0; i < state->nos; ++i )
+        {
+            for( int j = 0; j < state->nos; ++j )
+            {
+                for( int a = -n_max; a <= n_max; ++a )
+                for( int b = -n_max; b <= n_max; ++b )
+                for( int c = -n_max; c <= n_max; ++c )
+                {
+                    Vector3 r = geometry.positions[j] - geometry.positions[i]
+                        + 2 * ( a*geometry.bravais_vectors[0] + b*geometry.bravais_vectors[1] + c*geometry.bravais_vectors[2] );
+                    scalar d = r.norm();
+                    if( d < 1e-10 || d > 2*n_max ) continue;
+                    E_direct += 0.5 * ( spins[i].dot( spins[j] ) - 3 * spins[i].dot( r ) * spins[j].dot( r ) / (d*d) ) / (d*d*d);
+                }
+            }
+        }
+        REQUIRE( ddi_energy_per_spin() == Approx( E_direct / state->nos * unit ).epsilon( 1e-4 ) );
+    }
+
+    SECTION( "Gradient" )
+    {
+        bool periodical[3] = { true, true, false };
+        int n_cells[3] = { 3, 2, 2 };
+        Hamiltonian_Set_Boundary_Conditions( state.get(), periodical );
+        Geometry_Set_N_Cells( state.get(), n_cells );
+        Configuration_Random( state.get() );
+
+        auto& spins = *image.spins;
+        auto grad    = vectorfield( state->nos );
+        auto grad_fd = vectorfield( state->nos );
+        image.hamiltonian->Gradient( spins, grad );
+        image.hamiltonian->Gradient_FD( spins, grad_fd );
+
+        for( int i = 0; i < state->nos; ++i )
+            REQUIRE( grad_fd[i].isApprox( grad[i], 1e-5 ) );
+    }
+}
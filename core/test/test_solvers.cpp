@@ -8,6 +8,8 @@
 #include <Spirit/System.h>
 #include <Spirit/Chain.h>
 #include <Spirit/Quantities.h>
+#include <data/State.hpp>
+#include <engine/Method_MMF.hpp>
 #include <iostream>
 
 TEST_CASE( "Solvers testing", "[solvers]" )
@@ -135,4 +137,46 @@ TEST_CASE( "Solvers testing", "[solvers]" )
             REQUIRE( magnetization_sp[dim] == Approx( magnetization_sp_expected[dim] ) );
     }
 
-}
\ No newline at end of file
+}
+
+// Gives access to a single iteration of a Method, which is private in the specialized Methods
+template<typename Method_Type>
+class Single_Iteration : public Method_Type
+{
+public:
+    using Method_Type::Method_Type;
+
+    void Step()
+    {
+        this->Hook_Pre_Iteration();
+        this->Iteration();
+        this->Hook_Post_Iteration();
+    }
+
+private:
+    using Engine::Method::Hook_Pre_Iteration;
+    using Engine::Method::Iteration;
+    using Engine::Method::Hook_Post_Iteration;
+};
+
+TEST_CASE( "MMF iteration", "[solvers]" )
+{
+    auto state = std::shared_ptr<State>( State_Setup( "core/test/input/solvers.cfg" ), State_Delete );
+    int n_cells[3]{ 6, 6, 1 };
+    Geometry_Set_N_Cells( state.get(), n_cells );
+    Configuration_PlusZ( state.get() );
+    Configuration_Skyrmion( state.get(), 2, 1, -90, false, false, false );
+    auto & image = *state->active_image;
+
+    // The Method has to set up the configurations and forces of its systems before the Solver
+    //      allocates its workspace and iterates them. The minimum mode force itself is not
+    //      implemented yet, so the spins only have to stay on the unit sphere.
+    for (int step = 0; step < 2; ++step)
+    {
+        std::shared_ptr<Single_Iteration<Engine::Method_MMF<Engine::Solver::SIB>>> method;
+        REQUIRE_NOTHROW( method = std::make_shared<Single_Iteration<Engine::Method_MMF<Engine::Solver::SIB>>>( state->collection, 0 ) );
+        REQUIRE_NOTHROW( method->Step() );
+    }
+    for (int i = 0; i < image.nos; ++i)
+        REQUIRE( (*image.spins)[i].norm() == Approx( 1 ) );
+}
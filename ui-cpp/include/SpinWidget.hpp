@@ -4,9 +4,11 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 
 #include <QtWidgets/QOpenGLWidget>
 #include "MouseDecoratorWidget.hpp"
+#include "Spirit_Defines.h"
 
 #include "glm/glm.hpp"
 
@@ -265,6 +267,16 @@ private:
   VFRendering::VectorField m_vf;
   VFRendering::VectorField m_vf_surf2D;
 
+  // Geometry of the last update of the vectorfield geometry (numbers of spins and cells, cell step,
+  //  dimensionality, bounds and arrow size), so that the geometry is only rebuilt when it changed
+  std::vector<float> m_geometry_key;
+  std::vector<float> geometryKey();
+  // Indices of the spins which are drawn with the current n_cell_step
+  std::vector<int> m_draw_indices;
+  // Buffers reused between updates of the directions
+  std::vector<scalar> m_snapshot;
+  std::vector<glm::vec3> m_directions;
+
   // Interaction mode
   InteractionMode m_interactionmode;
 	bool   regular_mode_perspective;
@@ -48,10 +48,10 @@ void DebugWidget::updateData()
 void DebugWidget::UpdateFromLog()
 {
 	// Load all new Log messages and apply filters
-	auto entries = Log_Get_Entries(state.get());
-	auto n_old_entries = this->n_log_entries;
-	this->n_log_entries = entries.size();
-	for (int i = n_old_entries; i < this->n_log_entries; ++i)
+	int n_entries = Log_Get_N_Entries(state.get());
+	auto entries = Log_Get_Entries(state.get(), this->n_log_entries, n_entries);
+	this->n_log_entries = n_entries;
+	for (int i = 0; i < (int)entries.size(); ++i)
 	{
 		if ((int)entries[i].level <= this->comboBox_ShowLevel->currentIndex())
 		{
@@ -302,9 +302,20 @@ void SpinWidget::screenShot(std::string filename)
     pixmap.save((filename + ".png").c_str());
 }
 
+std::vector<float> SpinWidget::geometryKey()
+{
+    int n_cells[3];
+    Geometry_Get_N_Cells(this->state.get(), n_cells);
+    float b_min[3], b_max[3];
+    Geometry_Get_Bounds(state.get(), b_min, b_max);
+    return { (float)System_Get_NOS(state.get()), (float)Geometry_Get_N_Cell_Atoms(this->state.get()),
+             (float)n_cells[0], (float)n_cells[1], (float)n_cells[2], (float)n_cell_step,
+             (float)Geometry_Get_Dimensionality(state.get()),
+             b_min[0], b_min[1], b_min[2], b_max[0], b_max[1], b_max[2], this->arrowSize() };
+}
+
 void SpinWidget::updateVectorFieldGeometry()
 {
-    int nos = System_Get_NOS(state.get());
     int n_cells[3];
     Geometry_Get_N_Cells(this->state.get(), n_cells);
     int n_cell_atoms = Geometry_Get_N_Cell_Atoms(this->state.get());
@@ -312,16 +323,10 @@ void SpinWidget::updateVectorFieldGeometry()
     int n_cells_draw[3] = {std::max(1, n_cells[0]/n_cell_step), std::max(1, n_cells[1]/n_cell_step), std::max(1, n_cells[2]/n_cell_step)};
     int nos_draw = n_cell_atoms*n_cells_draw[0]*n_cells_draw[1]*n_cells_draw[2];
 
-    // Positions of the vectorfield
-    std::vector<glm::vec3> positions = std::vector<glm::vec3>(nos_draw);
+    this->m_geometry_key = this->geometryKey();
 
-    // ToDo: Update the pointer to our Data instead of copying Data?
-    // Positions
-    //		get pointer
-    scalar *spin_pos;
-    int *atom_types;
-    spin_pos = Geometry_Get_Positions(state.get());
-    atom_types = Geometry_Get_Atom_Types(state.get());
+    // Indices of the spins which are drawn, i.e. of every n_cell_step'th cell
+    this->m_draw_indices.resize(nos_draw);
     int icell = 0;
     for (int cell_c=0; cell_c<n_cells_draw[2]; cell_c++)
     {
@@ -331,14 +336,23 @@ void SpinWidget::updateVectorFieldGeometry()
             {
                 for (int ibasis=0; ibasis < n_cell_atoms; ++ibasis)
                 {
-                    int idx = ibasis + n_cell_atoms*cell_a*n_cell_step + n_cell_atoms*n_cells[0]*cell_b*n_cell_step + n_cell_atoms*n_cells[0]*n_cells[1]*cell_c*n_cell_step;
-                    positions[icell] = glm::vec3(spin_pos[3*idx], spin_pos[1 + 3*idx], spin_pos[2 + 3*idx]);
+                    this->m_draw_indices[icell] = ibasis + n_cell_atoms*cell_a*n_cell_step + n_cell_atoms*n_cells[0]*cell_b*n_cell_step + n_cell_atoms*n_cells[0]*n_cells[1]*cell_c*n_cell_step;
                     ++icell;
                 }
             }
         }
     }
 
+    // Positions of the vectorfield
+    std::vector<glm::vec3> positions = std::vector<glm::vec3>(nos_draw);
+    const scalar *spin_pos = Geometry_Get_Positions(state.get());
+    #pragma omp parallel for
+    for (int i = 0; i < nos_draw; ++i)
+    {
+        int idx = this->m_draw_indices[i];
+        positions[i] = glm::vec3(spin_pos[3*idx], spin_pos[1 + 3*idx], spin_pos[2 + 3*idx]);
+    }
+
     // Generate the right geometry (triangles and tetrahedra)
     VFRendering::Geometry geometry;
     VFRendering::Geometry geometry_surf2D;
@@ -362,7 +376,7 @@ void SpinWidget::updateVectorFieldGeometry()
         // Determine two basis vectors
         std::array<glm::vec3, 2> basis;
         float eps = 1e-6;
-        for (int i=1, j=0; i < nos && j < 2; ++i)
+        for (int i=1, j=0; i < nos_draw && j < 2; ++i)
         {
             if ( glm::length(positions[i] - positions[0]) > eps )
             {
@@ -421,79 +435,62 @@ void SpinWidget::updateVectorFieldGeometry()
 
 void SpinWidget::updateVectorFieldDirections()
 {
-    int nos = System_Get_NOS(state.get());
-    int n_cells[3];
-    Geometry_Get_N_Cells(this->state.get(), n_cells);
-    int n_cell_atoms = Geometry_Get_N_Cell_Atoms(this->state.get());
-
-    int n_cells_draw[3] = {std::max(1, n_cells[0]/n_cell_step), std::max(1, n_cells[1]/n_cell_step), std::max(1, n_cells[2]/n_cell_step)};
-    int nos_draw = n_cell_atoms*n_cells_draw[0]*n_cells_draw[1]*n_cells_draw[2];
+    // The drawn spins need to belong to the current geometry
+    if (this->geometryKey() != this->m_geometry_key)
+        this->updateVectorFieldGeometry();
 
-    // Directions of the vectorfield
-    std::vector<glm::vec3> directions = std::vector<glm::vec3>(nos_draw);
+    int nos = System_Get_NOS(state.get());
+    int nos_draw = this->m_draw_indices.size();
 
-    // ToDo: Update the pointer to our Data instead of copying Data?
     // Directions
-    //		get pointer
-    scalar *spins;
-    int *atom_types;
-    atom_types = Geometry_Get_Atom_Types(state.get());
-    if (this->m_source == 0)
-        spins = System_Get_Spin_Directions(state.get());
-    else if (this->m_source == 1)
-        spins = System_Get_Effective_Field(state.get());
+    //		get a consistent snapshot, which does not block a running simulation
+    this->m_snapshot.resize(3*nos);
+    if (this->m_source == 1)
+        System_Get_Spin_Snapshot(state.get(), nullptr, this->m_snapshot.data());
     else
-        spins = System_Get_Spin_Directions(state.get());
-    //		copy
-    /*positions.assign(spin_pos, spin_pos + 3*nos);
-    directions.assign(spins, spins + 3*nos);*/
-    int icell = 0;
-    for (int cell_c=0; cell_c<n_cells_draw[2]; cell_c++)
-    {
-        for (int cell_b=0; cell_b<n_cells_draw[1]; cell_b++)
-        {
-            for (int cell_a=0; cell_a<n_cells_draw[0]; cell_a++)
-            {
-                for (int ibasis=0; ibasis < n_cell_atoms; ++ibasis)
-                {
-                    int idx = ibasis + n_cell_atoms*cell_a*n_cell_step + n_cell_atoms*n_cells[0]*cell_b*n_cell_step + n_cell_atoms*n_cells[0]*n_cells[1]*cell_c*n_cell_step;
-                    // std::cerr << idx << " " << icell << std::endl;
-                    directions[icell] = glm::vec3(spins[3*idx], spins[1 + 3*idx], spins[2 + 3*idx]);
-                    if (atom_types[idx] < 0) directions[icell] *= 0;
-                    ++icell;
-                }
-            }
-        }
+        System_Get_Spin_Snapshot(state.get(), this->m_snapshot.data());
+    const scalar *spins = this->m_snapshot.data();
+    const int *atom_types = Geometry_Get_Atom_Types(state.get());
+
+    //		pick the drawn spins and convert them to float, vacancies are drawn as zero vectors
+    this->m_directions.resize(nos_draw);
+    glm::vec3 *directions = this->m_directions.data();
+    const int *draw_indices = this->m_draw_indices.data();
+    #pragma omp parallel for
+    for (int i = 0; i < nos_draw; ++i)
+    {
+        int idx = draw_indices[i];
+        if (atom_types[idx] < 0)
+            directions[i] = glm::vec3(0, 0, 0);
+        else
+            directions[i] = glm::vec3(spins[3*idx], spins[1 + 3*idx], spins[2 + 3*idx]);
     }
+
     //		rescale if effective field
     if (this->m_source == 1)
     {
         float max_length = 0;
-        for (auto direction : directions)
-        {
-            max_length = std::max(max_length, glm::length(direction));
-        }
+        for (int i = 0; i < nos_draw; ++i)
+            max_length = std::max(max_length, glm::length(directions[i]));
         if (max_length > 0)
         {
-            for (auto& direction : directions)
-            {
-                direction /= max_length;
-            }
+            #pragma omp parallel for
+            for (int i = 0; i < nos_draw; ++i)
+                directions[i] /= max_length;
         }
     }
 
     // Update the vectorfield
-    this->m_vf.updateVectors(directions);
+    this->m_vf.updateVectors(this->m_directions);
 
     if (Geometry_Get_Dimensionality(state.get()) == 2)
-        this->m_vf_surf2D.updateVectors(directions);
+        this->m_vf_surf2D.updateVectors(this->m_directions);
 }
 
 void SpinWidget::updateData()
 {
-    // Update the VectorField
+    // Update the VectorField, the geometry is only rebuilt if it has changed
     this->updateVectorFieldDirections();
-    this->updateVectorFieldGeometry();
 
     // Update the View
     float b_min[3], b_max[3];